@@ -239,8 +239,10 @@ void pqComparativeVisPanel::updateView()
     vtkSMComparativeViewProxy* viewProxy =
       vtkSMComparativeViewProxy::SafeDownCast(this->Internal->View->getProxy());
 
-    // Call UpdateVisualization with 1 to force the update
+    // Call UpdateVisualization with 1 to force the update. It only updates the
+    // data of the views, render them to show the new visualization.
     viewProxy->UpdateVisualization(1);
+    this->Internal->View->render();
     }
 }
 
@@ -177,6 +177,7 @@ vtkSMViewProxy* pqComparativePlotView::getViewProxy() const
 void pqComparativePlotView::updateVisibility()
 {
   this->getComparativeViewProxy()->UpdateVisualization(1);
+  this->render();
 }
 
 //-----------------------------------------------------------------------------
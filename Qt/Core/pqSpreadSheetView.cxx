@@ -234,7 +234,13 @@ public:
   this->Table->setSelectionBehavior(QAbstractItemView::SelectRows);
   this->Table->setSelectionModel(&this->SelectionModel);
   this->Table->horizontalHeader()->setMovable(true);
+  // Clicking on a column header sorts the rows on the server.
+  this->Table->horizontalHeader()->setClickable(true);
+  this->Table->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+  this->Table->horizontalHeader()->setSortIndicatorShown(true);
   this->SingleColumnMode = false;
+  this->SortSection = -1;
+  this->SortClicks = 0;
   }
 
   ~pqInternal()
@@ -247,6 +253,11 @@ public:
   pqSpreadSheetViewModel Model;
   pqSpreadSheetViewSelectionModel SelectionModel;
   bool SingleColumnMode;
+
+  // The column the rows are sorted by and the number of times its header was
+  // clicked in a row.
+  int SortSection;
+  int SortClicks;
 };
 
 
@@ -274,6 +285,10 @@ pqSpreadSheetView::pqSpreadSheetView(
   QObject::connect(
     this->Internal->Table->horizontalHeader(), SIGNAL(sectionDoubleClicked(int)),
     this, SLOT(onSectionDoubleClicked(int)), Qt::QueuedConnection);
+  QObject::connect(
+    this->Internal->Table->horizontalHeader(),
+    SIGNAL(sortIndicatorChanged(int, Qt::SortOrder)),
+    this, SLOT(onSortIndicatorChanged(int, Qt::SortOrder)));
   
   QObject::connect( &(this->Internal->Model), SIGNAL( selectionOnly(int) ),
     this, SLOT( onSelectionOnly(int) ) );
@@ -442,6 +457,43 @@ void pqSpreadSheetView::onSectionDoubleClicked(int logicalindex)
     }
 }
 
+//-----------------------------------------------------------------------------
+/// Called when user clicks on a column header. Clicking on the same header
+/// toggles between ascending and descending order, the third click goes back
+/// to the natural order of the rows.
+void pqSpreadSheetView::onSortIndicatorChanged(int logicalindex,
+  Qt::SortOrder order)
+{
+  if (logicalindex >= 0 && logicalindex == this->Internal->SortSection &&
+    this->Internal->SortClicks >= 2)
+    {
+    logicalindex = -1;
+    QHeaderView* header = this->Internal->Table->horizontalHeader();
+    header->blockSignals(true);
+    header->setSortIndicator(-1, Qt::AscendingOrder);
+    header->blockSignals(false);
+    }
+
+  if (logicalindex < 0)
+    {
+    this->Internal->SortSection = -1;
+    this->Internal->SortClicks = 0;
+    this->Internal->Model.clearSort();
+    return;
+    }
+
+  if (logicalindex == this->Internal->SortSection)
+    {
+    this->Internal->SortClicks++;
+    }
+  else
+    {
+    this->Internal->SortSection = logicalindex;
+    this->Internal->SortClicks = 1;
+    }
+  this->Internal->Model.sort(logicalindex, order);
+}
+
 //-----------------------------------------------------------------------------
 void pqSpreadSheetView::onSelectionOnly(int selOnly)
 {
@@ -101,6 +101,9 @@ protected slots:
 
   /// Called when user double clicks on a column header.
   void onSectionDoubleClicked(int logicalindex);
+
+  /// Called when user clicks on a column header to sort by it.
+  void onSortIndicatorChanged(int logicalindex, Qt::SortOrder order);
   
   /// Called when checkbox "Show Only Selected Elements" is updated
   void onSelectionOnly(int selOnly);
@@ -130,9 +130,7 @@ public:
     {
     if (this->Representation)
       {
-      vtkPVDataInformation* info =
-        this->Representation->GetRepresentedDataInformation(true);
-      return info->GetNumberOfRows();
+      return this->Representation->GetNumberOfRows();
       }
     return 0;
     }
@@ -953,3 +951,60 @@ int pqSpreadSheetViewModel::getDecimalPrecision()
 {
   return this->Internal->DecimalPrecision;
 }
+
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::sort(int column, Qt::SortOrder order)
+{
+  vtkSMSpreadSheetRepresentationProxy* repr = this->Internal->Representation;
+  if (!repr || column < 0 || column >= this->columnCount() ||
+    !repr->IsAvailable(this->Internal->ActiveBlockNumber))
+    {
+    return;
+    }
+
+  vtkTable* table = vtkTable::SafeDownCast(
+    repr->GetOutput(this->Internal->ActiveBlockNumber));
+  if (!table || table->GetNumberOfColumns() <= column)
+    {
+    return;
+    }
+
+  QString name = table->GetColumnName(column);
+  if (name == "Structured Coordinates" || name == "vtkCompositeIndexArray")
+    {
+    // These columns are generated for the delivered block only, their order
+    // is that of the element ids.
+    name = "vtkOriginalIndices";
+    }
+
+  // The representation cleans its block cache when these are pushed, the next
+  // render then fetches the visible blocks in the new order.
+  pqSMAdaptor::setElementProperty(repr->GetProperty("SortColumnName"), name);
+  pqSMAdaptor::setElementProperty(repr->GetProperty("SortDescending"),
+    (order == Qt::DescendingOrder)? 1 : 0);
+  repr->UpdateVTKObjects();
+  if (this->Internal->DataRepresentation)
+    {
+    this->Internal->DataRepresentation->renderViewEventually();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::clearSort()
+{
+  vtkSMSpreadSheetRepresentationProxy* repr = this->Internal->Representation;
+  if (!repr)
+    {
+    return;
+    }
+
+  // An empty column name passes the rows in their natural order and releases
+  // the sort permutation on the server.
+  pqSMAdaptor::setElementProperty(repr->GetProperty("SortColumnName"), "");
+  pqSMAdaptor::setElementProperty(repr->GetProperty("SortDescending"), 0);
+  repr->UpdateVTKObjects();
+  if (this->Internal->DataRepresentation)
+    {
+    this->Internal->DataRepresentation->renderViewEventually();
+    }
+}
@@ -130,6 +130,14 @@ public:
   void setDecimalPrecision(int);
   int getDecimalPrecision();
 
+  /// Sorts the rows by the given column. The sort is done on the server, across
+  /// all processes, and only the visible blocks are fetched afterwards.
+  virtual void sort(int column, Qt::SortOrder order=Qt::AscendingOrder);
+
+  /// Clears the sort set by sort(), the rows are shown in their natural order
+  /// again.
+  void clearSort();
+
 signals:
   void requestDelayedUpdate() const;
   
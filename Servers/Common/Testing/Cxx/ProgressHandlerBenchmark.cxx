@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test executes vtkElevationFilter on the blocks of a multiblock dataset
+// while vtkPVProgressHandler reports its progress. Each report costs the given
+// time, standing for the handling of the progress by the client. It prints the
+// time taken without progress, with every progress event reported and with
+// the default sampling and report intervals, and checks that the reports
+// respect the report interval.
+// Usage: ProgressHandlerBenchmark [number of blocks] [block dimension]
+//                                 [report cost in milliseconds]
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkElevationFilter.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkProcessModuleGUIHelper.h"
+#include "vtkPVProgressHandler.h"
+#include "vtkSelfConnection.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <stdlib.h>
+
+// Counts the progress reports and spends the report cost on each.
+class vtkBenchmarkGUIHelper : public vtkProcessModuleGUIHelper
+{
+public:
+  static vtkBenchmarkGUIHelper* New();
+  vtkTypeRevisionMacro(vtkBenchmarkGUIHelper, vtkProcessModuleGUIHelper);
+
+  virtual int RunGUIStart(int, char**, int, int) { return 0; }
+  virtual void SendPrepareProgress() {}
+  virtual void SendCleanupPendingProgress() {}
+  virtual void SetLocalProgress(const char*, int)
+    {
+    this->NumberOfReports++;
+    if (this->ReportCost > 0)
+      {
+      vtksys::SystemTools::Delay(this->ReportCost);
+      }
+    }
+  virtual void ExitApplication() {}
+
+  int NumberOfReports;
+  unsigned int ReportCost;
+
+protected:
+  vtkBenchmarkGUIHelper()
+    {
+    this->NumberOfReports = 0;
+    this->ReportCost = 0;
+    }
+};
+
+vtkStandardNewMacro(vtkBenchmarkGUIHelper);
+vtkCxxRevisionMacro(vtkBenchmarkGUIHelper, "$Revision$");
+
+// Builds numBlocks image blocks of dim^3 points.
+static vtkMultiBlockDataSet* NewBlocks(int numBlocks, int dim)
+{
+  vtkMultiBlockDataSet* blocks = vtkMultiBlockDataSet::New();
+  blocks->SetNumberOfBlocks(numBlocks);
+  for (int b = 0; b < numBlocks; b++)
+    {
+    vtkImageData* image = vtkImageData::New();
+    image->SetDimensions(dim, dim, dim);
+    image->SetOrigin(b * (dim - 1), 0, 0);
+    blocks->SetBlock(b, image);
+    image->Delete();
+    }
+  return blocks;
+}
+
+// Executes the filter between PrepareProgress() and CleanupPendingProgress()
+// and returns the time taken.
+static double Execute(vtkElevationFilter* filter,
+                      vtkPVProgressHandler* handler)
+{
+  vtkTimerLog* timer = vtkTimerLog::New();
+  filter->Modified();
+  timer->StartTimer();
+  handler->PrepareProgress();
+  filter->Update();
+  handler->CleanupPendingProgress();
+  timer->StopTimer();
+  double time = timer->GetElapsedTime();
+  timer->Delete();
+  return time;
+}
+
+int main(int argc, char* argv[])
+{
+  int numBlocks = 1000;
+  int dim = 8;
+  unsigned int cost = 1;
+  if (argc > 3)
+    {
+    numBlocks = atoi(argv[1]);
+    dim = atoi(argv[2]);
+    cost = static_cast<unsigned int>(atoi(argv[3]));
+    }
+
+  vtkProcessModule* pm = vtkProcessModule::New();
+  vtkProcessModule::SetProcessModule(pm);
+  vtkBenchmarkGUIHelper* helper = vtkBenchmarkGUIHelper::New();
+  helper->ReportCost = cost;
+  pm->SetGUIHelper(helper);
+  vtkSelfConnection* connection = vtkSelfConnection::New();
+  vtkPVProgressHandler* handler = connection->GetProgressHandler();
+  handler->SetConnection(connection);
+
+  vtkSmartPointer<vtkMultiBlockDataSet> input;
+  input.TakeReference(NewBlocks(numBlocks, dim));
+  vtkSmartPointer<vtkCompositeDataPipeline> executive =
+    vtkSmartPointer<vtkCompositeDataPipeline>::New();
+  vtkSmartPointer<vtkElevationFilter> filter =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  filter->SetExecutive(executive);
+  filter->SetInput(input);
+  filter->SetHighPoint(numBlocks * (dim - 1), 0, 0);
+
+  double baseTime = Execute(filter, handler);
+  cout << "Blocks: " << numBlocks << ", no progress, time: " << baseTime
+       << " s" << endl;
+
+  handler->RegisterProgressEvent(filter, 1);
+  double samplingInterval = handler->GetSamplingInterval();
+  double reportInterval = handler->GetReportInterval();
+  int retVal = EXIT_SUCCESS;
+  for (int limited = 0; limited < 2; limited++)
+    {
+    handler->SetSamplingInterval(limited? samplingInterval : 0.0);
+    handler->SetReportInterval(limited? reportInterval : 0.0);
+    helper->NumberOfReports = 0;
+    double time = Execute(filter, handler);
+    cout << "Blocks: " << numBlocks << ", sampling interval: "
+         << handler->GetSamplingInterval() << " s, report interval: "
+         << handler->GetReportInterval() << " s, reports: "
+         << helper->NumberOfReports << ", time: " << time
+         << " s, overhead: " << (time - baseTime) / baseTime * 100.0 << "%"
+         << endl;
+    if (limited &&
+        helper->NumberOfReports > static_cast<int>(time / reportInterval) + 1)
+      {
+      cerr << "The progress was reported more than once every "
+           << reportInterval << " s." << endl;
+      retVal = EXIT_FAILURE;
+      }
+    }
+
+  connection->Delete();
+  pm->SetGUIHelper(0);
+  helper->Delete();
+  vtkProcessModule::SetProcessModule(0);
+  pm->Delete();
+  return retVal;
+}
@@ -42,6 +42,7 @@
 #include "vtkPVOpenGLExtensionsInformation.h"
 #include "vtkPVOptions.h"
 #include "vtkPVOptionsXMLParser.h"
+#include "vtkPVParallelArrayHelper.h"
 #include "vtkPVPluginLoader.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVSelectionInformation.h"
@@ -92,6 +93,7 @@ int main(int, char * [])
   c = vtkPVProgressHandler::New(); c->Print(cout); c->Delete();
   c = vtkPVOptions::New(); c->Print(cout); c->Delete();
   c = vtkPVOptionsXMLParser::New(); c->Print(cout); c->Delete();
+  c = vtkPVParallelArrayHelper::New(); c->Print(cout); c->Delete();
   c = vtkPVOpenGLExtensionsInformation::New(); c->Print(cout); c->Delete();
   c = vtkPVSelectionInformation::New(); c->Print(cout); c->Delete();
   c = vtkPVCompositeDataInformation::New(); c->Print(cout); c->Delete();
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test splits an image along x among the processes, each piece with a
+// layer of ghost cells, and checks vtkPVParallelArrayHelper on the pieces.
+// The gradients of a scalar and of a vector array must match the ones of
+// vtkCellDerivatives followed by vtkCellDataToPointData on the whole image,
+// also when they are computed again for the same pieces. The minimum,
+// maximum and sum reductions of arrays and of values must match the ones
+// computed from all the pieces on every process.
+
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkCellDerivatives.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPVParallelArrayHelper.h"
+#include "vtkSmartPointer.h"
+#include "vtkToolkits.h"
+#include "vtkUnsignedCharArray.h"
+
+#ifdef VTK_USE_MPI
+# include "vtkMPIController.h"
+#else
+# include "vtkDummyController.h"
+#endif
+
+#include <math.h>
+
+#define DIMENSION 16
+
+// The first and last x index of the points of a piece, without ghosts.
+static void GetPieceRange(int piece, int numPieces, int range[2])
+{
+  range[0] = (DIMENSION - 1) * piece / numPieces;
+  range[1] = (DIMENSION - 1) * (piece + 1) / numPieces;
+}
+
+// Builds the image between the x indices with a scalar array "s" and a
+// vector array "v". The cells outside of [owned[0], owned[1]] are marked
+// as ghost cells when owned is given.
+static vtkImageData* NewImage(int x0, int x1, const int* owned)
+{
+  vtkImageData* image = vtkImageData::New();
+  image->SetExtent(x0, x1, 0, DIMENSION - 1, 0, DIMENSION - 1);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  vtkIdType numPts = image->GetNumberOfPoints();
+  vtkDoubleArray* s = vtkDoubleArray::New();
+  s->SetName("s");
+  s->SetNumberOfTuples(numPts);
+  vtkDoubleArray* v = vtkDoubleArray::New();
+  v->SetName("v");
+  v->SetNumberOfComponents(3);
+  v->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    double p[3];
+    image->GetPoint(i, p);
+    s->SetValue(i, p[0] * p[0] * p[1] + sin(p[2]));
+    v->SetTuple3(i, p[0] * p[1], p[2] * p[2] * p[0], p[1]);
+    }
+  image->GetPointData()->AddArray(s);
+  image->GetPointData()->AddArray(v);
+  s->Delete();
+  v->Delete();
+
+  if (owned)
+    {
+    vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::New();
+    ghosts->SetName("vtkGhostLevels");
+    ghosts->SetNumberOfTuples(image->GetNumberOfCells());
+    int cellDims[3] = { x1 - x0, DIMENSION - 1, DIMENSION - 1 };
+    for (vtkIdType c = 0; c < image->GetNumberOfCells(); c++)
+      {
+      int x = x0 + static_cast<int>(c % cellDims[0]);
+      ghosts->SetValue(c, (x < owned[0] || x >= owned[1]) ? 1 : 0);
+      }
+    image->GetCellData()->AddArray(ghosts);
+    ghosts->Delete();
+    }
+  return image;
+}
+
+// Builds a piece with one layer of ghost cells.
+static vtkImageData* NewPiece(int piece, int numPieces)
+{
+  int owned[2];
+  GetPieceRange(piece, numPieces, owned);
+  int x0 = (owned[0] > 0) ? owned[0] - 1 : owned[0];
+  int x1 = (owned[1] < DIMENSION - 1) ? owned[1] + 1 : owned[1];
+  return NewImage(x0, x1, owned);
+}
+
+// Compares the gradient of the array computed on the piece with the one of
+// the filters on the whole image, at the points of the piece that are not
+// only used by ghost cells.
+static int CheckGradient(vtkPVParallelArrayHelper* helper,
+                         vtkImageData* piece, vtkImageData* whole,
+                         const int owned[2], const char* name, int myId)
+{
+  vtkSmartPointer<vtkCellDerivatives> derivatives =
+    vtkSmartPointer<vtkCellDerivatives>::New();
+  derivatives->SetInput(whole);
+  int isVector = (whole->GetPointData()->GetArray(name)->
+                  GetNumberOfComponents() == 3);
+  if (isVector)
+    {
+    whole->GetPointData()->SetActiveVectors(name);
+    }
+  else
+    {
+    whole->GetPointData()->SetActiveScalars(name);
+    }
+  vtkSmartPointer<vtkCellDataToPointData> toPoints =
+    vtkSmartPointer<vtkCellDataToPointData>::New();
+  toPoints->SetInputConnection(derivatives->GetOutputPort());
+  toPoints->Update();
+  vtkDataArray* expected = toPoints->GetOutput()->GetPointData()->GetArray(
+    isVector ? "VectorGradient" : "ScalarGradient");
+
+  if (!helper->ComputeGradient(piece, piece->GetPointData()->GetArray(name)))
+    {
+    cerr << "ERROR: process " << myId << " could not compute the gradient of "
+         << name << "." << endl;
+    return 0;
+    }
+  vtkDoubleArray* gradient = helper->GetGradient();
+  if (!expected || gradient->GetNumberOfComponents() !=
+      expected->GetNumberOfComponents())
+    {
+    cerr << "ERROR: the gradient of " << name << " has "
+         << gradient->GetNumberOfComponents() << " components." << endl;
+    return 0;
+    }
+
+  double maxError = 0.0;
+  int* extent = piece->GetExtent();
+  int dimX = extent[1] - extent[0] + 1;
+  for (vtkIdType i = 0; i < piece->GetNumberOfPoints(); i++)
+    {
+    int x = extent[0] + static_cast<int>(i % dimX);
+    if (x < owned[0] || x > owned[1])
+      {
+      continue;
+      }
+    double p[3];
+    piece->GetPoint(i, p);
+    vtkIdType j = whole->FindPoint(p);
+    for (int c = 0; c < gradient->GetNumberOfComponents(); c++)
+      {
+      double error =
+        fabs(gradient->GetComponent(i, c) - expected->GetComponent(j, c));
+      maxError = (error > maxError) ? error : maxError;
+      }
+    }
+  if (maxError > 1e-9)
+    {
+    cerr << "ERROR: the gradient of " << name << " on process " << myId
+         << " differs from the filters by " << maxError << "." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Checks the reductions against the ones of all the pieces, which every
+// process builds.
+static int CheckReductions(vtkPVParallelArrayHelper* helper,
+                           vtkImageData* piece, int myId, int numProcs)
+{
+  double expectedMin = VTK_DOUBLE_MAX;
+  double expectedMax[3] = { -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  double expectedSum = 0.0;
+  for (int p = 0; p < numProcs; p++)
+    {
+    vtkImageData* other = NewPiece(p, numProcs);
+    vtkDataArray* s = other->GetPointData()->GetArray("s");
+    vtkDataArray* v = other->GetPointData()->GetArray("v");
+    for (vtkIdType i = 0; i < other->GetNumberOfPoints(); i++)
+      {
+      double value = s->GetTuple1(i);
+      expectedMin = (value < expectedMin) ? value : expectedMin;
+      expectedSum += value;
+      for (int c = 0; c < 3; c++)
+        {
+        value = v->GetComponent(i, c);
+        expectedMax[c] = (value > expectedMax[c]) ? value : expectedMax[c];
+        }
+      }
+    other->Delete();
+    }
+
+  helper->ClearReductions();
+  int minIndex = helper->AddMin(piece->GetPointData()->GetArray("s"));
+  int maxIndex = helper->AddMax(piece->GetPointData()->GetArray("v"));
+  int sumIndex = helper->AddSum(piece->GetPointData()->GetArray("s"));
+  int countIndex = helper->AddSum(1.0);
+  int idIndex = helper->AddMax(static_cast<double>(myId));
+  if (!helper->Reduce())
+    {
+    cerr << "ERROR: process " << myId << " could not reduce." << endl;
+    return 0;
+    }
+
+  int retVal = 1;
+  if (helper->GetResult(minIndex) != expectedMin)
+    {
+    cerr << "ERROR: the minimum is " << helper->GetResult(minIndex)
+         << " instead of " << expectedMin << "." << endl;
+    retVal = 0;
+    }
+  if (helper->GetNumberOfResultComponents(maxIndex) != 3)
+    {
+    cerr << "ERROR: the maximum of v has "
+         << helper->GetNumberOfResultComponents(maxIndex)
+         << " components." << endl;
+    retVal = 0;
+    }
+  for (int c = 0; retVal && c < 3; c++)
+    {
+    if (helper->GetResult(maxIndex, c) != expectedMax[c])
+      {
+      cerr << "ERROR: the maximum of component " << c << " is "
+           << helper->GetResult(maxIndex, c) << " instead of "
+           << expectedMax[c] << "." << endl;
+      retVal = 0;
+      }
+    }
+  if (fabs(helper->GetResult(sumIndex) - expectedSum) >
+      1e-9 * fabs(expectedSum))
+    {
+    cerr << "ERROR: the sum is " << helper->GetResult(sumIndex)
+         << " instead of " << expectedSum << "." << endl;
+    retVal = 0;
+    }
+  if (helper->GetResult(countIndex) != numProcs ||
+      helper->GetResult(idIndex) != numProcs - 1)
+    {
+    cerr << "ERROR: the reductions of values are "
+         << helper->GetResult(countIndex) << " and "
+         << helper->GetResult(idIndex) << "." << endl;
+    retVal = 0;
+    }
+  return retVal;
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef VTK_USE_MPI
+  vtkMPIController* controller = vtkMPIController::New();
+#else
+  vtkDummyController* controller = vtkDummyController::New();
+#endif
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  int owned[2];
+  GetPieceRange(myId, numProcs, owned);
+  vtkImageData* piece = NewPiece(myId, numProcs);
+  vtkImageData* whole = NewImage(0, DIMENSION - 1, 0);
+  vtkPVParallelArrayHelper* helper = vtkPVParallelArrayHelper::New();
+
+  // The second pass reuses the shared points found by the first one.
+  int retVal = 1;
+  for (int pass = 0; pass < 2; pass++)
+    {
+    retVal = CheckGradient(helper, piece, whole, owned, "s", myId) && retVal;
+    retVal = CheckGradient(helper, piece, whole, owned, "v", myId) && retVal;
+    }
+  retVal = CheckReductions(helper, piece, myId, numProcs) && retVal;
+
+  helper->Delete();
+  piece->Delete();
+  whole->Delete();
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MIN_OP);
+  controller->Finalize();
+  controller->Delete();
+  return globalRetVal? 0 : 1;
+}
@@ -0,0 +1,268 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test queues streams for the data and render servers in the batches
+// of vtkServerConnection, with the socket controllers replaced by ones that
+// record the RMIs instead of sending them. It decodes each batch sent the
+// way vtkClientConnectionBatchRMI does on the server, and checks that the
+// streams come back in order, byte for byte, with their root only flags. It
+// also checks that nothing is sent outside of a batch, before the outermost
+// batch ends, or when there is nothing left to send.
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkRemoteConnection.h"
+#include "vtkServerConnection.h"
+#include "vtkSocketController.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <string.h>
+
+// Records the RMIs triggered instead of sending them.
+class vtkRecordingSocketController : public vtkSocketController
+{
+public:
+  static vtkRecordingSocketController* New();
+  vtkTypeRevisionMacro(vtkRecordingSocketController, vtkSocketController);
+
+  vtkstd::vector<int> Tags;
+  vtkstd::vector<vtkstd::string> Data;
+
+protected:
+  vtkRecordingSocketController() {}
+
+  virtual void TriggerRMIInternal(int, void* arg, int argLength, int rmiTag,
+                                  bool)
+    {
+    this->Tags.push_back(rmiTag);
+    this->Data.push_back(
+      vtkstd::string(static_cast<const char*>(arg), argLength));
+    }
+};
+
+vtkStandardNewMacro(vtkRecordingSocketController);
+vtkCxxRevisionMacro(vtkRecordingSocketController, "$Revision$");
+
+// Exposes the batches of a server connection that uses recording
+// controllers for both servers.
+class vtkBatchServerConnection : public vtkServerConnection
+{
+public:
+  static vtkBatchServerConnection* New();
+  vtkTypeRevisionMacro(vtkBatchServerConnection, vtkServerConnection);
+
+  vtkRecordingSocketController* GetRecorder(int renderServer)
+    {
+    return vtkRecordingSocketController::SafeDownCast(renderServer?
+      this->RenderServerSocketController : this->Controller);
+    }
+
+  int AddToBatch(int renderServer, vtkClientServerStream& stream,
+                 int rootOnly)
+    {
+    return this->AddToStreamBatch(this->GetRecorder(renderServer), stream,
+      rootOnly);
+    }
+
+  void FlushBatches()
+    {
+    this->FlushStreamBatches();
+    }
+
+protected:
+  vtkBatchServerConnection()
+    {
+    this->Controller->Delete();
+    this->Controller = vtkRecordingSocketController::New();
+    this->RenderServerSocketController = vtkRecordingSocketController::New();
+    }
+};
+
+vtkStandardNewMacro(vtkBatchServerConnection);
+vtkCxxRevisionMacro(vtkBatchServerConnection, "$Revision$");
+
+// A stream queued for a server, and whether it is for the root node only.
+struct QueuedStream
+{
+  vtkClientServerStream Stream;
+  int RootOnly;
+};
+
+// Builds a stream that differs from the ones of the other indices.
+static void MakeStream(int index, vtkClientServerStream& stream)
+{
+  vtkClientServerID id(index + 1);
+  stream.Reset();
+  stream << vtkClientServerStream::Invoke << id << "SetValue" << index
+         << vtkClientServerStream::End;
+  if (index % 2)
+    {
+    stream << vtkClientServerStream::Delete << id
+           << vtkClientServerStream::End;
+    }
+}
+
+// Checks the RMIs recorded for a server: none when nothing is expected,
+// otherwise one batch holding the expected streams in order.
+static int CheckBatch(vtkBatchServerConnection* connection, int renderServer,
+                      const vtkstd::vector<QueuedStream>& expected,
+                      const char* step)
+{
+  const char* server = renderServer? "render server" : "data server";
+  vtkRecordingSocketController* recorder =
+    connection->GetRecorder(renderServer);
+  size_t numRMIs = expected.empty()? 0 : 1;
+  if (recorder->Tags.size() != numRMIs)
+    {
+    cerr << "ERROR: " << step << ": " << recorder->Tags.size()
+         << " RMIs were sent to the " << server << " instead of " << numRMIs
+         << "." << endl;
+    return 0;
+    }
+  if (numRMIs == 0)
+    {
+    return 1;
+    }
+  if (recorder->Tags[0] != vtkRemoteConnection::CLIENT_SERVER_BATCH_RMI_TAG)
+    {
+    cerr << "ERROR: " << step << ": the " << server << " got an RMI with tag "
+         << recorder->Tags[0] << " instead of a batch." << endl;
+    return 0;
+    }
+
+  // The batch is decoded as on the server.
+  vtkClientServerStream batch;
+  const vtkstd::string& data = recorder->Data[0];
+  batch.SetData(reinterpret_cast<const unsigned char*>(data.c_str()),
+    data.size());
+  if (batch.GetNumberOfMessages() != static_cast<int>(expected.size()))
+    {
+    cerr << "ERROR: " << step << ": the batch of the " << server << " holds "
+         << batch.GetNumberOfMessages() << " streams instead of "
+         << expected.size() << "." << endl;
+    return 0;
+    }
+  for (int i = 0; i < batch.GetNumberOfMessages(); i++)
+    {
+    vtkClientServerStream stream;
+    int rootOnly = -1;
+    if (!vtkRemoteConnection::GetStreamFromBatch(batch, i, stream, &rootOnly))
+      {
+      cerr << "ERROR: " << step << ": message " << i << " of the batch of the "
+           << server << " does not hold a stream." << endl;
+      return 0;
+      }
+    const unsigned char* streamData;
+    size_t streamLength;
+    stream.GetData(&streamData, &streamLength);
+    const unsigned char* expectedData;
+    size_t expectedLength;
+    expected[i].Stream.GetData(&expectedData, &expectedLength);
+    if (streamLength != expectedLength ||
+      memcmp(streamData, expectedData, streamLength) != 0)
+      {
+      cerr << "ERROR: " << step << ": stream " << i << " of the batch of the "
+           << server << " is not the one queued." << endl;
+      return 0;
+      }
+    if (rootOnly != expected[i].RootOnly)
+      {
+      cerr << "ERROR: " << step << ": stream " << i << " of the batch of the "
+           << server << " has the root only flag " << rootOnly
+           << " instead of " << expected[i].RootOnly << "." << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+// Checks the RMIs recorded for both servers and forgets them.
+static int CheckBatches(vtkBatchServerConnection* connection,
+                        const vtkstd::vector<QueuedStream>* expected,
+                        const char* step)
+{
+  int retVal = 1;
+  for (int renderServer = 0; renderServer < 2; renderServer++)
+    {
+    retVal = CheckBatch(connection, renderServer, expected[renderServer],
+      step) && retVal;
+    connection->GetRecorder(renderServer)->Tags.clear();
+    connection->GetRecorder(renderServer)->Data.clear();
+    }
+  return retVal;
+}
+
+int main(int, char*[])
+{
+  vtkBatchServerConnection* connection = vtkBatchServerConnection::New();
+  vtkstd::vector<QueuedStream> expected[2];
+  int retVal = 1;
+
+  // Outside of a batch, the streams are sent right away by the caller.
+  vtkClientServerStream stream;
+  MakeStream(0, stream);
+  if (connection->AddToBatch(0, stream, 0))
+    {
+    cerr << "ERROR: a stream was queued outside of a batch." << endl;
+    retVal = 0;
+    }
+  retVal = CheckBatches(connection, expected, "no batch") && retVal;
+
+  // The streams are queued per server, with their root only flags mixed,
+  // and sent when the outermost batch ends.
+  connection->BeginStreamBatch();
+  connection->BeginStreamBatch();
+  const int rootOnlyFlags[8] = { 1, 0, 0, 1, 1, 0, 1, 0 };
+  for (int i = 0; i < 8; i++)
+    {
+    QueuedStream queued;
+    MakeStream(i, queued.Stream);
+    queued.RootOnly = rootOnlyFlags[i];
+    int renderServer = (i % 3 == 2)? 1 : 0;
+    if (!connection->AddToBatch(renderServer, queued.Stream, queued.RootOnly))
+      {
+      cerr << "ERROR: stream " << i << " was not queued in a batch." << endl;
+      retVal = 0;
+      }
+    expected[renderServer].push_back(queued);
+    }
+  connection->EndStreamBatch();
+  vtkstd::vector<QueuedStream> none[2];
+  retVal = CheckBatches(connection, none, "inner batch") && retVal;
+  connection->EndStreamBatch();
+  retVal = CheckBatches(connection, expected, "outer batch") && retVal;
+
+  // The batches sent are emptied.
+  connection->FlushBatches();
+  retVal = CheckBatches(connection, none, "empty batches") && retVal;
+
+  connection->BeginStreamBatch();
+  expected[0].clear();
+  expected[1].clear();
+  QueuedStream queued;
+  MakeStream(8, queued.Stream);
+  queued.RootOnly = 1;
+  connection->AddToBatch(1, queued.Stream, queued.RootOnly);
+  expected[1].push_back(queued);
+  connection->FlushBatches();
+  retVal = CheckBatches(connection, expected, "flushed batch") && retVal;
+  connection->EndStreamBatch();
+  retVal = CheckBatches(connection, none, "batch ended after a flush") &&
+    retVal;
+
+  connection->Delete();
+  return retVal? 0 : 1;
+}
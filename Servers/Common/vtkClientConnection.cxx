@@ -96,6 +96,46 @@ void vtkClientConnectionRootRMI(void *vtkNotUsed(localArg), void *remoteArg,
     }
 }
 
+//-----------------------------------------------------------------------------
+// Called when requesting to process a batch of streams. Each message of the
+// batch holds a flag telling whether the stream is for the root node only,
+// and the stream.
+void vtkClientConnectionBatchRMI(void *vtkNotUsed(localArg), void *remoteArg,
+  int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  try
+    {
+    vtkClientServerStream batch;
+    batch.SetData(reinterpret_cast<unsigned char*>(remoteArg), remoteArgLength);
+
+    vtkClientServerStream stream;
+    for (int i = 0; i < batch.GetNumberOfMessages(); ++i)
+      {
+      int rootOnly = 0;
+      if (!vtkRemoteConnection::GetStreamFromBatch(batch, i, stream,
+          &rootOnly))
+        {
+        vtkGenericWarningMacro("Invalid stream in batch.");
+        continue;
+        }
+      vtkProcessModule::GetProcessModule()->SendStream(
+        vtkProcessModuleConnectionManager::GetSelfConnectionID(),
+        rootOnly? vtkProcessModule::DATA_SERVER_ROOT :
+        vtkProcessModule::DATA_SERVER, stream);
+      }
+    }
+  catch (vtkstd::bad_alloc)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_BAD_ALLOC);
+    }
+  catch (...)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_UNKNOWN);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Called on client is requesting Information from this server.
 void vtkClientConnectionGatherInformationRMI(void *localArg, 
@@ -337,6 +377,10 @@ void vtkClientConnection::SetupRMIs()
     (void *)(this),
     vtkRemoteConnection::CLIENT_SERVER_ROOT_RMI_TAG);
 
+  this->Controller->AddRMI(vtkClientConnectionBatchRMI, 
+    (void *)(this),
+    vtkRemoteConnection::CLIENT_SERVER_BATCH_RMI_TAG);
+
   this->Controller->AddRMI(vtkClientConnectionGatherInformationRMI,
     (void*)(this),
     vtkRemoteConnection::CLIENT_SERVER_GATHER_INFORMATION_RMI_TAG);
@@ -18,19 +18,32 @@
 #include "vtkObjectFactory.h"
 #include "vtkMPIMToNSocketConnectionPortInformation.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
 #include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 
 
 #include <vtkstd/string>
 #include <vtkstd/vector>
 
+// The buffers are sent in chunks of this size, so that messages stay within
+// the size the communicator can send at once.
+#define VTK_MPIMTON_CHUNK_SIZE 1048576
+
+// All the processes of the other server that connect to one process may
+// connect at once; the system caps the backlog to its own maximum.
+#define VTK_MPIMTON_LISTEN_BACKLOG 1024
+
+#define VTK_MPIMTON_HELLO_TAG 1238
+#define VTK_MPIMTON_NUMBER_OF_BUFFERS_TAG 23480
+#define VTK_MPIMTON_LENGTHS_TAG 23481
+#define VTK_MPIMTON_BUFFERS_TAG 23482
 
 vtkCxxRevisionMacro(vtkMPIMToNSocketConnection, "$Revision$");
 vtkStandardNewMacro(vtkMPIMToNSocketConnection);
 
 vtkCxxSetObjectMacro(vtkMPIMToNSocketConnection,Controller, vtkMultiProcessController);
-vtkCxxSetObjectMacro(vtkMPIMToNSocketConnection,SocketCommunicator, vtkSocketCommunicator);
 class vtkMPIMToNSocketConnectionInternals
 {
 public:
@@ -41,8 +54,84 @@ public:
   };
   vtkstd::vector<NodeInformation> ServerInformation;
   vtkstd::vector<vtkstd::string> MachineNames;
+
+  // The communicators of this process, in the order of the processes of
+  // the connecting server.
+  vtkstd::vector<vtkSmartPointer<vtkSocketCommunicator> > Communicators;
+
+  // The asynchronous send in progress, if any.
+  vtkSmartPointer<vtkMultiThreader> Threader;
+  int SendThread;
+  int NumberOfBuffers;
+  vtkIdType* Lengths;
+  char* Buffers;
+
+  vtkMPIMToNSocketConnectionInternals()
+    {
+    this->SendThread = -1;
+    this->NumberOfBuffers = 0;
+    this->Lengths = 0;
+    this->Buffers = 0;
+    }
+
+  void SendBuffers()
+    {
+    vtkSocketCommunicator* com = this->Communicators[0];
+    vtkIdType totalLength = 0;
+    for (int i = 0; i < this->NumberOfBuffers; ++i)
+      {
+      totalLength += this->Lengths[i];
+      }
+    if (com->Send(&this->NumberOfBuffers, 1, 1,
+                  VTK_MPIMTON_NUMBER_OF_BUFFERS_TAG) &&
+        com->Send(this->Lengths, this->NumberOfBuffers, 1,
+                  VTK_MPIMTON_LENGTHS_TAG))
+      {
+      for (vtkIdType offset = 0; offset < totalLength;
+           offset += VTK_MPIMTON_CHUNK_SIZE)
+        {
+        vtkIdType length = totalLength - offset;
+        if (length > VTK_MPIMTON_CHUNK_SIZE)
+          {
+          length = VTK_MPIMTON_CHUNK_SIZE;
+          }
+        if (!com->Send(this->Buffers + offset, length, 1,
+                       VTK_MPIMTON_BUFFERS_TAG))
+          {
+          break;
+          }
+        }
+      }
+    delete [] this->Lengths;
+    this->Lengths = 0;
+    delete [] this->Buffers;
+    this->Buffers = 0;
+    }
 };
 
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkMPIMToNSocketConnectionSendBuffers(
+  void* arg)
+{
+  static_cast<vtkMPIMToNSocketConnectionInternals*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData)->SendBuffers();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Returns the process of the waiting server that the given process of the
+// connecting server connects to. When the connecting server has more
+// processes, they are split in contiguous groups.
+static int vtkMPIMToNSocketConnectionGetTarget(int id, int numConnecting,
+                                               int numWaiting)
+{
+  if (numConnecting <= numWaiting)
+    {
+    return id;
+    }
+  return static_cast<int>(static_cast<double>(id) * numWaiting /
+                          numConnecting);
+}
 
 vtkMPIMToNSocketConnection::vtkMPIMToNSocketConnection()
 {
@@ -53,23 +142,23 @@ vtkMPIMToNSocketConnection::vtkMPIMToNSocketConnection()
   this->Internals = new vtkMPIMToNSocketConnectionInternals;
   this->Controller = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());  
-  this->SocketCommunicator = 0;
+  this->AllProcessesConnected = 0;
   this->NumberOfConnections = -1;
   this->ServerSocket = 0;
 }
 
 vtkMPIMToNSocketConnection::~vtkMPIMToNSocketConnection()
 {
+  this->WaitForSends();
   if (this->ServerSocket)
     {
     this->ServerSocket->Delete();
     this->ServerSocket = 0;
     }
-  if(this->SocketCommunicator)
+  for (unsigned int i = 0; i < this->Internals->Communicators.size(); ++i)
     {
-    this->SocketCommunicator->CloseConnection();
-    this->SocketCommunicator->Delete();
-    } 
+    this->Internals->Communicators[i]->CloseConnection();
+    }
   this->SetController(0);
   delete [] this->HostName;
   this->HostName = 0;
@@ -85,7 +174,10 @@ void vtkMPIMToNSocketConnection::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfConnections: (" << this->NumberOfConnections << ")\n";
   os << indent << "Controller: (" << this->Controller << ")\n";
   os << indent << "Socket: (" << this->Socket << ")\n";
-  os << indent << "SocketCommunicator: (" << this->SocketCommunicator << ")\n";
+  os << indent << "NumberOfSocketCommunicators: "
+     << this->Internals->Communicators.size() << "\n";
+  os << indent << "AllProcessesConnected: " << this->AllProcessesConnected
+     << "\n";
   vtkIndent i2 = indent.GetNextIndent();
   for(unsigned int i = 0; i < this->Internals->ServerInformation.size(); ++i)
     {
@@ -153,7 +245,7 @@ void vtkMPIMToNSocketConnection::SetMachineName(unsigned int idx,
 
 void  vtkMPIMToNSocketConnection::SetupWaitForConnection()
 {
-  if(this->SocketCommunicator)
+  if(this->ServerSocket || !this->Internals->Communicators.empty())
     {
     vtkErrorMacro("SetupWaitForConnection called more than once");
     return;
@@ -163,11 +255,11 @@ void  vtkMPIMToNSocketConnection::SetupWaitForConnection()
     {
     return;
     }
-  this->SocketCommunicator = vtkSocketCommunicator::New();
   // open a socket on a random port
   vtkDebugMacro( << "open with port " << this->PortNumber );
   this->ServerSocket = vtkServerSocket::New();
-  this->ServerSocket->CreateServer(this->PortNumber);
+  this->ServerSocket->CreateServer(this->PortNumber,
+                                   VTK_MPIMTON_LISTEN_BACKLOG);
   
   // find out the random port picked
   int port = this->ServerSocket->GetServerPort();
@@ -201,60 +293,211 @@ void  vtkMPIMToNSocketConnection::SetupWaitForConnection()
 
 void vtkMPIMToNSocketConnection::WaitForConnection()
 { 
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  this->AllProcessesConnected = (this->NumberOfConnections >= numProcs);
   unsigned int myId = this->Controller->GetLocalProcessId();
   if(myId >= static_cast<unsigned int>(this->NumberOfConnections))
     {
     return;
     }
-  if(!this->SocketCommunicator || !this->ServerSocket)
+  if(!this->ServerSocket)
     {
     vtkErrorMacro("SetupWaitForConnection must be called before WaitForConnection");
     return;
     }
   cout << "WaitForConnection: id :" 
        << myId << "  Port:" << this->PortNumber << "\n";
-  vtkClientSocket* socket = this->ServerSocket->WaitForConnection();
-  this->ServerSocket->Delete();
-  this->ServerSocket = 0;
-  if (!socket)
-    {
-    vtkErrorMacro("Failed to get connection!");
-    return;
-    }
-  this->SocketCommunicator->SetSocket(socket);
-  this->SocketCommunicator->ServerSideHandshake();
 
-  socket->Delete();
+  // The first process connecting tells how many processes the other
+  // server has, from which we know how many of them connect to us.
+  vtkstd::vector<int> ids;
+  int numExpected = 1;
+  for (int i = 0; i < numExpected; ++i)
+    {
+    vtkClientSocket* socket = this->ServerSocket->WaitForConnection();
+    if (!socket)
+      {
+      vtkErrorMacro("Failed to get connection!");
+      break;
+      }
+    vtkSmartPointer<vtkSocketCommunicator> com =
+      vtkSmartPointer<vtkSocketCommunicator>::New();
+    com->SetSocket(socket);
+    com->ServerSideHandshake();
+    socket->Delete();
+
+    int hello[2];
+    com->Receive(hello, 2, 1, VTK_MPIMTON_HELLO_TAG);
+    cout << "Received Hello from process " << hello[0] << "\n";
+    if (i == 0)
+      {
+      numExpected = 0;
+      for (int id = 0; id < hello[1]; ++id)
+        {
+        if (vtkMPIMToNSocketConnectionGetTarget(
+              id, hello[1], this->NumberOfConnections) ==
+            static_cast<int>(myId))
+          {
+          ++numExpected;
+          }
+        }
+      }
 
-  int data;
-  this->SocketCommunicator->Receive(&data, 1, 1, 1238);
-  cout << "Received Hello from process " << data << "\n";
+    // Keep the communicators in the order of the connecting processes.
+    unsigned int pos = static_cast<unsigned int>(ids.size());
+    while (pos > 0 && ids[pos - 1] > hello[0])
+      {
+      --pos;
+      }
+    ids.insert(ids.begin() + pos, hello[0]);
+    this->Internals->Communicators.insert(
+      this->Internals->Communicators.begin() + pos, com);
+    }
+  this->ServerSocket->Delete();
+  this->ServerSocket = 0;
   cout.flush();
 } 
 
 void vtkMPIMToNSocketConnection::Connect()
 { 
-   if(this->SocketCommunicator)
+  if(!this->Internals->Communicators.empty())
     {
     vtkErrorMacro("Connect called more than once");
     return;
     }
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int numServers = static_cast<int>(this->Internals->ServerInformation.size());
+  this->AllProcessesConnected = (numProcs >= numServers);
   unsigned int myId = this->Controller->GetLocalProcessId();
-  if(myId >= this->Internals->ServerInformation.size())
+  if(myId >= this->Internals->ServerInformation.size() &&
+     !this->AllProcessesConnected)
     {
     return;
     }
-  this->SocketCommunicator = vtkSocketCommunicator::New();
+  int target = vtkMPIMToNSocketConnectionGetTarget(myId, numProcs, numServers);
+  vtkSmartPointer<vtkSocketCommunicator> com =
+    vtkSmartPointer<vtkSocketCommunicator>::New();
   cout << "Connect: id :" << myId << "  host: " 
-       << this->Internals->ServerInformation[myId].HostName.c_str() 
+       << this->Internals->ServerInformation[target].HostName.c_str() 
        << "  Port:" 
-       << this->Internals->ServerInformation[myId].PortNumber 
+       << this->Internals->ServerInformation[target].PortNumber 
        << "\n";
   cout.flush();
-  this->SocketCommunicator->ConnectTo((char*)this->Internals->ServerInformation[myId].HostName.c_str(),
-                                      this->Internals->ServerInformation[myId].PortNumber );
-  int id = static_cast<int>(myId);
-  this->SocketCommunicator->Send(&id, 1, 1, 1238);
+  com->ConnectTo((char*)this->Internals->ServerInformation[target].HostName.c_str(),
+                 this->Internals->ServerInformation[target].PortNumber );
+  this->Internals->Communicators.push_back(com);
+  int hello[2];
+  hello[0] = static_cast<int>(myId);
+  hello[1] = numProcs;
+  com->Send(hello, 2, 1, VTK_MPIMTON_HELLO_TAG);
+}
+
+vtkSocketCommunicator* vtkMPIMToNSocketConnection::GetSocketCommunicator()
+{
+  this->WaitForSends();
+  return this->GetSocketCommunicator(0);
+}
+
+int vtkMPIMToNSocketConnection::GetNumberOfSocketCommunicators()
+{
+  return static_cast<int>(this->Internals->Communicators.size());
+}
+
+vtkSocketCommunicator* vtkMPIMToNSocketConnection::GetSocketCommunicator(
+  int idx)
+{
+  if (idx < 0 || idx >= this->GetNumberOfSocketCommunicators())
+    {
+    return 0;
+    }
+  return this->Internals->Communicators[idx];
+}
+
+void vtkMPIMToNSocketConnection::SendBuffersAsynchronously(
+  int numBuffers, vtkIdType* lengths, char* buffers)
+{
+  this->WaitForSends();
+  if (this->Internals->Communicators.empty())
+    {
+    vtkErrorMacro("No connection to send the buffers on.");
+    delete [] lengths;
+    delete [] buffers;
+    return;
+    }
+  if (!this->Internals->Threader)
+    {
+    this->Internals->Threader = vtkSmartPointer<vtkMultiThreader>::New();
+    }
+  this->Internals->NumberOfBuffers = numBuffers;
+  this->Internals->Lengths = lengths;
+  this->Internals->Buffers = buffers;
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  this->Internals->SendThread = this->Internals->Threader->SpawnThread(
+    vtkMPIMToNSocketConnectionSendBuffers, this->Internals);
+#endif
+  if (this->Internals->SendThread < 0)
+    {
+    // No thread could be spawned; send on this thread instead.
+    this->Internals->SendBuffers();
+    }
+}
+
+int vtkMPIMToNSocketConnection::ReceiveBuffers(int idx, int& numBuffers,
+                                               vtkIdType*& lengths,
+                                               char*& buffers)
+{
+  numBuffers = 0;
+  lengths = 0;
+  buffers = 0;
+  vtkSocketCommunicator* com = this->GetSocketCommunicator(idx);
+  if (!com)
+    {
+    return 0;
+    }
+  this->WaitForSends();
+
+  if (!com->Receive(&numBuffers, 1, 1, VTK_MPIMTON_NUMBER_OF_BUFFERS_TAG))
+    {
+    numBuffers = 0;
+    return 0;
+    }
+  lengths = new vtkIdType[numBuffers];
+  int success = com->Receive(lengths, numBuffers, 1, VTK_MPIMTON_LENGTHS_TAG);
+  vtkIdType totalLength = 0;
+  for (int i = 0; success && i < numBuffers; ++i)
+    {
+    totalLength += lengths[i];
+    }
+  buffers = new char[totalLength];
+  for (vtkIdType offset = 0; success && offset < totalLength;
+       offset += VTK_MPIMTON_CHUNK_SIZE)
+    {
+    vtkIdType length = totalLength - offset;
+    if (length > VTK_MPIMTON_CHUNK_SIZE)
+      {
+      length = VTK_MPIMTON_CHUNK_SIZE;
+      }
+    success = com->Receive(buffers + offset, length, 1,
+                           VTK_MPIMTON_BUFFERS_TAG);
+    }
+  if (!success)
+    {
+    numBuffers = 0;
+    delete [] lengths;
+    lengths = 0;
+    delete [] buffers;
+    buffers = 0;
+    }
+  return success;
+}
+
+void vtkMPIMToNSocketConnection::WaitForSends()
+{
+  if (this->Internals->SendThread >= 0)
+    {
+    this->Internals->Threader->TerminateThread(this->Internals->SendThread);
+    this->Internals->SendThread = -1;
+    }
 }
 
 
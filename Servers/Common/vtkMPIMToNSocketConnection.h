@@ -23,7 +23,12 @@
 // mismatch in the size of large parallel computing resources and the often
 // smaller parallel hardward-accelerated rendering resources. The larger
 // number of processors on the compute servers are called M, and the smaller
-// number of rendering processors are call N.  This class is used to create N
+// number of rendering processors are call N.  When the data server connects
+// to the render server, each of the M processes connects to one of the N
+// processes, the processes of the data server being split in N contiguous
+// groups. Each process can then send its own data to the render server
+// without first redistributing it among the data server processes. When the
+// render server connects to the data server, this class creates N
 // vtkSocketCommunicator's that connect the first N of the M processes on the
 // data server to the N processes on the render server.
 
@@ -68,8 +73,46 @@ public:
   void SetPortInformation(unsigned int processNumber, int portNumber, const char* hostName);
   
   // Description:
-  // Return the socket communicator for this process.
-  vtkGetObjectMacro(SocketCommunicator, vtkSocketCommunicator);
+  // Return the socket communicator for this process. On the render server,
+  // this is the communicator connected to the first data server process
+  // connected to this process. Pending asynchronous sends are completed
+  // before the communicator is returned.
+  vtkSocketCommunicator* GetSocketCommunicator();
+
+  // Description:
+  // Return the number of socket communicators of this process. A render
+  // server process has one communicator for each data server process
+  // connected to it, in the order of the data server processes.
+  int GetNumberOfSocketCommunicators();
+  vtkSocketCommunicator* GetSocketCommunicator(int idx);
+
+  // Description:
+  // Return 1 when every process of this server has a socket communicator,
+  // so that each can send its own data to the other server.
+  vtkGetMacro(AllProcessesConnected, int);
+
+//BTX
+  // Description:
+  // Send the buffers to the process of the other server in chunks, on a
+  // separate thread, and return without waiting for them to be received.
+  // When no thread can be spawned, the buffers are sent before returning.
+  // The connection takes ownership of the arrays, which must be allocated
+  // with new []. A send waits for the previous one to complete. The
+  // buffers are received with ReceiveBuffers.
+  void SendBuffersAsynchronously(int numBuffers, vtkIdType* lengths,
+                                 char* buffers);
+
+  // Description:
+  // Receive the buffers sent with SendBuffersAsynchronously on the
+  // communicator idx. The caller owns the arrays returned, which are
+  // allocated with new []. Returns 0 on error, with no arrays.
+  int ReceiveBuffers(int idx, int& numBuffers, vtkIdType*& lengths,
+                     char*& buffers);
+//ETX
+
+  // Description:
+  // Wait for the pending asynchronous send to complete.
+  void WaitForSends();
   
   // Description:
   // Fill the port information values into the port information object.
@@ -91,7 +134,6 @@ public:
 protected:
   void LoadMachinesFile();
   virtual void SetController(vtkMultiProcessController*);
-  virtual void SetSocketCommunicator(vtkSocketCommunicator*);
   vtkMPIMToNSocketConnection();
   ~vtkMPIMToNSocketConnection();
 private:
@@ -104,7 +146,7 @@ private:
   int NumberOfConnections;
   vtkMPIMToNSocketConnectionInternals* Internals;
   vtkMultiProcessController *Controller;
-  vtkSocketCommunicator* SocketCommunicator;
+  int AllProcessesConnected;
   vtkMPIMToNSocketConnection(const vtkMPIMToNSocketConnection&); // Not implemented
   void operator=(const vtkMPIMToNSocketConnection&); // Not implemented
 };
@@ -79,6 +79,10 @@ vtkPVOptions::vtkPVOptions()
   this->LogFileName = 0;
 
   this->Timeout = 0;
+  this->CompressConnection = 0;
+  this->ProgressSamplingInterval = 100;
+  this->ProgressInterval = 300;
+  this->MeanProgress = 0;
 
   if (this->XMLParser)
     {
@@ -207,6 +211,28 @@ void vtkPVOptions::Initialize()
                     "after which the server may timeout. The client typically shows warning "
                     "messages before the server times out.",
                     vtkPVOptions::PVDATA_SERVER|vtkPVOptions::PVSERVER);
+
+  this->AddBooleanArgument("--compress-connection", 0, &this->CompressConnection,
+                           "Compress the messages between the client and the servers."
+                           " Use this option when the network is slow.",
+                           vtkPVOptions::PVCLIENT | vtkPVOptions::PVSERVER |
+                           vtkPVOptions::PVRENDER_SERVER | vtkPVOptions::PVDATA_SERVER);
+
+  this->AddArgument("--progress-sampling-interval", 0, &this->ProgressSamplingInterval,
+                    "Minimum time (in milliseconds) between two samples of the progress "
+                    "of the filters of a process.",
+                    vtkPVOptions::PARAVIEW | vtkPVOptions::PVBATCH |
+                    vtkPVOptions::PVSERVER | vtkPVOptions::PVDATA_SERVER);
+  this->AddArgument("--progress-interval", 0, &this->ProgressInterval,
+                    "Minimum time (in milliseconds) between two progress reports "
+                    "sent to the root node or to the client.",
+                    vtkPVOptions::PARAVIEW | vtkPVOptions::PVBATCH |
+                    vtkPVOptions::PVSERVER | vtkPVOptions::PVDATA_SERVER);
+  this->AddBooleanArgument("--mean-progress", 0, &this->MeanProgress,
+                           "Report the mean progress of the processes instead of "
+                           "the progress of the slowest one.",
+                           vtkPVOptions::PARAVIEW | vtkPVOptions::PVBATCH |
+                           vtkPVOptions::PVSERVER | vtkPVOptions::PVDATA_SERVER);
  
   // Disabling for now since we don't support Cave anymore.
   // this->AddArgument("--cave-configuration", "-cc", &this->CaveConfigurationFileName,
@@ -386,6 +412,10 @@ void vtkPVOptions::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Timeout: " << this->Timeout << endl;
+  os << indent << "Compress Connection: " << (this->CompressConnection?"on":"off") << endl;
+  os << indent << "Progress Sampling Interval: " << this->ProgressSamplingInterval << endl;
+  os << indent << "Progress Interval: " << this->ProgressInterval << endl;
+  os << indent << "Mean Progress: " << (this->MeanProgress?"on":"off") << endl;
   os << indent << "Software Rendering: " << (this->UseSoftwareRendering?"Enabled":"Disabled") << endl;
 
   os << indent << "Satellite Software Rendering: " << (this->UseSatelliteSoftwareRendering?"Enabled":"Disabled") << endl;
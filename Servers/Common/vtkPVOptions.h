@@ -84,6 +84,25 @@ public:
   // server may timeout. timeout <= 0 means no timeout.
   vtkGetMacro(Timeout, int);
 
+  // Description:
+  // Ask for the messages between the client and the servers to be
+  // compressed. Compression is used if either side of a connection asks
+  // for it.
+  vtkGetMacro(CompressConnection, int);
+
+  // Description:
+  // Minimum time (in milliseconds) between two samples of the progress of
+  // the filters of a process, and between two progress reports sent to the
+  // root node or to the client. Sampling less often reduces the cost of
+  // progress reporting for fine-grained filters run on many processes.
+  vtkGetMacro(ProgressSamplingInterval, int);
+  vtkGetMacro(ProgressInterval, int);
+
+  // Description:
+  // Report the mean progress of the processes rather than the progress of
+  // the slowest one.
+  vtkGetMacro(MeanProgress, int);
+
   // Description:
   // Clients need to set the ConnectID so they can handle server connections
   // after the client has started.
@@ -201,6 +220,10 @@ private:
   int TileMullions[2];
   int UseRenderingGroup;
   int Timeout;
+  int CompressConnection;
+  int ProgressSamplingInterval;
+  int ProgressInterval;
+  int MeanProgress;
 
   
   char* RenderModuleName;
@@ -0,0 +1,690 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVParallelArrayHelper.h"
+
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkWeakPointer.h"
+
+#include <vtkstd/map>
+#include <vtkstd/vector>
+
+// Tags of the messages exchanged with the neighbor processes.
+#define VTK_PV_PARALLEL_ARRAY_HELPER_COUNT_TAG 23710
+#define VTK_PV_PARALLEL_ARRAY_HELPER_POINTS_TAG 23711
+#define VTK_PV_PARALLEL_ARRAY_HELPER_VALUES_TAG 23712
+
+vtkStandardNewMacro(vtkPVParallelArrayHelper);
+vtkCxxRevisionMacro(vtkPVParallelArrayHelper, "$Revision$");
+vtkCxxSetObjectMacro(vtkPVParallelArrayHelper, Controller,
+                     vtkMultiProcessController);
+
+//----------------------------------------------------------------------------
+// Applies the operation of each value (one of vtkCommunicator::MIN_OP,
+// MAX_OP and SUM_OP) so that reductions of different kinds are done by one
+// collective operation.
+class vtkPVParallelArrayHelperOperation : public vtkCommunicator::Operation
+{
+public:
+  vtkPVParallelArrayHelperOperation(const vtkstd::vector<int>& operations)
+    : Operations(operations) {}
+
+  virtual void Function(const void* A, void* B, vtkIdType length, int)
+    {
+    const double* a = reinterpret_cast<const double*>(A);
+    double* b = reinterpret_cast<double*>(B);
+    for (vtkIdType i = 0; i < length; i++)
+      {
+      switch (this->Operations[i])
+        {
+        case vtkCommunicator::MIN_OP:
+          b[i] = a[i] < b[i]? a[i] : b[i];
+          break;
+        case vtkCommunicator::MAX_OP:
+          b[i] = a[i] > b[i]? a[i] : b[i];
+          break;
+        default:
+          b[i] += a[i];
+        }
+      }
+    }
+  virtual int Commutative() { return 1; }
+
+  const vtkstd::vector<int>& Operations;
+};
+
+//----------------------------------------------------------------------------
+// A point location used to match the points shared among processes. Shared
+// points have the same coordinates on all processes.
+struct vtkPVParallelArrayHelperPoint
+{
+  double X[3];
+  bool operator<(const vtkPVParallelArrayHelperPoint& other) const
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      if (this->X[i] != other.X[i])
+        {
+        return this->X[i] < other.X[i];
+        }
+      }
+    return false;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Sends numSend values to another process and receives numReceive values
+// from it. The process with the lower id sends first; as every process
+// visits its neighbors in increasing order, the exchanges never deadlock.
+template <class T>
+void vtkPVParallelArrayHelperExchange(vtkMultiProcessController* controller,
+                                      int other, T* sendBuffer,
+                                      vtkIdType numSend, T* receiveBuffer,
+                                      vtkIdType numReceive, int tag)
+{
+  int sendFirst = (controller->GetLocalProcessId() < other);
+  for (int pass = 0; pass < 2; pass++)
+    {
+    if (sendFirst == (pass == 0))
+      {
+      if (numSend > 0)
+        {
+        controller->Send(sendBuffer, numSend, other, tag);
+        }
+      }
+    else if (numReceive > 0)
+      {
+      controller->Receive(receiveBuffer, numReceive, other, tag);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+class vtkPVParallelArrayHelper::vtkInternals
+{
+public:
+  // The queued reductions: one value per component, the operation of each
+  // value, and the first value and number of values of each reduction.
+  vtkstd::vector<double> Values;
+  vtkstd::vector<int> Operations;
+  vtkstd::vector<int> Offsets;
+  vtkstd::vector<int> Sizes;
+  vtkstd::vector<double> Results;
+
+  // The dataset the shared points were found for.
+  vtkWeakPointer<vtkDataSet> DataSet;
+  unsigned long DataSetMTime;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+
+  // A process whose piece may share points with the local one: the local
+  // points sent to it and, for each point received from it, the matching
+  // local point or -1.
+  struct vtkNeighbor
+  {
+    int Process;
+    vtkstd::vector<vtkIdType> SendIds;
+    vtkstd::vector<vtkIdType> Matches;
+  };
+  // The neighbors, in increasing order of process id.
+  vtkstd::vector<vtkNeighbor> Neighbors;
+
+  // Number of non-ghost cells using each point on all processes.
+  vtkstd::vector<double> Counts;
+
+  vtkInternals() : DataSetMTime(0), NumberOfPoints(0), NumberOfCells(0) {}
+
+  // Returns the time the structure of the dataset was last modified.
+  // Changes of the attributes other than the ghost levels are ignored.
+  static unsigned long GetStructureMTime(vtkDataSet* input)
+    {
+    unsigned long mtime = input->vtkDataObject::GetMTime();
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
+    if (ps && ps->GetPoints() && ps->GetPoints()->GetMTime() > mtime)
+      {
+      mtime = ps->GetPoints()->GetMTime();
+      }
+    vtkDataArray* ghosts = input->GetCellData()->GetArray("vtkGhostLevels");
+    if (ghosts && ghosts->GetMTime() > mtime)
+      {
+      mtime = ghosts->GetMTime();
+      }
+    return mtime;
+    }
+
+  // Sends the values of the shared points to the neighbors and adds the
+  // values received to the matching local points.
+  void ExchangeSharedValues(vtkMultiProcessController* controller,
+                            double* values, int numComps)
+    {
+    // Gather the local values first, the received ones are added later.
+    size_t numNeighbors = this->Neighbors.size();
+    vtkstd::vector<vtkstd::vector<double> > sendBuffers(numNeighbors);
+    for (size_t n = 0; n < numNeighbors; n++)
+      {
+      const vtkstd::vector<vtkIdType>& sendIds = this->Neighbors[n].SendIds;
+      vtkstd::vector<double>& sendBuffer = sendBuffers[n];
+      sendBuffer.resize(sendIds.size()*numComps + 1);
+      for (size_t i = 0; i < sendIds.size(); i++)
+        {
+        for (int j = 0; j < numComps; j++)
+          {
+          sendBuffer[i*numComps + j] = values[sendIds[i]*numComps + j];
+          }
+        }
+      }
+
+    vtkstd::vector<double> receiveBuffer;
+    for (size_t n = 0; n < numNeighbors; n++)
+      {
+      vtkNeighbor& neighbor = this->Neighbors[n];
+      vtkIdType numReceived =
+        static_cast<vtkIdType>(neighbor.Matches.size());
+      receiveBuffer.resize(numReceived*numComps + 1);
+      vtkPVParallelArrayHelperExchange(
+        controller, neighbor.Process, &sendBuffers[n][0],
+        static_cast<vtkIdType>(neighbor.SendIds.size())*numComps,
+        &receiveBuffer[0], numReceived*numComps,
+        VTK_PV_PARALLEL_ARRAY_HELPER_VALUES_TAG);
+      for (vtkIdType i = 0; i < numReceived; i++)
+        {
+        vtkIdType ptId = neighbor.Matches[i];
+        if (ptId < 0)
+          {
+          continue;
+          }
+        for (int j = 0; j < numComps; j++)
+          {
+          values[ptId*numComps + j] += receiveBuffer[i*numComps + j];
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkPVParallelArrayHelperReduce(T* data, vtkIdType numTuples,
+                                    int numComps, int operation,
+                                    double* result)
+{
+  for (vtkIdType i = 0; i < numTuples; i++)
+    {
+    for (int j = 0; j < numComps; j++)
+      {
+      double value = static_cast<double>(data[i*numComps + j]);
+      switch (operation)
+        {
+        case vtkCommunicator::MIN_OP:
+          result[j] = value < result[j]? value : result[j];
+          break;
+        case vtkCommunicator::MAX_OP:
+          result[j] = value > result[j]? value : result[j];
+          break;
+        default:
+          result[j] += value;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPVParallelArrayHelper::vtkPVParallelArrayHelper()
+{
+  this->Internals = new vtkInternals;
+  this->Controller = 0;
+  this->Gradient = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkPVParallelArrayHelper::~vtkPVParallelArrayHelper()
+{
+  this->SetController(0);
+  if (this->Gradient)
+    {
+    this->Gradient->Delete();
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddMin(vtkDataArray* array)
+{
+  return this->AddReduction(array, vtkCommunicator::MIN_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddMax(vtkDataArray* array)
+{
+  return this->AddReduction(array, vtkCommunicator::MAX_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddSum(vtkDataArray* array)
+{
+  return this->AddReduction(array, vtkCommunicator::SUM_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddMin(double value)
+{
+  return this->AddReduction(value, vtkCommunicator::MIN_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddMax(double value)
+{
+  return this->AddReduction(value, vtkCommunicator::MAX_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddSum(double value)
+{
+  return this->AddReduction(value, vtkCommunicator::SUM_OP);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddReduction(vtkDataArray* array, int operation)
+{
+  if (!array)
+    {
+    vtkErrorMacro("No array to reduce.");
+    return -1;
+    }
+
+  int numComps = array->GetNumberOfComponents();
+  double identity = 0.0;
+  if (operation == vtkCommunicator::MIN_OP)
+    {
+    identity = VTK_DOUBLE_MAX;
+    }
+  else if (operation == vtkCommunicator::MAX_OP)
+    {
+    identity = -VTK_DOUBLE_MAX;
+    }
+
+  vtkInternals* internals = this->Internals;
+  int offset = static_cast<int>(internals->Values.size());
+  internals->Offsets.push_back(offset);
+  internals->Sizes.push_back(numComps);
+  internals->Values.resize(offset + numComps, identity);
+  internals->Operations.resize(offset + numComps, operation);
+
+  double* result = &internals->Values[offset];
+  vtkIdType numTuples = array->GetNumberOfTuples();
+  if (numTuples > 0)
+    {
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkPVParallelArrayHelperReduce(
+          static_cast<VTK_TT*>(array->GetVoidPointer(0)), numTuples,
+          numComps, operation, result));
+      default:
+        vtkErrorMacro("Unsupported array type: " << array->GetClassName());
+      }
+    }
+  return static_cast<int>(internals->Offsets.size()) - 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::AddReduction(double value, int operation)
+{
+  vtkInternals* internals = this->Internals;
+  internals->Offsets.push_back(static_cast<int>(internals->Values.size()));
+  internals->Sizes.push_back(1);
+  internals->Values.push_back(value);
+  internals->Operations.push_back(operation);
+  return static_cast<int>(internals->Offsets.size()) - 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::Reduce()
+{
+  vtkInternals* internals = this->Internals;
+  vtkIdType length = static_cast<vtkIdType>(internals->Values.size());
+  internals->Results = internals->Values;
+  if (length == 0 || !this->Controller ||
+      this->Controller->GetNumberOfProcesses() <= 1)
+    {
+    return 1;
+    }
+
+  vtkPVParallelArrayHelperOperation operation(internals->Operations);
+  return this->Controller->AllReduce(&internals->Values[0],
+                                     &internals->Results[0], length,
+                                     &operation);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::GetNumberOfResultComponents(int index)
+{
+  if (index < 0 || index >= static_cast<int>(this->Internals->Sizes.size()))
+    {
+    return 0;
+    }
+  return this->Internals->Sizes[index];
+}
+
+//----------------------------------------------------------------------------
+double vtkPVParallelArrayHelper::GetResult(int index, int component)
+{
+  vtkInternals* internals = this->Internals;
+  if (component < 0 || component >= this->GetNumberOfResultComponents(index) ||
+      internals->Results.size() != internals->Values.size())
+    {
+    vtkErrorMacro("No result " << index << ", " << component
+                  << ". Was Reduce() called?");
+    return 0.0;
+    }
+  return internals->Results[internals->Offsets[index] + component];
+}
+
+//----------------------------------------------------------------------------
+void vtkPVParallelArrayHelper::ClearReductions()
+{
+  vtkInternals* internals = this->Internals;
+  internals->Values.clear();
+  internals->Operations.clear();
+  internals->Offsets.clear();
+  internals->Sizes.clear();
+  internals->Results.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::UpdateSharedPoints(vtkDataSet* input)
+{
+  vtkInternals* internals = this->Internals;
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  unsigned long mtime = vtkInternals::GetStructureMTime(input);
+  int numProcs = this->Controller? this->Controller->GetNumberOfProcesses() : 1;
+
+  // All processes must agree on finding the shared points again since it
+  // communicates.
+  int needUpdate = (internals->DataSet.GetPointer() != input ||
+                    internals->DataSetMTime != mtime ||
+                    internals->NumberOfPoints != numPts ||
+                    internals->NumberOfCells != numCells)? 1 : 0;
+  if (numProcs > 1)
+    {
+    int localNeedUpdate = needUpdate;
+    this->Controller->AllReduce(&localNeedUpdate, &needUpdate, 1,
+                                vtkCommunicator::MAX_OP);
+    }
+  if (!needUpdate)
+    {
+    return 1;
+    }
+
+  internals->DataSet = input;
+  internals->DataSetMTime = mtime;
+  internals->NumberOfPoints = numPts;
+  internals->NumberOfCells = numCells;
+  internals->Neighbors.clear();
+  internals->Counts.assign(numPts, 0.0);
+
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    input->GetCellData()->GetArray("vtkGhostLevels"));
+  vtkIdList* ptIds = vtkIdList::New();
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    if (ghosts && ghosts->GetValue(cellId) > 0)
+      {
+      continue;
+      }
+    input->GetCellPoints(cellId, ptIds);
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+      {
+      internals->Counts[ptIds->GetId(i)] += 1.0;
+      }
+    }
+  ptIds->Delete();
+
+  if (numProcs <= 1)
+    {
+    return 1;
+    }
+
+  // Points on the boundary of the local piece lie in the bounds of the
+  // pieces they are shared with. Only the processes whose piece bounds
+  // overlap the local ones exchange points, and only the points in the
+  // bounds of the other piece are sent.
+  int myId = this->Controller->GetLocalProcessId();
+  double bounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+                       -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  if (numPts > 0)
+    {
+    input->GetBounds(bounds);
+    }
+  vtkstd::vector<double> allBounds(6*numProcs);
+  this->Controller->AllGather(bounds, &allBounds[0], 6);
+
+  double tolerance = 0.0;
+  for (int i = 0; i < 3; i++)
+    {
+    double length = 0.0;
+    for (int proc = 0; proc < numProcs; proc++)
+      {
+      double* b = &allBounds[6*proc];
+      if (b[2*i] <= b[2*i+1] && b[2*i+1] - b[2*i] > length)
+        {
+        length = b[2*i+1] - b[2*i];
+        }
+      }
+    tolerance += length;
+    }
+  tolerance *= 1e-6;
+
+  for (int proc = 0; proc < numProcs; proc++)
+    {
+    double* b = &allBounds[6*proc];
+    if (proc == myId || numPts == 0 || b[0] > b[1] ||
+        bounds[0] > b[1] + tolerance || b[0] > bounds[1] + tolerance ||
+        bounds[2] > b[3] + tolerance || b[2] > bounds[3] + tolerance ||
+        bounds[4] > b[5] + tolerance || b[4] > bounds[5] + tolerance)
+      {
+      continue;
+      }
+    internals->Neighbors.push_back(vtkInternals::vtkNeighbor());
+    internals->Neighbors.back().Process = proc;
+    }
+
+  typedef vtkstd::map<vtkPVParallelArrayHelperPoint, vtkIdType> PointMapType;
+  PointMapType localPoints;
+  vtkPVParallelArrayHelperPoint point;
+  vtkstd::vector<double> sendPoints;
+  vtkstd::vector<double> receivedPoints;
+  for (size_t n = 0; n < internals->Neighbors.size(); n++)
+    {
+    vtkInternals::vtkNeighbor& neighbor = internals->Neighbors[n];
+    double* b = &allBounds[6*neighbor.Process];
+    sendPoints.clear();
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+      {
+      input->GetPoint(ptId, point.X);
+      if (point.X[0] >= b[0] - tolerance && point.X[0] <= b[1] + tolerance &&
+          point.X[1] >= b[2] - tolerance && point.X[1] <= b[3] + tolerance &&
+          point.X[2] >= b[4] - tolerance && point.X[2] <= b[5] + tolerance)
+        {
+        neighbor.SendIds.push_back(ptId);
+        sendPoints.insert(sendPoints.end(), point.X, point.X + 3);
+        localPoints.insert(PointMapType::value_type(point, ptId));
+        }
+      }
+    sendPoints.push_back(0.0);
+
+    vtkIdType numSent = static_cast<vtkIdType>(neighbor.SendIds.size());
+    vtkIdType numReceived = 0;
+    vtkPVParallelArrayHelperExchange(
+      this->Controller, neighbor.Process, &numSent, 1, &numReceived, 1,
+      VTK_PV_PARALLEL_ARRAY_HELPER_COUNT_TAG);
+    receivedPoints.resize(3*numReceived + 1);
+    vtkPVParallelArrayHelperExchange(
+      this->Controller, neighbor.Process, &sendPoints[0], 3*numSent,
+      &receivedPoints[0], 3*numReceived,
+      VTK_PV_PARALLEL_ARRAY_HELPER_POINTS_TAG);
+
+    neighbor.Matches.assign(numReceived, -1);
+    for (vtkIdType i = 0; i < numReceived; i++)
+      {
+      point.X[0] = receivedPoints[3*i];
+      point.X[1] = receivedPoints[3*i+1];
+      point.X[2] = receivedPoints[3*i+2];
+      PointMapType::iterator iter = localPoints.find(point);
+      if (iter != localPoints.end())
+        {
+        neighbor.Matches[i] = iter->second;
+        }
+      }
+    }
+
+  // Add the cells of the other processes to the counts.
+  if (numPts > 0)
+    {
+    internals->ExchangeSharedValues(this->Controller,
+                                    &internals->Counts[0], 1);
+    }
+  else
+    {
+    double dummy = 0.0;
+    internals->ExchangeSharedValues(this->Controller, &dummy, 1);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVParallelArrayHelper::ComputeGradient(vtkDataSet* input,
+                                              vtkDataArray* array)
+{
+  int numProcs = this->Controller? this->Controller->GetNumberOfProcesses() : 1;
+  int error = 0;
+  if (!input || !array ||
+      array->GetNumberOfTuples() != input->GetNumberOfPoints())
+    {
+    vtkErrorMacro("The array must have one tuple per point of the input.");
+    error = 1;
+    }
+  else if (array->GetNumberOfComponents() != 1 &&
+           array->GetNumberOfComponents() != 3)
+    {
+    vtkErrorMacro("Gradients can only be computed for 1 or 3 components.");
+    error = 1;
+    }
+  // Stop on all processes if one of them fails.
+  if (numProcs > 1)
+    {
+    int localError = error;
+    this->Controller->AllReduce(&localError, &error, 1,
+                                vtkCommunicator::MAX_OP);
+    }
+  if (error || !this->UpdateSharedPoints(input))
+    {
+    return 0;
+    }
+
+  vtkInternals* internals = this->Internals;
+  int numComps = array->GetNumberOfComponents();
+  int numDerivs = 3*numComps;
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  // Sum the derivatives of the cells at their centers at their points.
+  vtkstd::vector<double> sums(numPts*numDerivs + 1, 0.0);
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    input->GetCellData()->GetArray("vtkGhostLevels"));
+  vtkGenericCell* cell = vtkGenericCell::New();
+  vtkstd::vector<double> values;
+  double pcoords[3];
+  double derivs[9];
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    if (ghosts && ghosts->GetValue(cellId) > 0)
+      {
+      continue;
+      }
+    input->GetCell(cellId, cell);
+    vtkIdType numCellPts = cell->GetNumberOfPoints();
+    if (numCellPts == 0)
+      {
+      continue;
+      }
+    values.resize(numCellPts*numComps);
+    for (vtkIdType i = 0; i < numCellPts; i++)
+      {
+      array->GetTuple(cell->GetPointId(i), &values[i*numComps]);
+      }
+    int subId = cell->GetParametricCenter(pcoords);
+    cell->Derivatives(subId, pcoords, &values[0], numComps, derivs);
+    for (vtkIdType i = 0; i < numCellPts; i++)
+      {
+      double* sum = &sums[cell->GetPointId(i)*numDerivs];
+      for (int j = 0; j < numDerivs; j++)
+        {
+        sum[j] += derivs[j];
+        }
+      }
+    }
+  cell->Delete();
+
+  if (numProcs > 1)
+    {
+    internals->ExchangeSharedValues(this->Controller, &sums[0], numDerivs);
+    }
+
+  // Average. Tensors are stored like the ones of vtkCellDerivatives: the
+  // derivative of component i along axis j is at i+3*j.
+  vtkDoubleArray* gradient = vtkDoubleArray::New();
+  gradient->SetNumberOfComponents(numDerivs);
+  gradient->SetNumberOfTuples(numPts);
+  double* out = gradient->GetPointer(0);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    double count = internals->Counts[ptId];
+    double* sum = &sums[ptId*numDerivs];
+    double* result = out + ptId*numDerivs;
+    for (int i = 0; i < numComps; i++)
+      {
+      for (int j = 0; j < 3; j++)
+        {
+        result[i + numComps*j] = count > 0.0? sum[3*i + j]/count : 0.0;
+        }
+      }
+    }
+  if (this->Gradient)
+    {
+    this->Gradient->Delete();
+    }
+  this->Gradient = gradient;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVParallelArrayHelper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "Gradient: " << this->Gradient << endl;
+}
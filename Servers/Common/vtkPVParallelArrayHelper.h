@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVParallelArrayHelper - global reductions and derivatives of
+// arrays distributed among the processes.
+// .SECTION Description
+// vtkPVParallelArrayHelper is used by the paraview.vtk.algorithms python
+// module to compute global quantities with the controller of ParaView (the
+// global controller by default) instead of a separate MPI communicator.
+//
+// Reductions are queued with AddMin(), AddMax() and AddSum() and are all
+// performed by one collective operation when Reduce() is called. All the
+// processes must queue the same reductions in the same order.
+//
+// ComputeGradient() computes the point gradient of a point array the way
+// vtkCellDerivatives followed by vtkCellDataToPointData does, in one pass
+// and without a pipeline. Ghost cells are skipped and the contributions of
+// the cells of other processes to the points on the boundary of the local
+// piece are added, so the result is the same as the one of the whole
+// dataset on one process. The points shared with other processes are found
+// the first time a dataset is used (all processes must call
+// ComputeGradient() together) and are reused while the dataset is not
+// modified, which makes computing many derived quantities of one dataset
+// cheap. Only the processes whose piece bounds overlap exchange points and
+// values, with point-to-point messages.
+
+#ifndef __vtkPVParallelArrayHelper_h
+#define __vtkPVParallelArrayHelper_h
+
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkDataSet;
+class vtkDoubleArray;
+class vtkMultiProcessController;
+
+class VTK_EXPORT vtkPVParallelArrayHelper : public vtkObject
+{
+public:
+  static vtkPVParallelArrayHelper* New();
+  vtkTypeRevisionMacro(vtkPVParallelArrayHelper, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The controller used to communicate. It is set to the global controller
+  // when the helper is created.
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+  // Description:
+  // Queue the reduction of each component of the array (or of a value)
+  // among all tuples of all processes. The array may be NULL or empty on
+  // some processes, but the number of components must be the same
+  // everywhere. Returns the index of the reduction, used to get its result
+  // after Reduce().
+  int AddMin(vtkDataArray* array);
+  int AddMax(vtkDataArray* array);
+  int AddSum(vtkDataArray* array);
+  int AddMin(double value);
+  int AddMax(double value);
+  int AddSum(double value);
+
+  // Description:
+  // Performs all the queued reductions with one collective operation.
+  // Returns 0 on failure.
+  int Reduce();
+
+  // Description:
+  // Returns a component of the result of a reduction after Reduce().
+  int GetNumberOfResultComponents(int index);
+  double GetResult(int index, int component);
+  double GetResult(int index) { return this->GetResult(index, 0); }
+
+  // Description:
+  // Removes the queued reductions and their results.
+  void ClearReductions();
+
+  // Description:
+  // Computes the gradient of the point array at the points of input. The
+  // gradient of a scalar array has 3 components. The gradient of a 3
+  // component array is a tensor of 9 components ordered as the tensors of
+  // vtkCellDerivatives. Returns 0 on failure.
+  int ComputeGradient(vtkDataSet* input, vtkDataArray* array);
+
+  // Description:
+  // The result of the last ComputeGradient(). A new array is created by
+  // every call.
+  vtkGetObjectMacro(Gradient, vtkDoubleArray);
+
+//BTX
+protected:
+  vtkPVParallelArrayHelper();
+  ~vtkPVParallelArrayHelper();
+
+  int AddReduction(vtkDataArray* array, int operation);
+  int AddReduction(double value, int operation);
+
+  // Description:
+  // Finds the points of input shared with other processes and the number
+  // of cells using each point, unless they are known already.
+  int UpdateSharedPoints(vtkDataSet* input);
+
+  vtkMultiProcessController* Controller;
+  vtkDoubleArray* Gradient;
+
+private:
+  vtkPVParallelArrayHelper(const vtkPVParallelArrayHelper&); // Not implemented
+  void operator=(const vtkPVParallelArrayHelper&); // Not implemented
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
@@ -42,9 +42,6 @@
 # define SNPRINTF snprintf
 #endif
 
-
-#define MIN_PROGRESS_INTERVAL_IN_SECS 0.3
-
 inline const char* vtkGetProgressText(vtkObjectBase* o)
 {
   vtkAlgorithm* alg = vtkAlgorithm::SafeDownCast(o);
@@ -57,7 +54,7 @@ inline const char* vtkGetProgressText(vtkObjectBase* o)
 }
 
 // When in parallel, we want to collect progress reported by all processess and
-// then report the lowest progress. That's managed by this class.
+// then report the lowest (or the mean) progress. That's managed by this class.
 class vtkProgressStore
 {
   class vtkRow
@@ -66,40 +63,75 @@ class vtkProgressStore
     int ObjectID;
     vtkstd::vector<double> Progress;
     vtkstd::vector<vtkstd::string> Text;
+    // Set when the end of the filter on the process has been reported.
+    vtkstd::vector<bool> Reported;
 
     // Returns true if there's some progress to report for this row.
-    // NOTE: This is a non-idempotent method.
-    bool Report(vtkstd::string& txt, double& progress)
+    bool Report(int reduction, vtkstd::string& txt, double& progress)
       {
-      progress = VTK_DOUBLE_MAX;
+      double minProgress = VTK_DOUBLE_MAX;
+      double sum = 0.0;
+      int count = 0;
       for (unsigned int cc=0; cc < this->Progress.size(); cc++)
         {
-        if (this->Progress[cc] >= 0.0 && this->Progress[cc] < progress)
+        if (this->Progress[cc] < 0.0)
+          {
+          continue;
+          }
+        // The filter has ended on the processes that have reported it.
+        sum += this->Reported[cc]? 1.0 : this->Progress[cc];
+        count++;
+        if (!this->Reported[cc] && this->Progress[cc] < minProgress)
           {
-          progress = this->Progress[cc];
+          minProgress = this->Progress[cc];
           txt = this->Text[cc];
-          if (this->Progress[cc] >= 1.0)
-            {
-            // Report 100% only once.
-            this->Progress[cc] = -1;
-            }
           }
         }
-      return (progress < VTK_DOUBLE_MAX);
+      if (minProgress == VTK_DOUBLE_MAX)
+        {
+        return false;
+        }
+      progress = (reduction == vtkPVProgressHandler::MEAN_PROGRESS)?
+        sum/count : minProgress;
+      return true;
       }
 
-    // Returns if this row has any valid progress.
+    // Called after the progress returned by Report() has been reported.
+    void MarkReported(double progress)
+      {
+      if (progress < 1.0)
+        {
+        return;
+        }
+      // Report 100% only once.
+      for (unsigned int cc=0; cc < this->Progress.size(); cc++)
+        {
+        if (this->Progress[cc] >= 1.0)
+          {
+          this->Reported[cc] = true;
+          }
+        }
+      }
+
+    // Returns if this row has no progress left to report.
     bool ReadyToClean()
       {
       for (unsigned int cc=0; cc < this->Progress.size(); cc++)
         {
-        if (this->Progress[cc] != -1)
+        if (this->Progress[cc] >= 0.0 && !this->Reported[cc])
           {
           return false;
           }
         }
       return true;
       }
+
+    void Set(int index, const vtkstd::string& txt, double progress)
+      {
+      this->Text[index] = txt;
+      this->Progress[index] = progress;
+      this->Reported[index] = false;
+      }
     };
   typedef vtkstd::deque<vtkRow> ListOfRows;
   ListOfRows Rows;
@@ -120,6 +152,7 @@ class vtkProgressStore
     this->Rows.push_back(row);
     this->Rows.back().Progress.resize(numProcs, -1);
     this->Rows.back().Text.resize(numProcs);
+    this->Rows.back().Reported.resize(numProcs, false);
     return this->Rows.back();
     }
 
@@ -133,41 +166,76 @@ class vtkProgressStore
     return 2;
     }
 
+  // A process executes its filters one after the other. When it reports the
+  // progress of a filter, the end of its previous filters, that may not have
+  // been sent because of the rate limits, is implied.
+  void Add(int index, int objectId, const vtkstd::string& txt,
+    double progress)
+    {
+    ListOfRows::iterator iter = this->Rows.begin();
+    while (iter != this->Rows.end())
+      {
+      if (iter->ObjectID != objectId && iter->Progress[index] >= 0.0)
+        {
+        iter->Reported[index] = true;
+        if (iter->ReadyToClean())
+          {
+          iter = this->Rows.erase(iter);
+          continue;
+          }
+        }
+      ++iter;
+      }
+    this->Find(objectId).Set(index, txt, progress);
+    }
+
 public:
   void AddLocalProgress(int objectId, const vtkstd::string& txt,
     double progress)
     {
-    vtkRow& row = this->Find(objectId);
-    row.Text[0] = txt;
-    row.Progress[0] = progress;
+    this->Add(0, objectId, txt, progress);
     }
 
   void AddRemoteProgress(int remoteId, int objectId,
     const vtkstd::string& txt, double progress)
     {
-    vtkRow& row = this->Find(objectId);
-    row.Text[remoteId] = txt;
-    row.Progress[remoteId] = progress;
+    this->Add(remoteId, objectId, txt, progress);
     }
 
-  // Returns the progress to report. This is a non-idempotent method (esp. when
-  // any of the filters is reporting 100%).
-  bool GetProgress(int &objectId, vtkstd::string& txt, double& progress)
+  // Returns the progress to report, combining the progress of the processes
+  // with the given reduction. The progress remains to be reported until
+  // MarkReported() is called.
+  bool GetProgress(int reduction, int &objectId, vtkstd::string& txt,
+    double& progress)
     {
     ListOfRows::iterator iter;
     for (iter = this->Rows.begin(); iter != this->Rows.end(); ++iter)
       {
-      if (iter->Report(txt, progress))
+      if (iter->Report(reduction, txt, progress))
         {
         objectId = iter->ObjectID;
+        return true;
+        }
+      }
+    return false;
+    }
+
+  // Called when the progress returned by GetProgress() has been reported.
+  void MarkReported(int objectId, double progress)
+    {
+    ListOfRows::iterator iter;
+    for (iter = this->Rows.begin(); iter != this->Rows.end(); ++iter)
+      {
+      if (iter->ObjectID == objectId)
+        {
+        iter->MarkReported(progress);
         if (iter->ReadyToClean())
           {
           this->Rows.erase(iter);
           }
-        return true;
+        return;
         }
       }
-    return false;
     }
 
   void Clear()
@@ -216,20 +284,17 @@ public:
   bool EnableProgress;
   bool ForceAsyncRequestReceived;
 
-  vtkTimerLog* ProgressTimer;
+  // Times of the last sample of the local progress and of the last report.
+  double LastSampleTime;
+  double LastReportTime;
+
   vtkInternals()
     {
     this->AsyncRequestValid = false;
     this->EnableProgress = false;
     this->ForceAsyncRequestReceived = false;
-    this->ProgressTimer = vtkTimerLog::New();
-    this->ProgressTimer->StartTimer();
-    }
-
-  ~vtkInternals()
-    {
-    this->ProgressTimer->Delete();
-    this->ProgressTimer = 0;
+    this->LastSampleTime = 0.0;
+    this->LastReportTime = 0.0;
     }
 
   int GetIDFromObject(vtkObject* obj)
@@ -252,6 +317,9 @@ vtkPVProgressHandler::vtkPVProgressHandler()
   this->Observer = vtkPVProgressHandler::vtkObserver::New();
   this->Observer->SetTarget(this);
   this->ProcessType = INVALID; 
+  this->SamplingInterval = 0.1;
+  this->ReportInterval = 0.3;
+  this->ProgressReduction = MIN_PROGRESS;
 }
 
 //----------------------------------------------------------------------------
@@ -308,6 +376,8 @@ void vtkPVProgressHandler::DetermineProcessType()
 void vtkPVProgressHandler::PrepareProgress()
 {
   this->Internals->EnableProgress = true;
+  this->Internals->LastSampleTime = 0.0;
+  this->Internals->LastReportTime = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -413,6 +483,17 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* obj,
     {
     return;
     }
+
+  // Sample the progress: the end of a filter is always recorded so that its
+  // row can be cleaned, the other events only every SamplingInterval.
+  double now = vtkTimerLog::GetUniversalTime();
+  if (progress < 1.0 &&
+    now - this->Internals->LastSampleTime < this->SamplingInterval)
+    {
+    return;
+    }
+  this->Internals->LastSampleTime = now;
+
   vtkstd::string text = ::vtkGetProgressText(obj);
   if (text.size() > 128)
     {
@@ -438,9 +519,11 @@ void vtkPVProgressHandler::RefreshProgress()
     this->GatherProgress();
 
     // Display progress locally.
-    if (this->Internals->ProgressStore.GetProgress(id, text, progress))
+    if (this->Internals->ProgressStore.GetProgress(this->ProgressReduction,
+        id, text, progress) && this->ReportProgress())
       {
       this->SetLocalProgress(static_cast<int>(progress*100.0), text.c_str());
+      this->Internals->ProgressStore.MarkReported(id, progress);
       }
     }
   else if (this->ProcessType == CLIENTSERVER_SERVER_ROOT)
@@ -463,9 +546,11 @@ void vtkPVProgressHandler::RefreshProgress()
     this->ReceiveProgressFromServer();
 
     // Display progress locally.
-    if (this->Internals->ProgressStore.GetProgress(id, text, progress))
+    if (this->Internals->ProgressStore.GetProgress(this->ProgressReduction,
+        id, text, progress) && this->ReportProgress())
       {
       this->SetLocalProgress(static_cast<int>(progress*100.0), text.c_str());
+      this->Internals->ProgressStore.MarkReported(id, progress);
       }
     }
 }
@@ -478,14 +563,14 @@ bool vtkPVProgressHandler::GetIsRoot()
 }
 
 //----------------------------------------------------------------------------
-bool vtkPVProgressHandler::ReportProgress(double progress)
+bool vtkPVProgressHandler::ReportProgress()
 {
-  this->Internals->ProgressTimer->StopTimer();
-  if (progress <= 0.0 ||
-    progress >= 1.0 ||
-    this->Internals->ProgressTimer->GetElapsedTime() > MIN_PROGRESS_INTERVAL_IN_SECS)
+  // The progress that is not reported remains in the ProgressStore until the
+  // next report, so the end of a filter is not lost.
+  double now = vtkTimerLog::GetUniversalTime();
+  if (now - this->Internals->LastReportTime >= this->ReportInterval)
     {
-    this->Internals->ProgressTimer->StartTimer();
+    this->Internals->LastReportTime = now;
     return true;
     }
   return false;
@@ -502,17 +587,16 @@ void vtkPVProgressHandler::SendProgressToClient()
   int id;
   vtkstd::string text;
   double progress;
-  if (this->Internals->ProgressStore.GetProgress(id, text, progress))
+  if (this->Internals->ProgressStore.GetProgress(this->ProgressReduction,
+      id, text, progress) && this->ReportProgress())
     {
-    if (this->ReportProgress(progress))
-      {
-      char buffer[1026];
-      buffer[0] = static_cast<int>(progress*100.0);
-      SNPRINTF(buffer+1, 1024, "%s", text.c_str());
-      int len = static_cast<int>(strlen(buffer+1)) + 2;
-      rc->GetSocketController()->Send(buffer, len, 1,
-        vtkProcessModule::PROGRESS_EVENT_TAG);
-      }
+    char buffer[1026];
+    buffer[0] = static_cast<int>(progress*100.0);
+    SNPRINTF(buffer+1, 1024, "%s", text.c_str());
+    int len = static_cast<int>(strlen(buffer+1)) + 2;
+    rc->GetSocketController()->Send(buffer, len, 1,
+      vtkProcessModule::PROGRESS_EVENT_TAG);
+    this->Internals->ProgressStore.MarkReported(id, progress);
     }
 }
 
@@ -534,12 +618,7 @@ void vtkPVProgressHandler::HandleServerProgress(int progress, const char* text)
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::SetLocalProgress(int progress, const char* text)
 {
-  this->Internals->ProgressTimer->StopTimer();
-  //if (this->Internals->ProgressTimer->GetElapsedTime() > MIN_PROGRESS_INTERVAL_IN_SECS)
-    {
-    this->Internals->ProgressTimer->StartTimer();
-    vtkProcessModule::GetProcessModule()->SetLocalProgress(text, progress);
-    }
+  vtkProcessModule::GetProcessModule()->SetLocalProgress(text, progress);
 }
 
 //----------------------------------------------------------------------------
@@ -647,40 +726,40 @@ void vtkPVProgressHandler::SendProgressToRoot()
     double progress;
     int id;
     vtkstd::string text;
-    if (this->Internals->ProgressStore.GetProgress(id, text, progress))
+    if (this->Internals->ProgressStore.GetProgress(this->ProgressReduction,
+        id, text, progress) && this->ReportProgress())
       {
-      if (this->ReportProgress(progress))
-        {
-        vtkByteSwap::SwapLE(&id);
-
-        int i_progress = static_cast<int>(progress*100.0);
-        vtkByteSwap::SwapLE(&i_progress);
-
-        int myId = vtkProcessModule::GetProcessModule()->GetPartitionId();
-        vtkByteSwap::SwapLE(&myId);
-
-        char buf[20];
-        sprintf(buf, "(%d)", myId);
-        text += buf;
-
-
-        memcpy(this->Internals->AsyncRequestData, &myId, sizeof(int));
-        memcpy(this->Internals->AsyncRequestData + sizeof(int), &id, sizeof(int));
-        memcpy(this->Internals->AsyncRequestData + sizeof(int)*2, &i_progress,
-          sizeof(int));
-        memcpy(this->Internals->AsyncRequestData + sizeof(int)*3, text.c_str(),
-          text.size()+1);
-
-        vtkIdType messageSize = sizeof(int)*3 + text.size() + 1;
-        vtkMPIController* controller = vtkMPIController::SafeDownCast(
-          vtkMultiProcessController::GetGlobalController());
-        controller->NoBlockSend(this->Internals->AsyncRequestData,
-          messageSize, 0,
-          vtkPVProgressHandler::PROGRESS_EVENT_TAG,
-          this->Internals->AsyncRequest);
-        //cout << "Sent To Root: " << text.c_str() << ": " << i_progress<< endl;
-        this->Internals->AsyncRequestValid = true;
-        }
+      int oid = id;
+      vtkByteSwap::SwapLE(&oid);
+
+      int i_progress = static_cast<int>(progress*100.0);
+      vtkByteSwap::SwapLE(&i_progress);
+
+      int myId = vtkProcessModule::GetProcessModule()->GetPartitionId();
+      vtkByteSwap::SwapLE(&myId);
+
+      char buf[20];
+      sprintf(buf, "(%d)", myId);
+      text += buf;
+
+
+      memcpy(this->Internals->AsyncRequestData, &myId, sizeof(int));
+      memcpy(this->Internals->AsyncRequestData + sizeof(int), &oid, sizeof(int));
+      memcpy(this->Internals->AsyncRequestData + sizeof(int)*2, &i_progress,
+        sizeof(int));
+      memcpy(this->Internals->AsyncRequestData + sizeof(int)*3, text.c_str(),
+        text.size()+1);
+
+      vtkIdType messageSize = sizeof(int)*3 + text.size() + 1;
+      vtkMPIController* controller = vtkMPIController::SafeDownCast(
+        vtkMultiProcessController::GetGlobalController());
+      controller->NoBlockSend(this->Internals->AsyncRequestData,
+        messageSize, 0,
+        vtkPVProgressHandler::PROGRESS_EVENT_TAG,
+        this->Internals->AsyncRequest);
+      //cout << "Sent To Root: " << text.c_str() << ": " << i_progress<< endl;
+      this->Internals->AsyncRequestValid = true;
+      this->Internals->ProgressStore.MarkReported(id, progress);
       }
     }
 #endif
@@ -690,6 +769,10 @@ void vtkPVProgressHandler::SendProgressToRoot()
 void vtkPVProgressHandler::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "SamplingInterval: " << this->SamplingInterval << endl;
+  os << indent << "ReportInterval: " << this->ReportInterval << endl;
+  os << indent << "ProgressReduction: "
+     << (this->ProgressReduction == MEAN_PROGRESS? "Mean" : "Min") << endl;
 }
 
 
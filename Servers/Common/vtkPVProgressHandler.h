@@ -17,6 +17,12 @@
 // vtkPVProgressHandler handles the progress messages. It handles progress in
 // all configurations single process, client-server, mpi-batch. One progress
 // handler is created per connection.
+//
+// The progress of the local filters is sampled at most once every
+// SamplingInterval seconds. Satellites send their samples to the root node
+// with non-blocking messages. The root node combines the progress of all the
+// processes (see ProgressReduction) and reports it to the client, or displays
+// it, at most once every ReportInterval seconds.
 // .SECTION See Also
 // vtkPVMPICommunicator
 
@@ -46,6 +52,35 @@ public:
     }
   vtkGetObjectMacro(Connection, vtkProcessModuleConnection);
 
+  // Description:
+  // Get/Set the minimum time in seconds between two samples of the progress
+  // of the local filters. The progress events received in between are
+  // ignored, except the ones marking the end of a filter. Default is 0.1.
+  vtkSetClampMacro(SamplingInterval, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(SamplingInterval, double);
+
+  // Description:
+  // Get/Set the minimum time in seconds between two progress reports sent to
+  // the root node or to the client, or displayed. Default is 0.3.
+  vtkSetClampMacro(ReportInterval, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ReportInterval, double);
+
+  enum ProgressReductions
+    {
+    MIN_PROGRESS = 0,
+    MEAN_PROGRESS
+    };
+
+  // Description:
+  // Get/Set how the progress of a filter on the different processes is
+  // combined: MIN_PROGRESS reports the progress of the slowest process,
+  // MEAN_PROGRESS the mean progress of the processes. Default is
+  // MIN_PROGRESS.
+  vtkSetClampMacro(ProgressReduction, int, MIN_PROGRESS, MEAN_PROGRESS);
+  vtkGetMacro(ProgressReduction, int);
+  void SetProgressReductionToMin() { this->SetProgressReduction(MIN_PROGRESS); }
+  void SetProgressReductionToMean() { this->SetProgressReduction(MEAN_PROGRESS); }
+
   // Description:
   // Listen to progress events from the object.
   void RegisterProgressEvent(vtkObject* object, int id);
@@ -108,8 +143,9 @@ protected:
   int GatherProgress();
 
   // Description:
-  // Returns if the progress should be reported.
-  bool ReportProgress(double progress);
+  // Returns if the progress should be reported, i.e. if ReportInterval
+  // seconds have elapsed since the last report.
+  bool ReportProgress();
 
 
   void SetLocalProgress(int progress, const char* text);
@@ -121,6 +157,9 @@ protected:
 
   vtkProcessModuleConnection* Connection;
   eProcessTypes ProcessType;
+  double SamplingInterval;
+  double ReportInterval;
+  int ProgressReduction;
 private:
   vtkPVProgressHandler(const vtkPVProgressHandler&); // Not implemented
   void operator=(const vtkPVProgressHandler&); // Not implemented
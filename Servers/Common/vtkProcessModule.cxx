@@ -748,6 +748,30 @@ int vtkProcessModule::IsRemote(vtkIdType id)
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModule::BeginStreamBatch(vtkIdType id)
+{
+  vtkServerConnection* conn = vtkServerConnection::SafeDownCast(
+    this->ConnectionManager->GetConnectionFromID(
+      vtkProcessModuleConnectionManager::GetRootConnection(id)));
+  if (conn)
+    {
+    conn->BeginStreamBatch();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkProcessModule::EndStreamBatch(vtkIdType id)
+{
+  vtkServerConnection* conn = vtkServerConnection::SafeDownCast(
+    this->ConnectionManager->GetConnectionFromID(
+      vtkProcessModuleConnectionManager::GetRootConnection(id)));
+  if (conn)
+    {
+    conn->EndStreamBatch();
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkIdType vtkProcessModule::MonitorConnections(unsigned long msec)
 {
@@ -517,6 +517,15 @@ public:
   // Returns 1 is the connection is a connection with a remote server (or client).
   int IsRemote(vtkIdType id);
 
+  // Description:
+  // Between BeginStreamBatch and EndStreamBatch, the streams sent to the
+  // servers of a remote server connection are accumulated and sent in a
+  // single message when the batch ends. They are sent earlier when a result
+  // is requested from the servers or when a stream also goes to the client,
+  // so that the order of the operations is kept. Batches can be nested.
+  void BeginStreamBatch(vtkIdType id);
+  void EndStreamBatch(vtkIdType id);
+
   // Description:
   // Checks if any new connections are available, if so, creates
   // vtkConnections for them. The call will wait for a timeout of msec
@@ -22,6 +22,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkProcessModule.h"
+#include "vtkPVOptions.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkSocket.h"
 
@@ -171,6 +172,16 @@ int vtkProcessModuleConnection::Initialize(
   int vtkNotUsed(argc), char** vtkNotUsed(argv), int *vtkNotUsed(partitionId))
 {
   this->ProgressHandler->SetConnection(this);
+  vtkPVOptions* options = vtkProcessModule::GetProcessModule()->GetOptions();
+  if (options)
+    {
+    this->ProgressHandler->SetSamplingInterval(
+      options->GetProgressSamplingInterval()/1000.0);
+    this->ProgressHandler->SetReportInterval(
+      options->GetProgressInterval()/1000.0);
+    this->ProgressHandler->SetProgressReduction(options->GetMeanProgress()?
+      vtkPVProgressHandler::MEAN_PROGRESS : vtkPVProgressHandler::MIN_PROGRESS);
+    }
   // returns 0 on success, 1 on error.
   return 0;
 }
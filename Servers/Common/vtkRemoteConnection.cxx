@@ -14,11 +14,13 @@
 =========================================================================*/
 #include "vtkRemoteConnection.h"
 
+#include "vtkClientServerStream.h"
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkProcessModuleConnectionManager.h"
+#include "vtkPVOptions.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 
@@ -51,6 +53,24 @@ vtkSocketController* vtkRemoteConnection::GetSocketController()
   return vtkSocketController::SafeDownCast(this->Controller);
 }
 
+//-----------------------------------------------------------------------------
+void vtkRemoteConnection::AddStreamToBatch(vtkClientServerStream& batch,
+  const vtkClientServerStream& stream, int rootOnly)
+{
+  // Each message of the batch holds one stream, processed on its own on
+  // the server so that an error in a stream does not stop the others.
+  batch << vtkClientServerStream::Invoke << rootOnly << stream
+    << vtkClientServerStream::End;
+}
+
+//-----------------------------------------------------------------------------
+int vtkRemoteConnection::GetStreamFromBatch(const vtkClientServerStream& batch,
+  int message, vtkClientServerStream& stream, int* rootOnly)
+{
+  return batch.GetArgument(message, 0, rootOnly) &&
+    batch.GetArgument(message, 1, &stream);
+}
+
 //-----------------------------------------------------------------------------
 int vtkRemoteConnection::SetSocket(vtkClientSocket* soc)
 {
@@ -62,6 +82,11 @@ int vtkRemoteConnection::SetSocket(vtkClientSocket* soc)
     return 0;
     }
   comm->SetSocket(soc);
+  vtkPVOptions* options = vtkProcessModule::GetProcessModule()->GetOptions();
+  if (options)
+    {
+    comm->SetCompression(options->GetCompressConnection());
+    }
   soc->AddObserver(vtkCommand::ErrorEvent, this->GetObserver());
   comm->AddObserver(vtkCommand::ErrorEvent, this->GetObserver());
   return comm->Handshake();
@@ -24,6 +24,7 @@
 
 #include "vtkProcessModuleConnection.h"
 
+class vtkClientServerStream;
 class vtkClientSocket;
 class vtkSocketController;
 
@@ -40,6 +41,7 @@ public:
     CLIENT_SERVER_LAST_RESULT_TAG = 838490,
     CLIENT_SERVER_GATHER_INFORMATION_RMI_TAG = 838491,
     CLIENT_SERVER_PUSH_UNDO_XML_TAG = 838494,
+    CLIENT_SERVER_BATCH_RMI_TAG = 838497,
 
     CLIENT_SERVER_COMMUNICATION_TAG = 8843,
     ROOT_INFORMATION_LENGTH_TAG = 838492,
@@ -69,6 +71,16 @@ public:
   vtkSocketController* GetSocketController();
 
 //BTX
+  // Description:
+  // Append a stream to a batch sent with CLIENT_SERVER_BATCH_RMI_TAG, with
+  // a flag telling whether it is for the root node only, and get them back
+  // from the given message of a received batch. GetStreamFromBatch returns
+  // 0 when the message does not hold a stream.
+  static void AddStreamToBatch(vtkClientServerStream& batch,
+    const vtkClientServerStream& stream, int rootOnly);
+  static int GetStreamFromBatch(const vtkClientServerStream& batch,
+    int message, vtkClientServerStream& stream, int* rootOnly);
+
   // Description:
   // These methods should be called before and after 
   // the subclass has sent some stream for processing on 
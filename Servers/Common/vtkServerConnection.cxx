@@ -44,7 +44,9 @@ vtkServerConnection::vtkServerConnection()
   this->MPIMToNSocketConnectionID.ID = 0;
   this->ServerInformation = vtkPVServerInformation::New();
   this->LastResultStream = new vtkClientServerStream;
-
+  this->StreamBatchDepth = 0;
+  this->DataServerBatch = new vtkClientServerStream;
+  this->RenderServerBatch = new vtkClientServerStream;
 }
 
 //-----------------------------------------------------------------------------
@@ -57,6 +59,8 @@ vtkServerConnection::~vtkServerConnection()
     }
   this->ServerInformation->Delete();
   delete this->LastResultStream;
+  delete this->DataServerBatch;
+  delete this->RenderServerBatch;
 }
 
 //-----------------------------------------------------------------------------
@@ -72,6 +76,8 @@ void vtkServerConnection::OnSocketError()
 //-----------------------------------------------------------------------------
 void vtkServerConnection::Finalize()
 {
+  this->StreamBatchDepth = 0;
+  this->FlushStreamBatches();
   if (this->MPIMToNSocketConnectionID.ID)
     {
     vtkClientServerStream stream;
@@ -195,6 +201,10 @@ int vtkServerConnection::SendStreamToClient(vtkClientServerStream& stream)
 int vtkServerConnection::SendStreamToServer(vtkSocketController* controller,
   vtkClientServerStream& stream)
 {
+  if (this->AddToStreamBatch(controller, stream, 0))
+    {
+    return 0;
+    }
   const unsigned char* data;
   size_t len;
   stream.GetData(&data, &len);
@@ -207,6 +217,10 @@ int vtkServerConnection::SendStreamToServer(vtkSocketController* controller,
 int vtkServerConnection::SendStreamToRoot(vtkSocketController* controller,
   vtkClientServerStream& stream)
 {
+  if (this->AddToStreamBatch(controller, stream, 1))
+    {
+    return 0;
+    }
   const unsigned char* data;
   size_t len;
   stream.GetData(&data, &len);
@@ -215,6 +229,83 @@ int vtkServerConnection::SendStreamToRoot(vtkSocketController* controller,
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+int vtkServerConnection::SendStream(vtkTypeUInt32 servers,
+  vtkClientServerStream& stream)
+{
+  vtkTypeUInt32 sendflag = this->CreateSendFlag(servers);
+  if (this->StreamBatchDepth > 0 && (sendflag & vtkProcessModule::CLIENT) &&
+    (sendflag & ~vtkProcessModule::CLIENT))
+    {
+    // The client side of the stream may wait for the servers, for example
+    // to receive data from them, so the servers must get their streams
+    // first.
+    this->Superclass::SendStream(sendflag & ~vtkProcessModule::CLIENT, stream);
+    this->FlushStreamBatches();
+    return this->Superclass::SendStream(vtkProcessModule::CLIENT, stream);
+    }
+  return this->Superclass::SendStream(servers, stream);
+}
+
+//-----------------------------------------------------------------------------
+void vtkServerConnection::BeginStreamBatch()
+{
+  this->StreamBatchDepth++;
+}
+
+//-----------------------------------------------------------------------------
+void vtkServerConnection::EndStreamBatch()
+{
+  if (this->StreamBatchDepth > 0 && --this->StreamBatchDepth == 0)
+    {
+    this->FlushStreamBatches();
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkServerConnection::AddToStreamBatch(vtkSocketController* controller,
+  vtkClientServerStream& stream, int rootOnly)
+{
+  if (this->StreamBatchDepth == 0)
+    {
+    return 0;
+    }
+  vtkClientServerStream* batch = (controller == this->GetSocketController())?
+    this->DataServerBatch : this->RenderServerBatch;
+  vtkRemoteConnection::AddStreamToBatch(*batch, stream, rootOnly);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkServerConnection::FlushStreamBatches()
+{
+  this->FlushStreamBatch(this->GetSocketController(), this->DataServerBatch);
+  if (this->RenderServerSocketController)
+    {
+    this->FlushStreamBatch(this->RenderServerSocketController,
+      this->RenderServerBatch);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkServerConnection::FlushStreamBatch(vtkSocketController* controller,
+  vtkClientServerStream* batch)
+{
+  if (batch->GetNumberOfMessages() < 1)
+    {
+    return;
+    }
+  if (!this->AbortConnection)
+    {
+    const unsigned char* data;
+    size_t len;
+    batch->GetData(&data, &len);
+    controller->TriggerRMI(1, (void*)data, static_cast<int>(len),
+      vtkRemoteConnection::CLIENT_SERVER_BATCH_RMI_TAG);
+    }
+  batch->Reset();
+}
+
 //-----------------------------------------------------------------------------
 const vtkClientServerStream& vtkServerConnection::GetLastResult(vtkTypeUInt32 
   serverFlags)
@@ -257,6 +348,7 @@ const vtkClientServerStream& vtkServerConnection::GetLastResultInternal(
     return *this->LastResultStream;
     }
 
+  this->FlushStreamBatches();
   int length =0;
   controller->TriggerRMI(1, "", 
     vtkRemoteConnection::CLIENT_SERVER_LAST_RESULT_TAG);
@@ -327,6 +419,7 @@ void vtkServerConnection::GatherInformation(vtkTypeUInt32 serverFlags,
 void vtkServerConnection::GatherInformationFromController(vtkSocketController* controller,
   vtkPVInformation* info, vtkClientServerID id)
 {
+  this->FlushStreamBatches();
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Assign // dummy command.
     << info->GetClassName()
@@ -664,6 +757,7 @@ void vtkServerConnection::PushUndo(const char* label, vtkPVXMLElement* uelem)
     << vtkClientServerStream::End;
 
   // Send the string to server.
+  this->FlushStreamBatches();
   vtkSocketController* controller = this->GetSocketController();
   const unsigned char* data;
   size_t len;
@@ -676,6 +770,7 @@ void vtkServerConnection::PushUndo(const char* label, vtkPVXMLElement* uelem)
 //-----------------------------------------------------------------------------
 vtkPVXMLElement* vtkServerConnection::NewNextUndo()
 {
+  this->FlushStreamBatches();
   vtkSocketController* controller = this->GetSocketController();
   controller->TriggerRMI(1, NULL, 0, vtkRemoteConnection::UNDO_XML_TAG);
   int length;
@@ -720,6 +815,7 @@ vtkPVXMLElement* vtkServerConnection::NewNextUndo()
 //-----------------------------------------------------------------------------
 vtkPVXMLElement* vtkServerConnection::NewNextRedo()
 {
+  this->FlushStreamBatches();
   vtkSocketController* controller = this->GetSocketController();
   controller->TriggerRMI(1, NULL, 0, vtkRemoteConnection::REDO_XML_TAG);
   int length;
@@ -767,6 +863,7 @@ void vtkServerConnection::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "MPIMToNSocketConnectionID: " 
     << this->MPIMToNSocketConnectionID << endl;
+  os << indent << "StreamBatchDepth: " << this->StreamBatchDepth << endl;
 
   os << indent << "ServerInformation: ";
   if (this->ServerInformation)
@@ -78,6 +78,21 @@ public:
   // Get the number of data server processes on the server.
   virtual int GetNumberOfPartitions() { return this->NumberOfServerProcesses; }
 
+  // Description:
+  // Between BeginStreamBatch and EndStreamBatch, the streams sent to each
+  // server are accumulated and sent in one message when the batch ends.
+  // They are sent earlier when a result is requested from the servers or
+  // when a stream also goes to the client. Batches can be nested.
+  void BeginStreamBatch();
+  void EndStreamBatch();
+
+//BTX
+  // Description:
+  // Overridden to send the pending streams before executing a stream on
+  // the client, which may wait for the servers.
+  virtual int SendStream(vtkTypeUInt32 servers, vtkClientServerStream& stream);
+//ETX
+
   // Description:
   // Push the vtkUndoSet xml state on the undo stack for this connection.
   // Subclasses override this method to do the appropriate action.
@@ -125,6 +140,18 @@ protected:
   int SendStreamToRoot(vtkSocketController* controller,
   vtkClientServerStream& stream);
 
+  // Description:
+  // Send the streams accumulated for each server since the batch started.
+  void FlushStreamBatches();
+  void FlushStreamBatch(vtkSocketController* controller,
+    vtkClientServerStream* batch);
+
+  // Description:
+  // Append the stream to the batch of the server when a batch is in
+  // progress. Returns 0 when the stream has to be sent now.
+  int AddToStreamBatch(vtkSocketController* controller,
+    vtkClientServerStream& stream, int rootOnly);
+
   // Description:
   // Authenticates with the Server. Returns 1 on success, 0 on failure.
   int AuthenticateWithServer(vtkSocketController*);
@@ -160,6 +187,12 @@ protected:
 
   vtkPVServerInformation* ServerInformation;
   vtkClientServerStream* LastResultStream;
+
+  // The streams accumulated for the data and render servers while a batch
+  // is in progress.
+  int StreamBatchDepth;
+  vtkClientServerStream* DataServerBatch;
+  vtkClientServerStream* RenderServerBatch;
 private:
   vtkServerConnection(const vtkServerConnection&); // Not implemented.
   void operator=(const vtkServerConnection&); // Not implemented.
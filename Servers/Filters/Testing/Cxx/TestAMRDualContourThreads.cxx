@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test contours a multi-level AMR fractal with vtkAMRDualContour on one
+// and on several threads and checks that both give the same faces. Run in
+// parallel, each process contours its piece, so the blocks that need ghost
+// values from other processes are contoured after the ghost exchange.
+
+#include "vtkAMRDualContour.h"
+#include "vtkCellArray.h"
+#include "vtkDataObject.h"
+#include "vtkHierarchicalFractal.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkToolkits.h"
+
+#ifdef VTK_USE_MPI
+# include "vtkMPIController.h"
+#else
+# include "vtkDummyController.h"
+#endif
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+#include <math.h>
+
+// The coordinates of the points of a face, sorted so that faces can be
+// compared whatever the order of their points and of the faces.
+typedef vtkstd::vector<double> Face;
+
+// Contours the piece of the fractal on the given number of threads and
+// returns the sorted faces.
+static void Contour(int numThreads, int piece, int numPieces,
+                    vtkstd::vector<Face>& faces)
+{
+  vtkSmartPointer<vtkHierarchicalFractal> fractal =
+    vtkSmartPointer<vtkHierarchicalFractal>::New();
+  fractal->SetDimensions(8);
+  fractal->SetMaximumLevel(4);
+  fractal->SetGhostLevels(1);
+  fractal->SetTwoDimensional(0);
+  fractal->SetAsymetric(0);
+
+  vtkSmartPointer<vtkAMRDualContour> contour =
+    vtkSmartPointer<vtkAMRDualContour>::New();
+  contour->SetInputConnection(fractal->GetOutputPort());
+  contour->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "Fractal Volume Fraction");
+  contour->SetIsoValue(0.5);
+  contour->SetNumberOfThreads(numThreads);
+  contour->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline* sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(contour->GetExecutive());
+  sddp->SetUpdateExtent(0, piece, numPieces, 0);
+  contour->Update();
+
+  faces.clear();
+  vtkMultiBlockDataSet* output = contour->GetOutput();
+  vtkMultiPieceDataSet* pieces =
+    vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0));
+  vtkPolyData* mesh = pieces?
+    vtkPolyData::SafeDownCast(pieces->GetPiece(0)) : 0;
+  if (!mesh || !mesh->GetPolys())
+    {
+    return;
+    }
+  vtkIdType npts;
+  vtkIdType* pts;
+  vtkCellArray* polys = mesh->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+    {
+    vtkstd::vector<Face> points(npts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      double* pt = mesh->GetPoint(pts[i]);
+      points[i].assign(pt, pt + 3);
+      }
+    vtkstd::sort(points.begin(), points.end());
+    Face face;
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      face.insert(face.end(), points[i].begin(), points[i].end());
+      }
+    faces.push_back(face);
+    }
+  vtkstd::sort(faces.begin(), faces.end());
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef VTK_USE_MPI
+  vtkMPIController* controller = vtkMPIController::New();
+#else
+  vtkDummyController* controller = vtkDummyController::New();
+#endif
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  vtkstd::vector<Face> serial;
+  vtkstd::vector<Face> threaded;
+  Contour(1, myId, numProcs, serial);
+  Contour(4, myId, numProcs, threaded);
+
+  int retVal = 0;
+  if (serial.empty())
+    {
+    cerr << "ERROR: process " << myId << " produced no faces." << endl;
+    retVal = 1;
+    }
+  else if (serial.size() != threaded.size())
+    {
+    cerr << "ERROR: process " << myId << " produced " << threaded.size()
+         << " faces on several threads instead of " << serial.size()
+         << "." << endl;
+    retVal = 1;
+    }
+  for (size_t i = 0; !retVal && i < serial.size(); i++)
+    {
+    Face& a = serial[i];
+    Face& b = threaded[i];
+    int same = (a.size() == b.size());
+    for (size_t j = 0; same && j < a.size(); j++)
+      {
+      same = (fabs(a[j] - b[j]) <= 1e-6);
+      }
+    if (!same)
+      {
+      cerr << "ERROR: face " << i << " of process " << myId
+           << " differs on several threads." << endl;
+      retVal = 1;
+      }
+    }
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MAX_OP);
+  controller->Finalize();
+  controller->Delete();
+  return globalRetVal;
+}
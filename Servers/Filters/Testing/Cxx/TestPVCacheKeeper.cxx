@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test sets up the full resolution and LOD cache keepers the way the
+// representation strategies do, and scrubs through the time steps twice.
+// The second pass must only use the LOD cache, while modifying the source
+// must clear it.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkPVCacheKeeper.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#define NUMBER_OF_TIME_STEPS 5
+
+static void CountExecution(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  ++(*static_cast<int*>(clientdata));
+}
+
+// Updates the LOD keeper for every time step and returns the number of times
+// the decimator executed.
+static int Scrub(vtkPVCacheKeeper* keeper, vtkPVCacheKeeper* lodKeeper,
+                 int* executions)
+{
+  *executions = 0;
+  for (int i = 0; i < NUMBER_OF_TIME_STEPS; i++)
+    {
+    keeper->SetCacheTime(i);
+    lodKeeper->SetCacheTime(i);
+    lodKeeper->Update();
+    }
+  return *executions;
+}
+
+int main(int, char* [])
+{
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+
+  vtkSmartPointer<vtkPVCacheKeeper> keeper =
+    vtkSmartPointer<vtkPVCacheKeeper>::New();
+  keeper->SetInputConnection(sphere->GetOutputPort());
+
+  vtkSmartPointer<vtkQuadricClustering> decimator =
+    vtkSmartPointer<vtkQuadricClustering>::New();
+  decimator->SetInputConnection(keeper->GetOutputPort());
+  decimator->SetNumberOfDivisions(10, 10, 10);
+
+  vtkSmartPointer<vtkPVCacheKeeper> lodKeeper =
+    vtkSmartPointer<vtkPVCacheKeeper>::New();
+  lodKeeper->SetInputConnection(decimator->GetOutputPort());
+  lodKeeper->SetClearCacheWhenInputModified(true);
+
+  int executions = 0;
+  vtkSmartPointer<vtkCallbackCommand> counter =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  counter->SetCallback(CountExecution);
+  counter->SetClientData(&executions);
+  decimator->AddObserver(vtkCommand::StartEvent, counter);
+
+  int retVal = 0;
+  int count = Scrub(keeper, lodKeeper, &executions);
+  if (count != NUMBER_OF_TIME_STEPS)
+    {
+    cerr << "ERROR: the first pass decimated " << count << " times instead of "
+         << NUMBER_OF_TIME_STEPS << "." << endl;
+    retVal = 1;
+    }
+
+  count = Scrub(keeper, lodKeeper, &executions);
+  if (count != 0)
+    {
+    cerr << "ERROR: the second pass decimated " << count
+         << " times instead of using the cache." << endl;
+    retVal = 1;
+    }
+
+  // Modifying the pipeline upstream must discard the LOD of all the time
+  // steps.  The strategies clear the full resolution cache themselves.
+  sphere->SetThetaResolution(16);
+  keeper->RemoveAllCaches();
+  count = Scrub(keeper, lodKeeper, &executions);
+  if (count != NUMBER_OF_TIME_STEPS)
+    {
+    cerr << "ERROR: the pass after modifying the source decimated " << count
+         << " times instead of " << NUMBER_OF_TIME_STEPS << "." << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
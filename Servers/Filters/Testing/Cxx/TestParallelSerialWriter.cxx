@@ -0,0 +1,281 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test writes the pieces of a polydata with vtkParallelSerialWriter and
+// a legacy vtk writer into 1, 2 and as many files as there are processes. It
+// reads the files back on the root process and checks that each holds the
+// points of the processes of its group, in order. The second process has no
+// points, so that its group writes an empty file when every process writes
+// its own file. The time taken and the write bandwidth are printed for each
+// number of files.
+// The command line arguments are:
+// -T <dir>  => directory the files are written to
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkIntArray.h"
+#include "vtkParallelSerialWriter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkProcessModule.h"
+#include "vtkPVOptions.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkToolkits.h"
+
+#ifdef VTK_USE_MPI
+# include "vtkMPIController.h"
+#else
+# include "vtkDummyController.h"
+#endif
+
+#include <vtksys/ios/sstream>
+#include <vtksys/SystemTools.hxx>
+#include <vtkstd/string>
+
+extern "C" void vtkIOCS_Initialize(vtkClientServerInterpreter*);
+
+#define POINTS_PER_PROCESS 100000
+
+// The number of points of the piece of a process.
+static vtkIdType NumberOfPoints(int process)
+{
+  return process == 1? 0 : POINTS_PER_PROCESS;
+}
+
+// Builds the piece of a process: vertices along the x axis, numbered after
+// the points of the previous processes, with the process id as point data.
+static vtkPolyData* NewPiece(int process)
+{
+  vtkPolyData* piece = vtkPolyData::New();
+  vtkPoints* points = vtkPoints::New();
+  vtkCellArray* verts = vtkCellArray::New();
+  vtkIntArray* ranks = vtkIntArray::New();
+  ranks->SetName("Rank");
+  vtkIdType first = static_cast<vtkIdType>(process) * POINTS_PER_PROCESS;
+  for (vtkIdType cc = 0; cc < NumberOfPoints(process); cc++)
+    {
+    vtkIdType id = points->InsertNextPoint(first + cc, 0.0, 0.0);
+    verts->InsertNextCell(1, &id);
+    ranks->InsertNextValue(process);
+    }
+  piece->SetPoints(points);
+  piece->SetVerts(verts);
+  piece->GetPointData()->AddArray(ranks);
+  points->Delete();
+  verts->Delete();
+  ranks->Delete();
+  return piece;
+}
+
+// The name of the file of a group, as the writer names it.
+static vtkstd::string GroupFileName(const char* dir, int group, int numFiles)
+{
+  vtksys_ios::ostringstream fname;
+  fname << dir << "/TestParallelSerialWriter";
+  if (numFiles > 1)
+    {
+    fname << "_" << group;
+    }
+  fname << ".vtk";
+  return fname.str();
+}
+
+// Reads the file of a group and checks that it holds the points of the
+// processes of the group, in order.
+static int CheckFile(const vtkstd::string& fname, int first, int last)
+{
+  if (!vtksys::SystemTools::FileExists(fname.c_str()))
+    {
+    cerr << "ERROR: " << fname << " was not written." << endl;
+    return 0;
+    }
+  vtkSmartPointer<vtkPolyDataReader> reader =
+    vtkSmartPointer<vtkPolyDataReader>::New();
+  reader->SetFileName(fname.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  vtkIdType numPoints = 0;
+  for (int p = first; p < last; p++)
+    {
+    numPoints += NumberOfPoints(p);
+    }
+  if (output->GetNumberOfPoints() != numPoints ||
+    output->GetNumberOfVerts() != numPoints)
+    {
+    cerr << "ERROR: " << fname << " has " << output->GetNumberOfPoints()
+         << " points and " << output->GetNumberOfVerts()
+         << " vertices instead of " << numPoints << "." << endl;
+    return 0;
+    }
+  vtkIntArray* ranks = vtkIntArray::SafeDownCast(
+    output->GetPointData()->GetArray("Rank"));
+  if (numPoints > 0 && !ranks)
+    {
+    cerr << "ERROR: " << fname << " has no Rank array." << endl;
+    return 0;
+    }
+  vtkIdType cc = 0;
+  for (int p = first; p < last; p++)
+    {
+    vtkIdType firstId = static_cast<vtkIdType>(p) * POINTS_PER_PROCESS;
+    for (vtkIdType i = 0; i < NumberOfPoints(p); i++, cc++)
+      {
+      if (ranks->GetValue(cc) != p || output->GetPoint(cc)[0] != firstId + i)
+        {
+        cerr << "ERROR: point " << cc << " of " << fname
+             << " is not point " << i << " of process " << p << "." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Writes the piece of this process into the given number of files. The root
+// process checks the files, prints the bandwidth and removes the files.
+static int Write(vtkMultiProcessController* controller,
+                 vtkParallelSerialWriter* writer, const char* dir,
+                 int numFiles)
+{
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  writer->SetNumberOfFiles(numFiles);
+  if (numFiles > numProcs)
+    {
+    numFiles = numProcs;
+    }
+
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  controller->Barrier();
+  timer->StartTimer();
+  writer->Write();
+  controller->Barrier();
+  timer->StopTimer();
+  if (myId != 0)
+    {
+    return 1;
+    }
+
+  int retVal = 1;
+  double bytes = 0.0;
+  for (int g = 0; g < numFiles; g++)
+    {
+    // Process p is in group p*numFiles/numProcs.
+    int first = (g*numProcs + numFiles - 1) / numFiles;
+    int last = ((g+1)*numProcs + numFiles - 1) / numFiles;
+    vtkstd::string fname = GroupFileName(dir, g, numFiles);
+    bytes += vtksys::SystemTools::FileLength(fname.c_str());
+    retVal = CheckFile(fname, first, last) && retVal;
+    vtksys::SystemTools::RemoveFile(fname.c_str());
+    }
+  vtkstd::string extra = GroupFileName(dir, numFiles, 2);
+  if (vtksys::SystemTools::FileExists(extra.c_str()))
+    {
+    cerr << "ERROR: " << extra << " was written for " << numFiles
+         << " files." << endl;
+    vtksys::SystemTools::RemoveFile(extra.c_str());
+    retVal = 0;
+    }
+
+  double time = timer->GetElapsedTime();
+  cout << "Processes: " << numProcs << ", files: " << numFiles
+       << ", bytes: " << bytes << ", time: " << time << " s";
+  if (time > 0.0)
+    {
+    cout << ", bandwidth: " << bytes / time / (1024.0 * 1024.0) << " MB/s";
+    }
+  cout << endl;
+  return retVal;
+}
+
+// Writes the pieces into 1, 2 and as many files as there are processes. The
+// writer is deleted before returning, together with the controllers of its
+// groups of processes.
+static int WriteFiles(vtkMultiProcessController* controller, const char* dir)
+{
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // The internal writer is called through the interpreter, as on a server.
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkProcessModule* pm = vtkProcessModule::New();
+  pm->SetOptions(options);
+  vtkProcessModule::SetProcessModule(pm);
+  pm->InitializeInterpreter();
+  vtkIOCS_Initialize(pm->GetInterpreter());
+  vtkClientServerStream stream;
+  vtkClientServerID writerId = pm->NewStreamObject("vtkPolyDataWriter", stream);
+  pm->GetInterpreter()->ProcessStream(stream);
+  vtkPolyDataWriter* internalWriter =
+    vtkPolyDataWriter::SafeDownCast(pm->GetObjectFromID(writerId));
+  internalWriter->SetFileTypeToBinary();
+
+  vtkPolyData* piece = NewPiece(myId);
+  vtkAppendPolyData* append = vtkAppendPolyData::New();
+  vtkParallelSerialWriter* writer = vtkParallelSerialWriter::New();
+  writer->SetInput(piece);
+  writer->SetWriter(internalWriter);
+  writer->SetFileNameMethod("SetFileName");
+  writer->SetPostGatherHelper(append);
+  writer->SetPiece(myId);
+  writer->SetNumberOfPieces(numProcs);
+  vtkstd::string fname = vtkstd::string(dir) + "/TestParallelSerialWriter.vtk";
+  writer->SetFileName(fname.c_str());
+
+  int retVal = Write(controller, writer, dir, 1);
+  retVal = Write(controller, writer, dir, 2) && retVal;
+  retVal = Write(controller, writer, dir, numProcs) && retVal;
+
+  writer->Delete();
+  append->Delete();
+  piece->Delete();
+  stream.Reset();
+  pm->DeleteStreamObject(writerId, stream);
+  pm->GetInterpreter()->ProcessStream(stream);
+  pm->FinalizeInterpreter();
+  vtkProcessModule::SetProcessModule(0);
+  pm->Delete();
+  options->Delete();
+  return retVal;
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef VTK_USE_MPI
+  vtkMPIController* controller = vtkMPIController::New();
+#else
+  vtkDummyController* controller = vtkDummyController::New();
+#endif
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* dir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", ".");
+  int retVal = WriteFiles(controller, dir);
+  delete [] dir;
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MIN_OP);
+  controller->Finalize();
+  controller->Delete();
+  return globalRetVal? 0 : 1;
+}
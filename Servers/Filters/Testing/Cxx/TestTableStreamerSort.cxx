@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test pages through a multiblock dataset of two tables with
+// vtkTableStreamer, sorted by a column, and checks the rows gathered on the
+// root process against the expected order. The second table has many equal
+// values, which are ordered by process and then by local row. It then limits
+// the number of top rows, which applies to both tables together, and finally
+// clears the sort. Run in parallel, the rows of every table are dealt out
+// among the processes.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+#include "vtkTableStreamer.h"
+#include "vtkToolkits.h"
+
+#ifdef VTK_USE_MPI
+# include "vtkMPIController.h"
+#else
+# include "vtkDummyController.h"
+#endif
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+#define NUMBER_OF_LEAVES 2
+#define BLOCK_SIZE 128
+
+static const vtkIdType LeafSizes[NUMBER_OF_LEAVES] = { 1000, 300 };
+
+// The value of a row of a leaf, given its global row id.
+static double Value(int leaf, vtkIdType row)
+{
+  return leaf == 0? static_cast<double>((row*7919) % 1000) :
+    static_cast<double>(row % 10);
+}
+
+// The (key, process, local row) a row is ordered by, and its global row id.
+struct Row
+{
+  double Key;
+  int Process;
+  vtkIdType LocalRow;
+  vtkIdType GlobalRow;
+  bool operator<(const Row& other) const
+    {
+    if (this->Key != other.Key)
+      {
+      return this->Key < other.Key;
+      }
+    if (this->Process != other.Process)
+      {
+      return this->Process < other.Process;
+      }
+    return this->LocalRow < other.LocalRow;
+    }
+};
+
+// Returns the global row ids of all leaves, one after another, in the order
+// the streamer must pass them.
+static vtkstd::vector<vtkIdType> ExpectedRows(int numProcs, bool descending)
+{
+  vtkstd::vector<vtkIdType> result;
+  for (int leaf = 0; leaf < NUMBER_OF_LEAVES; leaf++)
+    {
+    vtkstd::vector<Row> rows(LeafSizes[leaf]);
+    for (vtkIdType cc = 0; cc < LeafSizes[leaf]; cc++)
+      {
+      rows[cc].Key = descending? -Value(leaf, cc) : Value(leaf, cc);
+      rows[cc].Process = static_cast<int>(cc % numProcs);
+      rows[cc].LocalRow = cc / numProcs;
+      rows[cc].GlobalRow = cc;
+      }
+    vtkstd::sort(rows.begin(), rows.end());
+    for (vtkIdType cc = 0; cc < LeafSizes[leaf]; cc++)
+      {
+      result.push_back(rows[cc].GlobalRow);
+      }
+    }
+  return result;
+}
+
+// Pages through all the rows and returns the global row ids passed on this
+// process.
+static vtkstd::vector<vtkIdType> PageRows(vtkTableStreamer* streamer,
+                                          vtkIdType numRows)
+{
+  vtkstd::vector<vtkIdType> result;
+  vtkIdType blockSize = streamer->GetBlockSize();
+  vtkIdType numBlocks = (numRows + blockSize - 1) / blockSize;
+  for (vtkIdType block = 0; block < numBlocks; block++)
+    {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkMultiBlockDataSet* output =
+      vtkMultiBlockDataSet::SafeDownCast(streamer->GetOutputDataObject(0));
+    for (unsigned int leaf = 0; output && leaf < output->GetNumberOfBlocks();
+      leaf++)
+      {
+      vtkTable* table = vtkTable::SafeDownCast(output->GetBlock(leaf));
+      vtkIdTypeArray* ids = table? vtkIdTypeArray::SafeDownCast(
+        table->GetColumnByName("GlobalRow")) : 0;
+      for (vtkIdType cc = 0; ids && cc < ids->GetNumberOfTuples(); cc++)
+        {
+        result.push_back(ids->GetValue(cc));
+        }
+      }
+    }
+  return result;
+}
+
+// Compares the rows passed on this process with the expected ones. Only the
+// root process gets rows when sorting.
+static int CheckRows(const vtkstd::vector<vtkIdType>& rows,
+                     const vtkstd::vector<vtkIdType>& expected, int myId,
+                     const char* step)
+{
+  if (myId != 0)
+    {
+    if (!rows.empty())
+      {
+      cerr << "ERROR: " << step << ": process " << myId << " passed "
+           << rows.size() << " rows." << endl;
+      return 0;
+      }
+    return 1;
+    }
+  if (rows != expected)
+    {
+    cerr << "ERROR: " << step << ": " << rows.size()
+         << " rows were passed out of order, expected " << expected.size()
+         << "." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef VTK_USE_MPI
+  vtkMPIController* controller = vtkMPIController::New();
+#else
+  vtkDummyController* controller = vtkDummyController::New();
+#endif
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // Every process gets the rows whose id modulo the number of processes is
+  // its own id.
+  vtkSmartPointer<vtkMultiBlockDataSet> input =
+    vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  vtkIdType totalRows = 0;
+  for (int leaf = 0; leaf < NUMBER_OF_LEAVES; leaf++)
+    {
+    vtkSmartPointer<vtkTable> table = vtkSmartPointer<vtkTable>::New();
+    vtkSmartPointer<vtkDoubleArray> values =
+      vtkSmartPointer<vtkDoubleArray>::New();
+    values->SetName("Values");
+    vtkSmartPointer<vtkIdTypeArray> ids =
+      vtkSmartPointer<vtkIdTypeArray>::New();
+    ids->SetName("GlobalRow");
+    for (vtkIdType cc = myId; cc < LeafSizes[leaf]; cc += numProcs)
+      {
+      values->InsertNextValue(Value(leaf, cc));
+      ids->InsertNextValue(cc);
+      }
+    table->AddColumn(values);
+    table->AddColumn(ids);
+    input->SetBlock(leaf, table);
+    totalRows += LeafSizes[leaf];
+    }
+
+  vtkSmartPointer<vtkTableStreamer> streamer =
+    vtkSmartPointer<vtkTableStreamer>::New();
+  streamer->SetInput(input);
+  streamer->SetBlockSize(BLOCK_SIZE);
+  streamer->SetSortColumnName("Values");
+
+  int retVal = 1;
+  streamer->SetSortDescending(1);
+  retVal = CheckRows(PageRows(streamer, totalRows),
+    ExpectedRows(numProcs, true), myId, "descending") && retVal;
+
+  streamer->SetSortDescending(0);
+  retVal = CheckRows(PageRows(streamer, totalRows),
+    ExpectedRows(numProcs, false), myId, "ascending") && retVal;
+
+  // The limit spans the first leaf and part of the second one.
+  const vtkIdType numTopRows = LeafSizes[0] + 100;
+  streamer->SetNumberOfTopRows(numTopRows);
+  vtkstd::vector<vtkIdType> expected = ExpectedRows(numProcs, false);
+  expected.resize(numTopRows);
+  retVal = CheckRows(PageRows(streamer, totalRows), expected, myId,
+    "top rows") && retVal;
+
+  // Without a sort, every process passes its own rows in their natural order.
+  streamer->SetSortColumnName("");
+  streamer->SetBlockSize(totalRows);
+  vtkstd::vector<vtkIdType> rows = PageRows(streamer, totalRows);
+  expected.clear();
+  for (int leaf = 0; leaf < NUMBER_OF_LEAVES; leaf++)
+    {
+    for (vtkIdType cc = myId; cc < LeafSizes[leaf]; cc += numProcs)
+      {
+      expected.push_back(cc);
+      }
+    }
+  if (rows != expected)
+    {
+    cerr << "ERROR: process " << myId << " passed " << rows.size()
+         << " rows out of their natural order once the sort was cleared."
+         << endl;
+    retVal = 0;
+    }
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MIN_OP);
+  controller->Finalize();
+  controller->Delete();
+  return globalRetVal? 0 : 1;
+}
@@ -16,6 +16,7 @@
 #include "vtkAMRDualGridHelper.h"
 
 #include "vtkstd/vector"
+#include "vtkstd/set"
 
 // Pipeline & VTK 
 #include "vtkMarchingCubesCases.h"
@@ -42,7 +43,11 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
+#include "vtkIntArray.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkMergePoints.h"
+#include "vtkMultiThreader.h"
+#include "vtkPoints.h"
 #include <math.h>
 #include <ctime>
 
@@ -590,6 +595,75 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
 
 
 
+//============================================================================
+// A local block and the array to contour in it.
+struct vtkAMRDualContourBlockItem
+{
+  vtkAMRDualGridHelperBlock* Block;
+  int BlockId;
+  vtkDataArray* Array;
+};
+
+//----------------------------------------------------------------------------
+// Everything a thread writes while it contours its blocks.  Each thread
+// has its own mesh, so no locking is needed until the meshes are merged.
+class vtkAMRDualContourThreadData
+{
+public:
+  vtkAMRDualContourThreadData();
+  ~vtkAMRDualContourThreadData();
+
+  vtkPoints* Points;
+  vtkCellArray* Faces;
+  // For debugging.
+  vtkIntArray* BlockIdCellArray;
+
+  // Locator of the block being processed.  When points are not merged,
+  // this is one locator reused by all the blocks of the thread.
+  vtkAMRDualContourEdgeLocator* BlockLocator;
+
+  // Blocks this thread contours before (0) and after (1) the ghost
+  // values from other processes arrive.
+  vtkstd::vector<vtkAMRDualContourBlockItem> PhaseBlocks[2];
+  // Locators are only shared between blocks of the same thread.
+  vtkstd::set<vtkAMRDualGridHelperBlock*> OwnedBlocks;
+};
+
+//----------------------------------------------------------------------------
+vtkAMRDualContourThreadData::vtkAMRDualContourThreadData()
+{
+  this->Points = vtkPoints::New();
+  this->Faces = vtkCellArray::New();
+  this->BlockIdCellArray = vtkIntArray::New();
+  this->BlockIdCellArray->SetName("BlockIds");
+  this->BlockLocator = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkAMRDualContourThreadData::~vtkAMRDualContourThreadData()
+{
+  this->Points->Delete();
+  this->Faces->Delete();
+  this->BlockIdCellArray->Delete();
+  if (this->BlockLocator)
+    {
+    delete this->BlockLocator;
+    this->BlockLocator = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkAMRDualContourThreadedExecute(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* ti =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkAMRDualContour* self = static_cast<vtkAMRDualContour*>(ti->UserData);
+  self->ThreadedProcessBlocks(ti->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+
+
 
 
 
@@ -608,26 +682,22 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
   this->Controller = vtkMultiProcessController::GetGlobalController();
 
   // Pipeline
   this->SetNumberOfOutputPorts(1);
   
 
-  this->BlockIdCellArray = 0;
   this->Helper = 0;
 
-  this->BlockLocator = 0;
+  this->ThreadData = 0;
+  this->ThreadPhase = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-    {
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
-    }
 }
 
 //----------------------------------------------------------------------------
@@ -637,6 +707,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "IsoValue: " << this->IsoValue << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -716,47 +787,104 @@ int vtkAMRDualContour::RequestData(
   const char *arrayNameToProcess = inArrayInfo->Get(vtkDataObject::FIELD_NAME());      
 
 
+  // With more than one thread, blocks that need ghost values from other
+  // processes are contoured last.  The first thread exchanges these values
+  // while the others contour the rest.
+  int numThreads = this->NumberOfThreads;
   this->Helper = vtkAMRDualGridHelper::New();
   this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
   this->Helper->SetEnableMultiProcessCommunication(this->EnableMultiProcessCommunication);
+  this->Helper->SetDeferGhostExchange(numThreads > 1);
   this->Helper->Initialize(hbdsInput, arrayNameToProcess);
 
   vtkPolyData* mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
-  mesh->SetPolys(this->Faces);
   mpds->SetPiece(0, mesh);
-  
-  // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
 
-  // Loop through blocks
+  // Collect the local blocks, low levels first.
+  // Remote blocks are only to setup local block bit flags.
+  vtkstd::vector<vtkAMRDualContourBlockItem> blocks;
   int numLevels = hbdsInput->GetNumberOfLevels();
   int numBlocks;
   int blockId;
-
-  // Add each block.
   for (int level = 0; level < numLevels; ++level)
     {
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (blockId = 0; blockId < numBlocks; ++blockId)
       {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId);
+      if (block->Image)
+        {
+        vtkAMRDualContourBlockItem item;
+        item.Block = block;
+        item.BlockId = blockId;
+        item.Array = 0;
+        blocks.push_back(item);
+        }
       }
     }
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = 0;
+  int numLocalBlocks = (int)(blocks.size());
+  if (numThreads > numLocalBlocks)
+    {
+    numThreads = numLocalBlocks > 1 ? numLocalBlocks : 1;
+    }
+  this->ThreadData = new vtkAMRDualContourThreadData[numThreads];
+
+  // Each thread gets a contiguous range of blocks in each phase, so
+  // most neighbors share a thread and can share its locators.
+  // One thread keeps the original order (and output).
+  vtkstd::vector<vtkAMRDualContourBlockItem> phaseBlocks[2];
+  int phase;
+  int ii;
+  for (ii = 0; ii < numLocalBlocks; ++ii)
+    {
+    phase = 0;
+    if (numThreads > 1 &&
+        this->Helper->BlockNeedsRemoteGhostValues(blocks[ii].Block))
+      {
+      phase = 1;
+      }
+    phaseBlocks[phase].push_back(blocks[ii]);
+    }
+  for (phase = 0; phase < 2; ++phase)
+    {
+    int numPhaseBlocks = (int)(phaseBlocks[phase].size());
+    for (ii = 0; ii < numPhaseBlocks; ++ii)
+      {
+      vtkAMRDualContourThreadData* data =
+        this->ThreadData + (ii * numThreads / numPhaseBlocks);
+      data->PhaseBlocks[phase].push_back(phaseBlocks[phase][ii]);
+      data->OwnedBlocks.insert(phaseBlocks[phase][ii].Block);
+      }
+    }
 
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkAMRDualContourThreadedExecute, this);
+  for (phase = 0; phase < 2; ++phase)
+    {
+    // The ghost exchange replaces the images of the blocks it fills, so
+    // the arrays are only looked up once the previous phase is done.
+    for (int threadId = 0; threadId < numThreads; ++threadId)
+      {
+      vtkstd::vector<vtkAMRDualContourBlockItem>& items =
+        this->ThreadData[threadId].PhaseBlocks[phase];
+      for (ii = 0; ii < (int)(items.size()); ++ii)
+        {
+        items[ii].Array =
+          this->GetInputArrayToProcess(0, items[ii].Block->Image);
+        }
+      }
+    this->ThreadPhase = phase;
+    threader->SingleMethodExecute();
+    }
+  threader->Delete();
+
+  this->MergeThreadOutputs(numThreads, mesh);
+
+  delete [] this->ThreadData;
+  this->ThreadData = 0;
   mesh->Delete();
-  this->Points->Delete();
-  this->Points = 0;
-  this->Faces->Delete();
-  this->Faces = 0;
 
   mpds->Delete();
   this->Helper->Delete();
@@ -765,6 +893,153 @@ int vtkAMRDualContour::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ThreadedProcessBlocks(int threadId)
+{
+  if (threadId == 0 && this->ThreadPhase == 0)
+    { // The other threads keep contouring while this one communicates.
+    this->Helper->FinishGhostExchange();
+    }
+
+  vtkAMRDualContourThreadData* data = this->ThreadData + threadId;
+  vtkstd::vector<vtkAMRDualContourBlockItem>& items =
+    data->PhaseBlocks[this->ThreadPhase];
+  int numItems = (int)(items.size());
+  for (int ii = 0; ii < numItems; ++ii)
+    {
+    this->ProcessBlock(data, items[ii].Block, items[ii].BlockId,
+                       items[ii].Array);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::MergeThreadOutputs(int numThreads, vtkPolyData* mesh)
+{
+  vtkAMRDualContourThreadData* data;
+  int threadId;
+
+  if (numThreads == 1)
+    {
+    data = this->ThreadData;
+    mesh->SetPoints(data->Points);
+    mesh->SetPolys(data->Faces);
+    mesh->GetCellData()->AddArray(data->BlockIdCellArray);
+    return;
+    }
+
+  vtkIdType numPoints = 0;
+  vtkIdType numCells = 0;
+  vtkIdType connectivitySize = 0;
+  double bounds[6] = {VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX};
+  for (threadId = 0; threadId < numThreads; ++threadId)
+    {
+    data = this->ThreadData + threadId;
+    if (data->Points->GetNumberOfPoints() > 0)
+      {
+      double threadBounds[6];
+      data->Points->GetBounds(threadBounds);
+      for (int ii = 0; ii < 6; ii += 2)
+        {
+        if (threadBounds[ii] < bounds[ii])
+          {
+          bounds[ii] = threadBounds[ii];
+          }
+        if (threadBounds[ii+1] > bounds[ii+1])
+          {
+          bounds[ii+1] = threadBounds[ii+1];
+          }
+        }
+      }
+    numPoints += data->Points->GetNumberOfPoints();
+    numCells += data->Faces->GetNumberOfCells();
+    connectivitySize += data->Faces->GetNumberOfConnectivityEntries();
+    }
+
+  vtkPoints* points = vtkPoints::New();
+  points->Allocate(numPoints);
+  vtkCellArray* faces = vtkCellArray::New();
+  faces->Allocate(connectivitySize);
+  vtkIntArray* blockIds = vtkIntArray::New();
+  blockIds->SetName("BlockIds");
+  blockIds->Allocate(numCells);
+
+  // Threads do not share locators, so points on the seams between their
+  // blocks are duplicated.  Both copies are computed from the same values,
+  // so an exact locator finds them.
+  vtkMergePoints* locator = 0;
+  if (this->EnableMergePoints && numPoints > 0)
+    {
+    locator = vtkMergePoints::New();
+    locator->InitPointInsertion(points, bounds, numPoints);
+    }
+
+  vtkstd::vector<vtkIdType> pointMap;
+  vtkstd::vector<vtkIdType> cellPointIds;
+  for (threadId = 0; threadId < numThreads; ++threadId)
+    {
+    data = this->ThreadData + threadId;
+    vtkIdType threadNumPoints = data->Points->GetNumberOfPoints();
+    pointMap.resize(threadNumPoints);
+    double pt[3];
+    for (vtkIdType ptId = 0; ptId < threadNumPoints; ++ptId)
+      {
+      data->Points->GetPoint(ptId, pt);
+      if (locator)
+        {
+        locator->InsertUniquePoint(pt, pointMap[ptId]);
+        }
+      else
+        {
+        pointMap[ptId] = points->InsertNextPoint(pt);
+        }
+      }
+
+    vtkIdType npts;
+    vtkIdType* pts;
+    vtkIdType cellId = 0;
+    vtkCellArray* threadFaces = data->Faces;
+    for (threadFaces->InitTraversal(); threadFaces->GetNextCell(npts, pts); ++cellId)
+      {
+      // Merged points can collapse edges.  Skip repeated points and
+      // drop polygons that become degenerate.
+      cellPointIds.clear();
+      for (vtkIdType ii = 0; ii < npts; ++ii)
+        {
+        vtkIdType id = pointMap[pts[ii]];
+        if (cellPointIds.empty() || cellPointIds.back() != id)
+          {
+          cellPointIds.push_back(id);
+          }
+        }
+      while (cellPointIds.size() > 1 && cellPointIds.back() == cellPointIds.front())
+        {
+        cellPointIds.pop_back();
+        }
+      if (cellPointIds.size() < 3)
+        {
+        continue;
+        }
+      faces->InsertNextCell((vtkIdType)(cellPointIds.size()), &cellPointIds[0]);
+      blockIds->InsertNextValue(data->BlockIdCellArray->GetValue(cellId));
+      }
+    }
+
+  if (locator)
+    {
+    locator->Delete();
+    }
+  points->Squeeze();
+  faces->Squeeze();
+  mesh->SetPoints(points);
+  mesh->SetPolys(faces);
+  mesh->GetCellData()->AddArray(blockIds);
+  points->Delete();
+  faces->Delete();
+  blockIds->Delete();
+}
+
 //----------------------------------------------------------------------------
 // The only data specific stuff we need to do for the contour.
 template <class T>
@@ -787,6 +1062,7 @@ void vtkDualGridContourExtractCornerValues(
 
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(
+  vtkAMRDualContourThreadData* data,
   vtkAMRDualGridHelperBlock* block)
 {
   vtkAMRDualGridHelperBlock* neighbor;
@@ -824,7 +1100,11 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(
             {
             neighbor = this->Helper->GetBlock(level, ix, iy, iz); 
             // The unused center flag is used as a flag to indicate
-            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1])
+            // that the neighbor is already processed.  Locators of blocks
+            // assigned to other threads are left alone.
+            if (neighbor &&
+                data->OwnedBlocks.find(neighbor) != data->OwnedBlocks.end() &&
+                neighbor->RegionBits[1][1][1])
               {
               // This worked for neighbors in the same level.
               //vtkAMRDualContourEdgeLocator* blockLocator = vtkAMRDualContourGetBlockLocator(block);
@@ -844,15 +1124,16 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(
 
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block,
-                                     int blockId)
+void vtkAMRDualContour::ProcessBlock(vtkAMRDualContourThreadData* data,
+                                     vtkAMRDualGridHelperBlock* block,
+                                     int blockId,
+                                     vtkDataArray* volumeFractionArray)
 {
   vtkImageData* image = block->Image;
   if (image == 0)
     { // Remote blocks are only to setup local block bit flags.
     return;
     }
-  vtkDataArray *volumeFractionArray = this->GetInputArrayToProcess(0, image);
   void* volumeFractionPtr = volumeFractionArray->GetVoidPointer(0);
   double  origin[3];
   double* spacing;
@@ -869,16 +1150,16 @@ void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block,
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
     {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+    data->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
     }
   else
     { // Shared locator.
-    if (this->BlockLocator == 0)
+    if (data->BlockLocator == 0)
       {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
+      data->BlockLocator = new vtkAMRDualContourEdgeLocator;
       }
-    this->BlockLocator->Initialize(extent[1]-extent[0], extent[3]-extent[2], extent[5]-extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    data->BlockLocator->Initialize(extent[1]-extent[0], extent[3]-extent[2], extent[5]-extent[4]);
+    data->BlockLocator->CopyRegionLevelDifferences(block);
     }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -984,7 +1265,7 @@ void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block,
             {
             cubeIndex += 128;
             }
-          this->ProcessDualCell(block, blockId,
+          this->ProcessDualCell(data, block, blockId,
                                 cubeIndex, x, y, z,
                                 cornerValues);
           }
@@ -998,10 +1279,10 @@ void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block,
   if (this->EnableMergePoints)
     { 
     // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
+    this->ShareBlockLocatorWithNeighbors(data, block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
+    delete data->BlockLocator;
+    data->BlockLocator = 0;
     block->UserData = 0;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1060,6 +1341,7 @@ static int vtkAMRDualIsoPZCapEdgeMap[8] = {6,7,5,4 ,6,5,4,7};
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 void vtkAMRDualContour::ProcessDualCell(
+  vtkAMRDualContourThreadData* data,
   vtkAMRDualGridHelperBlock* block, int blockId,
   int cubeCase,
   int x, int y, int z,
@@ -1239,7 +1521,7 @@ void vtkAMRDualContour::ProcessDualCell(
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii=0; ii<3; ++ii, ++edge) //insert triangle
       {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x,y,z,*edge);
+      vtkIdType* ptIdPtr = data->BlockLocator->GetEdgePointer(x,y,z,*edge);
 
       if (*ptIdPtr == -1)
         {
@@ -1265,26 +1547,27 @@ void vtkAMRDualContour::ProcessDualCell(
         pt[0] = cornerPoints[pt1Idx] + k*(cornerPoints[pt2Idx]-cornerPoints[pt1Idx]);
         pt[1] = cornerPoints[pt1Idx|1] + k*(cornerPoints[pt2Idx|1]-cornerPoints[pt1Idx|1]);
         pt[2] = cornerPoints[pt1Idx|2] + k*(cornerPoints[pt2Idx|2]-cornerPoints[pt1Idx|2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        *ptIdPtr = data->Points->InsertNextPoint(pt);
         }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr; 
       }
     if (pointIds[0]!=pointIds[1] && pointIds[0]!=pointIds[2] && pointIds[1]!=pointIds[2])
       {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      data->Faces->InsertNextCell(3, pointIds);
+      data->BlockIdCellArray->InsertNextValue(blockId);
       }
     }
 
   if (this->EnableCapping)
     {
-    this->CapCell(x,y,z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, blockId);
+    this->CapCell(data, x,y,z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, blockId);
     }
 }
 
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(vtkAMRDualContourThreadData* data,
+                                      int ptCount, vtkIdType* pointIds, int blockId)
 {
   if (this->TriangulateCap)
     {
@@ -1300,8 +1583,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0]!=tri[1] && tri[0]!=tri[2] && tri[1]!=tri[2])
           {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          data->Faces->InsertNextCell(3, tri);
+          data->BlockIdCellArray->InsertNextValue(blockId);
           }
         }
       else
@@ -1311,16 +1594,16 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0]!=tri[1] && tri[0]!=tri[2] && tri[1]!=tri[2])
           {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          data->Faces->InsertNextCell(3, tri);
+          data->BlockIdCellArray->InsertNextValue(blockId);
           }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high+1];
         tri[2] = pointIds[low];
         if (tri[0]!=tri[1] && tri[0]!=tri[2] && tri[1]!=tri[2])
           {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          data->Faces->InsertNextCell(3, tri);
+          data->BlockIdCellArray->InsertNextValue(blockId);
           }
         }
       ++low;
@@ -1330,8 +1613,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
     {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    data->Faces->InsertNextCell(ptCount, pointIds);
+    data->BlockIdCellArray->InsertNextValue(blockId);
     }
 }
 
@@ -1343,6 +1626,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
 // It endsup being a little long to duplicate the code 6 times,
 // but it is still fast.
 void vtkAMRDualContour::CapCell(
+  vtkAMRDualContourThreadData* data,
   int cellX, int cellY, int cellZ, // cell index in block coordinates.
   // Which cell faces need to be capped.
   unsigned char cubeBoundaryBits,
@@ -1371,10 +1655,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1384,7 +1668,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
@@ -1401,10 +1685,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1414,7 +1698,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
@@ -1432,10 +1716,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1445,7 +1729,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
@@ -1463,10 +1747,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1476,7 +1760,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
@@ -1495,10 +1779,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1508,7 +1792,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
@@ -1526,10 +1810,10 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
           {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
+          ptIdPtr = data->BlockLocator->GetCornerPointer(cellX,cellY,cellZ, cornerIdx);
           if (*ptIdPtr == -1)
             {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
+            *ptIdPtr = data->Points->InsertNextPoint(cornerPoints+(cornerIdx<<2));
             }
           pointIds[ptCount++] = *ptIdPtr; 
           }
@@ -1539,7 +1823,7 @@ void vtkAMRDualContour::CapCell(
           }
         ++capPtr;
         }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(data, ptCount, pointIds, blockId);
       if (*capPtr == -1) {++capPtr;} // Skip to the next triangle.
       }
     }
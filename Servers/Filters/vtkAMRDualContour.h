@@ -47,6 +47,8 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourThreadData;
+class vtkDataArray;
 
 
 class VTK_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
@@ -87,6 +89,23 @@ public:
   vtkGetMacro(TriangulateCap,int);
   vtkBooleanMacro(TriangulateCap,int);
 
+  // Description:
+  // The number of threads that contour blocks.  Each thread contours its
+  // own share of the local blocks into a separate mesh, and the meshes are
+  // merged at the end (points on the seams between threads are merged when
+  // EnableMergePoints is on).  With more than one thread, blocks that need
+  // ghost values from other processes are contoured last, so the exchange
+  // of these values overlaps the contouring of the other blocks.
+  // It defaults to the vtkMultiThreader default.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  //BTX
+  // Description:
+  // For the thread function only.  Contours the blocks assigned to one
+  // thread for the current phase.
+  void ThreadedProcessBlocks(int threadId);
+  //ETX
 
 protected:
   vtkAMRDualContour();
@@ -100,6 +119,7 @@ protected:
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
   int TriangulateCap;
+  int NumberOfThreads;
 
   //BTX
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
@@ -107,19 +127,25 @@ protected:
   virtual int FillOutputPortInformation(int port, vtkInformation *info);
 
   void ShareBlockLocatorWithNeighbors(
+    vtkAMRDualContourThreadData* data,
     vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId);
+  void ProcessBlock(vtkAMRDualContourThreadData* data,
+                    vtkAMRDualGridHelperBlock* block, int blockId,
+                    vtkDataArray* volumeFractionArray);
   
   void ProcessDualCell(
+    vtkAMRDualContourThreadData* data,
     vtkAMRDualGridHelperBlock* block, int blockId,
     int marchingCase,
     int x, int y, int z,
     double values[8]);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(vtkAMRDualContourThreadData* data,
+                     int ptCount, vtkIdType* pointIds, int blockId);
 
   void CapCell(
+    vtkAMRDualContourThreadData* data,
     int cellX, int cellY, int cellZ,  // block coordinates
     // Which cell faces need to be capped.
     unsigned char cubeBoundaryBits,
@@ -132,13 +158,17 @@ protected:
     // For block id array (for debugging).  I should just make this an ivar.
     int blockId);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
+  // Combines the meshes of all threads into the output mesh.
+  void MergeThreadOutputs(int numThreads, vtkPolyData* mesh);
 
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
+
+  // Output mesh, locator and assigned blocks of each thread.
+  // The phase selects the blocks to contour before (0) or after (1)
+  // the ghost values from other processes arrive.
+  vtkAMRDualContourThreadData* ThreadData;
+  int ThreadPhase;
 
   vtkMultiProcessController *Controller;
 
@@ -147,8 +177,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
 private:
   vtkAMRDualContour(const vtkAMRDualContour&);  // Not implemented.
   void operator=(const vtkAMRDualContour&);  // Not implemented.
@@ -298,6 +298,7 @@ vtkAMRDualGridHelperBlock::vtkAMRDualGridHelperBlock()
   //  }
   this->Image = 0;
   this->CopyFlag = 0;
+  this->RemoteGhostFlag = 0;
 
   for (int x = 0; x < 3; ++x)
     {
@@ -616,6 +617,8 @@ vtkAMRDualGridHelper::vtkAMRDualGridHelper()
   this->DataTypeSize = 8;
   this->ArrayName = 0;
   this->EnableDegenerateCells = 1;
+  this->DeferGhostExchange = 0;
+  this->GhostExchangePending = 0;
   this->NumberOfBlocksInThisProcess = 0;
   for (ii = 0; ii < 3; ++ii)
     {
@@ -658,6 +661,7 @@ vtkAMRDualGridHelper::~vtkAMRDualGridHelper()
 void vtkAMRDualGridHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeferGhostExchange: " << this->DeferGhostExchange << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1155,6 +1159,10 @@ int vtkAMRDualGridHelper::ClaimBlockSharedRegion(
       dreg.ReceivingRegion[2] = regionZ;
       dreg.SourceBlock = bestBlock;
       this->DegenerateRegionQueue.push_back(dreg);
+      if (block->Image)
+        {
+        block->RemoteGhostFlag = 1;
+        }
       }
     else
       {
@@ -1779,13 +1787,39 @@ int vtkAMRDualGridHelper::Initialize(vtkHierarchicalBoxDataSet* input,
   this->AssignSharedRegions();
   
   // Copy regions on level boundaries between processes.
-  this->ProcessDegenerateRegionQueue();
+  // The caller may want to do this later, while it processes the blocks
+  // that do not depend on remote values.
+  this->GhostExchangePending = 1;
+  if ( ! this->DeferGhostExchange)
+    {
+    this->FinishGhostExchange();
+    }
   
   // Setup faces for seeding connectivity between blocks.
   //this->CreateFaces();
   
   return VTK_OK;
 }
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::FinishGhostExchange()
+{
+  if (this->GhostExchangePending)
+    {
+    this->GhostExchangePending = 0;
+    this->ProcessDegenerateRegionQueue();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Only meaningful after Initialize.  Until FinishGhostExchange returns,
+// the degenerate regions of these blocks hold stale values.
+int vtkAMRDualGridHelper::BlockNeedsRemoteGhostValues(
+  vtkAMRDualGridHelperBlock* block)
+{
+  return block->RemoteGhostFlag;
+}
+
+//----------------------------------------------------------------------------
 void vtkAMRDualGridHelper::ShareBlocks()
 {
   if (this->Controller == 0 || this->Controller->GetNumberOfProcesses() == 1)
@@ -1818,12 +1852,13 @@ void vtkAMRDualGridHelper::ShareBlocks()
 }
 void vtkAMRDualGridHelper::AllocateMessageBuffer(int maxSize)
 {
-  if (this->MessageBufferLength < maxSize)
+  if (this->MessageBuffer && this->MessageBufferLength >= maxSize)
     {
-    if (this->MessageBuffer)
-      {
-      delete [] this->MessageBuffer;
-      }
+    return;
+    }
+  if (this->MessageBuffer)
+    {
+    delete [] this->MessageBuffer;
     }
   this->MessageBufferLength = maxSize + 100; // Extra to avoid reallocating.
   this->MessageBuffer = new unsigned char[this->MessageBufferLength];
@@ -46,6 +46,15 @@ public:
 
   void SetEnableMultiProcessCommunication(int v);
 
+  // Description:
+  // When this is set, Initialize does not wait for the ghost values that
+  // other processes send for degenerate regions.  Blocks that do not need
+  // them (see BlockNeedsRemoteGhostValues) can be processed while
+  // FinishGhostExchange runs.  Set this before you call initialize.
+  void SetDeferGhostExchange(int v) { this->DeferGhostExchange = v;}
+  void FinishGhostExchange();
+  int BlockNeedsRemoteGhostValues(vtkAMRDualGridHelperBlock* block);
+
   int                       Initialize(vtkHierarchicalBoxDataSet* input,
                                        const char* arrayName);
   const double*             GetGlobalOrigin() { return this->GlobalOrigin;}
@@ -113,6 +122,9 @@ private:
   vtkstd::vector<vtkAMRDualGridHelperLevel*> Levels;
 
   int EnableDegenerateCells;
+  int DeferGhostExchange;
+  int GhostExchangePending;
+
   // Degenerate regions that span processes.  We keep them in a queue
   // to communicate and process all at once.
   vtkstd::vector<vtkAMRDualGridHelperDegenerateRegion> DegenerateRegionQueue;
@@ -192,6 +204,10 @@ public:
   // We need to modify the ghost layers of level interfaces.
   unsigned char CopyFlag;
 
+  // Set on local blocks that receive degenerate region values
+  // from a block owned by another process.
+  unsigned char RemoteGhostFlag;
+
   // We have to assign cells shared between blocks so only one
   // block will process them.  Faces, edges and corners have to be
   // considered separately (Extent does not work).
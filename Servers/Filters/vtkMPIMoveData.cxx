@@ -40,6 +40,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <vtksys/ios/sstream>
+#include <vtkstd/vector>
 #define EXTENT_HEADER_SIZE 360
 
 #ifdef VTK_USE_MPI
@@ -301,6 +302,12 @@ int vtkMPIMoveData::RequestData(vtkInformation*,
     {
     if (this->Server == vtkMPIMoveData::DATA_SERVER)
       {
+      if (this->MPIMToNSocketConnection->GetAllProcessesConnected())
+        {
+        // Each process sends its data directly to the render server.
+        this->DataServerSendToRenderServer(input);
+        return 1;
+        }
       this->DataServerAllToN(input,output,
                       this->MPIMToNSocketConnection->GetNumberOfConnections());
       this->DataServerSendToRenderServer(output);
@@ -407,10 +414,17 @@ int vtkMPIMoveData::RequestData(vtkInformation*,
       if (this->Server == vtkMPIMoveData::DATA_SERVER)
         {
         // Pass Through
-        this->DataServerAllToN(input,output,
-          this->MPIMToNSocketConnection->GetNumberOfConnections());
-        this->DataServerSendToRenderServer(output);
-        output->Initialize();
+        if (this->MPIMToNSocketConnection->GetAllProcessesConnected())
+          {
+          this->DataServerSendToRenderServer(input);
+          }
+        else
+          {
+          this->DataServerAllToN(input,output,
+            this->MPIMToNSocketConnection->GetNumberOfConnections());
+          this->DataServerSendToRenderServer(output);
+          output->Initialize();
+          }
 
         // Collect to client.
         this->DataServerGatherToZero(input, output);
@@ -632,10 +646,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataSet* input,
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataSet* output)
 {
-  vtkSocketCommunicator* com =
-      this->MPIMToNSocketConnection->GetSocketCommunicator();
-
-  if (com == 0)
+  if (this->MPIMToNSocketConnection->GetNumberOfSocketCommunicators() == 0)
     {
     // Some data server may not have sockets because there are more data
     // processes than render server processes.
@@ -646,38 +657,22 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataSet* output)
   // We might be able to eliminate this marshal.
   this->ClearBuffer();
   this->MarshalDataToBuffer(output);
-
-  com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->SendBuffersToRenderServer();
 }
 
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataSet* output)
 {
-  vtkSocketCommunicator* com =
-      this->MPIMToNSocketConnection->GetSocketCommunicator();
+  int numCommunicators =
+    this->MPIMToNSocketConnection->GetNumberOfSocketCommunicators();
 
-  if (com == 0)
+  if (numCommunicators == 0)
     {
     vtkErrorMacro("All render server processes should have sockets.");
     return;
     }
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-    {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-    }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->ReceiveBuffersFromDataServer(numCommunicators);
 
   //int fixme;  // Can we avoid this?
   this->ReconstructDataFromBuffer(output);
@@ -691,10 +686,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataSet* data)
 
   if (myId == 0)
     {
-    vtkSocketCommunicator* com =
-        this->MPIMToNSocketConnection->GetSocketCommunicator();
-
-    if (com == 0)
+    if (this->MPIMToNSocketConnection->GetNumberOfSocketCommunicators() == 0)
       {
       // Proc 0 (at least) should have a communicator.
       vtkErrorMacro("Missing socket connection.");
@@ -705,10 +697,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataSet* data)
     // We might be able to eliminate this marshal.
     this->ClearBuffer();
     this->MarshalDataToBuffer(data);
-    com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-    com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
-    this->ClearBuffer();
+    this->SendBuffersToRenderServer();
     }
 }
 
@@ -719,29 +708,14 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataSet* data)
 
   if (myId == 0)
     {
-    vtkSocketCommunicator* com =
-        this->MPIMToNSocketConnection->GetSocketCommunicator();
-
-    if (com == 0)
+    if (this->MPIMToNSocketConnection->GetNumberOfSocketCommunicators() == 0)
       {
       vtkErrorMacro("All render server processes should have sockets.");
       return;
       }
 
-    this->ClearBuffer();
-    com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-    this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-    com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    // Compute additional buffer information.
-    this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-    this->BufferTotalLength = 0;
-    for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-      {
-      this->BufferOffsets[idx] = this->BufferTotalLength;
-      this->BufferTotalLength += this->BufferLengths[idx];
-      }
-    this->Buffers = new char[this->BufferTotalLength];
-    com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+    // The first communicator is connected to data server process 0.
+    this->ReceiveBuffersFromDataServer(1);
 
     //int fixme;  // Can we avoid this?
     this->ReconstructDataFromBuffer(data);
@@ -749,6 +723,65 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataSet* data)
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::SendBuffersToRenderServer()
+{
+  // The connection takes ownership of the buffers.
+  this->MPIMToNSocketConnection->SendBuffersAsynchronously(
+    this->NumberOfBuffers, this->BufferLengths, this->Buffers);
+  this->BufferLengths = 0;
+  this->Buffers = 0;
+  this->ClearBuffer();
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ReceiveBuffersFromDataServer(int numCommunicators)
+{
+  vtkstd::vector<int> numBuffers(numCommunicators, 0);
+  vtkstd::vector<vtkIdType*> lengths(numCommunicators);
+  vtkstd::vector<char*> buffers(numCommunicators);
+  int idx;
+
+  this->ClearBuffer();
+  for (idx = 0; idx < numCommunicators; ++idx)
+    {
+    if (!this->MPIMToNSocketConnection->ReceiveBuffers(
+          idx, numBuffers[idx], lengths[idx], buffers[idx]))
+      {
+      vtkErrorMacro("Failed to receive the data of the data server.");
+      }
+    this->NumberOfBuffers += numBuffers[idx];
+    }
+
+  // Concatenate the buffers of all the data server processes.
+  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
+  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
+  int buffer = 0;
+  for (idx = 0; idx < numCommunicators; ++idx)
+    {
+    for (int i = 0; i < numBuffers[idx]; ++i, ++buffer)
+      {
+      this->BufferLengths[buffer] = lengths[idx][i];
+      this->BufferOffsets[buffer] = this->BufferTotalLength;
+      this->BufferTotalLength += lengths[idx][i];
+      }
+    }
+  this->Buffers = new char[this->BufferTotalLength];
+  vtkIdType offset = 0;
+  for (idx = 0; idx < numCommunicators; ++idx)
+    {
+    vtkIdType length = 0;
+    for (int i = 0; i < numBuffers[idx]; ++i)
+      {
+      length += lengths[idx][i];
+      }
+    memcpy(this->Buffers + offset, buffers[idx], length);
+    offset += length;
+    delete [] lengths[idx];
+    delete [] buffers[idx];
+    }
+}
+
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerSendToClient(vtkDataSet* output)
 {
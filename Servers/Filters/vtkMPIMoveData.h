@@ -131,6 +131,16 @@ protected:
   void DataServerSendToClient(vtkDataSet* output);
   void ClientReceiveFromDataServer(vtkDataSet* output);
 
+  // Description:
+  // Hand the marshaled buffers to the connection, which sends them to the
+  // render server while this process goes on.
+  void SendBuffersToRenderServer();
+
+  // Description:
+  // Receive the buffers from the first numCommunicators data server
+  // processes connected to this process, one after the other.
+  void ReceiveBuffersFromDataServer(int numCommunicators);
+
   int        NumberOfBuffers;
   vtkIdType* BufferLengths;
   vtkIdType* BufferOffsets;
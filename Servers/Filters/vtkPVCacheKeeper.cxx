@@ -50,6 +50,7 @@ vtkPVCacheKeeper::vtkPVCacheKeeper()
   this->Cache = new vtkPVCacheKeeper::vtkCacheMap();
   this->CacheTime = 0.0;
   this->CachingEnabled = true; 
+  this->ClearCacheWhenInputModified = false;
   this->CacheSizeKeeper = 0;
 
   vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
@@ -190,6 +191,10 @@ int vtkPVCacheKeeper::RequestData(vtkInformation* vtkNotUsed(reqInfo),
 void vtkPVCacheKeeper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheTime: " << this->CacheTime << endl;
+  os << indent << "CachingEnabled: " << this->CachingEnabled << endl;
+  os << indent << "ClearCacheWhenInputModified: "
+    << this->ClearCacheWhenInputModified << endl;
 }
 
 
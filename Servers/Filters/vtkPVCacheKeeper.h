@@ -20,6 +20,10 @@
 // then this filter shuts the update request, otherwise propagates the update
 // and then cache the result for later use.  The current time step is set using
 // SetCacheTime().
+// When ClearCacheWhenInputModified is on, the cache is also cleared as soon
+// as the pipeline upstream of this filter is modified, so that the cache can
+// be left enabled for data that is edited interactively (e.g. the LOD
+// geometry of a representation).
 // .SECTION See Also
 // vtkPVCacheKeeperPipeline
 
@@ -60,6 +64,14 @@ public:
   vtkGetMacro(CachingEnabled, bool);
   vtkBooleanMacro(CachingEnabled, bool);
 
+  // Description:
+  // Get/Set if the cache is cleared when the pipeline upstream of this
+  // filter is modified.  Changing the cache time does not clear the cache.
+  // Default is false.
+  vtkSetMacro(ClearCacheWhenInputModified, bool);
+  vtkGetMacro(ClearCacheWhenInputModified, bool);
+  vtkBooleanMacro(ClearCacheWhenInputModified, bool);
+
   // Description:
   // Get/Set the cache size keeper. The cacher
   // reports its cache size to this keeper, if any.
@@ -83,6 +95,7 @@ protected:
   bool SaveData(vtkDataObject*);
 
   bool CachingEnabled;
+  bool ClearCacheWhenInputModified;
   double CacheTime;
   vtkCacheSizeKeeper* CacheSizeKeeper;
 
@@ -14,14 +14,48 @@
 =========================================================================*/
 #include "vtkPVCacheKeeperPipeline.h"
 
+#include "vtkAlgorithmOutput.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCacheKeeper.h"
 
 vtkStandardNewMacro(vtkPVCacheKeeperPipeline);
 vtkCxxRevisionMacro(vtkPVCacheKeeperPipeline, "$Revision$");
+
+//----------------------------------------------------------------------------
+// Returns the latest modification of the algorithms upstream of (and
+// including) the given one.  Cache keepers are modified when their cache time
+// changes, which does not change the data that goes through them, so their
+// own MTime is skipped.
+static unsigned long vtkPVCacheKeeperPipelineGetContentMTime(
+  vtkAlgorithm* algorithm)
+{
+  unsigned long mtime = 0;
+  if (!algorithm->IsA("vtkPVCacheKeeper"))
+    {
+    mtime = algorithm->GetMTime();
+    }
+  for (int i=0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    for (int j=0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+      {
+      vtkAlgorithmOutput* input = algorithm->GetInputConnection(i, j);
+      if (input && input->GetProducer())
+        {
+        unsigned long inputMTime =
+          vtkPVCacheKeeperPipelineGetContentMTime(input->GetProducer());
+        if (inputMTime > mtime)
+          {
+          mtime = inputMTime;
+          }
+        }
+      }
+    }
+  return mtime;
+}
 //----------------------------------------------------------------------------
 vtkPVCacheKeeperPipeline::vtkPVCacheKeeperPipeline()
 {
+  this->InputPipelineMTime = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -56,6 +90,37 @@ int vtkPVCacheKeeperPipeline::ForwardUpstream(vtkInformation* request)
   return this->Superclass::ForwardUpstream(request);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVCacheKeeperPipeline::ComputePipelineMTime(
+  vtkInformation* request, vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec, int requestFromOutputPort,
+  unsigned long* mtime)
+{
+  if (!this->Superclass::ComputePipelineMTime(request, inInfoVec, outInfoVec,
+      requestFromOutputPort, mtime))
+    {
+    return 0;
+    }
+
+  vtkPVCacheKeeper* keeper = vtkPVCacheKeeper::SafeDownCast(this->Algorithm);
+  if (!keeper || !keeper->GetClearCacheWhenInputModified())
+    {
+    return 1;
+    }
+
+  // Changing the cache time of this keeper, or of any keeper upstream, does
+  // not change the data, so these changes must not clear the cache.
+  unsigned long inputMTime =
+    vtkPVCacheKeeperPipelineGetContentMTime(this->Algorithm);
+
+  if (inputMTime != this->InputPipelineMTime)
+    {
+    keeper->RemoveAllCaches();
+    this->InputPipelineMTime = inputMTime;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCacheKeeperPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
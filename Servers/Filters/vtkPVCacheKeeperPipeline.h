@@ -14,7 +14,9 @@
 =========================================================================*/
 // .NAME vtkPVCacheKeeperPipeline
 // .SECTION Description
-//
+// Executive for vtkPVCacheKeeper.  It shunts upstream updates when the
+// current cache time is cached, and clears the cache when the input
+// pipeline is modified if the keeper asks for it.
 
 #ifndef __vtkPVCacheKeeperPipeline_h
 #define __vtkPVCacheKeeperPipeline_h
@@ -36,6 +38,19 @@ protected:
 
   virtual int ForwardUpstream(int i, int j, vtkInformation* request);
   virtual int ForwardUpstream(vtkInformation* request);
+
+  // Description:
+  // Overridden to clear the cache of the keeper when the pipeline upstream
+  // of it is modified and ClearCacheWhenInputModified is on.  Changes to the
+  // cache time of this keeper or of other keepers upstream are ignored.
+  virtual int ComputePipelineMTime(vtkInformation* request,
+                                   vtkInformationVector** inInfoVec,
+                                   vtkInformationVector* outInfoVec,
+                                   int requestFromOutputPort,
+                                   unsigned long* mtime);
+
+  unsigned long InputPipelineMTime;
+
 private:
   vtkPVCacheKeeperPipeline(const vtkPVCacheKeeperPipeline&); // Not implemented
   void operator=(const vtkPVCacheKeeperPipeline&); // Not implemented
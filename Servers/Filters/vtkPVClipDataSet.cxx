@@ -14,7 +14,11 @@
 =========================================================================*/
 #include "vtkPVClipDataSet.h"
 
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
 vtkCxxRevisionMacro(vtkPVClipDataSet, "$Revision$");
 vtkStandardNewMacro(vtkPVClipDataSet);
@@ -31,6 +35,43 @@ vtkPVClipDataSet::vtkPVClipDataSet(vtkImplicitFunction *vtkNotUsed(cf))
 vtkPVClipDataSet::~vtkPVClipDataSet()
 {
 }
+//----------------------------------------------------------------------------
+int vtkPVClipDataSet::RequestUpdateExtent(vtkInformation* request,
+                                          vtkInformationVector** inputVector,
+                                          vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector, 
+                                             outputVector))
+    {
+    return 0;
+    }
+
+  vtkPlane* plane = vtkPlane::SafeDownCast(this->ClipFunction);
+  if (!plane || plane->GetTransform() || this->GenerateClippedOutput)
+    {
+    return 1;
+    }
+
+  double value = this->UseValueAsOffset ? this->Value : 0.0;
+  double roi[8];
+  plane->GetNormal(roi);
+  plane->GetOrigin(roi+3);
+  if (this->InsideOut)
+    {
+    roi[6] = -VTK_DOUBLE_MAX;
+    roi[7] = value;
+    }
+  else
+    {
+    roi[6] = value;
+    roi[7] = VTK_DOUBLE_MAX;
+    }
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST(),
+              roi, 8);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
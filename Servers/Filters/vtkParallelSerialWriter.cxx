@@ -23,6 +23,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkProcessGroup.h"
 #include "vtkProcessModule.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
@@ -58,6 +59,11 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
   this->WriteAllTimeSteps = 0;
   this->NumberOfTimeSteps = 0;
   this->CurrentTimeIndex = 0;
+
+  this->NumberOfFiles = 1;
+  this->GroupController = 0;
+  this->GroupNumberOfFiles = 1;
+  this->Group = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -68,6 +74,10 @@ vtkParallelSerialWriter::~vtkParallelSerialWriter()
   this->SetFileName(0);
   this->SetPreGatherHelper(0);
   this->SetPostGatherHelper(0);
+  if (this->GroupController)
+    {
+    this->GroupController->Delete();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -218,10 +228,63 @@ void vtkParallelSerialWriter::WriteATimestep(vtkDataObject* input)
 }
 
 //----------------------------------------------------------------------------
-void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* input)
+vtkMultiProcessController* vtkParallelSerialWriter::GetGroupController(
+  int& group)
 {
   vtkMultiProcessController* controller = 
     vtkProcessModule::GetProcessModule()->GetController();
+  int numProcs = controller->GetNumberOfProcesses();
+  int numFiles = 
+    (this->NumberOfFiles < numProcs ? this->NumberOfFiles : numProcs);
+  if (numFiles <= 1)
+    {
+    group = 0;
+    return controller;
+    }
+
+  if (!this->GroupController || this->GroupNumberOfFiles != numFiles)
+    {
+    if (this->GroupController)
+      {
+      this->GroupController->Delete();
+      this->GroupController = 0;
+      }
+    // Node p is in group p*numFiles/numProcs. Creating a sub-controller is
+    // collective, so every node creates all the groups.
+    for (int g = 0; g < numFiles; g++)
+      {
+      int first = (g*numProcs + numFiles - 1) / numFiles;
+      int last = ((g+1)*numProcs + numFiles - 1) / numFiles;
+      vtkProcessGroup* processGroup = vtkProcessGroup::New();
+      processGroup->Initialize(controller);
+      processGroup->RemoveAllProcessIds();
+      for (int p = first; p < last; p++)
+        {
+        processGroup->AddProcessId(p);
+        }
+      vtkMultiProcessController* subController = 
+        controller->CreateSubController(processGroup);
+      processGroup->Delete();
+      if (subController)
+        {
+        this->GroupController = subController;
+        this->Group = g;
+        }
+      }
+    this->GroupNumberOfFiles = numFiles;
+    }
+
+  group = this->Group;
+  return this->GroupController;
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* input)
+{
+  int group;
+  vtkMultiProcessController* controller = this->GetGroupController(group);
+  bool multipleFiles = 
+    (controller != vtkProcessModule::GetProcessModule()->GetController());
   
   vtkSmartPointer<vtkReductionFilter> md = vtkSmartPointer<vtkReductionFilter>::New();
   md->SetController(controller);
@@ -247,7 +310,9 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
   if (controller->GetLocalProcessId() == 0)
     {
     vtkDataObject* output = md->GetOutputDataObject(0);
-    if (vtkDataSet::SafeDownCast(output) == 0 || 
+    // A group without cells still writes its file, so that the files of
+    // the groups are numbered without gaps.
+    if (multipleFiles || vtkDataSet::SafeDownCast(output) == 0 ||
       vtkDataSet::SafeDownCast(output)->GetNumberOfCells() != 0)
       {
       vtkSmartPointer<vtkDataObject> outputCopy;
@@ -255,7 +320,7 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
       outputCopy->ShallowCopy(output);
 
       vtksys_ios::ostringstream fname;
-      if (this->WriteAllTimeSteps)
+      if (this->WriteAllTimeSteps || multipleFiles)
         {
         vtkstd::string path = 
           vtksys::SystemTools::GetFilenamePath(filename);
@@ -263,7 +328,16 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
           vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
         vtkstd::string ext =
           vtksys::SystemTools::GetFilenameLastExtension(filename);
-        fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+        fname << path << "/" << fnamenoext;
+        if (multipleFiles)
+          {
+          fname << "_" << group;
+          }
+        if (this->WriteAllTimeSteps)
+          {
+          fname << "." << this->CurrentTimeIndex;
+          }
+        fname << ext;
         }
       else
         {
@@ -340,4 +414,5 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfFiles: " << this->NumberOfFiles << endl;
 }
@@ -18,6 +18,8 @@
 // to work in parallel. It gathers data to the 1st node and invokes the
 // internal writer. The reduction is controlled defined by the PreGatherHelper
 // and PostGatherHelper.
+// The data can also be written to several files, each written by the first
+// node of a group of nodes (see NumberOfFiles).
 // This also makes it possible to write time-series for temporal datasets using
 // simple non-time-aware writers.
 
@@ -26,6 +28,8 @@
 
 #include "vtkDataObjectAlgorithm.h"
 
+class vtkMultiProcessController;
+
 class VTK_EXPORT vtkParallelSerialWriter : public vtkDataObjectAlgorithm
 {
 public:
@@ -94,6 +98,18 @@ public:
   vtkSetMacro(WriteAllTimeSteps, int);
   vtkBooleanMacro(WriteAllTimeSteps, int);
 
+  // Description:
+  // Get/Set the number of files written for each file name. The nodes are
+  // split into as many groups of consecutive nodes, and the data of each
+  // group is gathered to its first node, which writes it to its own file.
+  // When more than one file is written, the index of the group is appended
+  // to the file name, e.g. name_3.vtk, and every group writes its file,
+  // even when it has no cells. 1 by default, i.e. all the data is gathered
+  // to the first node, which writes nothing when there are no cells. It is
+  // clamped to the number of nodes.
+  vtkSetClampMacro(NumberOfFiles, int, 1, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfFiles, int);
+
 protected:
   vtkParallelSerialWriter();
   ~vtkParallelSerialWriter();
@@ -118,6 +134,10 @@ private:
   void SetWriterFileName(const char* fname);
   void WriteInternal();
 
+  // Returns the controller of the group of nodes of this node and the index
+  // of the group.
+  vtkMultiProcessController* GetGroupController(int& group);
+
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
 
@@ -131,6 +151,11 @@ private:
   int NumberOfTimeSteps;
   int CurrentTimeIndex;
 
+  int NumberOfFiles;
+  vtkMultiProcessController* GroupController;
+  int GroupNumberOfFiles;
+  int Group;
+
   // The name of the output file.
   char* FileName;
 };
@@ -36,6 +36,33 @@ vtkCxxRevisionMacro(vtkPythonCalculator, "$Revision$");
 vtkStandardNewMacro(vtkPythonCalculator);
 
 //----------------------------------------------------------------------------
+// Returns the given text as a python string literal.
+static vtkstd::string vtkPythonCalculatorQuote(const vtkstd::string& text)
+{
+  vtkstd::string quoted = "'";
+  for (size_t i = 0; i < text.size(); i++)
+    {
+    switch (text[i])
+      {
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\'':
+        quoted += "\\'";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      default:
+        quoted.push_back(text[i]);
+      }
+    }
+  quoted += "'";
+  return quoted;
+}
 
 //----------------------------------------------------------------------------
 vtkPythonCalculator::vtkPythonCalculator()
@@ -203,18 +230,21 @@ void vtkPythonCalculator::Exec(const char* expression,
   
   if (expression && strlen(expression) > 0)  
     {
-    fscript += "  retVal = ";
-    fscript += orgscript;
-    fscript += "\n";
+    // The expression is evaluated by paraview.vtk.expression, which writes
+    // the results of element-wise operations to the temporary arrays
+    // instead of allocating a new array for each operation.
+    fscript += "  retVal = _pv_expression.evaluate(";
+    fscript += vtkPythonCalculatorQuote(orgscript);
+    fscript += ", globals(), locals())\n";
     fscript += "  if not isinstance(retVal, ndarray):\n";
-    fscript += "    retVal = retVal * ones((inputs[0].GetNumberOf";
+    fscript += "    retVal = _pv_expression.broadcast(retVal, inputs[0].GetNumberOf";
     if (this->ArrayAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
       {
-      fscript += "Points(), 1))\n";
+      fscript += "Points())\n";
       }
     else if (this->ArrayAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS)
       {
-      fscript += "Cells(), 1))\n";
+      fscript += "Cells())\n";
       }
     fscript += "  return retVal\n";
     }
@@ -228,6 +258,7 @@ void vtkPythonCalculator::Exec(const char* expression,
   vtkstd::string runscript;
   runscript += "from paraview import vtk\n";
   runscript += "from paraview.vtk import dataset_adapter\n";
+  runscript += "from paraview.vtk import expression as _pv_expression\n";
   runscript += "from numpy import *\n";
   runscript += "from paraview.vtk.algorithms import *\n";
   runscript += "from paraview import servermanager\n";
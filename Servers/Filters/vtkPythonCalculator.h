@@ -26,6 +26,12 @@
 // valid Python variable, it has to be accessed through a dictionary called
 // arrays (i.e. arrays['array_name']). The points can be accessed using the
 // points variable.
+//
+// The arrays are not copied: the variables point to the memory of the
+// input arrays and the result is added to the output without a copy when
+// it is contiguous. Element-wise operations write to the temporary arrays
+// of the expression where possible (see paraview.vtk.expression) so that
+// evaluating an expression usually costs about one output array of memory.
 
 #ifndef __vtkPythonCalculator_h
 #define __vtkPythonCalculator_h
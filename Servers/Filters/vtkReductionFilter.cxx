@@ -317,7 +317,11 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     {
     // Note that preOutput is never the input directly (it is shallow copied at
     // the least, hence we can add arrays to it.
-    if (tablePreOutput->GetNumberOfRows() > 0)
+    // Rows may have already been gathered from other processes upstream
+    // (e.g. by a sorting vtkTableStreamer), in which case the existing
+    // process ids are retained.
+    if (tablePreOutput->GetNumberOfRows() > 0 &&
+      !tablePreOutput->GetColumnByName("vtkOriginalProcessIds"))
       {
       vtkIdTypeArray* originalProcessIds = vtkIdTypeArray::New();
       originalProcessIds->SetNumberOfComponents(1);
@@ -74,8 +74,8 @@ int vtkSelectionStreamer::RequestData(vtkInformation*,
   vtkDataObject* inputDO = vtkDataObject::GetData(inputVector[1], 0);
   vtkSelection* output = vtkSelection::GetData(outputVector, 0);
 
-  vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> > indices;
-  if (!this->DetermineIndicesToPass(inputDO, indices))
+  vtkstd::vector<vtkstd::vector<vtkIdType> > rows;
+  if (!this->DetermineRowsToPass(inputDO, rows))
     {
     return 0;
     }
@@ -87,8 +87,7 @@ int vtkSelectionStreamer::RequestData(vtkInformation*,
       {
       vtkSmartPointer<vtkSelectionNode> outputNode =
         vtkSmartPointer<vtkSelectionNode>::New();
-      this->PassBlock(outputNode, inSel,
-        indices[0].first, indices[0].second);
+      this->PassBlock(outputNode, inSel, rows[0]);
       output->AddNode(outputNode);
       }
     return 1;
@@ -106,9 +105,7 @@ int vtkSelectionStreamer::RequestData(vtkInformation*,
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
     iter->GoToNextItem(), cc++)
     {
-    vtkIdType curOffset = indices[cc].first;
-    vtkIdType curCount = indices[cc].second;
-    if (curCount > 0)
+    if (!rows[cc].empty())
       {
       vtkSelectionNode* curSel = this->LocateSelection(iter, inputSel);
       if (!curSel)
@@ -135,7 +132,7 @@ int vtkSelectionStreamer::RequestData(vtkInformation*,
         }
       else 
         {
-        hit |= this->PassBlock(curOutputSel, curSel, curOffset, curCount);
+        hit |= this->PassBlock(curOutputSel, curSel, rows[cc]);
         }
       if (hit)
         {
@@ -271,7 +268,7 @@ bool vtkSelectionStreamer::LocateSelection(vtkSelectionNode* node)
 
 //----------------------------------------------------------------------------
 bool vtkSelectionStreamer::PassBlock(vtkSelectionNode* output, vtkSelectionNode* input,
-  vtkIdType offset, vtkIdType count)
+  const vtkstd::vector<vtkIdType>& rows)
 {
   bool hit = false;
   output->GetProperties()->Copy(input->GetProperties());
@@ -283,9 +280,9 @@ bool vtkSelectionStreamer::PassBlock(vtkSelectionNode* output, vtkSelectionNode*
     outIds->SetNumberOfComponents(1);
     output->SetSelectionList(outIds);
     outIds->Delete();
-    for (vtkIdType cc=0; cc < count; cc++)
+    for (size_t cc=0; cc < rows.size(); cc++)
       {
-      vtkIdType curVal = offset + cc;
+      vtkIdType curVal = rows[cc];
       if (input->GetSelectionList()->LookupValue(vtkVariant(curVal)) != -1)
         {
         outIds->InsertNextValue(curVal);
@@ -78,8 +78,10 @@ protected:
 
   bool LocateSelection(vtkSelectionNode* node);
 
+  // Description:
+  // Passes the ids among \c rows that are selected in \c input.
   bool PassBlock(vtkSelectionNode* output, vtkSelectionNode* input,
-    vtkIdType offset, vtkIdType count);
+    const vtkstd::vector<vtkIdType>& rows);
 
   int FieldAssociation;
 private:
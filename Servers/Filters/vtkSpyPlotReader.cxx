@@ -793,6 +793,20 @@ int vtkSpyPlotReader::RequestData(
   // if they are current
   this->Map->TellReadersToCheck(this);
 
+  // A downstream cut or clip may only need the blocks that intersect a
+  // region; the others are neither decoded nor output.
+  double *roi = 0;
+  if (info->Has(vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST()) &&
+      info->Length(vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST()) == 8)
+    {
+    roi = info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST());
+    }
+  this->Map->SetRegionOfInterest(this, roi);
+  // The output also serves any slab that stops short of the nearest skipped
+  // blocks on each side of the requested one.
+  double skippedBelow = -VTK_DOUBLE_MAX;
+  double skippedAbove = VTK_DOUBLE_MAX;
+
   vtkSpyPlotBlock *block;
   vtkSpyPlotBlockIterator *blockIterator;
   if(this->DistributeFiles)
@@ -889,8 +903,23 @@ int vtkSpyPlotReader::RequestData(
         needTracers = 0;
         }
 
-      int dims[3];
       int blockID = blockIterator->GetBlockID();
+      if (roi && !uniReader->IsBlockInRegionOfInterest(blockID))
+        {
+        double range[2];
+        uniReader->GetBlockRegionOfInterestRange(blockID, range);
+        if (range[0] > roi[7])
+          {
+          skippedAbove = (range[0] < skippedAbove) ? range[0] : skippedAbove;
+          }
+        else
+          {
+          skippedBelow = (range[1] > skippedBelow) ? range[1] : skippedBelow;
+          }
+        continue;
+        }
+
+      int dims[3];
       int level = 0;
       int hasBadGhostCells;
       int realExtents[6];
@@ -951,6 +980,26 @@ int vtkSpyPlotReader::RequestData(
     delete blockIterator;
     }
 
+    if (roi)
+      {
+      double dataRoi[8];
+      memcpy(dataRoi, roi, 6 * sizeof(double));
+      dataRoi[6] = -VTK_DOUBLE_MAX;
+      dataRoi[7] = VTK_DOUBLE_MAX;
+      if (skippedBelow > -VTK_DOUBLE_MAX)
+        {
+        double middle = 0.5 * (roi[6] + skippedBelow);
+        dataRoi[6] = (middle > skippedBelow) ? middle : roi[6];
+        }
+      if (skippedAbove < VTK_DOUBLE_MAX)
+        {
+        double middle = 0.5 * (roi[7] + skippedAbove);
+        dataRoi[7] = (middle < skippedAbove) ? middle : roi[7];
+        }
+      cds->GetInformation()->Set(vtkDataObject::DATA_REGION_OF_INTEREST(),
+                                 dataRoi, 8);
+      }
+
     // At this point, each processor has its own blocks
     // They have to exchange the blocks they have get a unique id for
     // each block over the all dataset.
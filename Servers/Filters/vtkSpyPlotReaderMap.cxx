@@ -49,3 +49,14 @@ void vtkSpyPlotReaderMap::TellReadersToCheck(vtkSpyPlotReader *parent)
     this->GetReader(it, parent)->SetNeedToCheck(1);
     }
 }
+
+void vtkSpyPlotReaderMap::SetRegionOfInterest(vtkSpyPlotReader *parent,
+                                              const double *roi)
+{
+  MapOfStringToSPCTH::iterator it;
+  MapOfStringToSPCTH::iterator end=this->Files.end();
+  for (it=this->Files.begin();it!=end; ++it)
+    {
+    this->GetReader(it, parent)->SetRegionOfInterest(roi);
+    }
+}
@@ -41,6 +41,7 @@ public:
   vtkSpyPlotUniReader* GetReader(MapOfStringToSPCTH::iterator& it, 
                                  vtkSpyPlotReader* parent);
   void TellReadersToCheck(vtkSpyPlotReader *parent);
+  void SetRegionOfInterest(vtkSpyPlotReader *parent, const double *roi);
 };
 
 
@@ -8,6 +8,7 @@
 #include "vtkIntArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkByteSwap.h"
+#include "vtkMultiThreader.h"
 #include <vtkstd/vector>
 #include <vtksys/ios/sstream>
 //=============================================================================
@@ -78,6 +79,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
   this->DataTypeChanged = 0;
   this->GeomTimeStep = -1; // Indicate that geometry will have to be loaded
   this->NeedToCheck = 1; // Indicates non-geometric data needs to be checked
+  this->HasRegionOfInterest = 0;
   if ( !this->HaveInformation ) { vtkDebugMacro( << __LINE__ << " " << this << " Read: " << this->HaveInformation ); }
 }
 
@@ -592,6 +594,269 @@ int vtkSpyPlotUniReader::ReadInformation()
 }
 
 
+//-----------------------------------------------------------------------------
+// Assemble a big-endian float directly from the byte stream. This avoids a
+// memcpy and a byte swap call per value and keeps the loops below simple
+// enough for the compiler to unroll and vectorize.
+static inline float vtkSpyPlotUniReaderReadFloatBE(const unsigned char* p)
+{
+  union
+  {
+    vtkTypeUInt32 I;
+    float F;
+  } u;
+  u.I = (static_cast<vtkTypeUInt32>(p[0]) << 24) |
+        (static_cast<vtkTypeUInt32>(p[1]) << 16) |
+        (static_cast<vtkTypeUInt32>(p[2]) << 8) |
+         static_cast<vtkTypeUInt32>(p[3]);
+  return u.F;
+}
+
+//-----------------------------------------------------------------------------
+// Returns 1 on success and 0 when the input would overflow the output or
+// ends in the middle of a run. Does not report errors itself so that it can
+// be called from the decoding threads.
+template<class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(const unsigned char* in, 
+                                           int inSize, t* out, 
+                                           int outSize, t scale=1)
+{
+  const unsigned char* ptmp = in;
+  const unsigned char* pend = in + inSize;
+  t* optr = out;
+  t* oend = out + outSize;
+
+  /* Run-length decode */
+  while ((optr < oend) && (ptmp < pend))
+    {
+    // Okay get the run length
+    int runLength = *ptmp;
+    ptmp ++;
+    if (runLength < 128)
+      {
+      // A run of one repeated value
+      if ( optr + runLength > oend || ptmp + 4 > pend )
+        {
+        return 0;
+        }
+      t val = static_cast<t>(vtkSpyPlotUniReaderReadFloatBE(ptmp)*scale);
+      ptmp += 4;
+      t* rend = optr + runLength;
+      for (; optr < rend; ++optr)
+        {
+        *optr = val;
+        }
+      }
+    else  // runLength >= 128
+      {
+      // A run of literal values
+      runLength -= 128;
+      if ( optr + runLength > oend || ptmp + 4*runLength > pend )
+        {
+        return 0;
+        }
+      t* rend = optr + runLength;
+      for (; optr < rend; ++optr, ptmp += 4)
+        {
+        *optr = static_cast<t>(vtkSpyPlotUniReaderReadFloatBE(ptmp)*scale);
+        }
+      }
+    } // while
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+// One compressed ij plane of a cell field: its location in the read buffer
+// and where it decodes to.
+struct vtkSpyPlotUniReaderDecodeTask
+{
+  size_t InOffset;
+  int InSize;
+  void* Out;
+  int OutSize;
+};
+
+struct vtkSpyPlotUniReaderDecodeInfo
+{
+  const vtkstd::vector<vtkSpyPlotUniReaderDecodeTask>* Tasks;
+  const unsigned char* Buffer;
+  int ToUnsignedChar;
+  vtkstd::vector<int> Status;
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkSpyPlotUniReaderDecodeThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* ti = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkSpyPlotUniReaderDecodeInfo* info = 
+    static_cast<vtkSpyPlotUniReaderDecodeInfo*>(ti->UserData);
+  const vtkstd::vector<vtkSpyPlotUniReaderDecodeTask>& tasks = *info->Tasks;
+
+  // Planes of a dump are of similar size, so interleave them statically.
+  size_t cc;
+  for ( cc = ti->ThreadID; cc < tasks.size(); cc += ti->NumberOfThreads )
+    {
+    const vtkSpyPlotUniReaderDecodeTask& task = tasks[cc];
+    int res;
+    if ( info->ToUnsignedChar )
+      {
+      res = ::vtkSpyPlotUniReaderRunLengthDataDecode(
+        info->Buffer + task.InOffset, task.InSize, 
+        static_cast<unsigned char*>(task.Out), task.OutSize,
+        static_cast<unsigned char>(255));
+      }
+    else
+      {
+      res = ::vtkSpyPlotUniReaderRunLengthDataDecode(
+        info->Buffer + task.InOffset, task.InSize, 
+        static_cast<float*>(task.Out), task.OutSize);
+      }
+    if ( !res )
+      {
+      info->Status[ti->ThreadID] = 0;
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-----------------------------------------------------------------------------
+// Decode all the planes of one variable, spreading them over the available
+// processors when there is enough work to go around.
+static int vtkSpyPlotUniReaderDecodePlanes(
+  const vtkstd::vector<vtkSpyPlotUniReaderDecodeTask>& tasks,
+  const vtkstd::vector<unsigned char>& buffer, int toUnsignedChar)
+{
+  if ( tasks.empty() )
+    {
+    return 1;
+    }
+  vtkSpyPlotUniReaderDecodeInfo info;
+  info.Tasks = &tasks;
+  info.Buffer = &*buffer.begin();
+  info.ToUnsignedChar = toUnsignedChar;
+
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  int numThreads = threader->GetNumberOfThreads();
+  if ( static_cast<size_t>(numThreads) > tasks.size() )
+    {
+    numThreads = static_cast<int>(tasks.size());
+    }
+  info.Status.resize(numThreads, 1);
+  if ( numThreads > 1 )
+    {
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetSingleMethod(vtkSpyPlotUniReaderDecodeThread, &info);
+    threader->SingleMethodExecute();
+    }
+  else
+    {
+    vtkMultiThreader::ThreadInfo ti;
+    ti.ThreadID = 0;
+    ti.NumberOfThreads = 1;
+    ti.UserData = &info;
+    vtkSpyPlotUniReaderDecodeThread(&ti);
+    }
+  threader->Delete();
+
+  int cc;
+  for ( cc = 0; cc < numThreads; ++ cc )
+    {
+    if ( !info.Status[cc] )
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::SetRegionOfInterest(const double* roi)
+{
+  if ( !roi )
+    {
+    if ( this->HasRegionOfInterest )
+      {
+      this->HasRegionOfInterest = 0;
+      this->NeedToCheck = 1;
+      }
+    return;
+    }
+  if ( this->HasRegionOfInterest &&
+       !memcmp(this->RegionOfInterest, roi, 8 * sizeof(double)) )
+    {
+    return;
+    }
+  memcpy(this->RegionOfInterest, roi, 8 * sizeof(double));
+  this->HasRegionOfInterest = 1;
+  this->NeedToCheck = 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::ComputeBlockRegionOfInterestRange(
+  vtkSpyPlotBlock* b, double range[2])
+{
+  const double* n = this->RegionOfInterest;
+  const double* o = this->RegionOfInterest + 3;
+  double bounds[6];
+  b->GetBounds(bounds);
+  double fmin = VTK_DOUBLE_MAX;
+  double fmax = -VTK_DOUBLE_MAX;
+  int i, j, k;
+  for ( k = 4; k < 6; ++ k )
+    {
+    for ( j = 2; j < 4; ++ j )
+      {
+      for ( i = 0; i < 2; ++ i )
+        {
+        double f = n[0] * (bounds[i] - o[0]) + 
+                   n[1] * (bounds[j] - o[1]) + 
+                   n[2] * (bounds[k] - o[2]);
+        fmin = (f < fmin) ? f : fmin;
+        fmax = (f > fmax) ? f : fmax;
+        }
+      }
+    }
+  range[0] = fmin;
+  range[1] = fmax;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::BlockIntersectsRegionOfInterest(vtkSpyPlotBlock* b)
+{
+  if ( !this->HasRegionOfInterest )
+    {
+    return 1;
+    }
+  // The region is a slab between two planes, so the block intersects it
+  // unless all of its corners lie on the same side of the slab.
+  double range[2];
+  this->ComputeBlockRegionOfInterestRange(b, range);
+  return (range[1] >= this->RegionOfInterest[6] && 
+          range[0] <= this->RegionOfInterest[7]);
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::IsBlockInRegionOfInterest(int block)
+{
+  vtkSpyPlotBlock* b = this->GetBlock(block);
+  return b ? this->BlockIntersectsRegionOfInterest(b) : 0;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::GetBlockRegionOfInterestRange(int block,
+                                                       double range[2])
+{
+  vtkSpyPlotBlock* b = this->GetBlock(block);
+  if ( !b || !this->HasRegionOfInterest )
+    {
+    return 0;
+    }
+  this->ComputeBlockRegionOfInterestRange(b, range);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::MakeCurrent()
 {
@@ -724,6 +989,31 @@ int vtkSpyPlotUniReader::MakeCurrent()
 
   dump = this->CurrentTimeStep;
   dp = this->DataDumps+dump;
+
+  // The block layout is shared by all the variables of this dump, so look
+  // it up once instead of once per variable.
+  vtkstd::vector<int> allocatedBlocks;
+  int blockIdx;
+  for ( blockIdx = 0; blockIdx < dp->NumberOfBlocks; ++ blockIdx )
+    {
+    if ( this->Blocks[blockIdx].IsAllocated() )
+      {
+      allocatedBlocks.push_back(blockIdx);
+      }
+    }
+  if ( static_cast<int>(allocatedBlocks.size()) != dp->ActualNumberOfBlocks )
+    {
+    vtkErrorMacro( "Number of allocated blocks does not match the dump" );
+    return 0;
+    }
+  vtkstd::vector<unsigned char> requiredBlocks(allocatedBlocks.size(), 1);
+  size_t rb;
+  for ( rb = 0; rb < allocatedBlocks.size(); ++ rb )
+    {
+    requiredBlocks[rb] = static_cast<unsigned char>(
+      this->BlockIntersectsRegionOfInterest(this->Blocks+allocatedBlocks[rb]));
+    }
+  vtkstd::vector<vtkSpyPlotUniReaderDecodeTask> decodeTasks;
   
   int fieldCnt;
   for ( fieldCnt = 0; fieldCnt < dp->NumVars; ++ fieldCnt )
@@ -739,6 +1029,15 @@ int vtkSpyPlotUniReader::MakeCurrent()
       vtkDebugMacro( " *** Looks like variable: " << var->Name 
                      << " is already loaded" );
       blocksExists = 1;
+      // A larger region of interest may need blocks skipped before
+      for ( rb = 0; rb < allocatedBlocks.size(); ++ rb )
+        {
+        if ( requiredBlocks[rb] && !var->DataBlocks[rb] )
+          {
+          blocksExists = 0;
+          break;
+          }
+        }
       }
     // Did we create data blocks that we do not need any more
     if ( !this->CellArraySelection->ArrayIsEnabled(var->Name) ||
@@ -752,8 +1051,11 @@ int vtkSpyPlotUniReader::MakeCurrent()
         for ( dataBlock = 0; 
               dataBlock < dp->ActualNumberOfBlocks; ++ dataBlock )
           {
-          var->DataBlocks[dataBlock]->Delete();
-          var->DataBlocks[dataBlock] = 0;
+          if ( var->DataBlocks[dataBlock] )
+            {
+            var->DataBlocks[dataBlock]->Delete();
+            var->DataBlocks[dataBlock] = 0;
+            }
           }
         delete [] var->DataBlocks;
         var->DataBlocks = 0;
@@ -792,89 +1094,87 @@ int vtkSpyPlotUniReader::MakeCurrent()
     //vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars 
     // << " [" << var->Name << "]" );
     //vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
+    // Read the compressed planes of every block first; the stream has to
+    // be walked sequentially, but the planes decode independently.
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
+    int toUnsignedChar = 
+      (this->DownConvertVolumeFraction && this->IsVolumeFraction(var));
     int numBytes;
-    int block;
-    int actualBlockId = 0;
-    for ( block = 0; block < dp->NumberOfBlocks; ++ block )
+    size_t bufferSize = 0;
+    decodeTasks.clear();
+    int actualBlockId;
+    for ( actualBlockId = 0; 
+          actualBlockId < static_cast<int>(allocatedBlocks.size());
+          ++ actualBlockId )
       {
-      vtkSpyPlotBlock* bk = this->Blocks+block;
-      if ( bk->IsAllocated() )
+      vtkSpyPlotBlock* bk = this->Blocks + allocatedBlocks[actualBlockId];
+      int zax;
+      if ( !requiredBlocks[actualBlockId] || var->DataBlocks[actualBlockId] )
         {
-        vtkFloatArray* floatArray = 0;
-        vtkUnsignedCharArray* unsignedCharArray = 0;
-        vtkDataArray* dataArray = 0;
-        if ( this->CellArraySelection->ArrayIsEnabled(var->Name) &&
-             !var->DataBlocks[actualBlockId] )
+        // Outside of the region of interest or already decoded: skip it
+        for ( zax = 0; zax < bk->GetDimension(2); ++ zax )
           {
-          if ( this->DownConvertVolumeFraction && this->IsVolumeFraction(var) )
-            {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-            }
-          else
-            {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
-            }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(bk->GetDimension(0) * 
-                                       bk->GetDimension(1) * 
-                                       bk->GetDimension(2));
-          dataArray->SetName(var->Name);
-          //vtkDebugMacro( "*** Create data array: " 
-          // << dataArray->GetNumberOfTuples() );
-          }
-        int zax;
-        int bdims[3];
-        bk->GetDimensions(bdims);
-        for ( zax = 0; zax < bdims[2]; ++ zax )
-          { 
-          int planeSize = bdims[0] * bdims[1];
-          if ( !spis.ReadInt32s(&numBytes, 1) )
+          if ( !spis.ReadInt32s(&numBytes, 1) || numBytes < 0 )
             {
             vtkErrorMacro( "Problem reading the number of bytes" );
             return 0;
             }
-          if ( static_cast<int>(arrayBuffer.size()) < numBytes )
-            {
-            arrayBuffer.resize(numBytes);
-            }
-          if ( !spis.ReadString(&*arrayBuffer.begin(), numBytes) )
-            {
-            vtkErrorMacro( "Problem reading the bytes" );
-            return 0;
-            }
-          if ( floatArray )
-            {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if ( !this->RunLengthDataDecode(&*arrayBuffer.begin(), 
-                                            numBytes, ptr, planeSize) )
-              {
-              vtkErrorMacro( "Problem RLD decoding float data array" );
-              return 0;
-              }
-            }
-          if ( unsignedCharArray )
-            {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if ( !this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes,
-                                            ptr, planeSize) )
-              {
-              vtkErrorMacro( "Problem RLD decoding unsigned char data array" );
-              return 0;
-              }
-            }
+          spis.Seek(numBytes, true);
           }
-        if ( dataArray )
+        continue;
+        }
+      vtkDataArray* dataArray;
+      if ( toUnsignedChar )
+        {
+        dataArray = vtkUnsignedCharArray::New();
+        }
+      else
+        {
+        dataArray = vtkFloatArray::New();
+        }
+      dataArray->SetNumberOfComponents(1);
+      dataArray->SetNumberOfTuples(bk->GetTotalSize());
+      dataArray->SetName(var->Name);
+      var->DataBlocks[actualBlockId] = dataArray;
+      var->GhostCellsFixed[actualBlockId] = 0;
+
+      int planeSize = bk->GetDimension(0) * bk->GetDimension(1);
+      for ( zax = 0; zax < bk->GetDimension(2); ++ zax )
+        { 
+        if ( !spis.ReadInt32s(&numBytes, 1) || numBytes < 0 )
           {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro( " " << dataArray << " initialized: " 
-                         << dataArray->GetName() );
-          actualBlockId++;
+          vtkErrorMacro( "Problem reading the number of bytes" );
+          return 0;
           }
+        if ( arrayBuffer.size() < bufferSize + numBytes )
+          {
+          arrayBuffer.resize(2 * (bufferSize + numBytes));
+          }
+        if ( numBytes && 
+             !spis.ReadString(&arrayBuffer[bufferSize], numBytes) )
+          {
+          vtkErrorMacro( "Problem reading the bytes" );
+          return 0;
+          }
+        vtkSpyPlotUniReaderDecodeTask task;
+        task.InOffset = bufferSize;
+        task.InSize = numBytes;
+        task.Out = dataArray->GetVoidPointer(zax * planeSize);
+        task.OutSize = planeSize;
+        decodeTasks.push_back(task);
+        bufferSize += numBytes;
         }
+      vtkDebugMacro( " " << dataArray << " initialized: " 
+                     << dataArray->GetName() );
+      }
+
+    if ( !::vtkSpyPlotUniReaderDecodePlanes(decodeTasks, arrayBuffer, 
+                                            toUnsignedChar) )
+      {
+      vtkErrorMacro( "Problem RLD decoding " 
+                     << (toUnsignedChar ? "unsigned char" : "float") 
+                     << " data array: " << var->Name );
+      return 0;
       }
     }
   this->DataTypeChanged = 0;
@@ -1080,78 +1380,17 @@ void vtkSpyPlotUniReader::PrintInformation()
    n bytes long. */
 
 
-//-----------------------------------------------------------------------------
-template<class t>
-int vtkSpyPlotUniReaderRunLengthDataDecode(vtkSpyPlotUniReader* self, 
-                                           const unsigned char* in, 
-                                           int inSize, t* out, 
-                                           int outSize, t scale=1)
-{
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
-
-  /* Run-length decode */
-  while ((outIndex<outSize) && (inIndex<inSize))
-    {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp ++;
-    if (runLength < 128)
-      {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k=0; k<runLength; ++k)
-        {
-        if ( outIndex >= outSize )
-          {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-                                  << "Too much data generated. Excpected: " 
-                                  << outSize );
-          return 0;
-          }
-        out[outIndex] = static_cast<t>(val*scale);
-        outIndex++;
-        }
-      inIndex += 5;
-      }
-    else  // runLength >= 128
-      {
-      int k;
-      for (k=0; k<runLength-128; ++k)
-        {
-        if ( outIndex >= outSize )
-          {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-                                  << "Too much data generated. Excpected: " 
-                                  << outSize );
-          return 0;
-          }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex]=static_cast<t>(val*scale);
-        outIndex++;
-        ptmp += 4;
-        }
-      inIndex += 4*(runLength-128)+1;
-      }
-    } // while
-
-  return 1;
-}
-
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(const unsigned char* in, 
                                              int inSize, float* out, 
                                              int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, 
-                                                  outSize);
+  if ( !::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize) )
+    {
+    vtkErrorMacro( "Problem doing RLD decode. Excpected: " << outSize );
+    return 0;
+    }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -1159,8 +1398,12 @@ int vtkSpyPlotUniReader::RunLengthDataDecode(const unsigned char* in,
                                              int inSize, int* out, 
                                              int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, 
-                                                  outSize);
+  if ( !::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize) )
+    {
+    vtkErrorMacro( "Problem doing RLD decode. Excpected: " << outSize );
+    return 0;
+    }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -1168,9 +1411,13 @@ int vtkSpyPlotUniReader::RunLengthDataDecode(const unsigned char* in,
                                              int inSize, unsigned char* out, 
                                              int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, 
-                                                  outSize, 
-                                                  static_cast<unsigned char>(255));
+  if ( !::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize, 
+        static_cast<unsigned char>(255)) )
+    {
+    vtkErrorMacro( "Problem doing RLD decode. Excpected: " << outSize );
+    return 0;
+    }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -1659,6 +1906,7 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
+  os << indent << "HasRegionOfInterest: " << this->HasRegionOfInterest << endl;
 }
 
 
@@ -160,6 +160,24 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  // Description:
+  // Only decode the cell data of the blocks that intersect the given
+  // slab (see vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST
+  // for the layout of the 8 values). The geometry of all blocks is still
+  // read. Pass NULL to decode every block.
+  void SetRegionOfInterest(const double* roi);
+
+  // Description:
+  // Return 1 if the cell data of the block is decoded for the current
+  // region of interest. Blocks are numbered as in GetCellFieldData.
+  int IsBlockInRegionOfInterest(int block);
+
+  // Description:
+  // Compute the range of the signed distances of the corners of the block
+  // along the normal of the region of interest, in the units of the range
+  // of the region. Return 0 if there is no such block or no region.
+  int GetBlockRegionOfInterestRange(int block, double range[2]);
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader();
@@ -173,6 +191,9 @@ private:
   int RunLengthDataDecode(const unsigned char* in, int inSize, 
                           unsigned char* out, int outSize);
 
+  int BlockIntersectsRegionOfInterest(vtkSpyPlotBlock* b);
+  void ComputeBlockRegionOfInterestRange(vtkSpyPlotBlock* b, double range[2]);
+
   int ReadHeader(vtkSpyPlotIStream *spis);
   int ReadGroupHeaderInformation(vtkSpyPlotIStream *spis);
 
@@ -231,6 +252,9 @@ private:
   int DataTypeChanged;
   int DownConvertVolumeFraction;
 
+  int HasRegionOfInterest;
+  double RegionOfInterest[8];
+
   int NumberOfCellFields;
   
   vtkDataArraySelection* CellArraySelection;
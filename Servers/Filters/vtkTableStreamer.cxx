@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkTableStreamer.h"
 
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkDataSetAttributes.h"
@@ -21,6 +22,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
+#include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -30,6 +32,9 @@
 #include "vtkTable.h"
 #include "vtkUnsignedIntArray.h"
 
+#include <vtkstd/algorithm>
+#include <vtkstd/string>
+
 static void vtkFillComponent(vtkUnsignedIntArray* array,
   int component, unsigned int value)
 {
@@ -42,6 +47,247 @@ static void vtkFillComponent(vtkUnsignedIntArray* array,
     }
 }
  
+//----------------------------------------------------------------------------
+// Number of keys each process contributes per round when locating a position
+// in the global sorted order.
+#define VTK_TABLE_STREAMER_SAMPLES 64
+
+enum
+{
+  VTK_TABLE_STREAMER_ROWS_TAG = 987601,
+  VTK_TABLE_STREAMER_KEYS_TAG = 987602
+};
+
+//----------------------------------------------------------------------------
+// Extracts the sort key for the rows of a table. Keys are negated for
+// descending order and NaNs are moved to the end, so that the global order
+// is always ascending in (key, process id, local order).
+class vtkTableStreamerSortKey
+{
+public:
+  vtkTableStreamerSortKey(vtkTable* table, const char* name, int component,
+    int descending, int processId)
+    {
+    this->Array = 0;
+    this->Component = component;
+    this->Sign = descending? -1.0 : 1.0;
+    this->Mode = CONSTANT;
+    this->Constant = 0.0;
+    this->Valid = true;
+    if (strcmp(name, "vtkOriginalIndices") == 0)
+      {
+      this->Mode = ROW;
+      }
+    else if (strcmp(name, "vtkOriginalProcessIds") == 0)
+      {
+      this->Constant = processId;
+      }
+    else
+      {
+      this->Valid = false;
+      this->Array = table?
+        vtkDataArray::SafeDownCast(table->GetColumnByName(name)) : 0;
+      if (this->Array)
+        {
+        this->Mode = ARRAY;
+        this->Valid = true;
+        if (this->Component >= this->Array->GetNumberOfComponents() ||
+          (this->Component < 0 && this->Array->GetNumberOfComponents() == 1))
+          {
+          this->Component = 0;
+          }
+        }
+      }
+    }
+
+  // Returns false when the table has no numeric column with the given name.
+  bool IsValid() { return this->Valid; }
+
+  double operator()(vtkIdType row) const
+    {
+    double value = this->Constant;
+    if (this->Mode == ROW)
+      {
+      value = static_cast<double>(row);
+      }
+    else if (this->Mode == ARRAY)
+      {
+      if (this->Component < 0)
+        {
+        double* tuple = this->Array->GetTuple(row);
+        int numComps = this->Array->GetNumberOfComponents();
+        value = 0.0;
+        for (int cc=0; cc < numComps; cc++)
+          {
+          value += tuple[cc]*tuple[cc];
+          }
+        value = sqrt(value);
+        }
+      else
+        {
+        value = this->Array->GetComponent(row, this->Component);
+        }
+      }
+    if (vtkMath::IsNan(value))
+      {
+      return vtkMath::Inf();
+      }
+    return this->Sign*value;
+    }
+
+private:
+  enum { CONSTANT, ROW, ARRAY };
+  vtkDataArray* Array;
+  int Component;
+  int Mode;
+  double Sign;
+  double Constant;
+  bool Valid;
+};
+
+//----------------------------------------------------------------------------
+// Orders row ids by their keys, breaking ties by row id.
+class vtkTableStreamerKeyCompare
+{
+public:
+  vtkTableStreamerKeyCompare(const double* keys) : Keys(keys) {}
+  bool operator()(vtkIdType a, vtkIdType b) const
+    {
+    return (this->Keys[a] < this->Keys[b] ||
+      (this->Keys[a] == this->Keys[b] && a < b));
+    }
+  const double* Keys;
+};
+
+//----------------------------------------------------------------------------
+class vtkTableStreamer::vtkInternals
+{
+public:
+  // Local sort order for one leaf.
+  struct LeafOrder
+    {
+    // Sorted keys and the rows they belong to.
+    vtkstd::vector<double> Keys;
+    vtkstd::vector<vtkIdType> Rows;
+
+    // Number of sorted rows (candidates) over all processes.
+    vtkIdType TotalCount;
+
+    // Number of rows of this leaf that are paged through, i.e. TotalCount
+    // clamped to what is left of NumberOfTopRows after the previous leaves.
+    vtkIdType GlobalCount;
+
+    // Range of Keys/Rows passed for the current block.
+    vtkIdType BlockBegin;
+    vtkIdType BlockEnd;
+    };
+
+  vtkstd::vector<LeafOrder> Leaves;
+
+  // Parameters the current sort order was computed for.
+  bool Valid;
+  unsigned long InputUpdateTime;
+  vtkstd::string Column;
+  int Component;
+  int Descending;
+  vtkIdType NumberOfTopRows;
+
+  vtkInternals() : Valid(false), InputUpdateTime(0), Component(-1),
+    Descending(0), NumberOfTopRows(0) {}
+};
+
+//----------------------------------------------------------------------------
+// Creates a table with the given rows of curTable (or count rows starting at
+// offset when rows is NULL) along with the book-keeping arrays.
+static vtkTable* vtkTableStreamerNewBlockTable(vtkTable* curTable,
+  vtkInformation* metaData, const vtkIdType* rows, vtkIdType offset,
+  vtkIdType count, int generateOriginalIds)
+{
+  vtkTable* outTable = vtkTable::New();
+  outTable->GetRowData()->CopyAllocate(curTable->GetRowData());
+  outTable->GetRowData()->SetNumberOfTuples(count);
+
+  vtkSmartPointer<vtkIdTypeArray> originalIndices;
+  if (generateOriginalIds)
+    {
+    originalIndices = vtkSmartPointer<vtkIdTypeArray>::New();
+    originalIndices->SetNumberOfComponents(1);
+    originalIndices->SetNumberOfTuples(count);
+    originalIndices->SetName("vtkOriginalIndices");
+    }
+
+  int dimensions[3] = {0, 0, 0};
+  vtkSmartPointer<vtkIdTypeArray> structuredIndices;
+  if (curTable->GetFieldData()->GetArray("STRUCTURED_DIMENSIONS"))
+    {
+    vtkIntArray::SafeDownCast(
+      curTable->GetFieldData()->GetArray("STRUCTURED_DIMENSIONS"))->
+      GetTupleValue(0, dimensions);
+    structuredIndices = vtkSmartPointer<vtkIdTypeArray>::New();
+    structuredIndices->SetNumberOfComponents(3);
+    structuredIndices->SetNumberOfTuples(count);
+    structuredIndices->SetName("Structured Coordinates");
+    }
+
+  vtkSmartPointer<vtkUnsignedIntArray> compositeIndex;
+  if (metaData->Has(vtkSelectionNode::HIERARCHICAL_LEVEL()) &&
+    metaData->Has(vtkSelectionNode::HIERARCHICAL_INDEX()))
+    {
+    compositeIndex = vtkSmartPointer<vtkUnsignedIntArray>::New();
+    compositeIndex->SetName("vtkCompositeIndexArray");
+    compositeIndex->SetNumberOfComponents(2);
+    compositeIndex->SetNumberOfTuples(count);
+    ::vtkFillComponent(compositeIndex, 0, static_cast<unsigned int>(
+        metaData->Get(vtkSelectionNode::HIERARCHICAL_LEVEL())));
+    ::vtkFillComponent(compositeIndex, 1, static_cast<unsigned int>(
+        metaData->Get(vtkSelectionNode::HIERARCHICAL_INDEX())));
+
+    }
+  else if (metaData->Has(vtkSelectionNode::COMPOSITE_INDEX()))
+    {
+    compositeIndex = vtkSmartPointer<vtkUnsignedIntArray>::New();
+    compositeIndex->SetName("vtkCompositeIndexArray");
+    compositeIndex->SetNumberOfComponents(1);
+    compositeIndex->SetNumberOfTuples(count);
+    ::vtkFillComponent(compositeIndex, 0, static_cast<unsigned int>(
+        metaData->Get(vtkSelectionNode::COMPOSITE_INDEX())));
+    }
+
+  // TODO: add Hierarchical index information.
+  for (vtkIdType jj=0; jj < count; jj++)
+    {
+    vtkIdType inIndex = rows? rows[jj] : offset+jj;
+    outTable->GetRowData()->CopyData(
+      curTable->GetRowData(), inIndex, jj);
+    if (originalIndices)
+      {
+      originalIndices->SetValue(jj, inIndex);
+      }
+    if (structuredIndices)
+      {
+      // Compute i,j,k from point id.
+      vtkIdType tuple[3];
+      tuple[0] = (inIndex % dimensions[0]);
+      tuple[1] = (inIndex/dimensions[0]) % dimensions[1];
+      tuple[2] = (inIndex/(dimensions[0]*dimensions[1]));
+      structuredIndices->SetTupleValue(jj, tuple);
+      }
+    }
+  if (originalIndices)
+    {
+    outTable->GetRowData()->AddArray(originalIndices);
+    }
+  if (structuredIndices)
+    {
+    outTable->GetRowData()->AddArray(structuredIndices);
+    }
+  if (compositeIndex)
+    {
+    outTable->GetRowData()->AddArray(compositeIndex);
+    }
+  return outTable;
+}
+
 vtkStandardNewMacro(vtkTableStreamer);
 vtkCxxRevisionMacro(vtkTableStreamer, "$Revision$");
 vtkCxxSetObjectMacro(vtkTableStreamer, Controller, vtkMultiProcessController);
@@ -53,12 +299,19 @@ vtkTableStreamer::vtkTableStreamer()
   this->BlockSize = 1024;
   this->Block = 0;
   this->GenerateOriginalIds = 0;
+  this->SortColumnName = 0;
+  this->SortComponent = -1;
+  this->SortDescending = 0;
+  this->NumberOfTopRows = 0;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
 vtkTableStreamer::~vtkTableStreamer()
 {
   this->SetController(0);
+  this->SetSortColumnName(0);
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -131,9 +384,23 @@ int vtkTableStreamer::RequestData(vtkInformation*,
   vtkDataObject* outputDO = vtkDataObject::GetData(outputVector, 0);
 
   vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> > indices;
-  if (!this->DetermineIndicesToPass(inputDO, indices))
+  vtkstd::vector<vtkstd::vector<vtkIdType> > sortedRows;
+  if (this->IsSorting())
     {
-    return 0;
+    if (!this->DetermineSortedRowsToPass(inputDO, sortedRows))
+      {
+      return 0;
+      }
+    }
+  else
+    {
+    // The sort was cleared, release the permutation.
+    this->Internals->Valid = false;
+    this->Internals->Leaves.clear();
+    if (!this->DetermineIndicesToPass(inputDO, indices))
+      {
+      return 0;
+      }
     }
 
   vtkSmartPointer<vtkCompositeDataSet> input =
@@ -154,6 +421,19 @@ int vtkTableStreamer::RequestData(vtkInformation*,
     }
   output->CopyStructure(input);
 
+  if (this->IsSorting())
+    {
+    if (!this->GatherSortedRows(input, output, sortedRows))
+      {
+      return 0;
+      }
+    if (!outputDO->IsA("vtkMultiBlockDataSet") && output->GetBlock(0))
+      {
+      outputDO->ShallowCopy(output->GetBlock(0));
+      }
+    return 1;
+    }
+
   vtkCompositeDataIterator* iter = input->NewIterator();
   iter->SkipEmptyNodesOff();
 
@@ -171,91 +451,11 @@ int vtkTableStreamer::RequestData(vtkInformation*,
       }
 
     something_added = true;
-    vtkTable* outTable = vtkTable::New();
+    vtkTable* outTable = ::vtkTableStreamerNewBlockTable(curTable,
+      iter->GetCurrentMetaData(), 0, curOffset, curCount,
+      this->GenerateOriginalIds);
     output->SetDataSet(iter, outTable);
     outTable->Delete();
-
-    outTable->GetRowData()->CopyAllocate(curTable->GetRowData());
-    outTable->GetRowData()->SetNumberOfTuples(curCount);
-
-    vtkSmartPointer<vtkIdTypeArray> originalIndices;
-    if (this->GenerateOriginalIds)
-      {
-      originalIndices = vtkSmartPointer<vtkIdTypeArray>::New();
-      originalIndices->SetNumberOfComponents(1);
-      originalIndices->SetNumberOfTuples(curCount);
-      originalIndices->SetName("vtkOriginalIndices");
-      }
-
-    int dimensions[3] = {0, 0, 0};
-    vtkSmartPointer<vtkIdTypeArray> structuredIndices;
-    if (curTable->GetFieldData()->GetArray("STRUCTURED_DIMENSIONS"))
-      {
-      vtkIntArray::SafeDownCast(
-        curTable->GetFieldData()->GetArray("STRUCTURED_DIMENSIONS"))->
-        GetTupleValue(0, dimensions);
-      structuredIndices = vtkSmartPointer<vtkIdTypeArray>::New();
-      structuredIndices->SetNumberOfComponents(3);
-      structuredIndices->SetNumberOfTuples(curCount);
-      structuredIndices->SetName("Structured Coordinates");
-      }
-
-    vtkSmartPointer<vtkUnsignedIntArray> compositeIndex;
-    if (iter->GetCurrentMetaData()->Has(vtkSelectionNode::HIERARCHICAL_LEVEL()) &&
-      iter->GetCurrentMetaData()->Has(vtkSelectionNode::HIERARCHICAL_INDEX()))
-      {
-      compositeIndex = vtkSmartPointer<vtkUnsignedIntArray>::New();
-      compositeIndex->SetName("vtkCompositeIndexArray");
-      compositeIndex->SetNumberOfComponents(2);
-      compositeIndex->SetNumberOfTuples(curCount);
-      ::vtkFillComponent(compositeIndex, 0, static_cast<unsigned int>(
-          iter->GetCurrentMetaData()->Get(vtkSelectionNode::HIERARCHICAL_LEVEL())));
-      ::vtkFillComponent(compositeIndex, 1, static_cast<unsigned int>(
-          iter->GetCurrentMetaData()->Get(vtkSelectionNode::HIERARCHICAL_INDEX())));
-
-      }
-    else if (iter->GetCurrentMetaData()->Has(vtkSelectionNode::COMPOSITE_INDEX()))
-      {
-      compositeIndex = vtkSmartPointer<vtkUnsignedIntArray>::New();
-      compositeIndex->SetName("vtkCompositeIndexArray");
-      compositeIndex->SetNumberOfComponents(1);
-      compositeIndex->SetNumberOfTuples(curCount);
-      ::vtkFillComponent(compositeIndex, 0, static_cast<unsigned int>(
-          iter->GetCurrentMetaData()->Get(vtkSelectionNode::COMPOSITE_INDEX())));
-      }
-
-    // TODO: add Hierarchical index information.
-    for (vtkIdType jj=0; jj < curCount; jj++)
-      {
-      vtkIdType inIndex = curOffset+jj;
-      outTable->GetRowData()->CopyData(
-        curTable->GetRowData(), inIndex, jj);
-      if (originalIndices)
-        {
-        originalIndices->SetValue(jj, inIndex);
-        }
-      if (structuredIndices)
-        {
-        // Compute i,j,k from point id.
-        vtkIdType tuple[3];
-        tuple[0] = (inIndex % dimensions[0]);
-        tuple[1] = (inIndex/dimensions[0]) % dimensions[1];
-        tuple[2] = (inIndex/(dimensions[0]*dimensions[1]));
-        structuredIndices->SetTupleValue(jj, tuple);
-        }
-      }
-    if (originalIndices)
-      {
-      outTable->GetRowData()->AddArray(originalIndices);
-      }
-    if (structuredIndices)
-      {
-      outTable->GetRowData()->AddArray(structuredIndices);
-      }
-    if (compositeIndex)
-      {
-      outTable->GetRowData()->AddArray(compositeIndex);
-      }
     }
   iter->Delete();
     
@@ -410,10 +610,473 @@ bool vtkTableStreamer::DetermineIndicesToPass(vtkDataObject* inputDO,
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkTableStreamer::DetermineRowsToPass(vtkDataObject* inputDO,
+  vtkstd::vector<vtkstd::vector<vtkIdType> >& result)
+{
+  if (this->IsSorting())
+    {
+    return this->DetermineSortedRowsToPass(inputDO, result);
+    }
+
+  vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> > indices;
+  if (!this->DetermineIndicesToPass(inputDO, indices))
+    {
+    return false;
+    }
+  result.clear();
+  result.resize(indices.size());
+  for (size_t cc=0; cc < indices.size(); cc++)
+    {
+    for (vtkIdType jj=0; jj < indices[cc].second; jj++)
+      {
+      result[cc].push_back(indices[cc].first + jj);
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTableStreamer::DetermineSortedRowsToPass(vtkDataObject* inputDO,
+  vtkstd::vector<vtkstd::vector<vtkIdType> >& result)
+{
+  vtkSmartPointer<vtkCompositeDataSet> input =
+    vtkCompositeDataSet::SafeDownCast(inputDO);
+  if (!input)
+    {
+    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::New();
+    mb->SetBlock(0, inputDO);
+    input = mb;
+    mb->Delete();
+    }
+
+  vtkstd::vector<vtkTable*> tables;
+  vtkCompositeDataIterator* iter = input->NewIterator();
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+    tables.push_back(vtkTable::SafeDownCast(iter->GetCurrentDataObject()));
+    }
+  iter->Delete();
+
+  int myId = this->Controller? this->Controller->GetLocalProcessId() : 0;
+  int numProcs = this->Controller?
+    this->Controller->GetNumberOfProcesses() : 1;
+
+  // Sort the local rows of every leaf, unless the cached order is still valid.
+  vtkInternals* internals = this->Internals;
+  if (!internals->Valid ||
+    internals->InputUpdateTime != inputDO->GetUpdateTime() ||
+    internals->Column != this->SortColumnName ||
+    internals->Component != this->SortComponent ||
+    internals->Descending != this->SortDescending ||
+    internals->NumberOfTopRows != this->NumberOfTopRows ||
+    internals->Leaves.size() != tables.size())
+    {
+    internals->Valid = false;
+    internals->Leaves.clear();
+    internals->Leaves.resize(tables.size());
+
+    vtkstd::vector<vtkIdType> counts(tables.size(), 0);
+    for (size_t cc=0; cc < tables.size(); cc++)
+      {
+      vtkTable* table = tables[cc];
+      vtkIdType numRows = table? table->GetNumberOfRows() : 0;
+      if (numRows == 0)
+        {
+        continue;
+        }
+
+      vtkTableStreamerSortKey key(table, this->SortColumnName,
+        this->SortComponent, this->SortDescending, myId);
+      if (!key.IsValid())
+        {
+        vtkWarningMacro("Cannot sort by \"" << this->SortColumnName
+          << "\". Rows will be passed in their natural order.");
+        }
+
+      vtkstd::vector<double> keys(numRows);
+      vtkstd::vector<vtkIdType> order(numRows);
+      for (vtkIdType jj=0; jj < numRows; jj++)
+        {
+        keys[jj] = key(jj);
+        order[jj] = jj;
+        }
+
+      // With a limit on the number of rows, only the local candidates for
+      // the top rows need to be ordered.
+      vtkIdType numSorted = numRows;
+      vtkTableStreamerKeyCompare compare(&keys[0]);
+      if (this->NumberOfTopRows > 0 && this->NumberOfTopRows < numRows)
+        {
+        numSorted = this->NumberOfTopRows;
+        vtkstd::nth_element(order.begin(), order.begin() + numSorted,
+          order.end(), compare);
+        order.resize(numSorted);
+        }
+      vtkstd::sort(order.begin(), order.end(), compare);
+
+      vtkInternals::LeafOrder& leaf = internals->Leaves[cc];
+      leaf.Rows.swap(order);
+      leaf.Keys.resize(numSorted);
+      for (vtkIdType jj=0; jj < numSorted; jj++)
+        {
+        leaf.Keys[jj] = keys[leaf.Rows[jj]];
+        }
+      counts[cc] = numSorted;
+      }
+
+    vtkstd::vector<vtkIdType> totals(counts);
+    if (numProcs > 1 && !counts.empty() &&
+      !this->Controller->AllReduce(&counts[0], &totals[0],
+        static_cast<vtkIdType>(counts.size()), vtkCommunicator::SUM_OP))
+      {
+      vtkErrorMacro("Communication error.");
+      return false;
+      }
+    // The limit applies to the leaves laid out one after another, as the
+    // representation counts the rows of the whole input.
+    vtkIdType remaining = this->NumberOfTopRows;
+    for (size_t cc=0; cc < tables.size(); cc++)
+      {
+      vtkInternals::LeafOrder& leaf = internals->Leaves[cc];
+      leaf.TotalCount = totals[cc];
+      leaf.GlobalCount = totals[cc];
+      if (this->NumberOfTopRows > 0)
+        {
+        leaf.GlobalCount = remaining < totals[cc]? remaining : totals[cc];
+        remaining -= leaf.GlobalCount;
+        }
+      }
+
+    internals->Valid = true;
+    internals->InputUpdateTime = inputDO->GetUpdateTime();
+    internals->Column = this->SortColumnName;
+    internals->Component = this->SortComponent;
+    internals->Descending = this->SortDescending;
+    internals->NumberOfTopRows = this->NumberOfTopRows;
+    }
+
+  vtkIdType blockStartIndex = this->Block*this->BlockSize;
+  vtkIdType blockEndIndex = blockStartIndex + this->BlockSize;
+  // To pass: [blockStartIndex, blockEndIndex) of the sorted order, with the
+  // leaves laid out one after another as for the unsorted case.
+
+  result.clear();
+  result.resize(tables.size());
+  vtkIdType leafStartIndex = 0;
+  for (size_t cc=0; cc < tables.size(); cc++)
+    {
+    vtkInternals::LeafOrder& leaf = internals->Leaves[cc];
+    leaf.BlockBegin = leaf.BlockEnd = 0;
+
+    vtkIdType start = blockStartIndex - leafStartIndex;
+    vtkIdType end = blockEndIndex - leafStartIndex;
+    start = start > 0? start : 0;
+    end = end < leaf.GlobalCount? end : leaf.GlobalCount;
+    leafStartIndex += leaf.GlobalCount;
+    if (start >= end)
+      {
+      continue;
+      }
+
+    // Every process takes this branch for the same leaves since the
+    // positions are global; LocateSortedPosition() is collective.
+    vtkIdType localStart = 0, localEnd = 0;
+    if (!this->LocateSortedPosition(static_cast<unsigned int>(cc), start,
+        localStart))
+      {
+      return false;
+      }
+    if (end >= leaf.TotalCount)
+      {
+      localEnd = static_cast<vtkIdType>(leaf.Rows.size());
+      }
+    else if (!this->LocateSortedPosition(static_cast<unsigned int>(cc), end,
+        localEnd))
+      {
+      return false;
+      }
+
+    leaf.BlockBegin = localStart;
+    leaf.BlockEnd = localEnd;
+    result[cc].assign(leaf.Rows.begin() + localStart,
+      leaf.Rows.begin() + localEnd);
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTableStreamer::LocateSortedPosition(unsigned int leafIndex,
+  vtkIdType position, vtkIdType& localIndex)
+{
+  const vtkstd::vector<double>& keys = this->Internals->Leaves[leafIndex].Keys;
+  vtkIdType numKeys = static_cast<vtkIdType>(keys.size());
+
+  if (!this->Controller || this->Controller->GetNumberOfProcesses() <= 1)
+    {
+    localIndex = position < numKeys? position : numKeys;
+    return true;
+    }
+
+  int myId = this->Controller->GetLocalProcessId();
+  int numProcs = this->Controller->GetNumberOfProcesses();
+
+  // The global order is (key, process id, local order). We look for the key
+  // K of the row at the given position by narrowing down an open interval
+  // (lo, hi) of keys known to contain K. Each round, every process
+  // contributes evenly spaced samples of its keys within the interval
+  // (always including its largest one), the global rank of every sample is
+  // computed with one reduction and the interval is shrunk to lie between
+  // two consecutive samples. This converges after about
+  // log(rows)/log(samples) rounds.
+  const int numSamples = VTK_TABLE_STREAMER_SAMPLES;
+  vtkstd::vector<double> sendBuffer(numSamples + 1);
+  vtkstd::vector<double> recvBuffer((numSamples + 1)*numProcs);
+  bool hasLo = false, hasHi = false;
+  double lo = 0.0, hi = 0.0;
+  for (;;)
+    {
+    vtkIdType begin = hasLo? static_cast<vtkIdType>(
+      vtkstd::upper_bound(keys.begin(), keys.end(), lo) - keys.begin()) : 0;
+    vtkIdType end = hasHi? static_cast<vtkIdType>(
+      vtkstd::lower_bound(keys.begin(), keys.end(), hi) - keys.begin()) :
+      numKeys;
+    vtkIdType count = end > begin? end - begin : 0;
+    vtkIdType numLocalSamples = count < numSamples? count : numSamples;
+    sendBuffer[0] = static_cast<double>(numLocalSamples);
+    for (vtkIdType jj=0; jj < numLocalSamples; jj++)
+      {
+      sendBuffer[jj+1] = keys[begin + ((jj+1)*count)/numLocalSamples - 1];
+      }
+    if (!this->Controller->AllGather(&sendBuffer[0], &recvBuffer[0],
+        numSamples + 1))
+      {
+      vtkErrorMacro("Communication error.");
+      return false;
+      }
+
+    vtkstd::vector<double> samples;
+    for (int proc=0; proc < numProcs; proc++)
+      {
+      const double* procBuffer = &recvBuffer[proc*(numSamples + 1)];
+      int numProcSamples = static_cast<int>(procBuffer[0]);
+      samples.insert(samples.end(), procBuffer + 1,
+        procBuffer + 1 + numProcSamples);
+      }
+    vtkstd::sort(samples.begin(), samples.end());
+    samples.erase(vtkstd::unique(samples.begin(), samples.end()),
+      samples.end());
+    if (samples.empty())
+      {
+      vtkErrorMacro("Failed to locate row " << position
+        << " in the sorted order.");
+      return false;
+      }
+
+    // Number of keys less than and less than or equal to each sample.
+    size_t numUnique = samples.size();
+    vtkstd::vector<vtkIdType> localRanks(2*numUnique);
+    vtkstd::vector<vtkIdType> ranks(2*numUnique);
+    for (size_t jj=0; jj < numUnique; jj++)
+      {
+      localRanks[2*jj] = static_cast<vtkIdType>(vtkstd::lower_bound(
+          keys.begin(), keys.end(), samples[jj]) - keys.begin());
+      localRanks[2*jj+1] = static_cast<vtkIdType>(vtkstd::upper_bound(
+          keys.begin(), keys.end(), samples[jj]) - keys.begin());
+      }
+    if (!this->Controller->AllReduce(&localRanks[0], &ranks[0],
+        static_cast<vtkIdType>(2*numUnique), vtkCommunicator::SUM_OP))
+      {
+      vtkErrorMacro("Communication error.");
+      return false;
+      }
+
+    size_t index = 0;
+    while (index < numUnique && ranks[2*index+1] <= position)
+      {
+      index++;
+      }
+    if (index == numUnique)
+      {
+      vtkErrorMacro("Failed to locate row " << position
+        << " in the sorted order.");
+      return false;
+      }
+
+    if (ranks[2*index] <= position)
+      {
+      // samples[index] is the key we are looking for. Rows with equal keys
+      // are ordered by process id.
+      vtkIdType numLess = localRanks[2*index];
+      vtkIdType numEqual = localRanks[2*index+1] - numLess;
+      vtkstd::vector<vtkIdType> allEqual(numProcs);
+      if (!this->Controller->AllGather(&numEqual, &allEqual[0], 1))
+        {
+        vtkErrorMacro("Communication error.");
+        return false;
+        }
+      vtkIdType skip = position - ranks[2*index];
+      for (int proc=0; proc < myId; proc++)
+        {
+        skip -= allEqual[proc];
+        }
+      skip = skip < 0? 0 : (skip > numEqual? numEqual : skip);
+      localIndex = numLess + skip;
+      return true;
+      }
+
+    hasHi = true;
+    hi = samples[index];
+    if (index > 0)
+      {
+      hasLo = true;
+      lo = samples[index-1];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkTableStreamer::GatherSortedRows(vtkDataObject* inputDO,
+  vtkMultiBlockDataSet* output,
+  const vtkstd::vector<vtkstd::vector<vtkIdType> >& rows)
+{
+  vtkCompositeDataSet* input = vtkCompositeDataSet::SafeDownCast(inputDO);
+  int myId = this->Controller? this->Controller->GetLocalProcessId() : 0;
+  int numProcs = this->Controller?
+    this->Controller->GetNumberOfProcesses() : 1;
+
+  vtkCompositeDataIterator* iter = input->NewIterator();
+  iter->SkipEmptyNodesOff();
+  unsigned int cc=0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem(), cc++)
+    {
+    vtkInternals::LeafOrder& leaf = this->Internals->Leaves[cc];
+    vtkIdType blockStartIndex = this->Block*this->BlockSize;
+    // Skip leaves that do not contribute to this block on any process.
+    vtkIdType leafStartIndex = 0;
+    for (unsigned int kk=0; kk < cc; kk++)
+      {
+      leafStartIndex += this->Internals->Leaves[kk].GlobalCount;
+      }
+    if (leafStartIndex >= blockStartIndex + this->BlockSize ||
+      leafStartIndex + leaf.GlobalCount <= blockStartIndex)
+      {
+      continue;
+      }
+
+    vtkTable* curTable = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    vtkIdType count = static_cast<vtkIdType>(rows[cc].size());
+    vtkSmartPointer<vtkTable> localTable;
+    if (curTable && count > 0)
+      {
+      localTable.TakeReference(::vtkTableStreamerNewBlockTable(curTable,
+          iter->GetCurrentMetaData(), &rows[cc][0], 0, count,
+          this->GenerateOriginalIds));
+      if (numProcs > 1)
+        {
+        // The rows are moved to the root before delivery, hence we need to
+        // record the process they came from here.
+        vtkIdTypeArray* originalProcessIds = vtkIdTypeArray::New();
+        originalProcessIds->SetNumberOfComponents(1);
+        originalProcessIds->SetName("vtkOriginalProcessIds");
+        originalProcessIds->SetNumberOfTuples(count);
+        originalProcessIds->FillComponent(0, myId);
+        localTable->AddColumn(originalProcessIds);
+        originalProcessIds->Delete();
+        }
+      }
+    else
+      {
+      localTable = vtkSmartPointer<vtkTable>::New();
+      count = 0;
+      }
+    const double* localKeys = count > 0? &leaf.Keys[leaf.BlockBegin] : 0;
+
+    if (myId != 0)
+      {
+      this->Controller->Send(localTable, 0, VTK_TABLE_STREAMER_ROWS_TAG);
+      if (count > 0)
+        {
+        this->Controller->Send(localKeys, count, 0,
+          VTK_TABLE_STREAMER_KEYS_TAG);
+        }
+      continue;
+      }
+
+    // Root: collect the rows from all processes and merge them by key. Ties
+    // are resolved by process id and then local order, as in the global
+    // order.
+    vtkstd::vector<vtkSmartPointer<vtkTable> > pieces(numProcs);
+    vtkstd::vector<vtkstd::vector<double> > pieceKeys(numProcs);
+    pieces[0] = localTable;
+    pieceKeys[0].assign(localKeys, localKeys + count);
+    for (int proc=1; proc < numProcs; proc++)
+      {
+      pieces[proc] = vtkSmartPointer<vtkTable>::New();
+      this->Controller->Receive(pieces[proc], proc,
+        VTK_TABLE_STREAMER_ROWS_TAG);
+      vtkIdType numRows = pieces[proc]->GetNumberOfRows();
+      if (numRows > 0)
+        {
+        pieceKeys[proc].resize(numRows);
+        this->Controller->Receive(&pieceKeys[proc][0], numRows, proc,
+          VTK_TABLE_STREAMER_KEYS_TAG);
+        }
+      }
+
+    vtkstd::vector<vtkstd::pair<double, vtkstd::pair<int, vtkIdType> > > order;
+    vtkTable* prototype = 0;
+    for (int proc=0; proc < numProcs; proc++)
+      {
+      vtkIdType numRows = static_cast<vtkIdType>(pieceKeys[proc].size());
+      if (numRows > 0 && !prototype)
+        {
+        prototype = pieces[proc];
+        }
+      for (vtkIdType jj=0; jj < numRows; jj++)
+        {
+        order.push_back(vtkstd::pair<double, vtkstd::pair<int, vtkIdType> >(
+            pieceKeys[proc][jj], vtkstd::pair<int, vtkIdType>(proc, jj)));
+        }
+      }
+    if (!prototype)
+      {
+      continue;
+      }
+    vtkstd::sort(order.begin(), order.end());
+
+    vtkTable* outTable = vtkTable::New();
+    outTable->GetRowData()->CopyAllocate(prototype->GetRowData());
+    outTable->GetRowData()->SetNumberOfTuples(
+      static_cast<vtkIdType>(order.size()));
+    for (size_t jj=0; jj < order.size(); jj++)
+      {
+      outTable->GetRowData()->CopyData(
+        pieces[order[jj].second.first]->GetRowData(),
+        order[jj].second.second, static_cast<vtkIdType>(jj));
+      }
+    output->SetDataSet(iter, outTable);
+    outTable->Delete();
+    }
+  iter->Delete();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Block: " << this->Block << endl;
+  os << indent << "BlockSize: " << this->BlockSize << endl;
+  os << indent << "GenerateOriginalIds: " << this->GenerateOriginalIds << endl;
+  os << indent << "SortColumnName: "
+    << (this->SortColumnName? this->SortColumnName : "(none)") << endl;
+  os << indent << "SortComponent: " << this->SortComponent << endl;
+  os << indent << "SortDescending: " << this->SortDescending << endl;
+  os << indent << "NumberOfTopRows: " << this->NumberOfTopRows << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
 
 
@@ -15,6 +15,15 @@
 // .NAME vtkTableStreamer - block-based vtkTable streaming filter.
 // .SECTION Description
 // vtkTableStreamer is a block-based vtkTable streaming filter. 
+//
+// When SortColumnName is set, blocks are cut from the rows ordered by that
+// column across all processes rather than from the rows in their natural
+// order. Each process sorts its own rows once (the permutation is cached
+// until the input or the sort parameters change) and the global position of
+// a block boundary is located by repeatedly sampling the local sorted keys of
+// all processes, so only a handful of small collective operations are needed
+// per block. The rows of the requested block are then gathered, in order, on
+// the root process; all other processes produce empty output.
 
 #ifndef __vtkTableStreamer_h
 #define __vtkTableStreamer_h
@@ -22,6 +31,7 @@
 #include "vtkDataObjectAlgorithm.h"
 #include <vtkstd/vector> // needed for vtkstd::vector
 
+class vtkMultiBlockDataSet;
 class vtkMultiProcessController;
 
 class VTK_EXPORT vtkTableStreamer : public vtkDataObjectAlgorithm
@@ -48,6 +58,36 @@ public:
   vtkSetMacro(GenerateOriginalIds, int);
   vtkGetMacro(GenerateOriginalIds, int);
 
+  // Description:
+  // Get/Set the name of the column to sort the rows by before cutting blocks.
+  // The special names "vtkOriginalIndices" and "vtkOriginalProcessIds" sort by
+  // row index and process id respectively. Default is 0, i.e. the rows are
+  // passed in their natural order. Setting it back to 0 or to an empty
+  // string clears the sort.
+  vtkSetStringMacro(SortColumnName);
+  vtkGetStringMacro(SortColumnName);
+
+  // Description:
+  // Get/Set the component of the sort column used as the sort key. -1
+  // (default) uses the magnitude for multi-component columns.
+  vtkSetMacro(SortComponent, int);
+  vtkGetMacro(SortComponent, int);
+
+  // Description:
+  // When set, rows are sorted in descending order. Off by default.
+  vtkSetMacro(SortDescending, int);
+  vtkGetMacro(SortDescending, int);
+  vtkBooleanMacro(SortDescending, int);
+
+  // Description:
+  // When sorting, only pass the first NumberOfTopRows rows. The sorted leaves
+  // are laid out one after another, so the limit applies to all the leaves
+  // together. Each process then only orders its candidates for those rows
+  // instead of all its rows, which makes queries such as "the 100 largest
+  // values" much cheaper than a full sort. Default is 0, i.e. no limit.
+  vtkSetMacro(NumberOfTopRows, vtkIdType);
+  vtkGetMacro(NumberOfTopRows, vtkIdType);
+
   // Description:
   // Get/Set the MPI controller used for gathering.
   void SetController(vtkMultiProcessController*);
@@ -78,10 +118,26 @@ protected:
   bool DetermineIndicesToPass(vtkDataObject* dObj,
     vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> >& result);
 
+  // Description:
+  // Fills up \c result with the local rows of each leaf node in the input
+  // dObj that belong to the current block, in the order in which they appear
+  // in the block. This works for sorted as well as unsorted streaming.
+  bool DetermineRowsToPass(vtkDataObject* dObj,
+    vtkstd::vector<vtkstd::vector<vtkIdType> >& result);
+
+  // Description:
+  // Returns true when the rows are to be sorted before cutting blocks.
+  bool IsSorting()
+    { return (this->SortColumnName && this->SortColumnName[0]); }
+
 
   vtkIdType Block;
   vtkIdType BlockSize;
   int GenerateOriginalIds;
+  char* SortColumnName;
+  int SortComponent;
+  int SortDescending;
+  vtkIdType NumberOfTopRows;
   vtkMultiProcessController* Controller;
 private:
   vtkTableStreamer(const vtkTableStreamer&); // Not implemented
@@ -93,6 +149,28 @@ private:
   // rows). This works in parallel collecting information across all processes.
   bool CountRows(vtkDataObject* dObj, vtkstd::vector<vtkIdType>& counts,
     vtkstd::vector<vtkIdType>& offsets);
+
+  // Description:
+  // Sorted counterpart of DetermineIndicesToPass(). Ensures the local sort
+  // permutation for each leaf is up-to-date and locates the local rows that
+  // fall within the current block of the global sorted order.
+  bool DetermineSortedRowsToPass(vtkDataObject* dObj,
+    vtkstd::vector<vtkstd::vector<vtkIdType> >& result);
+
+  // Description:
+  // Locates the local index (in the local sorted order of the given leaf)
+  // of the first row whose global sorted position is >= position.
+  bool LocateSortedPosition(unsigned int leaf, vtkIdType position,
+    vtkIdType& localIndex);
+
+  // Description:
+  // Produces the sorted output on the root process from the rows passed by
+  // every process.
+  bool GatherSortedRows(vtkDataObject* inputDO, vtkMultiBlockDataSet* output,
+    const vtkstd::vector<vtkstd::vector<vtkIdType> >& rows);
+
+  class vtkInternals;
+  vtkInternals* Internals;
 //ETX
 };
 
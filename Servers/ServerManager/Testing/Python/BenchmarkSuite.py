@@ -0,0 +1,24 @@
+# Runs the benchmark suite on tiny data to check that every benchmark runs
+# and that the results can be read back and compared.
+
+import SMPythonTesting
+from paraview import servermanager
+from paraview import benchmark
+
+SMPythonTesting.ProcessCommandLineArguments()
+
+servermanager.Connect()
+
+fname = SMPythonTesting.TempDir + "/BenchmarkSuite.csv"
+results = benchmark.run_suite(fname, size=20, repeat=1, nframes=2)
+if len(results) < 10:
+    raise SMPythonTesting.TestError, 'Too few benchmarks were run.'
+for suite, name, cells, seconds in results:
+    if cells <= 0:
+        raise SMPythonTesting.TestError, \
+          'Benchmark %s "%s" produced no cells.' % (suite, name)
+
+if len(benchmark.read_results(fname)) != len(results):
+    raise SMPythonTesting.TestError, 'Could not read the results back.'
+if benchmark.compare(fname, fname, 0.0):
+    raise SMPythonTesting.TestError, 'Results regressed against themselves.'
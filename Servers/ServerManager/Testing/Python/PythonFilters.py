@@ -25,6 +25,19 @@ if hasnumpy:
         if s_a.GetValue(i*3) != pc_a.GetValue(i):
             raise SMPythonTesting.Error("Extracted component %d does not match original") % i
 
+    # Element-wise expressions reuse the temporary arrays. Check that the
+    # result is still right.
+    pc.Expression = "Normals[:, 0]*2 + sin(Normals[:, 1]) - Normals[:, 2]/2"
+    pc.UpdatePipeline()
+
+    pc_a = servermanager.Fetch(pc).GetPointData().GetArray('result')
+
+    for i in range(10):
+        expected = s_a.GetValue(i*3)*2 + sin(s_a.GetValue(i*3+1)) - \
+          s_a.GetValue(i*3+2)/2
+        if abs(expected - pc_a.GetValue(i)) > 1e-5:
+            raise SMPythonTesting.TestError("Expression value %d does not match" % i)
+
     # Try the same with the programmable filter
     pf = ProgrammableFilter(s)
     pf.Script = """
@@ -14,12 +14,15 @@
 =========================================================================*/
 #include "vtkSMAnimationSceneImageWriter.h"
 
+#include "vtkConditionVariable.h"
 #include "vtkErrorCode.h"
 #include "vtkGenericMovieWriter.h"
 #include "vtkImageData.h"
 #include "vtkImageIterator.h"
 #include "vtkImageWriter.h"
 #include "vtkJPEGWriter.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkObjectFactory.h"
 #include "vtkPNGWriter.h"
@@ -35,6 +38,7 @@
 #endif
 
 #include <vtkstd/algorithm>
+#include <vtkstd/deque>
 #include <vtkstd/string>
 #include <vtksys/SystemTools.hxx>
 
@@ -51,6 +55,160 @@
 #  include "vtkPVConfig.h"
 #endif
 
+// Number of captured frames that may wait to be encoded. Rendering waits
+// when the encoder thread falls this far behind.
+#define VTK_MAX_QUEUED_FRAMES 4
+
+//-----------------------------------------------------------------------------
+// Encodes the frames captured by the main thread in a separate thread so that
+// image compression and file (or movie) writing overlap with rendering.
+class vtkSMAnimationSceneImageWriter::vtkInternals
+{
+public:
+  struct Frame
+    {
+    vtkImageData* Image; // reference owned by the queue.
+    vtkstd::string FileName;
+    };
+
+  vtkSMAnimationSceneImageWriter* Self;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+
+  // The following are protected by Lock.
+  vtkMutexLock* Lock;
+  vtkConditionVariable* FrameQueued;
+  vtkConditionVariable* FrameEncoded;
+  vtkstd::deque<Frame> Frames;
+  bool Done;
+  int ErrorCode;
+
+  vtkInternals(vtkSMAnimationSceneImageWriter* self)
+    {
+    this->Self = self;
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->Lock = vtkMutexLock::New();
+    this->FrameQueued = vtkConditionVariable::New();
+    this->FrameEncoded = vtkConditionVariable::New();
+    this->Done = false;
+    this->ErrorCode = 0;
+    }
+
+  ~vtkInternals()
+    {
+    this->Stop();
+    this->Threader->Delete();
+    this->Lock->Delete();
+    this->FrameQueued->Delete();
+    this->FrameEncoded->Delete();
+    }
+
+  bool IsRunning() { return this->ThreadId >= 0; }
+
+  // Does nothing without thread support, rather than letting SpawnThread()
+  // report an error for every animation saved, so that the frames are
+  // encoded in the calling thread.
+  void Start()
+    {
+    this->Done = false;
+    this->ErrorCode = 0;
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+    this->ThreadId = this->Threader->SpawnThread(
+      &vtkInternals::EncoderThread, this);
+#endif
+    }
+
+  // Waits for all the queued frames to be encoded and stops the thread.
+  // Returns the first error code of the writer, if any.
+  int Stop()
+    {
+    if (!this->IsRunning())
+      {
+      return 0;
+      }
+    this->Lock->Lock();
+    this->Done = true;
+    this->FrameQueued->Broadcast();
+    this->Lock->Unlock();
+    this->Threader->TerminateThread(this->ThreadId);
+    this->ThreadId = -1;
+    return this->ErrorCode;
+    }
+
+  // Takes the reference to image. Returns the error code of the frames
+  // encoded so far.
+  int Push(vtkImageData* image, const char* filename)
+    {
+    Frame frame;
+    frame.Image = image;
+    frame.FileName = filename? filename : "";
+
+    this->Lock->Lock();
+    while (!this->ErrorCode &&
+      this->Frames.size() >= VTK_MAX_QUEUED_FRAMES)
+      {
+      this->FrameEncoded->Wait(this->Lock);
+      }
+    int errcode = this->ErrorCode;
+    if (!errcode)
+      {
+      this->Frames.push_back(frame);
+      this->FrameQueued->Signal();
+      }
+    this->Lock->Unlock();
+    if (errcode)
+      {
+      image->Delete();
+      }
+    return errcode;
+    }
+
+  static VTK_THREAD_RETURN_TYPE EncoderThread(void* arg)
+    {
+    vtkMultiThreader::ThreadInfo* ti =
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    vtkInternals* self = static_cast<vtkInternals*>(ti->UserData);
+    self->EncodeFrames();
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
+  void EncodeFrames()
+    {
+    this->Lock->Lock();
+    for (;;)
+      {
+      while (this->Frames.empty() && !this->Done)
+        {
+        this->FrameQueued->Wait(this->Lock);
+        }
+      if (this->Frames.empty())
+        {
+        break;
+        }
+      Frame frame = this->Frames.front();
+      this->Frames.pop_front();
+      int errcode = this->ErrorCode;
+      this->Lock->Unlock();
+
+      // Once a frame failed the following ones are dropped.
+      if (!errcode)
+        {
+        errcode = this->Self->EncodeFrame(frame.Image, frame.FileName.c_str());
+        }
+      frame.Image->Delete();
+
+      this->Lock->Lock();
+      if (errcode && !this->ErrorCode)
+        {
+        this->ErrorCode = errcode;
+        }
+      this->FrameEncoded->Signal();
+      }
+    this->Lock->Unlock();
+    }
+};
+
 vtkStandardNewMacro(vtkSMAnimationSceneImageWriter);
 vtkCxxRevisionMacro(vtkSMAnimationSceneImageWriter, "$Revision$");
 vtkCxxSetObjectMacro(vtkSMAnimationSceneImageWriter,
@@ -80,11 +238,16 @@ vtkSMAnimationSceneImageWriter::vtkSMAnimationSceneImageWriter()
 
   this->BackgroundColor[0] = this->BackgroundColor[1] =
     this->BackgroundColor[2] = 0.0;
+
+  this->EncodeInBackground = 1;
+  this->Internals = new vtkInternals(this);
 }
 
 //-----------------------------------------------------------------------------
 vtkSMAnimationSceneImageWriter::~vtkSMAnimationSceneImageWriter()
 {
+  delete this->Internals;
+
   this->SetMovieWriter(0);
   this->SetImageWriter(0);
 
@@ -117,6 +280,12 @@ bool vtkSMAnimationSceneImageWriter::SaveInitialize()
 
   this->FileCount = 0;
 
+  if (this->EncodeInBackground)
+    {
+    // Falls back to encoding in SaveFrame() if threads are not available.
+    this->Internals->Start();
+    }
+
 #if !defined(__APPLE__)      
   // Iterate over all views and enable offscreen rendering. This avoid toggling
   // of the offscreen rendering flag on every frame.
@@ -252,26 +421,64 @@ bool vtkSMAnimationSceneImageWriter::SaveFrame(double vtkNotUsed(time))
       }
     combinedImage.TakeReference(capture);
     }
+  if (!combinedImage)
+    {
+    return false;
+    }
 
-  int errcode = 0;
+  vtkstd::string filename;
   if (this->ImageWriter)
     {
     char number[1024];
     sprintf(number, ".%04d", this->FileCount);
-    vtkstd::string filename = this->Prefix;
+    filename = this->Prefix;
     filename = filename + number + this->Suffix;
-    this->ImageWriter->SetInput(combinedImage);
-    this->ImageWriter->SetFileName(filename.c_str());
+    }
+
+  int errcode = 0;
+  if (this->Internals->IsRunning())
+    {
+    // The encoder thread takes the last reference to the image.
+    vtkImageData* image = combinedImage;
+    image->Register(0);
+    combinedImage = 0;
+    errcode = this->Internals->Push(image, filename.c_str());
+    }
+  else
+    {
+    errcode = this->EncodeFrame(combinedImage, filename.c_str());
+    }
+  if (!errcode && this->ImageWriter)
+    {
+    this->FileCount++;
+    }
+  combinedImage = 0;
+
+  if (errcode)
+    {
+    this->ErrorCode = errcode;
+    return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSMAnimationSceneImageWriter::EncodeFrame(vtkImageData* image,
+  const char* filename)
+{
+  int errcode = 0;
+  if (this->ImageWriter)
+    {
+    this->ImageWriter->SetInput(image);
+    this->ImageWriter->SetFileName(filename);
     this->ImageWriter->Write();
     this->ImageWriter->SetInput(0);
 
     errcode = this->ImageWriter->GetErrorCode();
-    this->FileCount = (!errcode)? this->FileCount + 1 : this->FileCount;
-
     }
   else if (this->MovieWriter)
     {
-    this->MovieWriter->SetInput(combinedImage);
+    this->MovieWriter->SetInput(image);
     this->MovieWriter->Write();
     this->MovieWriter->SetInput(0);
 
@@ -298,14 +505,7 @@ bool vtkSMAnimationSceneImageWriter::SaveFrame(double vtkNotUsed(time))
       errcode = alg_error;
       }
     }
-  combinedImage = 0;
-
-  if (errcode)
-    {
-    this->ErrorCode = errcode;
-    return false;
-    }
-  return true;
+  return errcode;
 }
 
 //-----------------------------------------------------------------------------
@@ -313,6 +513,13 @@ bool vtkSMAnimationSceneImageWriter::SaveFinalize()
 {
   this->AnimationScene->SetOverrideStillRender(0);
 
+  // Wait for the frames still being encoded.
+  int errcode = this->Internals->Stop();
+  if (errcode && !this->ErrorCode)
+    {
+    this->ErrorCode = errcode;
+    }
+
   // TODO: If save failed, we must remove the partially
   // written files.
   if (this->MovieWriter)
@@ -334,7 +541,7 @@ bool vtkSMAnimationSceneImageWriter::SaveFinalize()
       }
     }
 
-  return true;
+  return (errcode == 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -458,6 +665,7 @@ void vtkSMAnimationSceneImageWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Subsampling: " << this->Subsampling << endl;
   os << indent << "ErrorCode: " << this->ErrorCode << endl;
   os << indent << "FrameRate: " << this->FrameRate << endl;
+  os << indent << "EncodeInBackground: " << this->EncodeInBackground << endl;
   os << indent << "BackgroundColor: " << this->BackgroundColor[0]
     << ", " << this->BackgroundColor[1] << ", " << this->BackgroundColor[2]
     << endl;
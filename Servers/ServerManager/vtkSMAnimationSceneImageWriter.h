@@ -85,6 +85,15 @@ public:
   vtkSetMacro(FrameRate, double);
   vtkGetMacro(FrameRate, double);
 
+  // Description:
+  // When on, the frames are compressed and written to the files (or encoded
+  // in the movie) by a separate thread while the following frames are
+  // rendered. Frames are still written in order. Ignored when VTK is built
+  // without thread support. Default value is 1.
+  vtkSetMacro(EncodeInBackground, int);
+  vtkGetMacro(EncodeInBackground, int);
+  vtkBooleanMacro(EncodeInBackground, int);
+
 
   // Description:
   // Convenience method used to merge a smaller image (\c src) into a 
@@ -124,6 +133,11 @@ protected:
 
   vtkImageData* NewFrame();
 
+  // Description:
+  // Writes a frame with the image or movie writer. filename is used only when
+  // writing an image series. Returns the error code of the writer.
+  int EncodeFrame(vtkImageData* image, const char* filename);
+
   vtkSetVector2Macro(ActualSize, int);
   int ActualSize[2];
   int Quality;
@@ -131,6 +145,7 @@ protected:
   int FileCount;
   int ErrorCode;
   int Subsampling;
+  int EncodeInBackground;
 
   char* Prefix;
   char* Suffix;
@@ -148,6 +163,12 @@ protected:
 private:
   vtkSMAnimationSceneImageWriter(const vtkSMAnimationSceneImageWriter&); // Not implemented.
   void operator=(const vtkSMAnimationSceneImageWriter&); // Not implemented.
+
+//BTX
+  class vtkInternals;
+  friend class vtkInternals;
+  vtkInternals* Internals;
+//ETX
 };
 
 
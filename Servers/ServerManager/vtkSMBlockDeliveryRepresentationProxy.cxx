@@ -15,6 +15,7 @@
 #include "vtkSMBlockDeliveryRepresentationProxy.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkCommand.h"
 #include "vtkDataObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
@@ -227,6 +228,24 @@ void vtkSMBlockDeliveryRepresentationProxy::Update(vtkSMViewProxy* view)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMBlockDeliveryRepresentationProxy::ExecuteSubProxyEvent(
+  vtkSMProxy* subproxy, unsigned long event, void* data)
+{
+  if (subproxy && subproxy == this->Streamer &&
+    event == vtkCommand::UpdatePropertyEvent && data)
+    {
+    // "Block" is pushed by Fetch() itself, every other property changes what
+    // goes in a block.
+    const char* name = reinterpret_cast<const char*>(data);
+    if (strcmp(name, "Block") != 0)
+      {
+      this->CacheDirty = true;
+      }
+    }
+  this->Superclass::ExecuteSubProxyEvent(subproxy, event, data);
+}
+
 //----------------------------------------------------------------------------
 // Ensure that the block selected by \c block is available on the client.
 void vtkSMBlockDeliveryRepresentationProxy::Fetch(vtkIdType block)
@@ -286,11 +305,31 @@ vtkDataObject* vtkSMBlockDeliveryRepresentationProxy::GetOutput(vtkIdType block)
 }
 
 //----------------------------------------------------------------------------
-vtkIdType vtkSMBlockDeliveryRepresentationProxy::GetNumberOfRequiredBlocks()
+vtkIdType vtkSMBlockDeliveryRepresentationProxy::GetNumberOfRows()
 {
   vtkPVDataInformation* dInfo = this->GetRepresentedDataInformation(true);
+  vtkIdType numRows = dInfo->GetNumberOfRows();
+  if (this->GetProperty("NumberOfTopRows") &&
+    this->GetProperty("SortColumnName"))
+    {
+    const char* column =
+      vtkSMPropertyHelper(this, "SortColumnName").GetAsString();
+    vtkIdType numTopRows =
+      vtkSMPropertyHelper(this, "NumberOfTopRows").GetAsIdType();
+    // vtkTableStreamer applies the limit to all the leaves together.
+    if (column && column[0] && numTopRows > 0 && numTopRows < numRows)
+      {
+      numRows = numTopRows;
+      }
+    }
+  return numRows;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMBlockDeliveryRepresentationProxy::GetNumberOfRequiredBlocks()
+{
   return static_cast<vtkIdType>(ceil(
-      static_cast<double>(dInfo->GetNumberOfRows())/
+      static_cast<double>(this->GetNumberOfRows())/
       vtkSMPropertyHelper(this, "BlockSize").GetAsIdType()));
 }
 
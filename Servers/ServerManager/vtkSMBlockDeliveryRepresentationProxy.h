@@ -67,6 +67,12 @@ public:
   // cleaned.
   void CleanCache();
 
+  // Description:
+  // Returns the number of rows that can be fetched. This is the number of rows
+  // in the input, unless the rows are sorted with a limit on the number of
+  // top rows.
+  vtkIdType GetNumberOfRows();
+
   // Description:
   // Returns the number of blocks that are needed to fetch the entire input
   // dataset given the current block size.
@@ -93,6 +99,13 @@ protected:
   // Ensures that the block of data is available on the client.
   void Fetch(vtkIdType block);
 
+  // Description:
+  // Overridden to mark the cache dirty when a Streamer property that changes
+  // the contents of the blocks (such as the block size or the sort order) is
+  // pushed.
+  virtual void ExecuteSubProxyEvent(vtkSMProxy* o, unsigned long event,
+    void* data);
+
   vtkSMSourceProxy* PreProcessor;
   vtkSMSourceProxy* Streamer;
   vtkSMSourceProxy* Reduction;
@@ -667,10 +667,8 @@ void vtkSMComparativeViewProxy::UpdateFilmStripVisualization(
     // generated.
     view->SetCacheTime(view->GetCacheTime()+1.0);
 
-    // Make the view cache the current setup. 
-    // We do interactive render so that both the full-res as well as low-res cache
-    // is updated.
-    view->InteractiveRender();
+    // Make the view cache the current setup.
+    this->UpdateCachedView(view);
     }
 }
 
@@ -714,15 +712,27 @@ void vtkSMComparativeViewProxy::UpdateComparativeVisualization(
       // generated.
       view->SetCacheTime(view->GetCacheTime()+1.0);
 
-      // Make the view cache the current setup. 
-      // We do interactive render so that both the full-res as well as low-res cache
-      // is updated.
-      view->InteractiveRender();
+      // Make the view cache the current setup.
+      this->UpdateCachedView(view);
       view_index++;
       }
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMComparativeViewProxy::UpdateCachedView(vtkSMViewProxy* view)
+{
+  // Only the representation pipelines are updated (and their output cached)
+  // here. Rendering each view as soon as its data is ready used to render and
+  // composite every view twice per regeneration: once here and once when the
+  // StillRender on the root view is propagated to all the views through the
+  // ViewCameraLink. Now all views are rendered once, from their caches, by
+  // that StillRender. The low-res data is generated from the cached full-res
+  // data the first time a view is rendered interactively, without updating the
+  // pipeline shared by all the views.
+  view->UpdateAllRepresentations();
+}
+
 //----------------------------------------------------------------------------
 void vtkSMComparativeViewProxy::GetViews(vtkCollection* collection)
 {
@@ -243,6 +243,13 @@ protected:
   // Update timestrip scene.
   void UpdateFilmStripVisualization(vtkSMAnimationSceneProxy* scene);
 
+  // Description:
+  // Updates the representations of one of the internal views for the current
+  // state of the animation scene(s), caching the result. The view is not
+  // rendered: all the views are rendered together after the comparative
+  // visualization is generated.
+  void UpdateCachedView(vtkSMViewProxy* view);
+
   // Description:
   // Update layout for internal views.
   void UpdateViewLayout();
@@ -526,6 +526,13 @@ bool vtkSMRenderViewProxy::GetLODDecision()
   return (this->GetVisibileFullResDataSize() >= this->LODThreshold* 1000);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSMRenderViewProxy::GetUpdatedLODDecision()
+{
+  this->InvalidateDataSizes();
+  return this->GetLODDecision();
+}
+
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::BeginInteractiveRender()
 {
@@ -67,6 +67,20 @@ public:
   // Get/Set the LOD Resolution.
   void SetLODResolution(int);
   int GetLODResolution();
+
+  // Description:
+  // Determines if the LOD must be used for rendering. The difference between 
+  // GetUseLOD() and GetLODDecision() is that GetUseLOD() indicates if the
+  // most recent render decided to use LOD or not, while GetLODDecision()
+  // uses the current geometry sizes to indicate if their sum is above
+  // the LOD threshold.
+  virtual bool GetLODDecision();
+
+  // Description:
+  // Same as GetLODDecision() but discards the geometry sizes gathered
+  // earlier in the current render. Representations call it right after
+  // updating their full resolution data, when these sizes may be out of date.
+  bool GetUpdatedLODDecision();
    
   // Description:
   // Access to the rendering-related objects for the GUI.
@@ -295,14 +309,6 @@ protected:
   // Get whether the view module is currently using LOD.
   bool GetUseLOD();
 
-  // Description:
-  // Determines if the LOD must be used for rendering. The difference between 
-  // GetUseLOD() and GetLODDecision() is that GetUseLOD() indicates if the
-  // most recent render decided to use LOD or not, while GetLODDecision()
-  // uses the current geometry sizes to indicate if their sum is above
-  // the LOD threshold.
-  virtual bool GetLODDecision();
-
   // Description:
   // Called to process events.
   virtual void ProcessEvents(vtkObject* caller, unsigned long eventId, 
@@ -56,6 +56,7 @@ vtkSMRepresentationStrategy::vtkSMRepresentationStrategy()
   this->Observer = command;
 
   this->KeepLODPipelineUpdated = false;
+  this->PrepareLODPipeline = false;
   this->RepresentedDataInformation = 0;
   vtkPVGeometryInformation* info = vtkPVGeometryInformation::New();
   this->SetRepresentedDataInformation(info);
@@ -136,10 +137,16 @@ void vtkSMRepresentationStrategy::CleanCacheIfObsolete()
   if (this->SomethingCached && !this->GetUseCache())
     {
     this->SomethingCached = false;
-    this->CacheKeeper->InvokeCommand("RemoveAllCaches");
+    this->RemoveAllCaches();
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMRepresentationStrategy::RemoveAllCaches()
+{
+  this->CacheKeeper->InvokeCommand("RemoveAllCaches");
+}
+
 //----------------------------------------------------------------------------
 unsigned long vtkSMRepresentationStrategy::GetDisplayedMemorySize()
 {
@@ -162,6 +169,13 @@ bool vtkSMRepresentationStrategy::GetUseCache()
   return (this->EnableCaching && this->UseCache);
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMRepresentationStrategy::GetLODPipelineRequired()
+{
+  return (this->GetUseLOD() || (this->EnableLOD &&
+      (this->KeepLODPipelineUpdated || this->PrepareLODPipeline)));
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMRepresentationStrategy::UpdateRequired()
 {
@@ -171,7 +185,7 @@ bool vtkSMRepresentationStrategy::UpdateRequired()
 
   bool update_required = !this->GetDataValid();
 
-  if (this->GetUseLOD() || (this->EnableLOD && this->KeepLODPipelineUpdated))
+  if (this->GetLODPipelineRequired())
     {
     update_required |= !this->GetLODDataValid();
     }
@@ -191,8 +205,7 @@ void vtkSMRepresentationStrategy::Update()
       this->UpdatePipeline();
       }
 
-    if ((this->GetUseLOD() || (this->EnableLOD && this->KeepLODPipelineUpdated)) 
-      && !this->GetLODDataValid())
+    if (this->GetLODPipelineRequired() && !this->GetLODDataValid())
       {
       this->UpdateLODPipeline();
       }
@@ -216,8 +229,7 @@ void vtkSMRepresentationStrategy::UpdateDataInformation()
     info->Delete();
     }
 
-  if ( (this->GetUseLOD() || (this->EnableLOD && this->KeepLODPipelineUpdated)) 
-    && !this->LODInformationValid)
+  if (this->GetLODPipelineRequired() && !this->LODInformationValid)
     {
     vtkPVDataSizeInformation* info = vtkPVDataSizeInformation::New();
     this->GatherLODInformation(info);
@@ -394,6 +406,7 @@ void vtkSMRepresentationStrategy::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableCaching: " << this->EnableCaching << endl;
   os << indent << "KeepLODPipelineUpdated: " 
     << this->KeepLODPipelineUpdated << endl;
+  os << indent << "PrepareLODPipeline: " << this->PrepareLODPipeline << endl;
   os << indent << "RepresentedDataInformation: " 
     << this->RepresentedDataInformation << endl;
 }
@@ -166,6 +166,15 @@ public:
   vtkSetMacro(KeepLODPipelineUpdated, bool);
   vtkGetMacro(KeepLODPipelineUpdated, bool);
 
+  // Description:
+  // Representations set this to true to have the LOD pipeline updated with
+  // the full-res pipeline when they expect the view to use LOD on the next
+  // interaction. It is combined with KeepLODPipelineUpdated, which views and
+  // strategies set when they always need the LOD, and never turns it off.
+  // Default value is false.
+  vtkSetMacro(PrepareLODPipeline, bool);
+  vtkGetMacro(PrepareLODPipeline, bool);
+
   // Description:
   // Overridden to clear data valid flags.
   virtual void MarkDirty(vtkSMProxy* modifiedProxy);
@@ -298,6 +307,22 @@ protected:
   // When set to true, LODPipeline is always udpated with the full-res pipeline
   // (unless EnableLOD is false).
   bool KeepLODPipelineUpdated;
+  bool PrepareLODPipeline;
+
+  // Description:
+  // Returns true if the LOD pipeline must be updated, either because LOD is
+  // in use or because it is kept updated with the full-res pipeline.
+  bool GetLODPipelineRequired();
+
+  // Description:
+  // Removes the cached data. Called when caching is no longer used.
+  // Subclasses that cache more than the full-res data override this to clear
+  // their caches as well.
+  virtual void RemoveAllCaches();
+
+  // Flag used to avoid unnecessary "RemoveAllCaches" requests being set to the
+  // server. Subclasses set it when they cache data.
+  bool SomethingCached;
 
   vtkInformation* ViewInformation;
 
@@ -311,10 +336,6 @@ private:
   // building cache.
   void CleanCacheIfObsolete();
 
-  // Flag used to avoid unnecessary "RemoveAllCaches" requests being set to the
-  // server.
-  bool SomethingCached;
-
 private:
   vtkSMRepresentationStrategy(const vtkSMRepresentationStrategy&); // Not implemented
   void operator=(const vtkSMRepresentationStrategy&); // Not implemented
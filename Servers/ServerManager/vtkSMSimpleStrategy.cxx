@@ -20,6 +20,7 @@
 #include "vtkPVDataSizeInformation.h"
 #include "vtkSMDoubleVectorProperty.h"
 #include "vtkSMIntVectorProperty.h"
+#include "vtkSMPropertyHelper.h"
 #include "vtkSMSourceProxy.h"
 
 vtkStandardNewMacro(vtkSMSimpleStrategy);
@@ -28,6 +29,7 @@ vtkCxxRevisionMacro(vtkSMSimpleStrategy, "$Revision$");
 vtkSMSimpleStrategy::vtkSMSimpleStrategy()
 {
   this->LODDecimator = 0;
+  this->LODCacheKeeper = 0;
   this->UpdateSuppressor = 0;
   this->UpdateSuppressorLOD = 0;
   this->SetEnableLOD(true);
@@ -50,6 +52,8 @@ void vtkSMSimpleStrategy::BeginCreateVTKObjects()
     vtkSMSourceProxy::SafeDownCast(this->GetSubProxy("UpdateSuppressor"));
   this->UpdateSuppressorLOD = 
     vtkSMSourceProxy::SafeDownCast(this->GetSubProxy("UpdateSuppressorLOD"));
+  this->LODCacheKeeper = 
+    vtkSMSourceProxy::SafeDownCast(this->GetSubProxy("LODCacheKeeper"));
 
   this->UpdateSuppressor->SetServers(vtkProcessModule::CLIENT_AND_SERVERS);
 
@@ -57,6 +61,10 @@ void vtkSMSimpleStrategy::BeginCreateVTKObjects()
     {
     this->LODDecimator->SetServers(vtkProcessModule::DATA_SERVER);
     this->UpdateSuppressorLOD->SetServers(vtkProcessModule::CLIENT_AND_SERVERS);
+    if (this->LODCacheKeeper)
+      {
+      this->LODCacheKeeper->SetServers(vtkProcessModule::DATA_SERVER);
+      }
     }
   else
     {
@@ -74,7 +82,15 @@ void vtkSMSimpleStrategy::CreatePipeline(vtkSMSourceProxy* input, int outputport
 void vtkSMSimpleStrategy::CreateLODPipeline(vtkSMSourceProxy* input, int outputport)
 {
   this->Connect(input, this->LODDecimator, "Input", outputport);
-  this->Connect(this->LODDecimator, this->UpdateSuppressorLOD, "Input", 0);
+  if (this->LODCacheKeeper)
+    {
+    this->Connect(this->LODDecimator, this->LODCacheKeeper, "Input", 0);
+    this->Connect(this->LODCacheKeeper, this->UpdateSuppressorLOD, "Input", 0);
+    }
+  else
+    {
+    this->Connect(this->LODDecimator, this->UpdateSuppressorLOD, "Input", 0);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -136,11 +152,41 @@ void vtkSMSimpleStrategy::UpdateLODPipeline()
 
   this->Superclass::UpdateLODPipeline();
 
+  if (this->LODCacheKeeper)
+    {
+    // When caching, the decimated geometry is kept for every cache time it
+    // has been computed for, until the input pipeline (or the LOD
+    // resolution) changes. Going back to a cached time step then does not
+    // decimate again.
+    bool cachingEnabled = this->GetUseCache();
+    vtkSMPropertyHelper(this->LODCacheKeeper, "CachingEnabled").Set(
+      cachingEnabled? 1 : 0);
+    vtkSMPropertyHelper(this->LODCacheKeeper,
+      "ClearCacheWhenInputModified").Set(1);
+    vtkSMPropertyHelper(this->LODCacheKeeper, "CacheTime").Set(
+      this->CacheTime);
+    this->LODCacheKeeper->UpdateVTKObjects();
+    if (cachingEnabled)
+      {
+      this->SomethingCached = true;
+      }
+    }
+
   this->UpdateSuppressorLOD->InvokeCommand("ForceUpdate");
   // This is called for its side-effects; i.e. to force a PostUpdateData()
   this->UpdateSuppressorLOD->UpdatePipeline();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSimpleStrategy::RemoveAllCaches()
+{
+  this->Superclass::RemoveAllCaches();
+  if (this->LODCacheKeeper)
+    {
+    this->LODCacheKeeper->InvokeCommand("RemoveAllCaches");
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSimpleStrategy::SetLODResolution(int resolution)
 {
@@ -54,7 +54,9 @@ protected:
   // Description:
   // Create and initialize the LOD data pipeline.
   // Note that this method is called irrespective of EnableLOD
-  // flag.
+  // flag. If the strategy has a LODCacheKeeper subproxy, it is inserted
+  // after the decimator so that the LOD geometry is cached along with the
+  // full-res data when caching is used.
   virtual void CreateLODPipeline(vtkSMSourceProxy* input, int outputport);
 
   // Description:
@@ -90,9 +92,14 @@ protected:
   // has indeed changed.
   virtual void SetLODResolution(int resolution);
 
+  // Description:
+  // Overridden to clear the LOD cache as well.
+  virtual void RemoveAllCaches();
+
   vtkSMSourceProxy* UpdateSuppressor;
   vtkSMSourceProxy* UpdateSuppressorLOD;
   vtkSMSourceProxy* LODDecimator;
+  vtkSMSourceProxy* LODCacheKeeper;
 
 private:
   vtkSMSimpleStrategy(const vtkSMSimpleStrategy&); // Not implemented
@@ -126,9 +126,11 @@ void vtkSMSpreadSheetRepresentationProxy::PassEssentialAttributes()
   // properties has to be managed a bit more gracefully.
 
   // Pass essential properties to the selection representation
-  // such as "BlockSize", "CacheSize", "FieldAssociation"
+  // such as "BlockSize", "CacheSize", "FieldAssociation" and the sort
+  // parameters, so that the selection blocks line up with the data blocks.
   const char* pnames[] =
-    {"BlockSize", "CacheSize", "FieldAssociation", 0};
+    {"BlockSize", "CacheSize", "FieldAssociation", "SortColumnName",
+    "SortComponent", "SortDescending", "NumberOfTopRows", 0};
   for (int cc=0; pnames[cc]; cc++)
     {
     vtkSMProperty* src = this->GetProperty(pnames[cc]);
@@ -15,6 +15,7 @@
 #include "vtkSMStateLoader.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSmartPointer.h"
@@ -48,6 +49,10 @@ struct vtkSMStateLoaderInternals
   typedef vtkstd::vector<vtkSMStateLoaderRegistrationInfo> VectorOfRegInfo;
   typedef vtkstd::map<int, VectorOfRegInfo> RegInfoMapType;
   RegInfoMapType RegistrationInformation;
+
+  // Source proxies created while loading the state, whose pipeline
+  // information is updated once all proxies are created.
+  vtkstd::vector<vtkSmartPointer<vtkSMSourceProxy> > SourceProxies;
 };
 
 //---------------------------------------------------------------------------
@@ -152,9 +157,12 @@ void vtkSMStateLoader::CreatedNewProxy(int id, vtkSMProxy* proxy)
   // Ensure that the proxy is created before it is registered, unless we are
   // reviving the server-side server manager, which needs special handling.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxy);
+  if (source)
     {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    // Updating the pipeline information requires a round trip to the
+    // servers, so it is done once all the proxies are created.
+    this->Internal->SourceProxies.push_back(source);
     }
   this->RegisterProxy(id, proxy);
 }
@@ -465,9 +473,25 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem)
     return 0;
     }
 
+  // The streams creating the proxies and pushing their properties are sent
+  // to the servers in a batch instead of one by one.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType cid = this->ProxyLocator->GetConnectionID();
+  pm->BeginStreamBatch(cid);
+
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
+
+  vtkstd::vector<vtkSmartPointer<vtkSMSourceProxy> >::iterator iter;
+  for (iter = this->Internal->SourceProxies.begin();
+    iter != this->Internal->SourceProxies.end(); ++iter)
+    {
+    (*iter)->UpdatePipelineInformation();
+    }
+  this->Internal->SourceProxies.clear();
+
+  pm->EndStreamBatch(cid);
   return ret;
 }
 
@@ -34,7 +34,9 @@
 #include "vtkSMMaterialLoaderProxy.h"
 #include "vtkSMOutputPort.h"
 #include "vtkSMProxyProperty.h"
+#include "vtkSMRenderViewProxy.h"
 #include "vtkSMRepresentationStrategy.h"
+#include "vtkSMRepresentationStrategyVector.h"
 #include "vtkSMSelectionHelper.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
@@ -113,6 +115,38 @@ bool vtkSMSurfaceRepresentationProxy::InitializeStrategy(vtkSMViewProxy* view)
   return this->Superclass::InitializeStrategy(view);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSurfaceRepresentationProxy::Update(vtkSMViewProxy* view)
+{
+  // Decimate right after the full resolution geometry is updated only when
+  // the view will switch to LOD on the next interaction. Below the LOD
+  // threshold the LOD geometry is never shown, so it is not computed.
+  // The full resolution geometry is updated first so that the decision uses
+  // its current size, e.g. on the first Apply.
+  vtkSMRepresentationStrategyVector activeStrategies;
+  this->GetActiveStrategies(activeStrategies);
+  vtkSMRepresentationStrategyVector::iterator iter;
+  for (iter = activeStrategies.begin(); iter != activeStrategies.end(); ++iter)
+    {
+    iter->GetPointer()->SetPrepareLODPipeline(false);
+    }
+
+  this->Superclass::Update(view);
+
+  vtkSMRenderViewProxy* renderView = vtkSMRenderViewProxy::SafeDownCast(view);
+  if (this->SuppressLOD || !this->GetVisibility() || !renderView ||
+    !renderView->GetUpdatedLODDecision())
+    {
+    return;
+    }
+
+  for (iter = activeStrategies.begin(); iter != activeStrategies.end(); ++iter)
+    {
+    iter->GetPointer()->SetPrepareLODPipeline(true);
+    iter->GetPointer()->Update();
+    }
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMSurfaceRepresentationProxy::BeginCreateVTKObjects()
 {
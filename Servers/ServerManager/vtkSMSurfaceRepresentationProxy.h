@@ -127,6 +127,13 @@ public:
   // Overridden to add modification observer.
   virtual void SetViewInformation(vtkInformation*);
 
+  // Description:
+  // Overridden to keep the LOD pipeline updated with the full resolution
+  // pipeline when the geometry shown in a render view is above its LOD
+  // threshold, so that the first interaction does not wait for the LOD.
+  virtual void Update(vtkSMViewProxy* view);
+  virtual void Update() { this->Superclass::Update(); }
+
   // Description:
   // SuppressLOD controls whether this representation will use LOD
   // when asked by the render view. It can be used to disable LOD of
@@ -1,9 +1,21 @@
-""" This module can be used to run a simple rendering benchmark test. This
-test renders a sphere with various rendering settings and reports the rendering
-rate achieved in triangles/sec. """
+""" This module can be used to run benchmarks. run() renders a sphere with
+various rendering settings and reports the rendering rate achieved in
+triangles/sec. run_suite() times readers, filters, geometry delivery and
+compositing on synthetic data (so that no data files are needed) and writes
+the results along with a description of the machine as comma separated
+values. compare() checks such results against a baseline so that a release
+can be gated on performance regressions.
 
-import time
+The suite can be run with pvpython (builtin or connected to a pvserver on
+the local machine, which stands in for a remote client) or with pvbatch
+under mpirun:
+  mpirun -np 4 pvbatch benchmark.py --output results.csv
+  pvpython benchmark.py --server localhost:11111 --baseline baseline.csv
+"""
+
+import os
 import sys
+import time
 from paraview import servermanager
 
 def render(ss, v, title, nframes):
@@ -135,6 +147,483 @@ def run(filename=None, nframes=60):
   for i in results:
     print >>f, '"%s", %g, %g' % (i[0], i[1][1], i[2][1])  
 
+# The suites run by run_suite().
+SUITES = ('readers', 'filters', 'delivery', 'compositing')
+
+def _create(group, name, **props):
+  """ Creates a proxy given its XML group and name, and sets the given
+  properties using their XML names. The proxy is not registered. """
+  proxy = servermanager._getPyProxy(servermanager.CreateProxy(group, name))
+  if not proxy:
+    raise RuntimeError, "Could not create proxy %s in group %s." % \
+      (name, group)
+  for key, value in props.items():
+    proxy.SetPropertyWithName(key, value)
+  proxy.UpdateVTKObjects()
+  return proxy
+
+def _select_array(proxy, pname, name, association=0):
+  """ Sets an input array selection property (of 5 elements) directly on
+  the server manager proxy. association is 0 for points, 1 for cells. """
+  prop = proxy.SMProxy.GetProperty(pname)
+  prop.SetElement(3, str(association))
+  prop.SetElement(4, name)
+  proxy.UpdateVTKObjects()
+
+def _update(proxy):
+  """ Updates a proxy and gathers its data information. Gathering the
+  information waits for all the processes so the update is timed on all
+  of them. Returns the number of cells. """
+  proxy.UpdatePipeline()
+  return proxy.GetDataInformation().GetNumberOfCells()
+
+def _time(func, repeat):
+  """ Calls func repeat times and returns the smallest time taken by one call
+  along with the value it returned. """
+  best = None
+  value = None
+  for i in range(repeat):
+    start = time.time()
+    value = func()
+    elapsed = time.time() - start
+    if best is None or elapsed < best:
+      best = elapsed
+  return best, value
+
+def _time_execution(create, repeat):
+  """ Times the execution of a proxy made by create(). A new proxy is
+  created for every repetition so that it executes again while its input,
+  already up to date, does not. """
+  def execute():
+    return _update(create())
+  return _time(execute, repeat)
+
+def _wavelet(size):
+  """ Returns a wavelet source with size points along each axis. """
+  half = size/2
+  return _create("sources", "RTAnalyticSource",
+    WholeExtent=[-half, size-half-1, -half, size-half-1, -half, size-half-1])
+
+def get_hardware_info():
+  """ Returns a list of (key, value) pairs that describe the machine and
+  the ParaView configuration the benchmarks run on. """
+  import platform
+  info = []
+  info.append(('host', platform.node()))
+  info.append(('platform', platform.platform()))
+  info.append(('processor', platform.processor() or platform.machine()))
+  try:
+    for line in open('/proc/cpuinfo'):
+      if line.startswith('model name'):
+        info.append(('cpu', line.split(':', 1)[1].strip()))
+        break
+  except IOError:
+    pass
+  try:
+    info.append(('cores', os.sysconf('SC_NPROCESSORS_ONLN')))
+  except (AttributeError, ValueError, OSError):
+    pass
+  info.append(('python', platform.python_version()))
+  info.append(('paraview',
+    servermanager.vtkSMProxyManager.GetParaViewSourceVersion()))
+  connection = servermanager.ActiveConnection
+  if connection:
+    info.append(('connection', str(connection)))
+    info.append(('processes', connection.GetNumberOfDataPartitions()))
+  return info
+
+def _get_gl_info(view):
+  """ Returns (key, value) pairs describing the OpenGL implementation used
+  by the view, when it can be queried on this process. """
+  info = []
+  try:
+    caps = view.GetRenderWindow().ReportCapabilities()
+  except AttributeError:
+    return info
+  for line in caps.split('\n'):
+    for key in ('vendor', 'renderer', 'version'):
+      if line.startswith('OpenGL %s string:' % key):
+        info.append(('gl_%s' % key, line.split(':', 1)[1].strip()))
+  return info
+
+def benchmark_readers(size, repeat, tmpdir, spyplot_file=None):
+  """ Writes a wavelet in several formats to tmpdir and times reading it
+  back. SpyPlot files cannot be written by ParaView, so that reader is only
+  timed when spyplot_file is given. """
+  results = []
+  nprocs = servermanager.ActiveConnection.GetNumberOfDataPartitions()
+  wavelet = _wavelet(size)
+
+  # XML image data, one piece per process.
+  fname = os.path.join(tmpdir, 'wavelet.pvti')
+  writer = _create("writers", "XMLPImageDataWriter", Input=wavelet,
+    FileName=fname)
+  writer.UpdatePipeline()
+  t, cells = _time_execution(
+    lambda: _create("sources", "XMLPImageDataReader", FileName=[fname]),
+    repeat)
+  results.append(('readers', 'xml image data', cells, t))
+
+  # Exodus, written one file per process from the thresholded wavelet.
+  threshold = _create("filters", "Threshold", Input=wavelet,
+    ThresholdBetween=[0, 1000])
+  _select_array(threshold, "SelectInputScalars", "RTData")
+  fname = os.path.join(tmpdir, 'wavelet.ex2')
+  writer = _create("writers", "ExodusIIWriter", Input=threshold,
+    FileName=fname)
+  writer.UpdatePipeline()
+  if nprocs > 1:
+    fname = "%s.%d.0" % (fname, nprocs)
+  t, cells = _time_execution(
+    lambda: _create("sources", "ExodusIIReader", FileName=[fname]),
+    repeat)
+  results.append(('readers', 'exodus', cells, t))
+
+  # Raw floats, written on this process.
+  import array
+  values = array.array('f')
+  for k in range(size):
+    for j in range(size):
+      for i in range(size):
+        values.append(i + 2*j + 3*k)
+  fname = os.path.join(tmpdir, 'wavelet.raw')
+  f = open(fname, 'wb')
+  values.tofile(f)
+  f.close()
+  if sys.byteorder == 'little':
+    byteorder = 1
+  else:
+    byteorder = 0
+  t, cells = _time_execution(
+    lambda: _create("sources", "ImageReader", FilePrefix=fname,
+      DataScalarType=10, DataByteOrder=byteorder,
+      DataExtent=[0, size-1, 0, size-1, 0, size-1]),
+    repeat)
+  results.append(('readers', 'raw', cells, t))
+
+  if spyplot_file:
+    t, cells = _time_execution(
+      lambda: _create("sources", "spcthreader", FileName=spyplot_file),
+      repeat)
+    results.append(('readers', 'spyplot', cells, t))
+  return results
+
+def benchmark_filters(size, repeat):
+  """ Times the key filters on a wavelet, a Mandelbrot fractal and a
+  hierarchical (AMR) fractal. """
+  results = []
+  wavelet = _wavelet(size)
+  _update(wavelet)
+
+  def contour():
+    c = _create("filters", "Contour", Input=wavelet, ContourValues=[157])
+    _select_array(c, "SelectInputScalars", "RTData")
+    return c
+  t, cells = _time_execution(contour, repeat)
+  results.append(('filters', 'contour', cells, t))
+
+  def clip():
+    plane = _create("implicit_functions", "Plane", Origin=[0, 0, 0],
+      Normal=[1, 1, 0])
+    return _create("filters", "Clip", Input=wavelet, ClipFunction=plane)
+  t, cells = _time_execution(clip, repeat)
+  results.append(('filters', 'clip', cells, t))
+
+  def cut():
+    plane = _create("implicit_functions", "Plane", Origin=[0, 0, 0],
+      Normal=[1, 1, 1])
+    return _create("filters", "Cut", Input=wavelet, CutFunction=plane)
+  t, cells = _time_execution(cut, repeat)
+  results.append(('filters', 'slice', cells, t))
+
+  def threshold():
+    th = _create("filters", "Threshold", Input=wavelet,
+      ThresholdBetween=[150, 250])
+    _select_array(th, "SelectInputScalars", "RTData")
+    return th
+  t, cells = _time_execution(threshold, repeat)
+  results.append(('filters', 'threshold', cells, t))
+
+  gradient = _create("filters", "Gradient", Input=wavelet)
+  _select_array(gradient, "SelectInputScalars", "RTData")
+  _update(gradient)
+  def streamtracer():
+    seeds = _create("extended_sources", "PointSource", Center=[0, 0, 0],
+      Radius=size/4.0, NumberOfPoints=100)
+    st = _create("filters", "StreamTracer", Input=gradient, Source=seeds,
+      MaximumPropagation=[size])
+    _select_array(st, "SelectInputVectors", "RTDataGradient")
+    return st
+  t, cells = _time_execution(streamtracer, repeat)
+  results.append(('filters', 'stream tracer', cells, t))
+
+  t, cells = _time_execution(
+    lambda: _create("filters", "D3", Input=wavelet), repeat)
+  results.append(('filters', 'd3', cells, t))
+
+  fractal = _create("sources", "ImageMandelbrotSource",
+    WholeExtent=[0, size-1, 0, size-1, 0, size-1])
+  _update(fractal)
+  def fractal_contour():
+    c = _create("filters", "Contour", Input=fractal, ContourValues=[50])
+    _select_array(c, "SelectInputScalars", "Iterations")
+    return c
+  t, cells = _time_execution(fractal_contour, repeat)
+  results.append(('filters', 'mandelbrot contour', cells, t))
+
+  amr = _create("sources", "HierarchicalFractal", Dimensions=10,
+    MaximumLevel=5, TwoDimensional=0)
+  _update(amr)
+  amrpoints = _create("filters", "CellDataToPointData", Input=amr)
+  _update(amrpoints)
+  def amr_contour():
+    c = _create("filters", "Contour", Input=amrpoints, ContourValues=[0.5])
+    _select_array(c, "SelectInputScalars", "Fractal Volume Fraction")
+    return c
+  t, cells = _time_execution(amr_contour, repeat)
+  results.append(('filters', 'amr fractal contour', cells, t))
+  return results
+
+def _render_frames(view, nframes):
+  """ Renders nframes frames while rotating the camera and returns the
+  average time per frame. """
+  c = view.GetActiveCamera()
+  view.StillRender()
+  start = time.time()
+  for i in range(nframes):
+    c.Azimuth(1)
+    view.StillRender()
+  return (time.time() - start)/nframes
+
+def _remove_representation(view, rep):
+  newr = []
+  for r in view.Representations:
+    if r != rep:
+      newr.append(r)
+  view.Representations = newr
+
+def benchmark_delivery(size, repeat, view):
+  """ Times the first render of a contour surface, which includes moving
+  the geometry (vtkMPIMoveData) to where it is rendered. The move mode is
+  chosen by the view from its thresholds, so only the modes the view
+  supports are timed. """
+  results = []
+  wavelet = _wavelet(size)
+  contour = _create("filters", "Contour", Input=wavelet, ContourValues=[157])
+  _select_array(contour, "SelectInputScalars", "RTData")
+  cells = _update(contour)
+
+  modes = []
+  if view.GetProperty("RemoteRenderThreshold"):
+    modes.append(('pass through', 'RemoteRenderThreshold', 0))
+    modes.append(('collect', 'RemoteRenderThreshold', 1e6))
+  if view.GetProperty("CollectGeometryThreshold"):
+    modes.append(('clone', 'CollectGeometryThreshold', 1e6))
+  if not modes:
+    modes.append(('local', None, None))
+
+  for name, pname, value in modes:
+    if pname:
+      view.SetPropertyWithName(pname, value)
+    def first_render():
+      rep = servermanager.CreateRepresentation(contour, view)
+      view.ResetCamera()
+      view.StillRender()
+      _remove_representation(view, rep)
+    t, dummy = _time(first_render, repeat)
+    results.append(('delivery', name, cells, t))
+  return results
+
+def benchmark_compositing(size, nframes, view):
+  """ Times still renders of a contour surface with the compositing
+  options and image compressors the view supports. """
+  results = []
+  wavelet = _wavelet(size)
+  contour = _create("filters", "Contour", Input=wavelet, ContourValues=[157])
+  _select_array(contour, "SelectInputScalars", "RTData")
+  cells = _update(contour)
+  rep = servermanager.CreateRepresentation(contour, view)
+  view.ResetCamera()
+
+  if view.GetProperty("RemoteRenderThreshold"):
+    view.RemoteRenderThreshold = 0
+  configs = [('default', [])]
+  if view.GetProperty("DisableOrderedCompositing"):
+    configs.append(('no ordered compositing',
+      [('DisableOrderedCompositing', 1)]))
+    configs.append(('ordered compositing',
+      [('DisableOrderedCompositing', 0)]))
+  if view.GetProperty("ImageReductionFactor"):
+    for factor in (2, 4):
+      configs.append(('image reduction %d' % factor,
+        [('ImageReductionFactor', factor)]))
+  if view.GetProperty("CompressorConfig"):
+    for config in ('vtkSquirtCompressor 0 0', 'vtkSquirtCompressor 0 3',
+                   'vtkZlibImageCompressor 0 1 0 0',
+                   'vtkZlibImageCompressor 0 6 3 1'):
+      configs.append((config, [('CompressorConfig', config)]))
+
+  for name, props in configs:
+    old = []
+    for pname, value in props:
+      old.append((pname, view.GetPropertyValue(pname)))
+      view.SetPropertyWithName(pname, value)
+    t = _render_frames(view, nframes)
+    results.append(('compositing', name, cells, t))
+    for pname, value in old:
+      view.SetPropertyWithName(pname, value)
+
+  _remove_representation(view, rep)
+  return results
+
+def run_suite(filename=None, suites=SUITES, size=100, repeat=3, nframes=20,
+              spyplot_file=None):
+  """ Runs the benchmark suites and writes their results as csv to filename
+  (or to the standard output). size is the number of points along each axis
+  of the synthetic volumes. Execution times are the best of repeat runs.
+  Rendering times are averaged over nframes frames. Returns the results as
+  a list of (suite, name, number of cells, seconds) tuples. """
+  import shutil
+  import tempfile
+
+  if servermanager.progressObserverTag:
+    servermanager.ToggleProgressPrinting()
+  if not servermanager.ActiveConnection:
+    servermanager.Connect()
+
+  # A view created here is registered so that it can be deleted at the end.
+  view = None
+  created_view = False
+  if 'delivery' in suites or 'compositing' in suites:
+    view = servermanager.GetRenderView()
+    if not view:
+      view = servermanager.CreateRenderView(registrationGroup="views",
+        registrationName="benchmark view")
+      created_view = True
+
+  results = []
+  info = get_hardware_info()
+  tmpdir = tempfile.mkdtemp()
+  try:
+    if 'readers' in suites:
+      results += benchmark_readers(size, repeat, tmpdir, spyplot_file)
+    if 'filters' in suites:
+      results += benchmark_filters(size, repeat)
+    if 'delivery' in suites:
+      results += benchmark_delivery(size, repeat, view)
+    if 'compositing' in suites:
+      results += benchmark_compositing(size, nframes, view)
+    if view:
+      info += _get_gl_info(view)
+  finally:
+    shutil.rmtree(tmpdir, True)
+    if created_view:
+      servermanager.ProxyManager().UnRegisterProxy("views", "benchmark view",
+        view)
+    view = None
+
+  info.append(('size', size))
+  info.append(('date', time.strftime('%Y-%m-%d %H:%M:%S')))
+  write_results(results, info, filename)
+  return results
+
+def write_results(results, info, filename=None):
+  """ Writes the results as csv. The lines describing the machine start
+  with a #. """
+  nprocs = servermanager.ActiveConnection.GetNumberOfDataPartitions()
+  if filename:
+    f = open(filename, "w")
+  else:
+    f = sys.stdout
+  for key, value in info:
+    print >>f, '# %s: %s' % (key, value)
+  print >>f, 'suite, name, processes, cells, seconds'
+  for suite, name, cells, seconds in results:
+    print >>f, '%s, "%s", %d, %d, %g' % (suite, name, nprocs, cells, seconds)
+  if filename:
+    f.close()
+
+def read_results(filename):
+  """ Reads results written by write_results() into a dictionary that maps
+  (suite, name, processes) to seconds. """
+  results = {}
+  for line in open(filename):
+    line = line.strip()
+    if not line or line[0] == '#' or line.startswith('suite,'):
+      continue
+    suite, rest = line.split(',', 1)
+    name, rest = rest.strip()[1:].split('"', 1)
+    procs, cells, seconds = rest.strip(', ').split(',')
+    results[(suite.strip(), name, int(procs))] = float(seconds)
+  return results
+
+def compare(baseline, current, tolerance=0.2):
+  """ Compares two result files. Returns a list of the benchmarks that are
+  more than tolerance (a fraction) slower than in the baseline, as
+  (suite, name, processes, baseline seconds, current seconds) tuples. """
+  base = read_results(baseline)
+  cur = read_results(current)
+  regressions = []
+  keys = cur.keys()
+  keys.sort()
+  for key in keys:
+    if key in base and cur[key] > base[key]*(1.0 + tolerance):
+      regressions.append(key + (base[key], cur[key]))
+  return regressions
+
+def main(args):
+  """ Runs the suite from the command line. Returns 1 if a baseline is
+  given and a benchmark regressed, 0 otherwise. """
+  from optparse import OptionParser
+  parser = OptionParser(usage="%prog [options]")
+  parser.add_option("--output", help="write the results to this csv file")
+  parser.add_option("--baseline",
+    help="compare the results to this csv file")
+  parser.add_option("--tolerance", type="float", default=0.2,
+    help="allowed slow down relative to the baseline (default 0.2)")
+  parser.add_option("--suites", default=",".join(SUITES),
+    help="comma separated suites to run (default %default)")
+  parser.add_option("--size", type="int", default=100,
+    help="points along each axis of the synthetic volumes")
+  parser.add_option("--repeat", type="int", default=3,
+    help="number of times each execution is timed")
+  parser.add_option("--frames", type="int", default=20,
+    help="number of frames rendered per configuration")
+  parser.add_option("--server",
+    help="host[:port] of a pvserver to connect to")
+  parser.add_option("--spyplot", help="SpyPlot file to time reading")
+  parser.add_option("--render", action="store_true",
+    help="also run the sphere rendering benchmark")
+  (options, rest) = parser.parse_args(args)
+
+  if options.server:
+    host = options.server.split(':')
+    port = 11111
+    if len(host) > 1:
+      port = int(host[1])
+    servermanager.Connect(host[0], port)
+  else:
+    servermanager.Connect()
+
+  output = options.output
+  if options.baseline and not output:
+    import tempfile
+    handle, output = tempfile.mkstemp('.csv')
+    os.close(handle)
+  run_suite(output, options.suites.split(','), options.size,
+    options.repeat, options.frames, options.spyplot)
+  if options.render:
+    run(nframes=options.frames)
+
+  if not options.baseline:
+    return 0
+  regressions = compare(options.baseline, output, options.tolerance)
+  for suite, name, procs, base, cur in regressions:
+    print '%s "%s" on %d processes: %g s (baseline %g s)' % \
+      (suite, name, procs, cur, base)
+  if regressions:
+    return 1
+  return 0
+
 if __name__ == "__main__":
-  servermanager.Connect()
-  run()
\ No newline at end of file
+  sys.exit(main(sys.argv[1:]))
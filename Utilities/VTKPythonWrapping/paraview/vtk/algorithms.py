@@ -4,27 +4,76 @@ from paraview import servermanager
 from paraview import numpy_support
 from paraview import vtk
 
+_helper = None
+
+def _get_helper():
+    """Returns the vtkPVParallelArrayHelper used by this module. It is
+    kept so that the points shared among processes are found once for
+    each dataset."""
+    global _helper
+    if not _helper:
+        _helper = servermanager.vtkPVParallelArrayHelper()
+    return _helper
+
+def _to_vtk_array(narray):
+    "Returns a vtkDataArray pointing to the values of a numpy array."
+    narray = numpy.asarray(narray)
+    if len(narray.shape) > 2:
+        narray = narray.reshape(narray.shape[0],
+                                narray.size/max(narray.shape[0], 1))
+    if not narray.flags.contiguous:
+        narray = numpy.ascontiguousarray(narray)
+    return numpy_support.numpy_to_vtk(narray)
+
+def global_reduce(*reductions):
+    """Computes several reductions among all processes with one collective
+    operation. Each reduction is a pair of an operation ('min', 'max' or
+    'sum') and an array or a number. Arrays are reduced separately for each
+    component. Returns the list of results: a number for numbers and arrays
+    of one component, a numpy array otherwise. All processes must make the
+    same reductions in the same order. For example:
+      minimum, maximum, total = global_reduce(('min', a), ('max', a),
+                                              ('sum', len(a)))"""
+    helper = _get_helper()
+    helper.ClearReductions()
+    adders = {'min' : helper.AddMin, 'max' : helper.AddMax,
+              'sum' : helper.AddSum}
+    indices = []
+    for operation, value in reductions:
+        if isinstance(value, numpy.ndarray):
+            value = _to_vtk_array(value)
+        else:
+            value = float(value)
+        indices.append(adders[operation](value))
+    if not helper.Reduce():
+        raise RuntimeError, 'Global reduction failed.'
+    results = []
+    for index in indices:
+        ncomp = helper.GetNumberOfResultComponents(index)
+        if ncomp == 1:
+            results.append(helper.GetResult(index))
+        else:
+            results.append(numpy.array(
+                [helper.GetResult(index, i) for i in range(ncomp)]))
+    helper.ClearReductions()
+    return results
+
 def global_min(narray):
     "Returns the minimum value of the given array among all process."
-    local_min = min(narray)
-    pm = servermanager.vtkProcessModule.GetProcessModule()
-    if pm.GetNumberOfLocalPartitions == 1:
-        return local_min
-    else:
-        from mpi4py import MPI
-        comm = MPI.COMM_WORLD
-        return comm.Allreduce(local_min, None, MPI.MIN)
+    return global_reduce(('min', narray))[0]
 
 def global_max(narray):
     "Returns the maximum value of the given array among all process."
-    local_max = max(narray)
-    pm = servermanager.vtkProcessModule.GetProcessModule()
-    if pm.GetNumberOfLocalPartitions == 1:
-        return local_max
-    else:
-        from mpi4py import MPI
-        comm = MPI.COMM_WORLD
-        return comm.Allreduce(local_max, None, MPI.MAX)
+    return global_reduce(('max', narray))[0]
+
+def global_sum(narray):
+    "Returns the sum of the values of the given array among all process."
+    return global_reduce(('sum', narray))[0]
+
+def global_mean(narray):
+    "Returns the mean of the values of the given array among all process."
+    total, count = global_reduce(('sum', narray), ('sum', len(narray)))
+    return total/count
 
 def dot(a1, a2):
     m = a1*a2
@@ -56,7 +105,11 @@ def divergence(narray, dataset=None):
     return dataset_adapter.VTKArray(numpy.add.reduce(g.diagonal(axis1=1, axis2=2), 1),\
         dataset=dataset)
 
-def _cell_derivatives(narray, dataset, attribute_type, filter):
+def _gradient(narray, dataset, attribute_type):
+    """Returns the point gradient of narray over dataset as a vtkDataArray.
+    The values of the neighbor pieces are taken into account on the
+    boundary of the local piece, so the result does not depend on the
+    number of processes."""
     # basic error checking
     if not dataset:
         raise RuntimeError, 'Need a dataset to compute gradients'
@@ -71,46 +124,31 @@ def _cell_derivatives(narray, dataset, attribute_type, filter):
     if attribute_type == 'vectors' and ncomp != 3:
         raise RuntimeError, 'This function expects vectors.'
 
-    # create a dataset with only our array but the same geometry/topology
-    ds = dataset.NewInstance()
-    ds.CopyStructure(dataset.VTKObject)
-    # numpy_to_vtk converts only contiguous arrays
-    if not narray.flags.contiguous:
-        narray = narray.copy()
-    varray = numpy_support.numpy_to_vtk(narray)
-
-    if attribute_type == 'scalars':
-        varray.SetName('scalars')
-        ds.GetPointData().SetScalars(varray)
-    else:
-        varray.SetName('vectors')
-        ds.GetPointData().SetVectors(varray)
-
-    # setup and execute the pipeline
-    # filter (vtkCellDerivatives) must  have all of its properties
-    # set
-    filter.SetInput(ds)
-    ds.UnRegister(None)
-    c2p = vtk.vtkCellDataToPointData()
-    c2p.SetInputConnection(filter.GetOutputPort())
-    c2p.Update()
+    helper = _get_helper()
+    if not helper.ComputeGradient(dataset.VTKObject, _to_vtk_array(narray)):
+        raise RuntimeError, 'Could not compute the gradient.'
+    return helper.GetGradient()
 
-    return c2p.GetOutput().GetPointData()
+def _velocity_gradient(narray, dataset):
+    """Returns the gradient of a vector array as an array of 3x3 matrices
+    where [:, i, j] is the derivative of component i along axis j."""
+    if not dataset:
+        dataset = narray.DataSet()
+    g = _gradient(narray, dataset, 'vectors')
+    return dataset_adapter.vtkDataArrayToVTKArray(g, dataset)
 
 def curl(narray, dataset=None):
 
     if not dataset:
         dataset = narray.DataSet()
 
-    cd = vtk.vtkCellDerivatives()
-    cd.SetVectorModeToComputeVorticity()
-    
-    dsa = _cell_derivatives(narray, dataset, 'vectors', cd)
-
-    retVal = dsa.GetVectors()
-    retVal.SetName("vorticity")
+    g = numpy.asarray(_velocity_gradient(narray, dataset))
+    w = numpy.empty((g.shape[0], 3))
+    w[:, 0] = g[:, 2, 1] - g[:, 1, 2]
+    w[:, 1] = g[:, 0, 2] - g[:, 2, 0]
+    w[:, 2] = g[:, 1, 0] - g[:, 0, 1]
 
-    return dataset_adapter.vtkDataArrayToVTKArray(retVal, dataset)
+    return dataset_adapter.VTKArray(w, dataset=dataset)
 
 def vorticity(narray, dataset=None):
     return curl(narray, dataset)
@@ -120,12 +158,10 @@ def strain(narray, dataset=None):
     if not dataset:
         dataset = narray.DataSet()
 
-    cd = vtk.vtkCellDerivatives()
-    cd.SetTensorModeToComputeStrain()
-    
-    dsa = _cell_derivatives(narray, dataset, 'vectors', cd)
+    g = numpy.asarray(_velocity_gradient(narray, dataset))
+    s = 0.5*(g + g.transpose(0, 2, 1))
 
-    retVal = dsa.GetTensors()
+    retVal = numpy_support.numpy_to_vtk(s.reshape(s.shape[0], 9))
     retVal.SetName("strain")
 
     return dataset_adapter.vtkDataArrayToVTKArray(retVal, dataset)
@@ -140,18 +176,12 @@ def gradient(narray, dataset=None):
     if ncomp != 1 and ncomp != 3:
         raise RuntimeError, 'Gradient only works with scalars (1 component) and vectors (3 component)'
 
-    cd = vtk.vtkCellDerivatives()
     if ncomp == 1:
         attribute_type = 'scalars'
     else:
         attribute_type = 'vectors'
 
-    dsa = _cell_derivatives(narray, dataset, attribute_type, cd)
-
-    if ncomp == 1:
-        retVal = dsa.GetVectors()
-    else:
-        retVal = dsa.GetTensors()
+    retVal = _gradient(narray, dataset, attribute_type)
 
     try:
         if narray.GetName():
@@ -162,4 +192,3 @@ def gradient(narray, dataset=None):
         retVal.SetName("gradient")
 
     return dataset_adapter.vtkDataArrayToVTKArray(retVal, dataset)
-
@@ -19,12 +19,6 @@ class VTKObjectWrapper(object):
             return None
         return getattr(self.VTKObject, name)
 
-def MakeObserver(numpy_array):
-    "Internal function used to attach a numpy array to a vtk array"
-    def Closure(caller, event):
-        foo = numpy_array
-    return Closure
-
 def vtkDataArrayToVTKArray(array, dataset=None):
     "Given a vtkDataArray and a dataset owning it, returns a VTKArray."
     narray = numpy_support.vtk_to_numpy(array)
@@ -39,15 +33,13 @@ def vtkDataArrayToVTKArray(array, dataset=None):
     
 def numpyTovtkDataArray(array, name="numpy_array"):
     """Given a numpy array or a VTKArray and a name, returns a vtkDataArray.
-    The resulting vtkDataArray will store a reference to the numpy array
-    through a DeleteEvent observer: the numpy array is released only when
-    the vtkDataArray is destroyed."""
+    The vtkDataArray uses the memory of a contiguous array without copying
+    it and stores a reference to it: the numpy array is released only when
+    the vtkDataArray is destroyed. Other arrays are copied once."""
     if not array.flags.contiguous:
-        array = array.copy()
+        array = numpy.ascontiguousarray(array)
     vtkarray = numpy_support.numpy_to_vtk(array)
     vtkarray.SetName(name)
-    # This makes the VTK array carry a reference to the numpy array.
-    vtkarray.AddObserver('DeleteEvent', MakeObserver(array))
     return vtkarray
 
 def make_tensor_array_contiguous(array):
@@ -165,9 +157,11 @@ class DataSetAttributes(VTKObjectWrapper):
                  not narray.flags.contiguous):
                 narray  = narray.transpose(0, 2, 1)
 
-        # If array is not contiguous, make a deep copy that is contiguous
+        # If array is not contiguous, make a copy that is contiguous. This
+        # is the only copy made: contiguous arrays (such as the results
+        # of the python calculator) are used by VTK as they are.
         if not narray.flags.contiguous:
-            narray = narray.copy()
+            narray = numpy.ascontiguousarray(narray)
 
         # Flatten array of matrices to array of vectors
         if len(shape) == 3:
@@ -0,0 +1,134 @@
+"""This module evaluates the expressions of the python calculator. numpy
+allocates a new array for the result of every operation, so evaluating
+a*b + c*d directly allocates three arrays as large as the inputs. evaluate()
+walks the expression tree instead and writes the result of element-wise
+operations (arithmetic operators and numpy ufuncs) into the temporary
+arrays made by the operations below them. Most expressions need no more
+memory than one array for the result. Other parts of the expression (names,
+function calls, indexing etc.) are evaluated by python as usual."""
+
+import operator
+import numpy
+
+try:
+    import ast
+except ImportError:
+    # Python versions older than 2.6 do not have the ast module. The
+    # expressions are then simply evaluated.
+    ast = None
+
+if ast:
+    _binary_operators = {
+        ast.Add : (numpy.add, operator.add),
+        ast.Sub : (numpy.subtract, operator.sub),
+        ast.Mult : (numpy.multiply, operator.mul),
+        ast.Div : (numpy.divide, operator.div),
+        ast.FloorDiv : (numpy.floor_divide, operator.floordiv),
+        ast.Mod : (numpy.remainder, operator.mod),
+        ast.Pow : (numpy.power, operator.pow) }
+    _unary_operators = {
+        ast.USub : (numpy.negative, operator.neg) }
+
+def broadcast(value, n):
+    """Returns an array of n tuples all set to the given scalar value. The
+    array has the type of value*ones((n, 1)), but no other array is
+    allocated."""
+    dtype = numpy.multiply(value, numpy.ones(1)).dtype
+    result = numpy.empty((n, 1), dtype)
+    result.fill(value)
+    return result
+
+def _sample(value):
+    "Returns a one element array of the same type as value if it is an array."
+    if isinstance(value, numpy.ndarray):
+        return value.flat[:1]
+    return value
+
+class _Evaluator(object):
+    """Evaluates an expression tree. Temporaries holds the arrays allocated
+    by the evaluator that are not used yet by an operation. Only those can
+    be overwritten: the arrays of the dataset never are."""
+
+    def __init__(self, globals, locals):
+        self.Globals = globals
+        self.Locals = locals
+        self.Temporaries = {}
+
+    def Evaluate(self, node):
+        if isinstance(node, ast.BinOp) and \
+          type(node.op) in _binary_operators:
+            left = self.Evaluate(node.left)
+            right = self.Evaluate(node.right)
+            return self.Apply(_binary_operators[type(node.op)], [left, right])
+        if isinstance(node, ast.UnaryOp) and \
+          type(node.op) in _unary_operators:
+            operand = self.Evaluate(node.operand)
+            return self.Apply(_unary_operators[type(node.op)], [operand])
+        if isinstance(node, ast.Call) and not node.keywords and \
+          not node.starargs and not node.kwargs:
+            func = self.Eval(node.func)
+            if isinstance(func, numpy.ufunc) and func.nout == 1 and \
+              func.nin == len(node.args):
+                args = [self.Evaluate(arg) for arg in node.args]
+                return self.Apply((func, func), args)
+            args = [self.Eval(arg) for arg in node.args]
+            return func(*args)
+        return self.Eval(node)
+
+    def Eval(self, node):
+        "Lets python evaluate a sub-expression."
+        code = compile(ast.Expression(node), '<expression>', 'eval')
+        return eval(code, self.Globals, self.Locals)
+
+    def Apply(self, funcs, args):
+        """Calls the ufunc in funcs on args, writing to one of the
+        temporaries among args when it has the right shape and type. Calls
+        the python function in funcs if there are no arrays among args."""
+        ufunc, pyfunc = funcs
+        hasarrays = False
+        for i in range(len(args)):
+            if isinstance(args[i], numpy.ndarray):
+                # Work on ndarrays: VTKArray is a matrix and the ufuncs
+                # would return matrices.
+                args[i] = numpy.asarray(args[i])
+                hasarrays = True
+        if not hasarrays:
+            return pyfunc(*args)
+
+        out = None
+        for arg in args:
+            if id(arg) in self.Temporaries:
+                out = arg
+                break
+        if out is not None:
+            olderr = numpy.seterr(all='ignore')
+            try:
+                dtype = ufunc(*[_sample(arg) for arg in args]).dtype
+            finally:
+                numpy.seterr(**olderr)
+            if dtype != out.dtype or \
+              numpy.broadcast(*args).shape != out.shape:
+                out = None
+
+        for arg in args:
+            if id(arg) in self.Temporaries:
+                del self.Temporaries[id(arg)]
+        if out is None:
+            result = ufunc(*args)
+        else:
+            result = ufunc(*(args + [out]))
+        if isinstance(result, numpy.ndarray):
+            self.Temporaries[id(result)] = result
+        return result
+
+def evaluate(expression, globals, locals):
+    """Evaluates expression in the given namespaces. The element-wise
+    operations reuse the memory of temporary results where possible."""
+    if not ast:
+        return eval(expression, globals, locals)
+    try:
+        tree = ast.parse(expression.strip(), '<expression>', 'eval')
+    except SyntaxError:
+        # Let eval report the error.
+        return eval(expression, globals, locals)
+    return _Evaluator(globals, locals).Evaluate(tree.body)
@@ -54,6 +54,7 @@ XdmfDataItem::XdmfDataItem() {
     this->Function = NULL;
 	this->ColumnMajor = 0;
 	this->TransposeInMemory = 1;
+    this->CollectiveIO = 0;
 }
 
 XdmfDataItem::~XdmfDataItem() {
@@ -514,6 +515,7 @@ XdmfInt32 XdmfDataItem::Update(){
             // this->SetDsmBuffer(this->Values->GetDsmBuffer());
             // cout << "Setting Values Dsm to " << this->DsmBuffer << endl;
             this->Values->SetDsmBuffer(this->DsmBuffer);
+            ((XdmfValuesHDF *)this->Values)->SetCollectiveIO(this->CollectiveIO);
             XdmfDebug("Reading Data");
             if(!((XdmfValuesHDF *)this->Values)->Read(this->Array)){
                 XdmfErrorMessage("Reading Values Failed");
@@ -204,6 +204,9 @@ public:
     XdmfSetValueMacro(ColumnMajor, XdmfInt32);
     XdmfGetValueMacro(TransposeInMemory, XdmfInt32);
     XdmfSetValueMacro(TransposeInMemory, XdmfInt32);
+    //! Use collective MPI-IO when reading HDF5 heavy data. All processes must read the same items.
+    XdmfGetValueMacro(CollectiveIO, XdmfInt32);
+    XdmfSetValueMacro(CollectiveIO, XdmfInt32);
 
 protected:
     XdmfInt32       Format;
@@ -217,6 +220,7 @@ protected:
     XdmfString      Function;
 	XdmfInt32  ColumnMajor;
 	XdmfInt32  TransposeInMemory;
+    XdmfInt32       CollectiveIO;
 
     //! Make sure this->Values is correct
     XdmfInt32       CheckValues(XdmfInt32 Format);
@@ -47,6 +47,7 @@ XdmfHDF::XdmfHDF() {
   this->NumberOfChildren = 0;
   this->Compression = 0;
   this->UseSerialFile = 0;
+  this->CollectiveIO = 0;
   // We may have been compiled with Parallel IO support, but be run only on a single
   // machine without mpiexec. Disable parallel if just one process.
 #if H5_HAVE_PARALLEL && ((H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=6)))
@@ -527,6 +528,7 @@ XdmfHDF::DoRead( XdmfArray *Array ) {
 
   herr_t      status;
   XDMF_HDF5_SIZE_T  src_npts, dest_npts;
+  hid_t       XferPlist = H5P_DEFAULT;
 
   if ( Array == NULL ){
     Array = new XdmfArray;
@@ -554,13 +556,26 @@ XdmfHDF::DoRead( XdmfArray *Array ) {
     XdmfDebug("Reading " << XDMF_64BIT_CAST(src_npts) << " items");
   }
 
+#if H5_HAVE_PARALLEL && ((H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=6)))
+  if( this->CollectiveIO && ( this->AccessPlist != H5P_DEFAULT ) &&
+      ( H5Pget_driver( this->AccessPlist ) == H5FD_MPIO ) ) {
+    XdmfDebug("Using Collective MPI-IO Transfer");
+    XferPlist = H5Pcreate( H5P_DATASET_XFER );
+    H5Pset_dxpl_mpio( XferPlist, H5FD_MPIO_COLLECTIVE );
+  }
+#endif
+
   status = H5Dread( this->Dataset,
     Array->GetDataType(),
     Array->GetDataSpace(),
     this->GetDataSpace(),
-    H5P_DEFAULT,
+    XferPlist,
     Array->GetDataPointer() );
 
+  if( XferPlist != H5P_DEFAULT ) {
+    H5Pclose( XferPlist );
+  }
+
   if ( status < 0 ) {
     return( NULL );
   }
@@ -104,6 +104,16 @@ public:
   XdmfSetValueMacro(UseSerialFile, XdmfInt32);
 //! Get Value of Use Serial
   XdmfGetValueMacro(UseSerialFile, XdmfInt32);
+//! Use Collective MPI-IO Transfers for Reads when the Parallel File Interface is in use
+/*!
+        Every process that opened the file must call Read()
+        for the same datasets in the same order, each with
+        its own hyperslab. This lets MPI-IO aggregate the
+        requests into large contiguous accesses.
+*/
+  XdmfSetValueMacro(CollectiveIO, XdmfInt32);
+//! Get Value of Collective IO
+  XdmfGetValueMacro(CollectiveIO, XdmfInt32);
 //! Set the current internal HDF "Group" for creation
   XdmfInt32 SetCwdName( XdmfConstString Directory );
 //! Get the current internal HDF "Group"
@@ -199,6 +209,7 @@ protected:
   char    CwdName[XDMF_MAX_STRING_LENGTH];
   XdmfInt32  Compression;
   XdmfInt32  UseSerialFile;
+  XdmfInt32  CollectiveIO;
   XdmfInt64  NumberOfChildren;
   XdmfString  Child[1024];
 };
@@ -31,6 +31,7 @@
 
 XdmfValuesHDF::XdmfValuesHDF() {
     this->SetFormat(XDMF_FORMAT_HDF);
+    this->CollectiveIO = 0;
 }
 
 XdmfValuesHDF::~XdmfValuesHDF() {
@@ -69,6 +70,7 @@ XdmfValuesHDF::Read(XdmfArray *anArray){
         RetArray->Allocate();
     }
     H5.SetDsmBuffer(this->DsmBuffer);
+    H5.SetCollectiveIO(this->CollectiveIO);
     if( H5.Open( DataSetName, "r" ) == XDMF_FAIL ) {
         XdmfErrorMessage("Can't Open Dataset " << DataSetName);
         if(!anArray) delete RetArray;
@@ -63,8 +63,13 @@ public :
   XdmfInt32 Write(XdmfArray *Array, XdmfConstString HeavyDataSetName=NULL);
   //! Produce Xml for an existing HDF5 Dataset
   XdmfString DataItemFromHDF(XdmfConstString H5DataSet);
+  //! Use collective MPI-IO transfers in Read() when the parallel file interface is in use
+  XdmfSetValueMacro(CollectiveIO, XdmfInt32);
+  //! Get Value of Collective IO
+  XdmfGetValueMacro(CollectiveIO, XdmfInt32);
 
 protected :
+  XdmfInt32  CollectiveIO;
 };
 
 #endif
@@ -78,6 +78,7 @@
 #include "XdmfSet.h"
 
 #include <sys/stat.h>
+#include <vtkstd/algorithm>
 #include <vtkstd/set>
 #include <vtkstd/map>
 #include <vtkstd/string>
@@ -163,8 +164,45 @@ public:
 
   vtkstd::vector<vtkXdmfReaderGrid*> Children;
   vtkSmartPointer<vtkInformation> Information;
+
+  // Piece that reads each child when this grid is the parallel level.
+  vtkstd::vector<unsigned int> ChildPieces;
+
+  // Estimated cost (number of cells) of reading this grid.
+  double EstimateCost();
 };
 
+//----------------------------------------------------------------------------
+double vtkXdmfReaderGrid::EstimateCost()
+{
+  if (this->Children.size() > 0)
+    {
+    if (this->isTemporal)
+      {
+      // Only one time step is read at a time.
+      return this->Children[0]->EstimateCost();
+      }
+    double cost = 0.0;
+    vtkstd::vector<vtkXdmfReaderGrid*>::iterator it;
+    for (it = this->Children.begin(); it != this->Children.end(); ++it)
+      {
+      if ((*it)->Enabled)
+        {
+        cost += (*it)->EstimateCost();
+        }
+      }
+    return cost;
+    }
+  if (this->XMGrid && this->XMGrid->GetTopology())
+    {
+    // Heavy data (connectivity, geometry, attributes) scales with the
+    // number of cells; count at least one so empty grids still spread out.
+    return vtkMAX(1.0,
+      static_cast<double>(this->XMGrid->GetTopology()->GetNumberOfElements()));
+    }
+  return 1.0;
+}
+
 //----------------------------------------------------------------------------
 class vtkXdmfReaderMatchName : public vtkstd::binary_function<vtkXdmfReaderGrid *, const char *, bool>
 {
@@ -280,6 +318,7 @@ public:
   int UpdateArrays(vtkXdmfReaderGrid *grid);
   int RequestGridInformation(vtkXdmfReaderGrid *grid, vtkInformation *destInfo);
   int FindParallelism(vtkXdmfReaderGrid *grid = 0);
+  void AssignPieces(vtkXdmfReaderGrid *grid);
 
   int RequestGridData(/*const char* currentGridName,*/
     vtkXdmfReaderGrid *grid,
@@ -447,6 +486,8 @@ vtkXdmfReader::vtkXdmfReader()
     {
     this->Stride[i] = 1;
     }
+  this->LoadBalance = 1;
+  this->CollectiveIO = 0;
 
   this->Controller = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1524,6 +1565,10 @@ void vtkXdmfReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection 
      << endl;
   os << indent << "Domain: " << this->DomainName << endl;
+  os << indent << "Stride: " << this->Stride[0] << " " << this->Stride[1]
+     << " " << this->Stride[2] << endl;
+  os << indent << "LoadBalance: " << this->LoadBalance << endl;
+  os << indent << "CollectiveIO: " << this->CollectiveIO << endl;
   int cc;
   os << indent << "Grids:" << endl;
   for ( cc = 0; cc < this->GetNumberOfGrids(); ++ cc )
@@ -1746,6 +1791,67 @@ int vtkXdmfReaderInternal::FindParallelism(vtkXdmfReaderGrid *grid)
     return 0;
 }
 
+//----------------------------------------------------------------------------
+// Decide which piece reads each child of a grid at the parallel level.
+// Children are handed out largest first to the least loaded piece (the
+// classic LPT heuristic), which keeps the heaviest piece within 4/3 of the
+// optimum. Ties are broken by index so every process computes the same map.
+class vtkXdmfReaderCostCompare
+{
+public:
+  vtkXdmfReaderCostCompare(const vtkstd::vector<double>& costs)
+    : Costs(costs) {}
+  bool operator()(unsigned int a, unsigned int b) const
+    {
+    if (this->Costs[a] != this->Costs[b])
+      {
+      return this->Costs[a] > this->Costs[b];
+      }
+    return a < b;
+    }
+  const vtkstd::vector<double>& Costs;
+};
+
+void vtkXdmfReaderInternal::AssignPieces(vtkXdmfReaderGrid *grid)
+{
+  unsigned int nChildren = static_cast<unsigned int>(grid->Children.size());
+  unsigned int nPieces = vtkMAX(this->UpdateNumPieces, 1u);
+  grid->ChildPieces.resize(nChildren);
+  unsigned int i;
+  if (!this->Reader->GetLoadBalance() || nPieces == 1)
+    {
+    for (i = 0; i < nChildren; ++i)
+      {
+      grid->ChildPieces[i] = i % nPieces;
+      }
+    return;
+    }
+
+  vtkstd::vector<double> costs(nChildren, 0.0);
+  vtkstd::vector<unsigned int> order(nChildren);
+  for (i = 0; i < nChildren; ++i)
+    {
+    costs[i] = grid->Children[i]->Enabled ? grid->Children[i]->EstimateCost() : 0.0;
+    order[i] = i;
+    }
+  vtkstd::sort(order.begin(), order.end(), vtkXdmfReaderCostCompare(costs));
+
+  vtkstd::vector<double> load(nPieces, 0.0);
+  for (i = 0; i < nChildren; ++i)
+    {
+    unsigned int lightest = 0;
+    for (unsigned int p = 1; p < nPieces; ++p)
+      {
+      if (load[p] < load[lightest])
+        {
+        lightest = p;
+        }
+      }
+    grid->ChildPieces[order[i]] = lightest;
+    load[lightest] += costs[order[i]];
+    }
+}
+
 void vtkXdmfReaderInternalUpdateArraysInternal(vtkXdmfReaderGrid* grid,
   vtkstd::set<vtkstd::string>& pointArrays, 
   vtkstd::set<vtkstd::string>& cellArrays)
@@ -2191,6 +2297,10 @@ int vtkXdmfReaderInternal::RequestGridData(
     unsigned int outputGrid = 0;
     unsigned int IsParallel = 0;
     int nChildren = grid->Children.size();
+    if (grid->isParallel)
+      {
+      this->AssignPieces(grid);
+      }
     for ( it = grid->Children.begin();
           it != grid->Children.end();
           ++it )
@@ -2206,7 +2316,7 @@ int vtkXdmfReaderInternal::RequestGridData(
         //     ((this->ParallelLevel == grid) && ((outputGrid % this->UpdateNumPieces) == this->UpdatePiece)))
         // {
         if(!IsParallel ||
-            (IsParallel && ((outputGrid % this->UpdateNumPieces) == this->UpdatePiece)))
+            (IsParallel && (grid->ChildPieces[outputGrid] == this->UpdatePiece)))
         {
         vtkDataObject *soutput=
            vtkDataObjectTypes::NewDataObject(child->vtkType);
@@ -2296,6 +2406,12 @@ int vtkXdmfReaderInternal::RequestGridData(
 
   int upext[6];
   int whext[6];
+
+  // When one structured grid is split by extent, every piece reads a
+  // hyperslab of the same datasets in the same order, so the heavy data
+  // reads can be collective.
+  int collectiveIO = (this->Reader->GetCollectiveIO() && !isSubBlock &&
+                      this->UpdateNumPieces > 1) ? 1 : 0;
   
   if( xdmfGrid->GetTopology()->GetClass() != XDMF_UNSTRUCTURED)
     {
@@ -3049,6 +3165,7 @@ int vtkXdmfReaderInternal::RequestGridData(
           realcount[3] = realdims[3];
           }
         this->DataItem->GetDataDesc()->SelectHyperSlab(start, stride, realcount);
+        this->DataItem->SetCollectiveIO(collectiveIO);
         vtkDebugWithObjectMacro(this->Reader,
                                 "Dims = " << ds->GetShapeAsString()
                                 << "Slab = " << ds->GetHyperSlabAsString());
@@ -3064,6 +3181,7 @@ int vtkXdmfReaderInternal::RequestGridData(
         }
       else 
         {
+        this->DataItem->SetCollectiveIO(0);
         this->DataItem->Update();
         values = this->DataItem->GetArray();
         }
@@ -3234,6 +3352,7 @@ int vtkXdmfReaderInternal::RequestGridData(
           realcount[3] = realdims[3];
           }
         this->DataItem->GetDataDesc()->SelectHyperSlab(start, stride, realcount);
+        this->DataItem->SetCollectiveIO(collectiveIO);
         vtkDebugWithObjectMacro(this->Reader,
                                 "Dims = " << ds->GetShapeAsString()
                                 << "Slab = " << ds->GetHyperSlabAsString());
@@ -3249,6 +3368,7 @@ int vtkXdmfReaderInternal::RequestGridData(
         }
       else 
         {
+        this->DataItem->SetCollectiveIO(0);
         this->DataItem->Update();
         values = this->DataItem->GetArray();
         }
@@ -181,6 +181,26 @@ public:
     }
   vtkGetVector3Macro(Stride, int);
 
+  // PARALLEL /////////////////////////////////////////////////////////////////
+  // Description:
+  // When a collection is split across pieces, assign its grids so that
+  // every piece reads roughly the same number of cells instead of dealing
+  // grids out round-robin. The assignment depends only on the light data,
+  // so all processes agree on it without communicating. On by default.
+  vtkSetMacro(LoadBalance, int);
+  vtkGetMacro(LoadBalance, int);
+  vtkBooleanMacro(LoadBalance, int);
+
+  // Description:
+  // When a single structured grid is split across pieces, read its HDF5
+  // heavy data with collective MPI-IO hyperslab transfers. This requires
+  // the bundled HDF5 to be built with HDF5_ENABLE_PARALLEL and all
+  // processes to update the reader together; it is ignored otherwise.
+  // Off by default.
+  vtkSetMacro(CollectiveIO, int);
+  vtkGetMacro(CollectiveIO, int);
+  vtkBooleanMacro(CollectiveIO, int);
+
   // MISCELANEOUS /////////////////////////////////////////////////////////////
   // Description:
   // Get the Low Level XdmfDOM
@@ -271,6 +291,8 @@ protected:
   int NumberOfEnabledActualGrids;
 
   int Stride[3];
+  int LoadBalance;
+  int CollectiveIO;
 
   int            GridsModified;
   int            OutputsInitialized;
@@ -41,6 +41,12 @@ int vtkServerSocket::GetServerPort()
 
 //-----------------------------------------------------------------------------
 int vtkServerSocket::CreateServer(int port)
+{
+  return this->CreateServer(port, 1);
+}
+
+//-----------------------------------------------------------------------------
+int vtkServerSocket::CreateServer(int port, int backlog)
 {
   if (this->SocketDescriptor != -1)
     {
@@ -54,7 +60,7 @@ int vtkServerSocket::CreateServer(int port)
     return -1;
     }
   if ( this->BindSocket(this->SocketDescriptor, port) != 0|| 
-    this->Listen(this->SocketDescriptor) != 0)
+    this->Listen(this->SocketDescriptor, backlog) != 0)
     {
     // failed to bind or listen.
     this->CloseSocket(this->SocketDescriptor);
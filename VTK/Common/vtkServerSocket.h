@@ -31,8 +31,10 @@ public:
 
   // Description:
   // Creates a server socket at a given port and binds to it.
-  // Returns -1 on error. 0 on success.
+  // Returns -1 on error. 0 on success. The backlog is the number of
+  // connections that may wait to be accepted, 1 by default.
   int CreateServer(int port);
+  int CreateServer(int port, int backlog);
 
   // Description:
   // Waits for a connection. When a connection is received
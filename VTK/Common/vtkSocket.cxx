@@ -143,15 +143,22 @@ int vtkSocket::Accept(int socketdescriptor)
 
 //-----------------------------------------------------------------------------
 int vtkSocket::Listen(int socketdescriptor)
+{
+  return this->Listen(socketdescriptor, 1);
+}
+
+//-----------------------------------------------------------------------------
+int vtkSocket::Listen(int socketdescriptor, int backlog)
 {
 #ifndef VTK_SOCKET_FAKE_API
   if (socketdescriptor < 0)
     {
     return -1;
     }
-  return listen(socketdescriptor, 1);
+  return listen(socketdescriptor, backlog);
 #else
   static_cast<void>(socketdescriptor);
+  static_cast<void>(backlog);
   return -1;
 #endif
 }
@@ -91,7 +91,10 @@ protected:
 
   // Description:
   // Listen for connections on a socket. Returns 0 on success. -1 on error.
+  // The backlog is the number of pending connections that may be queued,
+  // 1 by default.
   int Listen(int socketdescriptor);
+  int Listen(int socketdescriptor, int backlog);
 
   // Description:
   // Connect to a server socket. Returns 0 on success, -1 on error.
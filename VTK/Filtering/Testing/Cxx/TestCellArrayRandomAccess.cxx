@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test checks that the random access layout of vtkCellArray gives the
+// same cells as the traversal, that it is released when the cells are
+// modified, that its connectivity can be released alone, and that cells
+// defined from offsets and connectivity arrays can be traversed.
+
+#include "vtkCellArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkSmartPointer.h"
+
+// Returns 1 when the random access to the cells matches the traversal.
+static int CompareCells(vtkCellArray* cells, const char* test)
+{
+  if (!cells->HasRandomAccess())
+    {
+    cerr << test << ": the random access layout is not built." << endl;
+    return 0;
+    }
+  vtkIdType npts, *pts;
+  vtkIdType cellId = 0;
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts); cellId++)
+    {
+    vtkIdType npts2, *pts2;
+    cells->GetCellAtId(cellId, npts2, pts2);
+    if (cells->GetCellSize(cellId) != npts || npts2 != npts)
+      {
+      cerr << test << ": cell " << cellId << " has the wrong size." << endl;
+      return 0;
+      }
+    vtkDataArray* conn = cells->GetConnectivityArray();
+    vtkIdType offset =
+      static_cast<vtkIdType>(cells->GetOffsetsArray()->GetTuple1(cellId));
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      if (pts2[i] != pts[i] ||
+          static_cast<vtkIdType>(conn->GetTuple1(offset + i)) != pts[i])
+        {
+        cerr << test << ": cell " << cellId << " has the wrong points."
+             << endl;
+        return 0;
+        }
+      }
+    }
+  if (cellId != cells->GetNumberOfCells())
+    {
+    cerr << test << ": wrong number of cells." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestCellArrayRandomAccess(int, char*[])
+{
+  int retVal = 0;
+
+  // Cells of 1 to 6 points.
+  vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+  vtkIdType pts[6];
+  for (vtkIdType cellId = 0; cellId < 1000; cellId++)
+    {
+    vtkIdType npts = 1 + cellId % 6;
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      pts[i] = (cellId * 7 + i * 13) % 2000;
+      }
+    cells->InsertNextCell(npts, pts);
+    }
+  if (cells->HasRandomAccess() || cells->IsHomogeneous() != -1)
+    {
+    cerr << "The layout of new cells is wrong." << endl;
+    retVal = 1;
+    }
+  cells->BuildRandomAccess();
+  if (!cells->HasRandomAccess() || cells->GetConnectivityArray())
+    {
+    cerr << "BuildRandomAccess did not build only the offsets." << endl;
+    retVal = 1;
+    }
+  cells->BuildConnectivityArray();
+  retVal |= !CompareCells(cells, "BuildConnectivityArray");
+  if (sizeof(vtkIdType) > sizeof(int) &&
+      (!cells->GetOffsetsArray()->IsA("vtkIntArray") ||
+       !cells->GetConnectivityArray()->IsA("vtkIntArray")))
+    {
+    cerr << "The layout is not stored with 32-bit integers." << endl;
+    retVal = 1;
+    }
+  cells->ReleaseConnectivityArray();
+  if (!cells->HasRandomAccess() || cells->GetConnectivityArray())
+    {
+    cerr << "ReleaseConnectivityArray did not keep only the offsets." << endl;
+    retVal = 1;
+    }
+
+  // Modifications release the layout.
+  cells->ReverseCell(cells->GetCellLocation(10));
+  if (cells->HasRandomAccess())
+    {
+    cerr << "ReverseCell did not release the layout." << endl;
+    retVal = 1;
+    }
+  cells->BuildRandomAccess();
+  cells->InsertNextCell(3, pts);
+  if (cells->HasRandomAccess())
+    {
+    cerr << "InsertNextCell did not release the layout." << endl;
+    retVal = 1;
+    }
+  cells->BuildConnectivityArray();
+  retVal |= !CompareCells(cells, "Rebuild");
+  cells->GetPointer()[1] = 5;
+  cells->Modified();
+  if (cells->HasRandomAccess())
+    {
+    cerr << "Modified did not release the layout." << endl;
+    retVal = 1;
+    }
+
+  // Cells defined from offsets and connectivity arrays.
+  vtkSmartPointer<vtkIntArray> offsets = vtkSmartPointer<vtkIntArray>::New();
+  vtkSmartPointer<vtkIntArray> conn = vtkSmartPointer<vtkIntArray>::New();
+  for (int cellId = 0; cellId < 500; cellId++)
+    {
+    offsets->InsertNextValue(3 * cellId);
+    conn->InsertNextValue(cellId);
+    conn->InsertNextValue(cellId + 1);
+    conn->InsertNextValue(cellId + 2);
+    }
+  offsets->InsertNextValue(3 * 500);
+  vtkSmartPointer<vtkCellArray> triangles =
+    vtkSmartPointer<vtkCellArray>::New();
+  triangles->SetCells(offsets, conn);
+  if (triangles->GetNumberOfCells() != 500 ||
+      triangles->GetNumberOfConnectivityEntries() != 2000 ||
+      triangles->IsHomogeneous() != 3)
+    {
+    cerr << "SetCells did not define the cells." << endl;
+    retVal = 1;
+    }
+  retVal |= !CompareCells(triangles, "SetCells");
+  triangles->InsertNextCell(4, pts);
+  if (triangles->IsHomogeneous() != -1)
+    {
+    cerr << "IsHomogeneous is wrong after InsertNextCell." << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
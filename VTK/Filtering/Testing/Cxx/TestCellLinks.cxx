@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test checks that the links built by vtkCellLinks on several threads
+// are the same as the links built serially, for a polydata and for the
+// connectivity of an unstructured grid, and prints the build times.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkCellType.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+// Builds the links of the data set, or of its connectivity, on the given
+// number of threads and prints the time taken.
+static vtkCellLinks* BuildLinks(vtkDataSet* data, vtkCellArray* conn,
+                                int numThreads, const char* test)
+{
+  vtkCellLinks::SetGlobalNumberOfThreads(numThreads);
+  vtkCellLinks* links = vtkCellLinks::New();
+  links->Allocate(data->GetNumberOfPoints());
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  timer->StartTimer();
+  if (conn)
+    {
+    links->BuildLinks(data, conn);
+    }
+  else
+    {
+    links->BuildLinks(data);
+    }
+  timer->StopTimer();
+  cout << test << ": " << numThreads << " thread(s), "
+       << timer->GetElapsedTime() << " s" << endl;
+  return links;
+}
+
+// Returns 1 when the links built on several threads match the serial ones.
+static int CompareLinks(vtkDataSet* data, vtkCellArray* conn,
+                        const char* test)
+{
+  vtkCellLinks* serial = BuildLinks(data, conn, 1, test);
+  vtkCellLinks* threaded = BuildLinks(data, conn, 4, test);
+  vtkCellLinks::SetGlobalNumberOfThreads(1);
+
+  int same = 1;
+  vtkIdType numPts = data->GetNumberOfPoints();
+  for (vtkIdType ptId = 0; same && ptId < numPts; ptId++)
+    {
+    unsigned short ncells = serial->GetNcells(ptId);
+    vtkIdType* cells = serial->GetCells(ptId);
+    vtkIdType* cells2 = threaded->GetCells(ptId);
+    same = threaded->GetNcells(ptId) == ncells;
+    for (unsigned short i = 0; same && i < ncells; i++)
+      {
+      same = cells2[i] == cells[i];
+      }
+    if (!same)
+      {
+      cerr << test << ": the links of point " << ptId << " differ." << endl;
+      }
+    }
+
+  serial->Delete();
+  threaded->Delete();
+  return same;
+}
+
+int TestCellLinks(int, char*[])
+{
+  // A grid of quads split in triangles, with a vertex and a line.
+  const int dim = 300;
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for (int j = 0; j < dim; j++)
+    {
+    for (int i = 0; i < dim; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> quads = vtkSmartPointer<vtkCellArray>::New();
+  for (int j = 0; j < dim - 1; j++)
+    {
+    for (int i = 0; i < dim - 1; i++)
+      {
+      vtkIdType a = j * dim + i;
+      vtkIdType t1[3] = { a, a + 1, a + dim + 1 };
+      vtkIdType t2[3] = { a, a + dim + 1, a + dim };
+      vtkIdType quad[4] = { a, a + 1, a + dim + 1, a + dim };
+      polys->InsertNextCell(3, t1);
+      polys->InsertNextCell(3, t2);
+      quads->InsertNextCell(4, quad);
+      }
+    }
+  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+  vtkIdType vert = dim / 2;
+  verts->InsertNextCell(1, &vert);
+  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+  vtkIdType line[2] = { 0, dim * dim - 1 };
+  lines->InsertNextCell(2, line);
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  polyData->BuildCells();
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->SetCells(VTK_QUAD, quads);
+
+  int retVal = 0;
+  retVal |= !CompareLinks(polyData, NULL, "vtkPolyData");
+  retVal |= !CompareLinks(grid, quads, "vtkUnstructuredGrid");
+  return retVal;
+}
@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test checks that the batched copy and interpolation methods of
+// vtkDataSetAttributes produce the same tuples as the per tuple methods.
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+
+#include <vtkstd/vector>
+
+static const vtkIdType NumberOfTuples = 1000;
+static const vtkIdType NumberOfOperations = 10000;
+
+static vtkPointData* NewSource()
+{
+  vtkPointData* pd = vtkPointData::New();
+
+  vtkFloatArray* vectors = vtkFloatArray::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(NumberOfTuples);
+  vtkIntArray* scalars = vtkIntArray::New();
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(NumberOfTuples);
+  vtkDoubleArray* values = vtkDoubleArray::New();
+  values->SetName("Values");
+  values->SetNumberOfComponents(2);
+  values->SetNumberOfTuples(NumberOfTuples);
+  vtkBitArray* bits = vtkBitArray::New();
+  bits->SetName("Bits");
+  bits->SetNumberOfTuples(NumberOfTuples);
+  vtkStringArray* names = vtkStringArray::New();
+  names->SetName("Names");
+  names->SetNumberOfTuples(NumberOfTuples);
+
+  for (vtkIdType i = 0; i < NumberOfTuples; i++)
+    {
+    vectors->SetTuple3(i, vtkMath::Random(-1, 1), vtkMath::Random(-1, 1),
+                       vtkMath::Random(-1, 1));
+    scalars->SetValue(i, static_cast<int>(vtkMath::Random(-100, 100)));
+    values->SetTuple2(i, vtkMath::Random(0, 10), vtkMath::Random(0, 10));
+    bits->SetValue(i, i % 3 == 0);
+    names->SetValue(i, i % 2 ? "odd" : "even");
+    }
+
+  pd->SetVectors(vectors);
+  pd->SetScalars(scalars);
+  pd->AddArray(values);
+  pd->AddArray(bits);
+  pd->AddArray(names);
+  vectors->Delete();
+  scalars->Delete();
+  values->Delete();
+  bits->Delete();
+  names->Delete();
+  return pd;
+}
+
+// Returns 1 when both attributes hold the same tuples.
+static int Compare(vtkPointData* a, vtkPointData* b, const char* test)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << test << ": the number of arrays differ." << endl;
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray* aa = a->GetAbstractArray(i);
+    vtkAbstractArray* ba = b->GetAbstractArray(aa->GetName());
+    if (!ba || aa->GetNumberOfTuples() != ba->GetNumberOfTuples())
+      {
+      cerr << test << ": array " << aa->GetName() << " differs." << endl;
+      return 0;
+      }
+    vtkIdType numValues =
+      aa->GetNumberOfTuples() * aa->GetNumberOfComponents();
+    for (vtkIdType j = 0; j < numValues; j++)
+      {
+      if (aa->GetVariantValue(j) != ba->GetVariantValue(j))
+        {
+        cerr << test << ": array " << aa->GetName() << " differs at value "
+             << j << "." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+int TestDataSetAttributesBatch(int, char*[])
+{
+  vtkMath::RandomSeed(8775070);
+  vtkSmartPointer<vtkPointData> source;
+  source.TakeReference(NewSource());
+  int retVal = 0;
+
+  // The operations: output tuple i is written from random source tuples.
+  vtkstd::vector<vtkIdType> toIds(NumberOfOperations);
+  vtkstd::vector<vtkIdType> p1(NumberOfOperations);
+  vtkstd::vector<vtkIdType> p2(NumberOfOperations);
+  vtkstd::vector<double> t(NumberOfOperations);
+  vtkstd::vector<vtkIdType> offsets(NumberOfOperations + 1);
+  vtkstd::vector<vtkIdType> ids;
+  vtkstd::vector<double> weights;
+  vtkIdType i;
+  for (i = 0; i < NumberOfOperations; i++)
+    {
+    // Write the output tuples in reverse order.
+    toIds[i] = NumberOfOperations - 1 - i;
+    p1[i] = static_cast<vtkIdType>(vtkMath::Random(0, NumberOfTuples - 1));
+    p2[i] = static_cast<vtkIdType>(vtkMath::Random(0, NumberOfTuples - 1));
+    t[i] = vtkMath::Random(0, 1);
+    offsets[i] = static_cast<vtkIdType>(ids.size());
+    int numIds = 1 + i % 8;
+    for (int j = 0; j < numIds; j++)
+      {
+      ids.push_back(
+        static_cast<vtkIdType>(vtkMath::Random(0, NumberOfTuples - 1)));
+      weights.push_back(1.0 / numIds);
+      }
+    }
+  offsets[NumberOfOperations] = static_cast<vtkIdType>(ids.size());
+
+  // Copy.
+  vtkSmartPointer<vtkPointData> expected = vtkSmartPointer<vtkPointData>::New();
+  vtkSmartPointer<vtkPointData> result = vtkSmartPointer<vtkPointData>::New();
+  expected->CopyAllocate(source);
+  result->CopyAllocate(source);
+  vtkSmartPointer<vtkIdList> fromList = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> toList = vtkSmartPointer<vtkIdList>::New();
+  for (i = 0; i < NumberOfOperations; i++)
+    {
+    expected->CopyData(source, p1[i], toIds[i]);
+    fromList->InsertNextId(p1[i]);
+    toList->InsertNextId(toIds[i]);
+    }
+  result->CopyData(source, fromList, toList);
+  retVal |= !Compare(expected, result, "CopyData");
+
+  // Interpolation of edges, with nearest neighbor interpolation of the
+  // scalars.
+  expected = vtkSmartPointer<vtkPointData>::New();
+  result = vtkSmartPointer<vtkPointData>::New();
+  expected->SetCopyScalars(2, vtkDataSetAttributes::INTERPOLATE);
+  result->SetCopyScalars(2, vtkDataSetAttributes::INTERPOLATE);
+  expected->InterpolateAllocate(source);
+  result->InterpolateAllocate(source);
+  for (i = 0; i < NumberOfOperations; i++)
+    {
+    expected->InterpolateEdge(source, toIds[i], p1[i], p2[i], t[i]);
+    }
+  result->InterpolateEdges(source, NumberOfOperations, &toIds[0], &p1[0],
+                           &p2[0], &t[0]);
+  retVal |= !Compare(expected, result, "InterpolateEdges");
+
+  // Interpolation of stencils.
+  expected = vtkSmartPointer<vtkPointData>::New();
+  result = vtkSmartPointer<vtkPointData>::New();
+  expected->InterpolateAllocate(source);
+  result->InterpolateAllocate(source);
+  vtkSmartPointer<vtkIdList> stencil = vtkSmartPointer<vtkIdList>::New();
+  for (i = 0; i < NumberOfOperations; i++)
+    {
+    stencil->Reset();
+    for (vtkIdType j = offsets[i]; j < offsets[i + 1]; j++)
+      {
+      stencil->InsertNextId(ids[j]);
+      }
+    expected->InterpolatePoint(source, toIds[i], stencil,
+                               &weights[offsets[i]]);
+    }
+  result->InterpolatePoints(source, NumberOfOperations, &toIds[0],
+                            &offsets[0], &ids[0], &weights[0]);
+  retVal |= !Compare(expected, result, "InterpolatePoints");
+
+  // Recorded operations, mixing copies and interpolations of distinct
+  // tuples, and calls with other sources that are performed immediately,
+  // including interpolations between tuples written before.
+  vtkSmartPointer<vtkPointData> other;
+  other.TakeReference(NewSource());
+  expected = vtkSmartPointer<vtkPointData>::New();
+  result = vtkSmartPointer<vtkPointData>::New();
+  expected->InterpolateAllocate(source);
+  result->InterpolateAllocate(source);
+  result->BeginBatch(source);
+  for (i = 0; i < NumberOfOperations; i++)
+    {
+    vtkPointData* from = (i % 5 == 0) ? other : source;
+    if (i % 7 == 3)
+      {
+      expected->InterpolateEdge(expected, toIds[i], toIds[i - 1],
+                                toIds[i - 2], t[i]);
+      result->InterpolateEdge(result, toIds[i], toIds[i - 1],
+                              toIds[i - 2], t[i]);
+      }
+    else if (i % 2)
+      {
+      expected->CopyData(from, p1[i], toIds[i]);
+      result->CopyData(from, p1[i], toIds[i]);
+      }
+    else
+      {
+      expected->InterpolateEdge(from, toIds[i], p1[i], p2[i], t[i]);
+      result->InterpolateEdge(from, toIds[i], p1[i], p2[i], t[i]);
+      }
+    }
+  result->EndBatch();
+  retVal |= !Compare(expected, result, "BeginBatch");
+
+  return retVal;
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test checks that vtkKdTree builds the same regions on several
+// threads as on one thread, from points and from the cells of a data set,
+// and that the points are listed in the same order in each region.
+
+#include "vtkCellArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTree.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+// Returns 1 when both trees have the same regions.
+static int CompareRegions(vtkKdTree* serial, vtkKdTree* threaded,
+                          const char* test)
+{
+  int numRegions = serial->GetNumberOfRegions();
+  if (threaded->GetNumberOfRegions() != numRegions)
+    {
+    cerr << test << ": the number of regions differs." << endl;
+    return 0;
+    }
+  for (int r = 0; r < numRegions; r++)
+    {
+    double bounds[6], bounds2[6];
+    serial->GetRegionBounds(r, bounds);
+    threaded->GetRegionBounds(r, bounds2);
+    for (int i = 0; i < 6; i++)
+      {
+      if (bounds[i] != bounds2[i])
+        {
+        cerr << test << ": the bounds of region " << r << " differ." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Returns 1 when both trees list the same points in each region, in the
+// same order.
+static int ComparePoints(vtkKdTree* serial, vtkKdTree* threaded)
+{
+  for (int r = 0; r < serial->GetNumberOfRegions(); r++)
+    {
+    vtkIdTypeArray* ids = serial->GetPointsInRegion(r);
+    vtkIdTypeArray* ids2 = threaded->GetPointsInRegion(r);
+    vtkIdType numIds = ids ? ids->GetNumberOfTuples() : 0;
+    if ((ids2 ? ids2->GetNumberOfTuples() : 0) != numIds)
+      {
+      cerr << "Points: region " << r << " has a different number of points."
+           << endl;
+      return 0;
+      }
+    for (vtkIdType i = 0; i < numIds; i++)
+      {
+      if (ids->GetValue(i) != ids2->GetValue(i))
+        {
+        cerr << "Points: the points of region " << r << " differ." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Returns 1 when both trees assign every cell to the same region.
+static int CompareCells(vtkKdTree* serial, vtkKdTree* threaded,
+                        vtkIdType numCells)
+{
+  int* regions = serial->AllGetRegionContainingCell();
+  int* regions2 = threaded->AllGetRegionContainingCell();
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    if (regions[cellId] != regions2[cellId])
+      {
+      cerr << "Cells: cell " << cellId << " is in a different region."
+           << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestKdTreeThreads(int, char*[])
+{
+  // Random points, with a triangle on each three consecutive points.
+  const vtkIdType numPts = 60000;
+  vtkMath::RandomSeed(1234);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    points->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                            vtkMath::Random());
+    }
+  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+  for (vtkIdType i = 0; i + 2 < numPts; i += 3)
+    {
+    vtkIdType tri[3] = { i, i + 1, i + 2 };
+    polys->InsertNextCell(3, tri);
+    }
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+
+  int retVal = 0;
+
+  vtkSmartPointer<vtkKdTree> serial = vtkSmartPointer<vtkKdTree>::New();
+  vtkSmartPointer<vtkKdTree> threaded = vtkSmartPointer<vtkKdTree>::New();
+  if (serial->GetNumberOfThreads() != 1)
+    {
+    cerr << "The default number of threads is not 1." << endl;
+    retVal = 1;
+    }
+  threaded->SetNumberOfThreads(4);
+
+  serial->BuildLocatorFromPoints(points);
+  threaded->BuildLocatorFromPoints(points);
+  retVal |= !CompareRegions(serial, threaded, "Points");
+  retVal |= !ComparePoints(serial, threaded);
+
+  serial->SetDataSet(polyData);
+  threaded->SetDataSet(polyData);
+  serial->SetMinCells(50);
+  threaded->SetMinCells(50);
+  serial->BuildLocator();
+  threaded->BuildLocator();
+  retVal |= !CompareRegions(serial, threaded, "Cells");
+  retVal |= !CompareCells(serial, threaded, polyData->GetNumberOfCells());
+
+  return retVal;
+}
@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test updates a source of blocks that honors
+// vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST through a
+// consumer that requests two slabs in turn, then the whole domain, then the
+// two slabs again. It checks how many times the source executes: the slabs
+// are not reused for each other nor for the whole domain, while the whole
+// domain is reused for both slabs. A slab inside the one the data was
+// generated for, described with a scaled normal and another origin, is
+// reused too.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#define NUMBER_OF_BLOCKS 10
+
+// Produces one block per unit along x, and only the blocks inside the
+// requested slab when there is one, like vtkSpyPlotReader.
+class vtkRegionOfInterestSource : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkRegionOfInterestSource* New();
+  vtkTypeRevisionMacro(vtkRegionOfInterestSource,
+                       vtkMultiBlockDataSetAlgorithm);
+
+protected:
+  vtkRegionOfInterestSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(
+      outInfo->Get(vtkDataObject::DATA_OBJECT()));
+    output->Initialize();
+
+    double* roi = 0;
+    if (outInfo->Length(
+          vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST()) == 8)
+      {
+      roi = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST());
+      output->GetInformation()->Set(vtkDataObject::DATA_REGION_OF_INTEREST(),
+                                    roi, 8);
+      }
+    for (int b = 0; b < NUMBER_OF_BLOCKS; b++)
+      {
+      // Block b spans [b, b+1] along x.
+      if (roi)
+        {
+        double d0 = roi[0] * (b - roi[3]) + roi[1] * -roi[4] +
+          roi[2] * -roi[5];
+        double d1 = d0 + roi[0];
+        double dmin = (d0 < d1) ? d0 : d1;
+        double dmax = (d0 < d1) ? d1 : d0;
+        if (dmax < roi[6] || dmin > roi[7])
+          {
+          continue;
+          }
+        }
+      vtkPolyData* block = vtkPolyData::New();
+      vtkPoints* points = vtkPoints::New();
+      points->InsertNextPoint(b, 0.0, 0.0);
+      points->InsertNextPoint(b + 1, 0.0, 0.0);
+      block->SetPoints(points);
+      points->Delete();
+      output->SetBlock(output->GetNumberOfBlocks(), block);
+      block->Delete();
+      }
+    return 1;
+    }
+};
+
+vtkStandardNewMacro(vtkRegionOfInterestSource);
+vtkCxxRevisionMacro(vtkRegionOfInterestSource, "$Revision$");
+
+// Requests a slab of its input, or the whole domain, and passes the input
+// through.
+class vtkRegionOfInterestConsumer : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkRegionOfInterestConsumer* New();
+  vtkTypeRevisionMacro(vtkRegionOfInterestConsumer,
+                       vtkMultiBlockDataSetAlgorithm);
+
+  // Request the points x for which low <= normal.(x-origin) <= high.
+  void SetRegion(const double normal[3], const double origin[3], double low,
+                 double high)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      this->Region[i] = normal[i];
+      this->Region[3 + i] = origin[i];
+      }
+    this->Region[6] = low;
+    this->Region[7] = high;
+    this->HasRegion = 1;
+    this->Modified();
+    }
+  void SetRegion(double low, double high)
+    {
+    double normal[3] = { 1.0, 0.0, 0.0 };
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    this->SetRegion(normal, origin, low, high);
+    }
+  void RemoveRegion()
+    {
+    this->HasRegion = 0;
+    this->Modified();
+    }
+
+protected:
+  vtkRegionOfInterestConsumer()
+    {
+    this->HasRegion = 0;
+    }
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector*)
+    {
+    if (this->HasRegion)
+      {
+      inputVector[0]->GetInformationObject(0)->Set(
+        vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST(),
+        this->Region, 8);
+      }
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkDataObject* input = inputVector[0]->GetInformationObject(0)->Get(
+      vtkDataObject::DATA_OBJECT());
+    vtkDataObject* output = outputVector->GetInformationObject(0)->Get(
+      vtkDataObject::DATA_OBJECT());
+    output->ShallowCopy(input);
+    return 1;
+    }
+
+  double Region[8];
+  int HasRegion;
+};
+
+vtkStandardNewMacro(vtkRegionOfInterestConsumer);
+vtkCxxRevisionMacro(vtkRegionOfInterestConsumer, "$Revision$");
+
+static void CountExecution(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  ++(*static_cast<int*>(clientdata));
+}
+
+// Updates the consumer and checks how many times the source executed and
+// how many blocks came through.
+static int Check(vtkRegionOfInterestConsumer* consumer, int* executions,
+                 int expectedExecutions, unsigned int expectedBlocks,
+                 const char* step)
+{
+  *executions = 0;
+  consumer->Update();
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(consumer->GetOutputDataObject(0));
+  if (*executions != expectedExecutions)
+    {
+    cerr << step << ": the source executed " << *executions
+         << " times instead of " << expectedExecutions << "." << endl;
+    return 0;
+    }
+  if (!output || output->GetNumberOfBlocks() != expectedBlocks)
+    {
+    cerr << step << ": " << (output ? output->GetNumberOfBlocks() : 0)
+         << " blocks came through instead of " << expectedBlocks << "."
+         << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestRegionOfInterest(int, char *[])
+{
+  vtkSmartPointer<vtkRegionOfInterestSource> source =
+    vtkSmartPointer<vtkRegionOfInterestSource>::New();
+  vtkSmartPointer<vtkRegionOfInterestConsumer> consumer =
+    vtkSmartPointer<vtkRegionOfInterestConsumer>::New();
+  consumer->SetInputConnection(source->GetOutputPort());
+
+  int executions = 0;
+  vtkSmartPointer<vtkCallbackCommand> counter =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  counter->SetCallback(CountExecution);
+  counter->SetClientData(&executions);
+  source->AddObserver(vtkCommand::StartEvent, counter);
+
+  // The slabs touch 2 and 3 blocks.
+  int retVal = 1;
+  consumer->SetRegion(1.5, 2.5);
+  retVal = Check(consumer, &executions, 1, 2, "first slab") && retVal;
+  consumer->SetRegion(5.5, 7.5);
+  retVal = Check(consumer, &executions, 1, 3, "second slab") && retVal;
+  consumer->RemoveRegion();
+  retVal = Check(consumer, &executions, 1, NUMBER_OF_BLOCKS,
+                 "whole domain") && retVal;
+  consumer->SetRegion(1.5, 2.5);
+  retVal = Check(consumer, &executions, 0, NUMBER_OF_BLOCKS,
+                 "first slab after the whole domain") && retVal;
+  consumer->SetRegion(5.5, 7.5);
+  retVal = Check(consumer, &executions, 0, NUMBER_OF_BLOCKS,
+                 "second slab after the whole domain") && retVal;
+
+  // Once the source is modified, the slab 2 <= x <= 8 is read. Seen from
+  // x = 4 with a normal twice as long and reversed, it contains 3 <= x <= 7
+  // but not 3 <= x <= 9.
+  source->Modified();
+  consumer->SetRegion(2.0, 8.0);
+  retVal = Check(consumer, &executions, 1, 8, "wide slab") && retVal;
+  double normal[3] = { -2.0, 0.0, 0.0 };
+  double origin[3] = { 4.0, 1.0, 0.0 };
+  consumer->SetRegion(normal, origin, -6.0, 2.0);
+  retVal = Check(consumer, &executions, 0, 8, "slab inside the wide slab") &&
+    retVal;
+  consumer->SetRegion(normal, origin, -10.0, 2.0);
+  retVal = Check(consumer, &executions, 1, 8,
+                 "slab across the wide slab") && retVal;
+
+  return retVal ? 0 : 1;
+}
@@ -60,6 +60,7 @@ vtkInformationKeyMacro(vtkAlgorithm, PRESERVES_BOUNDS, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, PRESERVES_TOPOLOGY, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, PRESERVES_ATTRIBUTES, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, PRESERVES_RANGES, Integer);
+vtkInformationKeyMacro(vtkAlgorithm, REENTRANT_REQUEST_DATA, Integer);
 
 vtkExecutive* vtkAlgorithm::DefaultExecutivePrototype = 0;
   
@@ -67,9 +68,15 @@ vtkExecutive* vtkAlgorithm::DefaultExecutivePrototype = 0;
 class vtkAlgorithmInternals
 {
 public:
+  vtkAlgorithmInternals() { this->DetachedSubjectHelper = 0; }
+
   // Proxy object instances for use in establishing connections from
   // the output ports to other algorithms.
   vtkstd::vector< vtkSmartPointer<vtkAlgorithmOutput> > Outputs;
+
+  // The observers of the algorithm, detached while it executes
+  // concurrently.
+  vtkSubjectHelper* DetachedSubjectHelper;
 };
 
 //----------------------------------------------------------------------------
@@ -89,6 +96,7 @@ vtkAlgorithm::vtkAlgorithm()
   this->ErrorCode = 0;
   this->Progress = 0.0;
   this->ProgressText = NULL;
+  this->ExecutingConcurrently = 0;
   this->Executive = 0;
   this->InputPortInformation = vtkInformationVector::New();
   this->OutputPortInformation = vtkInformationVector::New();
@@ -120,6 +128,10 @@ vtkAlgorithm::~vtkAlgorithm()
 // should range between (0,1).
 void vtkAlgorithm::UpdateProgress(double amount)
 {
+  if (this->ExecutingConcurrently)
+    {
+    return;
+    }
   this->Progress = amount;
   this->InvokeEvent(vtkCommand::ProgressEvent,static_cast<void *>(&amount));
 }
@@ -1323,9 +1335,38 @@ int vtkAlgorithm::UpdateExtentIsEmpty(vtkInformation *info, int extentType)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkAlgorithm::SetExecutingConcurrently(int concurrent)
+{
+  if (this->ExecutingConcurrently == concurrent)
+    {
+    return;
+    }
+  this->ExecutingConcurrently = concurrent;
+
+  // Without observers, vtkErrorMacro and vtkWarningMacro neither invoke
+  // events nor reference commands from the worker threads: they only
+  // display their message in the output window.
+  vtkAlgorithmInternals* internal = this->AlgorithmInternal;
+  if (concurrent)
+    {
+    internal->DetachedSubjectHelper = this->SubjectHelper;
+    this->SubjectHelper = 0;
+    }
+  else
+    {
+    this->SubjectHelper = internal->DetachedSubjectHelper;
+    internal->DetachedSubjectHelper = 0;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkAlgorithm::SetProgressText(const char* ptext)
 {
+  if (this->ExecutingConcurrently)
+    {
+    return;
+    }
   if (!this->ProgressText  && !ptext)
     {
     return;
@@ -171,6 +171,17 @@ public:
   void SetProgressText(const char* ptext);
   vtkGetStringMacro(ProgressText);
 
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  // Set by vtkCompositeDataPipeline while RequestData() executes on several
+  // threads. UpdateProgress() and SetProgressText() then do nothing and the
+  // observers of the algorithm are detached until this is turned off, so
+  // that they are only called from the thread updating the pipeline. The
+  // executive reports the errors and warnings raised meanwhile. This does
+  // not modify the algorithm.
+  void SetExecutingConcurrently(int concurrent);
+  int GetExecutingConcurrently() { return this->ExecutingConcurrently; }
+
   // Description:
   // The error code contains a possible error that occured while
   // reading or writing the file.
@@ -372,6 +383,15 @@ public:
   static vtkInformationIntegerKey* PRESERVES_ATTRIBUTES();
   static vtkInformationIntegerKey* PRESERVES_RANGES();
 
+  // Description:
+  // Set in the information of algorithms whose RequestData() may execute
+  // concurrently on different inputs and outputs: it only uses the data
+  // and the information vectors it is given and does not modify the
+  // algorithm. vtkCompositeDataPipeline then executes such an algorithm on
+  // several blocks of a composite input at once (see
+  // vtkCompositeDataPipeline::SetNumberOfBlockThreads()).
+  static vtkInformationIntegerKey* REENTRANT_REQUEST_DATA();
+
 protected:
   vtkAlgorithm();
   ~vtkAlgorithm();
@@ -472,6 +492,7 @@ protected:
   // Progress/Update handling
   double Progress;
   char  *ProgressText;
+  int ExecutingConcurrently;
 
   // Garbage collection support.
   virtual void ReportReferences(vtkGarbageCollector*);
@@ -13,6 +13,7 @@
 
 =========================================================================*/
 #include "vtkCellArray.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
 
 vtkCxxRevisionMacro(vtkCellArray, "$Revision$");
@@ -25,6 +26,10 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->Offsets = NULL;
+  this->Connectivity = NULL;
+  this->IntOffsets = NULL;
+  this->IdOffsets = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -36,6 +41,7 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
     }
 
+  this->ReleaseRandomAccess();
   this->Ia->DeepCopy(ca->Ia);
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
@@ -45,12 +51,14 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
 //----------------------------------------------------------------------------
 vtkCellArray::~vtkCellArray()
 {
+  this->ReleaseRandomAccess();
   this->Ia->Delete();
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize() 
 {
+  this->ReleaseRandomAccess();
   this->Ia->Initialize();
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
@@ -74,6 +82,247 @@ int vtkCellArray::GetMaxCellSize()
   return maxSize;
 }
 
+//----------------------------------------------------------------------------
+// Computes the offsets of the random access layout from the
+// (n,id1,id2,...,idn, ...) list of the cells.
+template <class T>
+void vtkCellArrayBuildOffsets(const vtkIdType *ia, vtkIdType numCells,
+                              T *offsets)
+{
+  T offset = 0;
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    vtkIdType npts = *ia;
+    offsets[cellId] = offset;
+    ia += npts + 1;
+    offset += static_cast<T>(npts);
+    }
+  offsets[numCells] = offset;
+}
+
+//----------------------------------------------------------------------------
+// Copies the point ids of the (n,id1,id2,...,idn, ...) list of the cells to
+// the connectivity array of the random access layout.
+template <class T>
+void vtkCellArrayBuildConnectivity(const vtkIdType *ia, vtkIdType numCells,
+                                   T *conn)
+{
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    vtkIdType npts = *ia++;
+    for (vtkIdType j=0; j < npts; j++)
+      {
+      *conn++ = static_cast<T>(*ia++);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::BuildRandomAccess()
+{
+  if ( this->HasRandomAccess() )
+    {
+    return;
+    }
+  this->ReleaseRandomAccess();
+
+  vtkIdType numIds = this->GetNumberOfConnectivityEntries() -
+    this->NumberOfCells;
+  const vtkIdType *ia = this->Ia->GetPointer(0);
+
+  // Use 32-bit integers when they are smaller than vtkIdType and hold the
+  // offsets.
+  if ( sizeof(vtkIdType) > sizeof(int) && numIds < VTK_INT_MAX )
+    {
+    vtkIntArray *offsets = vtkIntArray::New();
+    offsets->SetNumberOfTuples(this->NumberOfCells+1);
+    vtkCellArrayBuildOffsets(ia, this->NumberOfCells, offsets->GetPointer(0));
+    this->Offsets = offsets;
+    this->IntOffsets = offsets->GetPointer(0);
+    }
+  else
+    {
+    vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+    offsets->SetNumberOfTuples(this->NumberOfCells+1);
+    vtkCellArrayBuildOffsets(ia, this->NumberOfCells, offsets->GetPointer(0));
+    this->Offsets = offsets;
+    this->IdOffsets = offsets->GetPointer(0);
+    }
+  this->RandomAccessTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::BuildConnectivityArray()
+{
+  this->BuildRandomAccess();
+  if ( this->Connectivity )
+    {
+    return;
+    }
+
+  vtkIdType numEntries = this->GetNumberOfConnectivityEntries();
+  vtkIdType numIds = numEntries - this->NumberOfCells;
+  const vtkIdType *ia = this->Ia->GetPointer(0);
+
+  // Use 32-bit integers when they are smaller than vtkIdType and hold the
+  // point ids (the counts are smaller than the ids).
+  int use32Bit = sizeof(vtkIdType) > sizeof(int);
+  for (vtkIdType i=0; use32Bit && i < numEntries; i++)
+    {
+    use32Bit = ia[i] < VTK_INT_MAX;
+    }
+
+  if ( use32Bit )
+    {
+    vtkIntArray *conn = vtkIntArray::New();
+    conn->SetNumberOfTuples(numIds);
+    vtkCellArrayBuildConnectivity(ia, this->NumberOfCells,
+                                  conn->GetPointer(0));
+    this->Connectivity = conn;
+    }
+  else
+    {
+    vtkIdTypeArray *conn = vtkIdTypeArray::New();
+    conn->SetNumberOfTuples(numIds);
+    vtkCellArrayBuildConnectivity(ia, this->NumberOfCells,
+                                  conn->GetPointer(0));
+    this->Connectivity = conn;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::HasRandomAccess()
+{
+  return this->Offsets &&
+    this->Offsets->GetNumberOfTuples() == this->NumberOfCells + 1 &&
+    this->GetOffset(this->NumberOfCells) ==
+    this->GetNumberOfConnectivityEntries() - this->NumberOfCells &&
+    this->RandomAccessTime > this->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseRandomAccess()
+{
+  this->ReleaseConnectivityArray();
+  if ( this->Offsets )
+    {
+    this->Offsets->Delete();
+    this->Offsets = NULL;
+    this->IntOffsets = NULL;
+    this->IdOffsets = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseConnectivityArray()
+{
+  if ( this->Connectivity )
+    {
+    this->Connectivity->Delete();
+    this->Connectivity = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::IsHomogeneous()
+{
+  if ( this->NumberOfCells < 1 )
+    {
+    return 0;
+    }
+
+  vtkIdType cellId, npts;
+  if ( this->HasRandomAccess() )
+    {
+    npts = this->GetCellSize(0);
+    for (cellId=1; cellId < this->NumberOfCells; cellId++)
+      {
+      if ( this->GetCellSize(cellId) != npts )
+        {
+        return -1;
+        }
+      }
+    return static_cast<int>(npts);
+    }
+
+  const vtkIdType *ia = this->Ia->GetPointer(0);
+  vtkIdType numEntries = this->GetNumberOfConnectivityEntries();
+  npts = ia[0];
+  for (vtkIdType loc=npts+1; loc < numEntries; loc+=npts+1)
+    {
+    if ( ia[loc] != npts )
+      {
+      return -1;
+      }
+    }
+  return static_cast<int>(npts);
+}
+
+//----------------------------------------------------------------------------
+// Merges the offsets and connectivity arrays of the random access layout
+// into the (n,id1,id2,...,idn, ...) list of the cells.
+template <class T>
+void vtkCellArrayMergeRandomAccess(const T *offsets, const T *conn,
+                                   vtkIdType numCells, vtkIdType *ia)
+{
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    const T *pts = conn + offsets[cellId];
+    const T *end = conn + offsets[cellId+1];
+    *ia++ = static_cast<vtkIdType>(end - pts);
+    while ( pts < end )
+      {
+      *ia++ = static_cast<vtkIdType>(*pts++);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetCells(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if ( !offsets || !connectivity || offsets->GetNumberOfTuples() < 1 ||
+       offsets->GetDataType() != connectivity->GetDataType() ||
+       (offsets->GetDataType() != VTK_INT &&
+        offsets->GetDataType() != VTK_ID_TYPE) )
+    {
+    vtkErrorMacro("The offsets and connectivity arrays must both be "
+                  "vtkIntArray or vtkIdTypeArray.");
+    return;
+    }
+  vtkIdType numCells = offsets->GetNumberOfTuples() - 1;
+  vtkIdType numIds = connectivity->GetNumberOfTuples();
+  if ( static_cast<vtkIdType>(offsets->GetTuple1(numCells)) != numIds )
+    {
+    vtkErrorMacro("The last offset must be the size of the connectivity.");
+    return;
+    }
+
+  offsets->Register(this);
+  connectivity->Register(this);
+  vtkIdType *ia = this->WritePointer(numCells, numCells + numIds);
+  this->InsertLocation = numCells + numIds;
+  this->Offsets = offsets;
+  this->Connectivity = connectivity;
+  if ( offsets->GetDataType() == VTK_INT &&
+       sizeof(int) != sizeof(vtkIdType) )
+    {
+    this->IntOffsets = static_cast<int *>(offsets->GetVoidPointer(0));
+    vtkCellArrayMergeRandomAccess(
+      this->IntOffsets, static_cast<int *>(connectivity->GetVoidPointer(0)),
+      numCells, ia);
+    }
+  else
+    {
+    this->IdOffsets = static_cast<vtkIdType *>(offsets->GetVoidPointer(0));
+    vtkCellArrayMergeRandomAccess(
+      this->IdOffsets,
+      static_cast<vtkIdType *>(connectivity->GetVoidPointer(0)),
+      numCells, ia);
+    }
+  this->Modified();
+  this->RandomAccessTime.Modified();
+}
+
 //----------------------------------------------------------------------------
 // Specify a group of cells.
 void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
@@ -81,6 +330,7 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
     {
     this->Modified();
+    this->ReleaseRandomAccess();
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
@@ -94,7 +344,16 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if ( this->Offsets )
+    {
+    size += this->Offsets->GetActualMemorySize();
+    }
+  if ( this->Connectivity )
+    {
+    size += this->Connectivity->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -105,4 +364,13 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Random Access: ";
+  if ( this->HasRandomAccess() )
+    {
+    os << (this->IntOffsets ? "32 bit" : "vtkIdType") << endl;
+    }
+  else
+    {
+    os << "Not Built" << endl;
+    }
 }
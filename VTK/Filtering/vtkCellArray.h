@@ -24,7 +24,10 @@
 // easy interface to external data.  However, it is totally inadequate for 
 // random access.  This functionality (when necessary) is accomplished by 
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of 
-// the data structure.
+// the data structure, or by building the random access layout of the cell
+// array with BuildRandomAccess(). This layout is an offsets array, and
+// optionally a connectivity array, stored with 32-bit integers when the
+// point ids allow.
 //
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
@@ -50,7 +53,7 @@ public:
   // Description:
   // Allocate memory and set the size to extend by.
   int Allocate(const vtkIdType sz, const int ext=1000) 
-    {return this->Ia->Allocate(sz,ext);}
+    {this->ReleaseRandomAccess(); return this->Ia->Allocate(sz,ext);}
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -86,6 +89,60 @@ public:
   // is encountered, 0 is returned.
   int GetNextCell(vtkIdType& npts, vtkIdType* &pts);
 
+  // Description:
+  // Build the offsets array of the random access layout, if it is not up
+  // to date. It holds the index of the first point id of each cell in the
+  // connectivity (the point ids of the cells without their number of
+  // points), followed by the total number of point ids. It is a
+  // vtkIntArray when vtkIdType has 64 bits and the total fits in an int,
+  // and a vtkIdTypeArray otherwise. The layout is released when the cells
+  // are modified by the methods of this class. Call Modified() after
+  // writing in the array returned by GetPointer() or GetData().
+  void BuildRandomAccess();
+
+  // Description:
+  // Build the random access layout and its connectivity array. The
+  // connectivity is a vtkIntArray when vtkIdType has 64 bits and the point
+  // ids fit in an int, and a vtkIdTypeArray otherwise. It is a copy of the
+  // point ids, so release it with ReleaseConnectivityArray() once it has
+  // been used.
+  void BuildConnectivityArray();
+
+  // Description:
+  // Return 1 if the random access layout is built and up to date.
+  int HasRandomAccess();
+
+  // Description:
+  // Free the random access layout, or only its connectivity array.
+  void ReleaseRandomAccess();
+  void ReleaseConnectivityArray();
+
+  // Description:
+  // Get the offsets and connectivity arrays of the random access layout,
+  // or NULL if they are not built.
+  vtkDataArray *GetOffsetsArray() 
+    {return this->Offsets;}
+  vtkDataArray *GetConnectivityArray() 
+    {return this->Connectivity;}
+
+  // Description:
+  // Random access to the cells. These methods are valid only when
+  // HasRandomAccess() is true, and are safe to call from several threads.
+  // GetCellLocation() returns the location of the cell in the internal
+  // array, as used by GetCell(loc,...). GetCellAtId() returns the number
+  // of points and a pointer to the point ids of the cell.
+  vtkIdType GetCellSize(vtkIdType cellId)
+    {return this->GetOffset(cellId+1) - this->GetOffset(cellId);}
+  vtkIdType GetCellLocation(vtkIdType cellId)
+    {return this->GetOffset(cellId) + cellId;}
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts)
+    {this->GetCell(this->GetCellLocation(cellId), npts, pts);}
+
+  // Description:
+  // Return the number of points of the cells if all the cells have the
+  // same number of points, 0 if there are no cells and -1 otherwise.
+  int IsHomogeneous();
+
   // Description:
   // Get the size of the allocated connectivity array.
   vtkIdType GetSize() 
@@ -187,6 +244,14 @@ public:
   // beginning of the list; the insertion location is set to the end of the
   // list.
   void SetCells(vtkIdType ncells, vtkIdTypeArray *cells);
+
+  // Description:
+  // Define the cells from an offsets array of ncells+1 values and a
+  // connectivity array, laid out as described in BuildRandomAccess(). Both
+  // arrays must be vtkIntArray or vtkIdTypeArray. They are kept as the
+  // random access layout of the cells until ReleaseRandomAccess() or
+  // ReleaseConnectivityArray() is called.
+  void SetCells(vtkDataArray *offsets, vtkDataArray *connectivity);
   
   // Description:
   // Perform a deep copy (no reference counting) of the given cell array.
@@ -224,6 +289,17 @@ protected:
   vtkIdType TraversalLocation;   //keep track of traversal position
   vtkIdTypeArray *Ia;
 
+  // The random access layout, see BuildRandomAccess(). One of IntOffsets
+  // and IdOffsets points to the values of Offsets.
+  vtkDataArray *Offsets;
+  vtkDataArray *Connectivity;
+  int *IntOffsets;
+  vtkIdType *IdOffsets;
+  vtkTimeStamp RandomAccessTime;
+
+  vtkIdType GetOffset(vtkIdType i)
+    {return this->IntOffsets ? this->IntOffsets[i] : this->IdOffsets[i];}
+
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
   void operator=(const vtkCellArray&);  // Not implemented.
@@ -308,6 +384,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkCell *cell)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::Reset() 
 {
+  this->ReleaseRandomAccess();
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
@@ -346,6 +423,10 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
   vtkIdType tmp;
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
+  if (this->Offsets)
+    {
+    this->ReleaseRandomAccess();
+    }
   for (i=0; i < (npts/2); i++) 
     {
     tmp = pts[i];
@@ -359,6 +440,10 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
+  if (this->Offsets)
+    {
+    this->ReleaseRandomAccess();
+    }
   for (int i=0; i < npts; i++)
     {
     oldPts[i] = pts[i];
@@ -369,6 +454,7 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  this->ReleaseRandomAccess();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
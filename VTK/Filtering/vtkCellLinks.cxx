@@ -17,8 +17,19 @@
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkWindows.h"
+
+#if defined(__APPLE__)
+  #include <AvailabilityMacros.h>
+  #if MAC_OS_X_VERSION_MAX_ALLOWED >= 1050
+    #include <libkern/OSAtomic.h>
+  #endif
+#endif
+
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkCellLinks, "$Revision$");
 vtkStandardNewMacro(vtkCellLinks);
@@ -28,11 +39,8 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 {
   static vtkCellLinks::Link linkInit = {0,NULL};
 
+  this->DeleteLinks();
   this->Size = sz;
-  if ( this->Array != NULL )
-    {
-    delete [] this->Array;
-    }
   this->Array = new vtkCellLinks::Link[sz];
   this->Extend = ext;
   this->MaxId = -1;
@@ -46,29 +54,54 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 //----------------------------------------------------------------------------
 vtkCellLinks::~vtkCellLinks()
 {
-  if ( this->Array == NULL )
-    {
-    return;
-    }
+  this->DeleteLinks();
+}
 
-  for (vtkIdType i=0; i<=this->MaxId; i++)
+//----------------------------------------------------------------------------
+void vtkCellLinks::DeleteLinks()
+{
+  if ( this->Array != NULL )
     {
-    if ( this->Array[i].cells != NULL )
+    for (vtkIdType i=0; i<=this->MaxId; i++)
       {
-      delete [] this->Array[i].cells;
+      if ( !this->IsInStorage(this->Array[i].cells) )
+        {
+        delete [] this->Array[i].cells;
+        }
       }
+    delete [] this->Array;
+    this->Array = NULL;
     }
 
-  delete [] this->Array;
+  delete [] this->Storage;
+  this->Storage = NULL;
+  this->StorageSize = 0;
+  this->Size = 0;
+  this->MaxId = -1;
 }
 
 //----------------------------------------------------------------------------
-// Allocate memory for the list of lists of cell ids.
+// Allocate memory for the list of lists of cell ids. All the lists are
+// allocated in a single block.
 void vtkCellLinks::AllocateLinks(vtkIdType n)
 {
-  for (vtkIdType i=0; i < n; i++)
+  vtkIdType i, total=0;
+
+  for (i=0; i < n; i++)
+    {
+    total += this->Array[i].ncells;
+    }
+
+  delete [] this->Storage;
+  this->Storage = (total > 0 ? new vtkIdType[total] : NULL);
+  this->StorageSize = total;
+
+  vtkIdType *cells = this->Storage;
+  for (i=0; i < n; i++)
     {
-    this->Array[i].cells = new vtkIdType[this->Array[i].ncells];
+    this->Array[i].cells = (this->Array[i].ncells > 0 ? cells : NULL);
+    cells += this->Array[i].ncells;
+    this->Array[i].ncells = 0;
     }
 }
 
@@ -125,6 +158,253 @@ vtkCellLinks::Link *vtkCellLinks::Resize(vtkIdType sz)
   return this->Array;
 }
 
+//----------------------------------------------------------------------------
+// Atomic increment of a counter returning its previous value, with the same
+// platform primitives as vtkTimeStamp. Without them the links are built
+// serially.
+#if defined(WIN32) || defined(_WIN32)
+# define VTK_CELL_LINKS_ATOMIC
+typedef LONG vtkCellLinksCounter;
+static inline vtkCellLinksCounter vtkCellLinksIncrement(
+  vtkCellLinksCounter volatile *counter)
+{
+  return InterlockedIncrement(counter) - 1;
+}
+#elif defined(__APPLE__) && (MAC_OS_X_VERSION_MIN_REQUIRED >= 1050)
+# define VTK_CELL_LINKS_ATOMIC
+typedef int32_t vtkCellLinksCounter;
+static inline vtkCellLinksCounter vtkCellLinksIncrement(
+  vtkCellLinksCounter volatile *counter)
+{
+  return OSAtomicIncrement32Barrier(counter) - 1;
+}
+#elif defined(__GNUC__) && \
+  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+# define VTK_CELL_LINKS_ATOMIC
+typedef int vtkCellLinksCounter;
+static inline vtkCellLinksCounter vtkCellLinksIncrement(
+  vtkCellLinksCounter volatile *counter)
+{
+  return __sync_fetch_and_add(counter, 1);
+}
+#endif
+
+int vtkCellLinks::GlobalNumberOfThreads = 1;
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::SetGlobalNumberOfThreads(int numThreads)
+{
+  vtkCellLinks::GlobalNumberOfThreads =
+    (numThreads < 1 ? 1 :
+     (numThreads > VTK_MAX_THREADS ? VTK_MAX_THREADS : numThreads));
+}
+
+//----------------------------------------------------------------------------
+int vtkCellLinks::GetGlobalNumberOfThreads()
+{
+  return vtkCellLinks::GlobalNumberOfThreads;
+}
+
+#ifdef VTK_CELL_LINKS_ATOMIC
+//----------------------------------------------------------------------------
+// Builds the links of the cells of a polydata or of a cell array on several
+// threads. Each thread counts the uses of the points by its range of cells
+// with atomic increments. The counts are summed into the offsets of the
+// lists, then each thread fills the lists with its range of cells, taking
+// the next position of a list with an atomic increment. Last, the lists are
+// sorted so that the links are the same as those of the serial build.
+class vtkCellLinksBuild
+{
+public:
+  vtkCellLinks *Links;
+  vtkPolyData *PolyData;      // cells of the polydata, or
+  vtkCellArray *Connectivity; // cells of the cell array
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+  int NumberOfThreads;
+
+  // First cell of the range of each thread, and its location in
+  // Connectivity.
+  vtkstd::vector<vtkIdType> CellBegin;
+  vtkstd::vector<vtkIdType> LocationBegin;
+
+  // Number of uses of each point, then next position in its list.
+  vtkCellLinksCounter *Counts;
+
+  enum { COUNT, FILL, SORT };
+  int Pass;
+
+  void Build();
+  void Traverse(int range);
+  void Sort(vtkIdType beginPt, vtkIdType endPt);
+  void Visit(vtkIdType cellId, vtkIdType npts, const vtkIdType *pts)
+    {
+    vtkCellLinks::Link *links = this->Links->Array;
+    for (vtkIdType j=0; j < npts; j++)
+      {
+      vtkCellLinksCounter pos = vtkCellLinksIncrement(this->Counts + pts[j]);
+      if ( this->Pass == FILL )
+        {
+        links[pts[j]].cells[pos] = cellId;
+        }
+      }
+    }
+
+  static VTK_THREAD_RETURN_TYPE Execute(void *arg);
+};
+
+//----------------------------------------------------------------------------
+void vtkCellLinksBuild::Traverse(int range)
+{
+  vtkIdType cellId = this->CellBegin[range];
+  vtkIdType endCell = this->CellBegin[range+1];
+  vtkIdType npts;
+  vtkIdType *pts;
+
+  if ( this->PolyData )
+    {
+    for (; cellId < endCell; cellId++)
+      {
+      this->PolyData->GetCellPoints(cellId, npts, pts);
+      this->Visit(cellId, npts, pts);
+      }
+    }
+  else
+    {
+    vtkIdType *conn =
+      this->Connectivity->GetPointer() + this->LocationBegin[range];
+    for (; cellId < endCell; cellId++)
+      {
+      npts = *conn++;
+      this->Visit(cellId, npts, conn);
+      conn += npts;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Sets the number of cells of the links of the points from their counts,
+// and sorts their cell ids.
+void vtkCellLinksBuild::Sort(vtkIdType beginPt, vtkIdType endPt)
+{
+  vtkCellLinks::Link *links = this->Links->Array;
+  for (vtkIdType ptId=beginPt; ptId < endPt; ptId++)
+    {
+    vtkIdType *cells = links[ptId].cells;
+    int ncells = static_cast<int>(this->Counts[ptId]);
+    links[ptId].ncells = static_cast<unsigned short>(ncells);
+    for (int i=1; i < ncells; i++)
+      {
+      vtkIdType cellId = cells[i];
+      int j = i;
+      for (; j > 0 && cells[j-1] > cellId; j--)
+        {
+        cells[j] = cells[j-1];
+        }
+      cells[j] = cellId;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkCellLinksBuild::Execute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkCellLinksBuild *self = static_cast<vtkCellLinksBuild *>(info->UserData);
+
+  if ( self->Pass == vtkCellLinksBuild::SORT )
+    {
+    vtkIdType beginPt = static_cast<vtkIdType>(
+      static_cast<double>(self->NumberOfPoints) * info->ThreadID /
+      info->NumberOfThreads);
+    vtkIdType endPt = static_cast<vtkIdType>(
+      static_cast<double>(self->NumberOfPoints) * (info->ThreadID + 1) /
+      info->NumberOfThreads);
+    self->Sort(beginPt, endPt);
+    }
+  else
+    {
+    self->Traverse(info->ThreadID);
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinksBuild::Build()
+{
+  vtkIdType cellId, i;
+
+  // Split the cells in one range per thread. The ranges of a cell array
+  // also need the location of their first cell.
+  this->CellBegin.resize(this->NumberOfThreads + 1);
+  this->LocationBegin.resize(this->NumberOfThreads + 1);
+  for (i=0; i <= this->NumberOfThreads; i++)
+    {
+    this->CellBegin[i] = static_cast<vtkIdType>(
+      static_cast<double>(this->NumberOfCells) * i / this->NumberOfThreads);
+    }
+  if ( this->Connectivity )
+    {
+    const vtkIdType *ia = this->Connectivity->GetPointer();
+    vtkIdType loc = 0;
+    int range = 0;
+    for (cellId=0; cellId <= this->NumberOfCells; cellId++)
+      {
+      while ( range <= this->NumberOfThreads &&
+              this->CellBegin[range] == cellId )
+        {
+        this->LocationBegin[range++] = loc;
+        }
+      if ( cellId < this->NumberOfCells )
+        {
+        loc += ia[loc] + 1;
+        }
+      }
+    }
+
+  this->Counts = new vtkCellLinksCounter[this->NumberOfPoints];
+  memset(this->Counts, 0, this->NumberOfPoints * sizeof(vtkCellLinksCounter));
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(this->NumberOfThreads);
+  threader->SetSingleMethod(vtkCellLinksBuild::Execute, this);
+
+  // traverse data to determine number of uses of each point
+  this->Pass = COUNT;
+  threader->SingleMethodExecute();
+
+  // now allocate storage for the links: the prefix sum of the counts
+  vtkCellLinks::Link *links = this->Links->Array;
+  for (i=0; i < this->NumberOfPoints; i++)
+    {
+    links[i].ncells = static_cast<unsigned short>(this->Counts[i]);
+    }
+  this->Links->AllocateLinks(this->NumberOfPoints);
+  this->Links->MaxId = this->NumberOfPoints - 1;
+  memset(this->Counts, 0, this->NumberOfPoints * sizeof(vtkCellLinksCounter));
+
+  // fill out lists with references to cells, then put them in order
+  this->Pass = FILL;
+  threader->SingleMethodExecute();
+  this->Pass = SORT;
+  threader->SingleMethodExecute();
+
+  threader->Delete();
+  delete [] this->Counts;
+  this->Counts = NULL;
+}
+
+//----------------------------------------------------------------------------
+// Returns the number of threads to build the links of the cells with, 1 if
+// they are too few to be worth the threads.
+static int vtkCellLinksGetNumberOfThreads(vtkIdType numCells)
+{
+  return numCells >= 10000 ? vtkCellLinks::GetGlobalNumberOfThreads() : 1;
+}
+#endif
+
 //----------------------------------------------------------------------------
 // Build the link list array.
 void vtkCellLinks::BuildLinks(vtkDataSet *data)
@@ -133,18 +413,29 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
   vtkIdType numCells = data->GetNumberOfCells();
   int j;
   vtkIdType cellId;
-  unsigned short *linkLoc;
-
-  // fill out lists with number of references to cells
-  linkLoc = new unsigned short[numPts];
-  memset(linkLoc, 0, numPts*sizeof(unsigned short));
 
   // Use fast path if polydata
   if ( data->GetDataObjectType() == VTK_POLY_DATA )
     {
     vtkIdType *pts, npts;
-    
     vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
+
+#ifdef VTK_CELL_LINKS_ATOMIC
+    int numThreads = vtkCellLinksGetNumberOfThreads(numCells);
+    if ( numThreads > 1 )
+      {
+      vtkCellLinksBuild build;
+      build.Links = this;
+      build.PolyData = pdata;
+      build.Connectivity = NULL;
+      build.NumberOfPoints = numPts;
+      build.NumberOfCells = numCells;
+      build.NumberOfThreads = numThreads;
+      build.Build();
+      return;
+      }
+#endif
+
     // traverse data to determine number of uses of each point
     for (cellId=0; cellId < numCells; cellId++)
       {
@@ -164,14 +455,14 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
       pdata->GetCellPoints(cellId, npts, pts);
       for (j=0; j < npts; j++)
         {
-        this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);      
+        this->InsertNextCellReference(pts[j], cellId);      
         }      
       }
     }
 
   else //any other type of dataset
     {
-    vtkIdType numberOfPoints, ptId;
+    vtkIdType numberOfPoints;
     vtkGenericCell *cell=vtkGenericCell::New();
 
     // traverse data to determine number of uses of each point
@@ -195,14 +486,11 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
       numberOfPoints = cell->GetNumberOfPoints();
       for (j=0; j < numberOfPoints; j++)
         {
-        ptId = cell->PointIds->GetId(j);
-        this->InsertCellReference(ptId, (linkLoc[ptId])++, cellId);      
+        this->InsertNextCellReference(cell->PointIds->GetId(j), cellId);
         }      
       }
     cell->Delete();
     }//end else
-
-  delete [] linkLoc;
 }
 
 //----------------------------------------------------------------------------
@@ -211,9 +499,26 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
 {
   vtkIdType numPts = data->GetNumberOfPoints();
   vtkIdType j, cellId;
-  unsigned short *linkLoc;
   vtkIdType npts=0;
   vtkIdType *pts=0;
+
+#ifdef VTK_CELL_LINKS_ATOMIC
+  vtkIdType numCells = Connectivity->GetNumberOfCells();
+  int numThreads = vtkCellLinksGetNumberOfThreads(numCells);
+  if ( numThreads > 1 )
+    {
+    vtkCellLinksBuild build;
+    build.Links = this;
+    build.PolyData = NULL;
+    build.Connectivity = Connectivity;
+    build.NumberOfPoints = numPts;
+    build.NumberOfCells = numCells;
+    build.NumberOfThreads = numThreads;
+    build.Build();
+    return;
+    }
+#endif
+
   vtkIdType loc = Connectivity->GetTraversalLocation();
   
   // traverse data to determine number of uses of each point
@@ -231,19 +536,15 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
   this->MaxId = numPts - 1;
 
   // fill out lists with references to cells
-  linkLoc = new unsigned short[numPts];
-  memset(linkLoc, 0, numPts*sizeof(unsigned short));
-
   cellId = 0;
   for (Connectivity->InitTraversal(); 
        Connectivity->GetNextCell(npts,pts); cellId++)
     {
     for (j=0; j < npts; j++)
       {
-      this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);      
+      this->InsertNextCellReference(pts[j], cellId);      
       }      
     }
-  delete [] linkLoc;
   Connectivity->SetTraversalLocation(loc);
 }
 
@@ -271,7 +572,7 @@ unsigned long vtkCellLinks::GetActualMemorySize()
     size += this->GetNcells(ptId);
     }
 
-  size *= sizeof(int *); //references to cells
+  size *= sizeof(vtkIdType); //references to cells
   size += (this->MaxId+1) * sizeof(vtkCellLinks::Link); //list of cell lists
 
   return static_cast<unsigned long>( ceil(size/1024.0)); //kilobytes
@@ -280,8 +581,20 @@ unsigned long vtkCellLinks::GetActualMemorySize()
 //----------------------------------------------------------------------------
 void vtkCellLinks::DeepCopy(vtkCellLinks *src)
 {
+  vtkIdType i, numLinks = src->MaxId + 1;
+
   this->Allocate(src->Size, src->Extend);
-  memcpy(this->Array, src->Array, this->Size * sizeof(vtkCellLinks::Link));
+  for (i=0; i < numLinks; i++)
+    {
+    this->Array[i].ncells = src->Array[i].ncells;
+    }
+  this->AllocateLinks(numLinks);
+  for (i=0; i < numLinks; i++)
+    {
+    this->Array[i].ncells = src->Array[i].ncells;
+    memcpy(this->Array[i].cells, src->Array[i].cells,
+           this->Array[i].ncells * sizeof(vtkIdType));
+    }
   this->MaxId = src->MaxId;
 }
 
@@ -19,6 +19,12 @@
 // a list of Links, each link represents a dynamic list of cell id's using the 
 // point. The information provided by this object can be used to determine 
 // neighbors and construct other local topological information.
+//
+// BuildLinks() stores the cell ids of all the links in a single block of
+// memory. It counts and fills the links on GetGlobalNumberOfThreads()
+// threads for polydata and unstructured grids of at least 10000 cells.
+// The lists of the points inserted or resized later are allocated
+// separately.
 // .SECTION See Also
 // vtkCellArray vtkCellTypes
 
@@ -28,6 +34,7 @@
 #include "vtkObject.h"
 class vtkDataSet;
 class vtkCellArray;
+class vtkCellLinksBuild;
 
 class VTK_FILTERING_EXPORT vtkCellLinks : public vtkObject 
 {
@@ -124,16 +131,41 @@ public:
   // to other objects, there is no ShallowCopy.
   void DeepCopy(vtkCellLinks *src);
 
+  // Description:
+  // Set/Get the number of threads BuildLinks() uses, for all the instances.
+  // The cell ids of every link are in increasing order whatever the number
+  // of threads. The default is 1, since the processes of a parallel
+  // server already share the cores.
+  static void SetGlobalNumberOfThreads(int numThreads);
+  static int GetGlobalNumberOfThreads();
+
 protected:
-  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000) {};
+  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000),Storage(NULL),
+                StorageSize(0) {};
   ~vtkCellLinks();
 
   // Description:
   // Increment the count of the number of cells using the point.
   void IncrementLinkCount(vtkIdType ptId) { this->Array[ptId].ncells++;};
 
+  // Description:
+  // Allocate the lists of the first n links in Storage from their counts,
+  // and reset the counts so that the lists can be filled with
+  // InsertNextCellReference().
   void AllocateLinks(vtkIdType n);
 
+  // Description:
+  // Delete the lists of cell ids and the storage of the links.
+  void DeleteLinks();
+
+  // Description:
+  // Return true if the list of cell ids is in Storage, i.e. it must not be
+  // deleted on its own.
+  int IsInStorage(vtkIdType *cells)
+    {
+    return cells >= this->Storage && cells < this->Storage + this->StorageSize;
+    }
+
   // Description:
   // Insert a cell id into the list of cells using the point.
   void InsertCellReference(vtkIdType ptId, unsigned short pos,
@@ -144,6 +176,13 @@ protected:
   vtkIdType MaxId;     // maximum index inserted thus far
   vtkIdType Extend;     // grow array by this point
   Link *Resize(vtkIdType sz);  // function to resize data
+
+  vtkIdType *Storage;   // cell ids of the links built by BuildLinks()
+  vtkIdType StorageSize;
+
+  static int GlobalNumberOfThreads;
+
+  friend class vtkCellLinksBuild;
 private:
   vtkCellLinks(const vtkCellLinks&);  // Not implemented.
   void operator=(const vtkCellLinks&);  // Not implemented.
@@ -161,7 +200,10 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId,
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
   this->Array[ptId].ncells = 0;
-  delete [] this->Array[ptId].cells;
+  if ( !this->IsInStorage(this->Array[ptId].cells) )
+    {
+    delete [] this->Array[ptId].cells;
+    }
   this->Array[ptId].cells = NULL;
 }
 
@@ -208,7 +250,10 @@ inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
   cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
          this->Array[ptId].ncells*sizeof(vtkIdType));
-  delete [] this->Array[ptId].cells;
+  if ( !this->IsInStorage(this->Array[ptId].cells) )
+    {
+    delete [] this->Array[ptId].cells;
+    }
   this->Array[ptId].cells = cells;
 }
 
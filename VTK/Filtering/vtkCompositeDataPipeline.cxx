@@ -16,7 +16,9 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCommand.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCriticalSection.h"
 #include "vtkImageData.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -30,7 +32,9 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
+#include "vtkOutputWindow.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
@@ -38,6 +42,9 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkTemporalDataSet.h"
 #include "vtkUniformGrid.h"
 
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
 //----------------------------------------------------------------------------
 #if defined (JB_DEBUG1)
   #ifndef WIN32
@@ -86,6 +93,219 @@ vtkStandardNewMacro(vtkCompositeDataPipeline);
 
 vtkInformationKeyMacro(vtkCompositeDataPipeline,REQUIRES_TIME_DOWNSTREAM, Integer);
 
+static int vtkCompositeDataPipelineNumberOfBlockThreads = 1;
+
+//----------------------------------------------------------------------------
+// A message displayed in the output window while executing a block.
+struct vtkCompositeDataPipelineMessage
+{
+  int Type;
+  vtkstd::string Text;
+};
+
+//----------------------------------------------------------------------------
+// A block executed on a worker thread, with its own request and information
+// vectors so that the executive is not shared among threads.
+struct vtkCompositeDataPipelineBlock
+{
+  vtkSmartPointer<vtkInformation> Request;
+  vtkstd::vector<vtkSmartPointer<vtkInformationVector> > Inputs;
+  vtkstd::vector<vtkInformationVector*> InputPointers;
+  vtkSmartPointer<vtkInformationVector> Outputs;
+  vtkSmartPointer<vtkDataObject> Output;
+  int Result;
+  vtkstd::vector<vtkCompositeDataPipelineMessage> Messages;
+};
+
+//----------------------------------------------------------------------------
+// Replaces the output window while the worker threads execute the blocks,
+// where vtkErrorMacro and vtkWarningMacro display their messages since the
+// observers of the algorithm are detached. The messages of each worker
+// thread are stored with the block it executes, to be reported on the
+// calling thread once all the blocks are done. The messages of other
+// threads go to the replaced window.
+class vtkCompositeDataPipelineMessages : public vtkOutputWindow
+{
+public:
+  enum MessageTypes
+  {
+    TextMessage,
+    ErrorMessage,
+    WarningMessage,
+    GenericWarningMessage,
+    DebugMessage
+  };
+
+  static vtkCompositeDataPipelineMessages* New()
+    { return new vtkCompositeDataPipelineMessages; }
+
+  virtual void DisplayText(const char* text)
+    { this->Record(TextMessage, text); }
+  virtual void DisplayErrorText(const char* text)
+    { this->Record(ErrorMessage, text); }
+  virtual void DisplayWarningText(const char* text)
+    { this->Record(WarningMessage, text); }
+  virtual void DisplayGenericWarningText(const char* text)
+    { this->Record(GenericWarningMessage, text); }
+  virtual void DisplayDebugText(const char* text)
+    { this->Record(DebugMessage, text); }
+
+  // Called by a worker thread before it executes a block.
+  void SetBlock(vtkCompositeDataPipelineBlock* block)
+    {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    this->Lock.Lock();
+    size_t i = 0;
+    while (i < this->Threads.size() &&
+           !vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+      {
+      ++i;
+      }
+    if (i == this->Threads.size())
+      {
+      this->Threads.push_back(id);
+      this->Blocks.push_back(block);
+      }
+    this->Blocks[i] = block;
+    this->Lock.Unlock();
+    }
+
+  // Reports the messages of a block once the worker threads are done:
+  // errors and warnings go to the observers of the algorithm, if any, as
+  // vtkErrorMacro and vtkWarningMacro do.
+  static void Report(vtkAlgorithm* algorithm,
+                     vtkCompositeDataPipelineBlock& block)
+    {
+    for (size_t i = 0; i < block.Messages.size(); ++i)
+      {
+      int type = block.Messages[i].Type;
+      char* text = const_cast<char*>(block.Messages[i].Text.c_str());
+      unsigned long event = vtkCommand::NoEvent;
+      if (type == ErrorMessage)
+        {
+        event = vtkCommand::ErrorEvent;
+        }
+      else if (type == WarningMessage)
+        {
+        event = vtkCommand::WarningEvent;
+        }
+      if (event != vtkCommand::NoEvent && algorithm->HasObserver(event))
+        {
+        algorithm->InvokeEvent(event, text);
+        }
+      else
+        {
+        Display(vtkOutputWindow::GetInstance(), type, text);
+        }
+      }
+    block.Messages.clear();
+    }
+
+  vtkOutputWindow* Replaced;
+
+protected:
+  vtkCompositeDataPipelineMessages() { this->Replaced = 0; }
+
+  static void Display(vtkOutputWindow* window, int type, const char* text)
+    {
+    switch (type)
+      {
+      case ErrorMessage:
+        window->DisplayErrorText(text);
+        break;
+      case WarningMessage:
+        window->DisplayWarningText(text);
+        break;
+      case GenericWarningMessage:
+        window->DisplayGenericWarningText(text);
+        break;
+      case DebugMessage:
+        window->DisplayDebugText(text);
+        break;
+      default:
+        window->DisplayText(text);
+      }
+    }
+
+  void Record(int type, const char* text)
+    {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    vtkCompositeDataPipelineBlock* block = 0;
+    this->Lock.Lock();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        block = this->Blocks[i];
+        vtkCompositeDataPipelineMessage message;
+        message.Type = type;
+        message.Text = text? text : "";
+        block->Messages.push_back(message);
+        break;
+        }
+      }
+    this->Lock.Unlock();
+    if (!block && this->Replaced)
+      {
+      Display(this->Replaced, type, text);
+      }
+    }
+
+  vtkSimpleCriticalSection Lock;
+  vtkstd::vector<vtkMultiThreaderIDType> Threads;
+  vtkstd::vector<vtkCompositeDataPipelineBlock*> Blocks;
+};
+
+//----------------------------------------------------------------------------
+struct vtkCompositeDataPipelineBlockQueue
+{
+  vtkAlgorithm* Algorithm;
+  vtkCompositeDataPipelineMessages* Messages;
+  vtkstd::vector<vtkCompositeDataPipelineBlock*> Blocks;
+  vtkSimpleCriticalSection Lock;
+  size_t NextBlock;
+};
+
+//----------------------------------------------------------------------------
+// The worker threads take the next block to execute until all are done, so
+// that the threads executing smaller blocks execute more of them.
+static VTK_THREAD_RETURN_TYPE vtkCompositeDataPipelineExecuteBlocks(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkCompositeDataPipelineBlockQueue* queue =
+    static_cast<vtkCompositeDataPipelineBlockQueue*>(info->UserData);
+  vtkstd::vector<vtkCompositeDataPipelineBlock*>& blocks = queue->Blocks;
+  for (;;)
+    {
+    queue->Lock.Lock();
+    size_t index = queue->NextBlock++;
+    queue->Lock.Unlock();
+    if (index >= blocks.size() || queue->Algorithm->GetAbortExecute())
+      {
+      break;
+      }
+    vtkCompositeDataPipelineBlock& block = *blocks[index];
+    queue->Messages->SetBlock(&block);
+    block.Result = queue->Algorithm->ProcessRequest(
+      block.Request, &block.InputPointers[0], block.Outputs);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::SetNumberOfBlockThreads(int numThreads)
+{
+  vtkCompositeDataPipelineNumberOfBlockThreads =
+    (numThreads < 0)? 1 : numThreads;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompositeDataPipeline::GetNumberOfBlockThreads()
+{
+  return vtkCompositeDataPipelineNumberOfBlockThreads;
+}
+
 //----------------------------------------------------------------------------
 vtkCompositeDataPipeline::vtkCompositeDataPipeline()
 {
@@ -638,34 +858,42 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
     // ExecuteDataStart() should NOT Initialize() the composite output.
     this->InLocalLoop = 1;
 
-    vtkSmartPointer<vtkCompositeDataIterator> iter;
-    iter.TakeReference(input->NewIterator());
-    iter->VisitOnlyLeavesOn();
-    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); 
-      iter->GoToNextItem())
+    if (!this->ExecuteSimpleAlgorithmConcurrently(inInfoVec, outInfoVec,
+                                                  inInfo, outInfo, r,
+                                                  compositePort, input,
+                                                  compositeOutput,
+                                                  times, numTimeSteps))
       {
-      // if it is a temporal input, set the time for each piece
-      if (times)
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(input->NewIterator());
+      iter->VisitOnlyLeavesOn();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); 
+        iter->GoToNextItem())
         {
-        outInfo->Set(UPDATE_TIME_STEPS(), times, numTimeSteps);
-        }
-      vtkDataObject* dobj = iter->GetCurrentDataObject();
-      if (dobj)
-        {
-        // Note that since VisitOnlyLeaves is ON on the iterator,
-        // this method is called only for leaves, hence, we are assured that
-        // neither dobj nor outObj are vtkCompositeDataSet subclasses.
-        vtkDataObject* outObj =
-          this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
-                                               outInfoVec,
-                                               inInfo,
-                                               outInfo,
-                                               r,
-                                               dobj);
-        if (outObj)
+        // if it is a temporal input, set the time for each piece
+        if (times)
+          {
+          outInfo->Set(UPDATE_TIME_STEPS(), times, numTimeSteps);
+          }
+        vtkDataObject* dobj = iter->GetCurrentDataObject();
+        if (dobj)
           {
-          compositeOutput->SetDataSet(iter, outObj);
-          outObj->Delete();
+          // Note that since VisitOnlyLeaves is ON on the iterator,
+          // this method is called only for leaves, hence, we are assured
+          // that neither dobj nor outObj are vtkCompositeDataSet
+          // subclasses.
+          vtkDataObject* outObj =
+            this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
+                                                 outInfoVec,
+                                                 inInfo,
+                                                 outInfo,
+                                                 r,
+                                                 dobj);
+          if (outObj)
+            {
+            compositeOutput->SetDataSet(iter, outObj);
+            outObj->Delete();
+            }
           }
         }
       }
@@ -717,6 +945,42 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
 {
   vtkDebugMacro(<< "ExecuteSimpleAlgorithmForBlock");
 
+  int storedPiece = -1;
+  int storedNumPieces = -1;
+  if (!this->PrepareSimpleAlgorithmForBlock(inInfoVec, outInfoVec, inInfo,
+                                            outInfo, request, dobj,
+                                            storedPiece, storedNumPieces))
+    {
+    return 0;
+    }
+
+  request->Set(REQUEST_DATA());
+  this->Superclass::ExecuteData(request,inInfoVec,outInfoVec);
+  request->Remove(REQUEST_DATA());
+  
+  this->RestorePieceRequest(storedPiece, storedNumPieces);
+
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output)
+    {
+    return 0;
+    }
+  vtkDataObject* outputCopy = output->NewInstance();
+  outputCopy->ShallowCopy(output);
+  return outputCopy;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompositeDataPipeline::PrepareSimpleAlgorithmForBlock(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  vtkInformation* inInfo,
+  vtkInformation* outInfo,
+  vtkInformation* request,
+  vtkDataObject* dobj,
+  int& storedPiece,
+  int& storedNumPieces)
+{
   if (dobj && dobj->IsA("vtkCompositeDataSet"))
     {
     vtkErrorMacro("ExecuteSimpleAlgorithmForBlock cannot be called "
@@ -767,8 +1031,8 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
   this->Superclass::ExecuteInformation(request,inInfoVec,outInfoVec);
   request->Remove(REQUEST_INFORMATION());
   
-  int storedPiece = -1;
-  int storedNumPieces = -1;
+  storedPiece = -1;
+  storedNumPieces = -1;
   for(int m=0; m < this->Algorithm->GetNumberOfOutputPorts(); ++m)
     {
     vtkInformation* info = this->GetOutputInformation(m);
@@ -810,11 +1074,205 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
   this->CallAlgorithm(request, vtkExecutive::RequestUpstream,
                       inInfoVec, outInfoVec);
   request->Remove(REQUEST_UPDATE_EXTENT());
-  
-  request->Set(REQUEST_DATA());
-  this->Superclass::ExecuteData(request,inInfoVec,outInfoVec);
-  request->Remove(REQUEST_DATA());
-  
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompositeDataPipeline::ExecuteSimpleAlgorithmConcurrently(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  vtkInformation* inInfo,
+  vtkInformation* outInfo,
+  vtkInformation* request,
+  int compositePort,
+  vtkCompositeDataSet* input,
+  vtkCompositeDataSet* compositeOutput,
+  double* times,
+  int numTimeSteps)
+{
+  int numThreads = vtkCompositeDataPipelineNumberOfBlockThreads;
+  if (numThreads == 0)
+    {
+    numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  if (numThreads < 2 ||
+      !this->Algorithm->GetInformation()->Get(
+        vtkAlgorithm::REENTRANT_REQUEST_DATA()) ||
+      this->Algorithm->GetNumberOfOutputPorts() != 1)
+    {
+    return 0;
+    }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  iter->VisitOnlyLeavesOn();
+  int numLeaves = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal() && numLeaves < 2;
+    iter->GoToNextItem())
+    {
+    if (iter->GetCurrentDataObject())
+      {
+      numLeaves++;
+      }
+    }
+  if (numLeaves < 2)
+    {
+    return 0;
+    }
+
+  vtkDebugMacro(<< "Executing the blocks on " << numThreads << " threads");
+
+  // The passes preceding REQUEST_DATA use the information of the executive:
+  // execute them one block at a time and give each block its own copy of
+  // the information and its own output.
+  vtkstd::vector<vtkCompositeDataPipelineBlock> blocks;
+  int numInputPorts = this->Algorithm->GetNumberOfInputPorts();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkDataObject* dobj = iter->GetCurrentDataObject();
+    if (!dobj)
+      {
+      continue;
+      }
+    blocks.push_back(vtkCompositeDataPipelineBlock());
+    vtkCompositeDataPipelineBlock& block = blocks.back();
+    block.Result = 1;
+
+    if (times)
+      {
+      outInfo->Set(UPDATE_TIME_STEPS(), times, numTimeSteps);
+      }
+    int storedPiece = -1;
+    int storedNumPieces = -1;
+    if (!this->PrepareSimpleAlgorithmForBlock(inInfoVec, outInfoVec, inInfo,
+                                              outInfo, request, dobj,
+                                              storedPiece, storedNumPieces))
+      {
+      continue;
+      }
+    vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (output)
+      {
+      block.Request = vtkSmartPointer<vtkInformation>::New();
+      block.Request->Copy(request);
+      block.Request->Set(REQUEST_DATA());
+
+      for (int i = 0; i < numInputPorts; ++i)
+        {
+        vtkSmartPointer<vtkInformationVector> inputs =
+          vtkSmartPointer<vtkInformationVector>::New();
+        int numConnections = inInfoVec[i]->GetNumberOfInformationObjects();
+        for (int j = 0; j < numConnections; ++j)
+          {
+          if (i == compositePort && j == 0)
+            {
+            vtkSmartPointer<vtkInformation> blockInInfo =
+              vtkSmartPointer<vtkInformation>::New();
+            blockInInfo->Copy(inInfo);
+            inputs->SetInformationObject(j, blockInInfo);
+            }
+          else
+            {
+            inputs->SetInformationObject(
+              j, inInfoVec[i]->GetInformationObject(j));
+            }
+          }
+        block.Inputs.push_back(inputs);
+        block.InputPointers.push_back(inputs);
+        }
+
+      vtkSmartPointer<vtkInformation> blockOutInfo =
+        vtkSmartPointer<vtkInformation>::New();
+      blockOutInfo->Copy(outInfo);
+      blockOutInfo->Remove(vtkDataObject::DATA_OBJECT());
+      PRODUCER()->Remove(blockOutInfo);
+      CONSUMERS()->Remove(blockOutInfo);
+      block.Output.TakeReference(output->NewInstance());
+      block.Output->SetPipelineInformation(blockOutInfo);
+      block.Outputs = vtkSmartPointer<vtkInformationVector>::New();
+      block.Outputs->SetInformationObject(0, blockOutInfo);
+
+      this->ExecuteDataStart(block.Request, &block.InputPointers[0],
+                             block.Outputs);
+      }
+    this->RestorePieceRequest(storedPiece, storedNumPieces);
+    }
+
+  // Blocks that could not be prepared are left out.
+  vtkCompositeDataPipelineBlockQueue queue;
+  queue.Algorithm = this->Algorithm;
+  queue.NextBlock = 0;
+  for (size_t i = 0; i < blocks.size(); ++i)
+    {
+    if (blocks[i].Output)
+      {
+      queue.Blocks.push_back(&blocks[i]);
+      }
+    }
+
+  if (queue.Blocks.empty())
+    {
+    return 1;
+    }
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(
+    numThreads < static_cast<int>(queue.Blocks.size())?
+    numThreads : static_cast<int>(queue.Blocks.size()));
+  threader->SetSingleMethod(vtkCompositeDataPipelineExecuteBlocks, &queue);
+
+  // The messages of the workers are reported below, in the order of the
+  // blocks, so that observers are only called from this thread.
+  vtkOutputWindow* window = vtkOutputWindow::GetInstance();
+  window->Register(this);
+  vtkCompositeDataPipelineMessages* messages =
+    vtkCompositeDataPipelineMessages::New();
+  messages->Replaced = window;
+  vtkOutputWindow::SetInstance(messages);
+  queue.Messages = messages;
+
+  this->Algorithm->SetExecutingConcurrently(1);
+  threader->SingleMethodExecute();
+  this->Algorithm->SetExecutingConcurrently(0);
+  threader->Delete();
+
+  vtkOutputWindow::SetInstance(window);
+  window->UnRegister(this);
+  messages->Delete();
+
+  size_t next = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    if (!iter->GetCurrentDataObject())
+      {
+      continue;
+      }
+    vtkCompositeDataPipelineBlock& block = blocks[next++];
+    if (!block.Output)
+      {
+      continue;
+      }
+    vtkCompositeDataPipelineMessages::Report(this->Algorithm, block);
+    if (!block.Result)
+      {
+      vtkErrorMacro("Algorithm " << this->Algorithm->GetClassName()
+                    << "(" << this->Algorithm
+                    << ") returned failure for request: "
+                    << *block.Request);
+      }
+    this->ExecuteDataEnd(block.Request, &block.InputPointers[0],
+                         block.Outputs);
+    block.Output->SetPipelineInformation(0);
+    compositeOutput->SetDataSet(iter, block.Output);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::RestorePieceRequest(int storedPiece,
+                                                   int storedNumPieces)
+{
   for(int m=0; m < this->Algorithm->GetNumberOfOutputPorts(); ++m)
     {
     vtkInformation* info = this->GetOutputInformation(m);
@@ -829,18 +1287,8 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
         storedPiece);
       }
     }
-
-  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
-  if (!output)
-    {
-    return 0;
-    }
-  vtkDataObject* outputCopy = output->NewInstance();
-  outputCopy->ShallowCopy(output);
-  return outputCopy;
 }
 
-
 //----------------------------------------------------------------------------
 // Execute a simple (non-composite-aware) filter multiple times, once per
 // block. Collect the result in a composite dataset that is of the same
@@ -1027,6 +1475,11 @@ int vtkCompositeDataPipeline::NeedToExecuteData(
       }
     }
 
+  if (this->NeedToExecuteBasedOnRegionOfInterest(outInfo, dataObject))
+    {
+    return 1;
+    }
+
   if (this->NeedToExecuteBasedOnTime(outInfo, dataObject))
     {
     return 1;
@@ -80,6 +80,20 @@ public:
   // vtkCompositeDataPipeline specific keys
   static vtkInformationIntegerKey*       REQUIRES_TIME_DOWNSTREAM();
 
+  // Description:
+  // Set/Get the number of threads used to execute a simple algorithm on the
+  // blocks of a composite input. Only algorithms that set
+  // vtkAlgorithm::REENTRANT_REQUEST_DATA() in their information and have
+  // one output are executed concurrently: the threads take the next block
+  // to execute until all are done and the output blocks are in the order
+  // of the input blocks. The passes preceding REQUEST_DATA still execute
+  // one block at a time. The errors and warnings of the algorithm are
+  // reported on the calling thread once all the blocks are done. 0 uses
+  // the default number of threads of vtkMultiThreader. The default, 1,
+  // executes all the blocks in the calling thread.
+  static void SetNumberOfBlockThreads(int numThreads);
+  static int GetNumberOfBlockThreads();
+
 protected:
   vtkCompositeDataPipeline();
   ~vtkCompositeDataPipeline();
@@ -145,6 +159,36 @@ protected:
     vtkInformation* request,  
     vtkDataObject* dobj);
 
+  // Description:
+  // Executes the passes preceding REQUEST_DATA for one block. The piece
+  // request overridden to process the whole block is stored in
+  // storedPiece and storedNumPieces, to be restored by
+  // RestorePieceRequest(). Returns 0 if dobj can not be processed.
+  int PrepareSimpleAlgorithmForBlock(vtkInformationVector** inInfoVec,
+                                     vtkInformationVector* outInfoVec,
+                                     vtkInformation* inInfo,
+                                     vtkInformation* outInfo,
+                                     vtkInformation* request,
+                                     vtkDataObject* dobj,
+                                     int& storedPiece,
+                                     int& storedNumPieces);
+  void RestorePieceRequest(int storedPiece, int storedNumPieces);
+
+  // Description:
+  // Executes the algorithm on the leaves of input using several threads
+  // and stores the results in compositeOutput. Returns 0 without doing
+  // anything when the blocks must be executed one at a time.
+  int ExecuteSimpleAlgorithmConcurrently(vtkInformationVector** inInfoVec,
+                                         vtkInformationVector* outInfoVec,
+                                         vtkInformation* inInfo,
+                                         vtkInformation* outInfo,
+                                         vtkInformation* request,
+                                         int compositePort,
+                                         vtkCompositeDataSet* input,
+                                         vtkCompositeDataSet* compositeOutput,
+                                         double* times,
+                                         int numTimeSteps);
+
   bool ShouldIterateOverInput(int& compositePort);
   bool ShouldIterateTemporalData(vtkInformation *request,
                                  vtkInformationVector** inInfoVec, 
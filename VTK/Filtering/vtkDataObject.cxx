@@ -50,6 +50,7 @@ vtkInformationKeyMacro(vtkDataObject, DATA_PIECE_NUMBER, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_NUMBER_OF_PIECES, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_NUMBER_OF_GHOST_LEVELS, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkDataObject, DATA_REGION_OF_INTEREST, DoubleVector);
 vtkInformationKeyMacro(vtkDataObject, DATA_TIME_STEPS, DoubleVector);
 vtkInformationKeyMacro(vtkDataObject, POINT_DATA_VECTOR, InformationVector);
 vtkInformationKeyMacro(vtkDataObject, CELL_DATA_VECTOR, InformationVector);
@@ -386,6 +387,7 @@ void vtkDataObject::Initialize()
     this->Information->Remove(DATA_NUMBER_OF_GHOST_LEVELS());
     this->Information->Remove(DATA_TIME_STEPS());
     this->Information->Remove(DATA_RESOLUTION());
+    this->Information->Remove(DATA_REGION_OF_INTEREST());
     }
 
   this->Modified();
@@ -27,6 +27,7 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkInformation.h"
@@ -36,6 +37,170 @@
 vtkCxxRevisionMacro(vtkDataSetAttributes, "$Revision$");
 vtkStandardNewMacro(vtkDataSetAttributes);
 
+// The number of operations recorded between BeginBatch() and EndBatch()
+// before they are performed.
+#define VTK_DATA_SET_ATTRIBUTES_BATCH_SIZE 4096
+
+//--------------------------------------------------------------------------
+// The CopyData() and InterpolateEdge() calls recorded since BeginBatch().
+class vtkDataSetAttributes::vtkBatch
+{
+public:
+  vtkDataSetAttributes* Source;
+  vtkstd::vector<vtkIdType> CopyFromIds;
+  vtkstd::vector<vtkIdType> CopyToIds;
+  vtkstd::vector<vtkIdType> EdgeToIds;
+  vtkstd::vector<vtkIdType> EdgeP1;
+  vtkstd::vector<vtkIdType> EdgeP2;
+  vtkstd::vector<double> EdgeT;
+};
+
+//--------------------------------------------------------------------------
+// Returns 1 when the batched operations from one array to the other can be
+// done by the typed kernels below, that is when both arrays store their
+// values contiguously with the same type and number of components. Other
+// arrays are handled one tuple at a time.
+static int vtkDataSetAttributesUseKernel(vtkAbstractArray* fromArray,
+                                         vtkAbstractArray* toArray)
+{
+  vtkDataArray* fromData = vtkDataArray::SafeDownCast(fromArray);
+  vtkDataArray* toData = vtkDataArray::SafeDownCast(toArray);
+  return fromData && toData &&
+    fromData->GetDataType() == toData->GetDataType() &&
+    toData->GetDataType() != VTK_BIT &&
+    fromData->GetNumberOfComponents() == toData->GetNumberOfComponents();
+}
+
+//--------------------------------------------------------------------------
+// Makes room for the tuples up to maxId in the array and returns a pointer
+// to its first value.
+static void* vtkDataSetAttributesWritePointer(vtkAbstractArray* toArray,
+                                              vtkIdType maxId)
+{
+  int numComp = toArray->GetNumberOfComponents();
+  if (!static_cast<vtkDataArray*>(toArray)->WriteVoidPointer(maxId*numComp,
+                                                             numComp))
+    {
+    return 0;
+    }
+  return toArray->GetVoidPointer(0);
+}
+
+//--------------------------------------------------------------------------
+template <class T>
+void vtkDataSetAttributesCopyTuples(const T* from, T* to, int numComp,
+                                    vtkIdType numIds,
+                                    const vtkIdType* fromIds,
+                                    const vtkIdType* toIds)
+{
+  if (numComp == 1)
+    {
+    for (vtkIdType i = 0; i < numIds; i++)
+      {
+      to[toIds[i]] = from[fromIds[i]];
+      }
+    return;
+    }
+  for (vtkIdType i = 0; i < numIds; i++)
+    {
+    const T* f = from + fromIds[i]*numComp;
+    T* t = to + toIds[i]*numComp;
+    for (int j = 0; j < numComp; j++)
+      {
+      t[j] = f[j];
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+// Same computation as vtkDataArray::InterpolateTuple() for an edge.
+template <class T>
+void vtkDataSetAttributesInterpolateEdges(const T* from, T* to, int numComp,
+                                          vtkIdType numEdges,
+                                          const vtkIdType* toIds,
+                                          const vtkIdType* p1,
+                                          const vtkIdType* p2,
+                                          const double* t, int nearest)
+{
+  for (vtkIdType i = 0; i < numEdges; i++)
+    {
+    double w = t[i];
+    if (nearest)
+      {
+      w = (w < 0.5) ? 0.0 : 1.0;
+      }
+    const T* f1 = from + p1[i]*numComp;
+    const T* f2 = from + p2[i]*numComp;
+    T* o = to + toIds[i]*numComp;
+    for (int j = 0; j < numComp; j++)
+      {
+      double c = (1.0 - w) * static_cast<double>(f1[j])
+        + w * static_cast<double>(f2[j]);
+      o[j] = static_cast<T>(c);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+// Round integer types. Don't round floating point types.
+template <class T>
+inline void vtkDataSetAttributesRoundIfNecessary(double val, T* retVal)
+{
+  *retVal = static_cast<T>((val>=0.0)?(val + 0.5):(val - 0.5));
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRoundIfNecessary(double val, double* retVal)
+{
+  *retVal = val;
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRoundIfNecessary(double val, float* retVal)
+{
+  *retVal = static_cast<float>(val);
+}
+
+//--------------------------------------------------------------------------
+// Same computation as vtkDataArray::InterpolateTuple() for a stencil.
+template <class T>
+void vtkDataSetAttributesInterpolatePoints(const T* from, T* to, int numComp,
+                                           vtkIdType numPoints,
+                                           const vtkIdType* toIds,
+                                           const vtkIdType* offsets,
+                                           const vtkIdType* ids,
+                                           const double* weights)
+{
+  for (vtkIdType i = 0; i < numPoints; i++)
+    {
+    T* o = to + toIds[i]*numComp;
+    for (int j = 0; j < numComp; j++)
+      {
+      double c = 0;
+      for (vtkIdType k = offsets[i]; k < offsets[i+1]; k++)
+        {
+        c += weights[k]*static_cast<double>(from[ids[k]*numComp+j]);
+        }
+      vtkDataSetAttributesRoundIfNecessary(c, o + j);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+static vtkIdType vtkDataSetAttributesMaxId(vtkIdType numIds,
+                                           const vtkIdType* ids)
+{
+  vtkIdType maxId = -1;
+  for (vtkIdType i = 0; i < numIds; i++)
+    {
+    if (ids[i] > maxId)
+      {
+      maxId = ids[i];
+      }
+    }
+  return maxId;
+}
+
 //--------------------------------------------------------------------------
 const char vtkDataSetAttributes
 ::AttributeNames[vtkDataSetAttributes::NUM_ATTRIBUTES][12] =
@@ -81,7 +246,7 @@ vtkDataSetAttributes::vtkDataSetAttributes()
   this->CopyAttributeFlags[INTERPOLATE][PEDIGREEIDS] = 0;
 
   this->TargetIndices=0;
-
+  this->Batch=0;
 }
 
 //--------------------------------------------------------------------------
@@ -91,6 +256,7 @@ vtkDataSetAttributes::~vtkDataSetAttributes()
   this->Initialize();
   delete[] this->TargetIndices;
   this->TargetIndices = 0;
+  delete this->Batch;
 }
 
 //--------------------------------------------------------------------------
@@ -588,6 +754,9 @@ void vtkDataSetAttributes::InternalCopyAllocate(vtkDataSetAttributes* pd,
     return;
     }
 
+  // The recorded operations use the current required arrays.
+  this->FlushBatch();
+
   this->RequiredArrays = this->ComputeRequiredArrays(pd, ctype);
   if (this->RequiredArrays.GetListSize() == 0)
     {
@@ -694,6 +863,22 @@ void vtkDataSetAttributes::RemoveArray(int index)
 void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
                                     vtkIdType fromId, vtkIdType toId)
 {
+  if (this->Batch && this->Batch->Source == fromPd)
+    {
+    this->Batch->CopyFromIds.push_back(fromId);
+    this->Batch->CopyToIds.push_back(toId);
+    if (this->Batch->CopyToIds.size() >= VTK_DATA_SET_ATTRIBUTES_BATCH_SIZE)
+      {
+      this->FlushBatch();
+      }
+    return;
+    }
+  if (this->Batch && fromPd == this)
+    {
+    // The tuples read may not have been written yet.
+    this->FlushBatch();
+    }
+
   int i;
   for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
       i=this->RequiredArrays.NextIndex())
@@ -726,6 +911,11 @@ void vtkDataSetAttributes::InterpolatePoint(vtkDataSetAttributes *fromPd,
                                             vtkIdType toId, vtkIdList *ptIds, 
                                             double *weights)
 {
+  if (this->Batch && fromPd == this)
+    {
+    this->FlushBatch();
+    }
+
   int i;
   for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
       i=this->RequiredArrays.NextIndex())
@@ -744,6 +934,24 @@ void vtkDataSetAttributes::InterpolateEdge(vtkDataSetAttributes *fromPd,
                                            vtkIdType toId, vtkIdType p1,
                                            vtkIdType p2, double t)
 {
+  if (this->Batch && this->Batch->Source == fromPd)
+    {
+    this->Batch->EdgeToIds.push_back(toId);
+    this->Batch->EdgeP1.push_back(p1);
+    this->Batch->EdgeP2.push_back(p2);
+    this->Batch->EdgeT.push_back(t);
+    if (this->Batch->EdgeToIds.size() >= VTK_DATA_SET_ATTRIBUTES_BATCH_SIZE)
+      {
+      this->FlushBatch();
+      }
+    return;
+    }
+  if (this->Batch && fromPd == this)
+    {
+    // The tuples read may not have been written yet.
+    this->FlushBatch();
+    }
+
   int i;
   for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
       i=this->RequiredArrays.NextIndex())
@@ -815,6 +1023,226 @@ void vtkDataSetAttributes::CopyTuple(vtkAbstractArray *fromData,
   toData->InsertTuple(toId, fromId, fromData);
 }
 
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
+                                    vtkIdList* fromIds, vtkIdList* toIds)
+{
+  vtkIdType numIds = fromIds->GetNumberOfIds();
+  if (toIds->GetNumberOfIds() != numIds)
+    {
+    vtkErrorMacro("The lists of ids to copy from and to have different "
+                  "lengths.");
+    return;
+    }
+  this->CopyData(fromPd, numIds, fromIds->GetPointer(0),
+                 toIds->GetPointer(0));
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
+                                    vtkIdType numIds,
+                                    const vtkIdType* fromIds,
+                                    const vtkIdType* toIds)
+{
+  if (numIds <= 0)
+    {
+    return;
+    }
+  vtkIdType maxId = vtkDataSetAttributesMaxId(numIds, toIds);
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+    void* to;
+    if (!vtkDataSetAttributesUseKernel(fromArray, toArray) ||
+        !(to = vtkDataSetAttributesWritePointer(toArray, maxId)))
+      {
+      for (vtkIdType j = 0; j < numIds; j++)
+        {
+        this->CopyTuple(fromArray, toArray, fromIds[j], toIds[j]);
+        }
+      continue;
+      }
+    void* from = fromArray->GetVoidPointer(0);
+    switch (toArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkDataSetAttributesCopyTuples(static_cast<VTK_TT*>(from),
+                                       static_cast<VTK_TT*>(to),
+                                       toArray->GetNumberOfComponents(),
+                                       numIds, fromIds, toIds));
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolatePoints(vtkDataSetAttributes* fromPd,
+                                             vtkIdType numPoints,
+                                             const vtkIdType* toIds,
+                                             const vtkIdType* offsets,
+                                             const vtkIdType* ids,
+                                             const double* weights)
+{
+  if (numPoints <= 0)
+    {
+    return;
+    }
+  vtkIdType maxId = vtkDataSetAttributesMaxId(numPoints, toIds);
+  vtkIdList* stencil = 0;
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+    void* to;
+    if (!vtkDataSetAttributesUseKernel(fromArray, toArray) ||
+        !(to = vtkDataSetAttributesWritePointer(toArray, maxId)))
+      {
+      if (!stencil)
+        {
+        stencil = vtkIdList::New();
+        }
+      for (vtkIdType j = 0; j < numPoints; j++)
+        {
+        vtkIdType numIds = offsets[j+1] - offsets[j];
+        stencil->SetNumberOfIds(numIds);
+        for (vtkIdType k = 0; k < numIds; k++)
+          {
+          stencil->SetId(k, ids[offsets[j] + k]);
+          }
+        toArray->InterpolateTuple(toIds[j], stencil, fromArray,
+                                  const_cast<double*>(weights + offsets[j]));
+        }
+      continue;
+      }
+    void* from = fromArray->GetVoidPointer(0);
+    switch (toArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkDataSetAttributesInterpolatePoints(static_cast<VTK_TT*>(from),
+                                              static_cast<VTK_TT*>(to),
+                                              toArray->GetNumberOfComponents(),
+                                              numPoints, toIds, offsets,
+                                              ids, weights));
+      }
+    }
+  if (stencil)
+    {
+    stencil->Delete();
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolateEdges(vtkDataSetAttributes* fromPd,
+                                            vtkIdType numEdges,
+                                            const vtkIdType* toIds,
+                                            const vtkIdType* p1,
+                                            const vtkIdType* p2,
+                                            const double* t)
+{
+  if (numEdges <= 0)
+    {
+    return;
+    }
+  vtkIdType maxId = vtkDataSetAttributesMaxId(numEdges, toIds);
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+
+    //check if the destination array needs nearest neighbor interpolation
+    int attributeIndex = this->IsArrayAnAttribute(this->TargetIndices[i]);
+    int nearest = (attributeIndex != -1 &&
+                   this->CopyAttributeFlags[INTERPOLATE][attributeIndex]==2);
+
+    void* to;
+    if (!vtkDataSetAttributesUseKernel(fromArray, toArray) ||
+        !(to = vtkDataSetAttributesWritePointer(toArray, maxId)))
+      {
+      for (vtkIdType j = 0; j < numEdges; j++)
+        {
+        double w = t[j];
+        if (nearest)
+          {
+          w = (w < 0.5) ? 0.0 : 1.0;
+          }
+        toArray->InterpolateTuple(toIds[j], p1[j], fromArray, p2[j],
+                                  fromArray, w);
+        }
+      continue;
+      }
+    void* from = fromArray->GetVoidPointer(0);
+    switch (toArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkDataSetAttributesInterpolateEdges(static_cast<VTK_TT*>(from),
+                                             static_cast<VTK_TT*>(to),
+                                             toArray->GetNumberOfComponents(),
+                                             numEdges, toIds, p1, p2, t,
+                                             nearest));
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::BeginBatch(vtkDataSetAttributes* fromPd)
+{
+  this->FlushBatch();
+  if (!this->Batch)
+    {
+    this->Batch = new vtkBatch;
+    }
+  this->Batch->Source = fromPd;
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::EndBatch()
+{
+  this->FlushBatch();
+  delete this->Batch;
+  this->Batch = 0;
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::FlushBatch()
+{
+  vtkBatch* batch = this->Batch;
+  if (!batch)
+    {
+    return;
+    }
+  // Perform the operations as regular calls while flushing.
+  this->Batch = 0;
+  if (!batch->CopyToIds.empty())
+    {
+    this->CopyData(batch->Source,
+                   static_cast<vtkIdType>(batch->CopyToIds.size()),
+                   &batch->CopyFromIds[0], &batch->CopyToIds[0]);
+    batch->CopyFromIds.clear();
+    batch->CopyToIds.clear();
+    }
+  if (!batch->EdgeToIds.empty())
+    {
+    this->InterpolateEdges(batch->Source,
+                           static_cast<vtkIdType>(batch->EdgeToIds.size()),
+                           &batch->EdgeToIds[0], &batch->EdgeP1[0],
+                           &batch->EdgeP2[0], &batch->EdgeT[0]);
+    batch->EdgeToIds.clear();
+    batch->EdgeP1.clear();
+    batch->EdgeP2.clear();
+    batch->EdgeT.clear();
+    }
+  this->Batch = batch;
+}
+
 //--------------------------------------------------------------------------
 int vtkDataSetAttributes::SetScalars(vtkDataArray* da) 
 { 
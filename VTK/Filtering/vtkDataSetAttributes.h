@@ -508,6 +508,56 @@ public:
                        vtkDataSetAttributes *from2,
                        vtkIdType id, double t);
 
+  // -- batched operations --------------------------------------------------
+
+  // Description:
+  // Copy the attribute data of the tuples fromIds to the tuples toIds (the
+  // ith id of fromIds is copied to the ith id of toIds). This does the same
+  // as calling CopyData() for each pair of ids, but each array is copied by
+  // one typed loop instead of one virtual call per tuple. Make sure
+  // CopyAllocate() has been invoked before using this method.
+  void CopyData(vtkDataSetAttributes *fromPd, vtkIdList *fromIds,
+                vtkIdList *toIds);
+
+//BTX
+  // Description:
+  // Same as above for numIds ids given as arrays.
+  void CopyData(vtkDataSetAttributes *fromPd, vtkIdType numIds,
+                const vtkIdType *fromIds, const vtkIdType *toIds);
+
+  // Description:
+  // Interpolate numPoints tuples from weighted stencils of fromPd tuples.
+  // The tuple toIds[i] is interpolated from the tuples
+  // ids[offsets[i]] ... ids[offsets[i+1]-1] with the weights of the same
+  // indices, as InterpolatePoint() would do. offsets has numPoints+1
+  // values. Make sure that the method InterpolateAllocate() has been
+  // invoked before using this method.
+  void InterpolatePoints(vtkDataSetAttributes *fromPd, vtkIdType numPoints,
+                         const vtkIdType *toIds, const vtkIdType *offsets,
+                         const vtkIdType *ids, const double *weights);
+
+  // Description:
+  // Interpolate numEdges tuples as InterpolateEdge() would do, the ith
+  // tuple toIds[i] between the tuples p1[i] and p2[i] of fromPd.
+  void InterpolateEdges(vtkDataSetAttributes *fromPd, vtkIdType numEdges,
+                        const vtkIdType *toIds, const vtkIdType *p1,
+                        const vtkIdType *p2, const double *t);
+//ETX
+
+  // Description:
+  // Between BeginBatch() and EndBatch(), CopyData() and InterpolateEdge()
+  // calls made with fromPd as source are recorded and performed a few
+  // thousands at a time by the batched methods above. This lets filters
+  // that produce their output through code copying one tuple at a time,
+  // such as vtkCell::Clip() and vtkCell::Contour(), get the speed of the
+  // batched methods. Calls with another source are performed immediately,
+  // after the recorded ones when the source is this object itself (as
+  // vtkCell3D::Clip() does). While batching, each output tuple must be
+  // written once and the arrays must not be read or modified by other means
+  // until EndBatch() is called.
+  void BeginBatch(vtkDataSetAttributes *fromPd);
+  void EndBatch();
+
 //BTX
   class FieldList;
 
@@ -577,6 +627,13 @@ protected:
 
   int* TargetIndices;
 
+  // Description:
+  // Performs the operations recorded since BeginBatch().
+  void FlushBatch();
+
+  class vtkBatch;
+  vtkBatch* Batch;
+
   virtual void RemoveArray(int index);
 
   static const int NumberOfAttributeComponents[NUM_ATTRIBUTES];
@@ -41,6 +41,9 @@
 #include "vtkUniformGrid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCriticalSection.h"
+#include "vtkGenericCell.h"
+#include "vtkMultiThreader.h"
 
 #ifdef _MSC_VER
 #pragma warning ( disable : 4100 )
@@ -50,6 +53,7 @@
 #include <vtkstd/map>
 #include <vtkstd/queue>
 #include <vtkstd/set>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkKdTree, "$Revision$");
 
@@ -192,6 +196,7 @@ vtkKdTree::vtkKdTree()
   (1 << vtkKdTree::XDIM) | (1 << vtkKdTree::YDIM) | (1 << vtkKdTree::ZDIM);
 
   this->MinCells = 100;
+  this->NumberOfThreads = 1;
   this->NumberOfRegions     = 0;
 
   this->DataSets = vtkDataSetCollection::New();
@@ -599,37 +604,80 @@ float *vtkKdTree::ComputeCellCenters(int set)
 }
 
 //----------------------------------------------------------------------------
-float *vtkKdTree::ComputeCellCenters(vtkDataSet *set)
+// Computes the centers of the cells of several data sets on several
+// threads.  Each thread computes the centers of a contiguous range of
+// cells, the first thread reports the progress.
+class vtkKdTreeCellCenters
 {
-  this->UpdateSubOperationProgress(0);
-  int totalCells;
+public:
+  vtkKdTree *Tree;
+  vtkstd::vector<vtkDataSet *> DataSets;
+  vtkstd::vector<int> FirstCell;   // first center of each data set
+  float *Centers;
+  int MaxCellSize;
 
-  if (set)
-    {
-    totalCells = set->GetNumberOfCells();
-    }
-  else
-    {
-    totalCells = this->GetNumberOfCells();   // all data sets
-    }
+  static VTK_THREAD_RETURN_TYPE Compute(void *arg);
+};
 
-  if (totalCells == 0) 
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKdTreeCellCenters::Compute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkKdTreeCellCenters *self =
+    static_cast<vtkKdTreeCellCenters *>(info->UserData);
+
+  int totalCells = self->FirstCell.back();
+  int begin = static_cast<int>(
+    static_cast<double>(totalCells) * info->ThreadID / info->NumberOfThreads);
+  int end = static_cast<int>(
+    static_cast<double>(totalCells) * (info->ThreadID + 1) /
+    info->NumberOfThreads);
+
+  vtkGenericCell *cell = vtkGenericCell::New();
+  double *weights = new double [self->MaxCellSize];
+  double dcenter[3];
+  float *cptr = self->Centers + 3*begin;
+  size_t set = 0;
+
+  for (int i=begin; i<end; i++)
     {
-    return NULL;
+    while (self->FirstCell[set+1] <= i)
+      {
+      set++;
+      }
+    self->DataSets[set]->GetCell(i - self->FirstCell[set], cell);
+    self->Tree->ComputeCellCenter(cell, dcenter, weights);
+    cptr[0] = static_cast<float>(dcenter[0]);
+    cptr[1] = static_cast<float>(dcenter[1]);
+    cptr[2] = static_cast<float>(dcenter[2]);
+    cptr += 3;
+    if ((info->ThreadID == 0) && ((i - begin)%1000 == 0))
+      {
+      self->Tree->UpdateSubOperationProgress(
+        static_cast<double>(i - begin)/(end - begin));
+      }
     }
 
-  float *center = new float [3 * totalCells];
+  delete [] weights;
+  cell->Delete();
 
-  if (!center)
-    {
-    return NULL;
-    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+float *vtkKdTree::ComputeCellCenters(vtkDataSet *set)
+{
+  this->UpdateSubOperationProgress(0);
 
-  int maxCellSize = 0;
+  vtkKdTreeCellCenters centers;
+  centers.Tree = this;
+  centers.MaxCellSize = 0;
+  centers.FirstCell.push_back(0);
 
   if (set)
     {
-    maxCellSize = set->GetMaxCellSize();
+    centers.DataSets.push_back(set);
     }
   else
     {
@@ -638,56 +686,55 @@ float *vtkKdTree::ComputeCellCenters(vtkDataSet *set)
     for (vtkDataSet *iset = this->DataSets->GetNextDataSet(cookie);
          iset != NULL; iset = this->DataSets->GetNextDataSet(cookie))
       {
-      int cellSize = iset->GetMaxCellSize();
-      maxCellSize = (cellSize > maxCellSize) ? cellSize : maxCellSize;
+      centers.DataSets.push_back(iset);
       }
     }
 
-  double *weights = new double [maxCellSize];
-
-  float *cptr = center;
-  double dcenter[3];
-
-  if (set)
+  vtkGenericCell *cell = vtkGenericCell::New();
+  for (size_t i=0; i<centers.DataSets.size(); i++)
     {
-    for (int j=0; j<totalCells; j++)
+    vtkDataSet *iset = centers.DataSets[i];
+    int nCells = iset->GetNumberOfCells();
+    int cellSize = iset->GetMaxCellSize();
+    centers.MaxCellSize =
+      (cellSize > centers.MaxCellSize) ? cellSize : centers.MaxCellSize;
+    centers.FirstCell.push_back(centers.FirstCell.back() + nCells);
+    if (nCells > 0)
       {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j%1000 == 0)
-        {
-        this->UpdateSubOperationProgress(static_cast<double>(j)/totalCells);
-        }
+      // Some data sets build their cell structures the first time a cell
+      // is requested, which must not happen in the threads.
+      iset->GetCell(0, cell);
       }
     }
-  else
+  cell->Delete();
+
+  int totalCells = centers.FirstCell.back();
+
+  if (totalCells == 0) 
     {
-    vtkCollectionSimpleIterator cookie;
-    this->DataSets->InitTraversal(cookie);
-    for (vtkDataSet *iset = this->DataSets->GetNextDataSet(cookie);
-         iset != NULL; iset = this->DataSets->GetNextDataSet(cookie))
-      {
-      int nCells = iset->GetNumberOfCells();
+    return NULL;
+    }
 
-      for (int j=0; j<nCells; j++)
-        {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j%1000 == 0)
-          {
-          this->UpdateSubOperationProgress(static_cast<double>(j)/totalCells);
-          }
-        }
-      }
+  float *center = new float [3 * totalCells];
+
+  if (!center)
+    {
+    return NULL;
     }
 
-  delete [] weights;
+  centers.Centers = center;
+
+  int numThreads = this->NumberOfThreads;
+  if (numThreads > totalCells/1000 + 1)
+    {
+    numThreads = totalCells/1000 + 1;
+    }
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkKdTreeCellCenters::Compute, &centers);
+  threader->SingleMethodExecute();
+  threader->Delete();
 
   this->UpdateSubOperationProgress(1.0);
   return center;
@@ -917,7 +964,7 @@ void vtkKdTree::BuildLocator()
   
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, NULL, 0);
+    this->DivideRegionConcurrently(kd, ptarray, NULL);
   
     TIMERDONE("Build tree");
   
@@ -1245,6 +1292,26 @@ int vtkKdTree::DivideTest(int size, int level)
 }
 //----------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode *kd, float *c1, int *ids, int level)
+{
+  if (!this->DivideNode(kd, c1, ids, level))
+    {
+    return 0;
+    }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int *leftIds  = ids;
+  int *rightIds = ids ? ids + nleft : NULL;
+  
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+  
+  this->DivideRegion(kd->GetRight(), c1 + nleft*3, rightIds, level + 1);
+  
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::DivideNode(vtkKdNode *kd, float *c1, int *ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1304,16 +1371,131 @@ int vtkKdTree::DivideRegion(vtkKdNode *kd, float *c1, int *ids, int level)
     return 0;   // unable to divide region further
     }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
+  return 1;
+}
 
-  int *leftIds  = ids;
-  int *rightIds = ids ? ids + nleft : NULL;
-  
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-  
-  this->DivideRegion(kd->GetRight(), c1 + nleft*3, rightIds, level + 1);
-  
-  return 0;
+//----------------------------------------------------------------------------
+// The regions to divide by the threads of DivideRegionConcurrently().
+// Each thread takes the next region until all are divided.
+class vtkKdTreeDivideTasks
+{
+public:
+  struct Task
+  {
+    vtkKdNode *Node;
+    float *Points;
+    int *Ids;
+    int Level;
+  };
+
+  vtkKdTree *Tree;
+  vtkstd::vector<Task> Tasks;
+  int WholeSubtrees;     // divide the subtrees, or only the nodes
+  size_t NextTask;
+  vtkSimpleCriticalSection Lock;
+
+  void Add(vtkKdNode *kd, float *c1, int *ids, int level)
+    {
+    Task task = { kd, c1, ids, level };
+    this->Tasks.push_back(task);
+    }
+
+  void Run(vtkMultiThreader *threader, int numThreads, int wholeSubtrees)
+    {
+    this->WholeSubtrees = wholeSubtrees;
+    this->NextTask = 0;
+    if (static_cast<size_t>(numThreads) > this->Tasks.size())
+      {
+      numThreads = static_cast<int>(this->Tasks.size());
+      }
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetSingleMethod(vtkKdTreeDivideTasks::Divide, this);
+    threader->SingleMethodExecute();
+    }
+
+  static VTK_THREAD_RETURN_TYPE Divide(void *arg);
+};
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKdTreeDivideTasks::Divide(void *arg)
+{
+  vtkKdTreeDivideTasks *self = static_cast<vtkKdTreeDivideTasks *>(
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  for (;;)
+    {
+    self->Lock.Lock();
+    size_t next = self->NextTask++;
+    self->Lock.Unlock();
+
+    if (next >= self->Tasks.size())
+      {
+      break;
+      }
+
+    Task &task = self->Tasks[next];
+    if (self->WholeSubtrees)
+      {
+      self->Tree->DivideRegion(task.Node, task.Points, task.Ids, task.Level);
+      }
+    else
+      {
+      self->Tree->DivideNode(task.Node, task.Points, task.Ids, task.Level);
+      }
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkKdTree::DivideRegionConcurrently(vtkKdNode *kd, float *c1, int *ids)
+{
+  int numThreads = this->NumberOfThreads;
+
+  if ((numThreads < 2) || (kd->GetNumberOfPoints() < 10000))
+    {
+    this->DivideRegion(kd, c1, ids, 0);
+    return;
+    }
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  vtkKdTreeDivideTasks tasks;
+  tasks.Tree = this;
+  tasks.Add(kd, c1, ids, 0);
+
+  // The regions are disjoint ranges of the point array, so they can be
+  // divided in any order.  Divide the nodes one level at a time until
+  // there are enough subtrees to keep the threads busy.
+
+  while (!tasks.Tasks.empty() && 
+         (tasks.Tasks.size() < static_cast<size_t>(4 * numThreads)))
+    {
+    tasks.Run(threader, numThreads, 0);
+
+    vtkstd::vector<vtkKdTreeDivideTasks::Task> divided;
+    divided.swap(tasks.Tasks);
+    for (size_t i=0; i<divided.size(); i++)
+      {
+      vtkKdNode *node = divided[i].Node;
+      if (node->GetLeft() == NULL)
+        {
+        continue;
+        }
+      int nleft = node->GetLeft()->GetNumberOfPoints();
+      int *ids1 = divided[i].Ids;
+      tasks.Add(node->GetLeft(), divided[i].Points, ids1, 
+                divided[i].Level + 1);
+      tasks.Add(node->GetRight(), divided[i].Points + nleft*3,
+                ids1 ? ids1 + nleft : NULL, divided[i].Level + 1);
+      }
+    }
+
+  if (!tasks.Tasks.empty())
+    {
+    tasks.Run(threader, numThreads, 1);
+    }
+
+  threader->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -1878,7 +2060,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints **ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionConcurrently(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -4779,6 +4961,7 @@ void vtkKdTree::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "ValidDirections: " << this->ValidDirections << endl;
   os << indent << "MinCells: " << this->MinCells << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
   os << indent << "NumberOfRegionsOrLess: " << this->NumberOfRegionsOrLess << endl;
   os << indent << "NumberOfRegionsOrMore: " << this->NumberOfRegionsOrMore << endl;
 
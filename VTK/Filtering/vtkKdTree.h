@@ -87,6 +87,13 @@ public:
   vtkSetMacro(MinCells, int);
   vtkGetMacro(MinCells, int);
 
+  // Description:
+  //  Number of threads used to compute the cell centers and to divide
+  //  the regions when the tree is built.  The tree is the same for any
+  //  number of threads.  Default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:
   //   Set/Get the number of spatial regions you want to get close
   //   to without going over.  (The number of spatial regions is normally
@@ -692,6 +699,20 @@ protected:
 
   int DivideRegion(vtkKdNode *kd, float *c1, int *ids, int nlevels);
 
+  // Description:
+  //    Divide the region kd once, without dividing its children.
+  //    Returns 1 if kd was divided.
+  int DivideNode(vtkKdNode *kd, float *c1, int *ids, int level);
+
+  // Description:
+  //    Same as DivideRegion(kd, c1, ids, 0), using NumberOfThreads
+  //    threads.  The nodes of the first levels are divided concurrently
+  //    one level at a time, then the subtrees below them.
+  void DivideRegionConcurrently(vtkKdNode *kd, float *c1, int *ids);
+
+  friend class vtkKdTreeCellCenters;
+  friend class vtkKdTreeDivideTasks;
+
   void DoMedianFind(vtkKdNode *kd, float *c1, int *ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode *kd);
@@ -805,6 +826,7 @@ protected:
   int *CellRegionList;
 
   int MinCells;
+  int NumberOfThreads;
   int NumberOfRegions;              // number of leaf nodes
 
   int Timing;
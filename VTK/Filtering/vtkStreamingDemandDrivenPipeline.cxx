@@ -19,6 +19,7 @@
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkExtentTranslator.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -38,6 +39,7 @@ vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
 
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, CONTINUE_EXECUTING, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, EXACT_EXTENT, Integer);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_REGION_OF_INTEREST, DoubleVector);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_EXTENT, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_EXTENT_INFORMATION, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_RESOLUTION_PROPAGATE, Request);
@@ -64,12 +66,15 @@ vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_RESOLUTION, Doub
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REMOVE_ATTRIBUTE_INFORMATION, Integer);
 
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FAST_PATH_FOR_TEMPORAL_DATA, Integer);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, INDEPENDENT_PIECES, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FAST_PATH_OBJECT_TYPE, String);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FAST_PATH_ID_TYPE, String);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FAST_PATH_OBJECT_ID, IdType);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FAST_PATH_OBJECT_IDS, ObjectBase);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_FAST_PATH_OBJECT_ID, IdType);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_FAST_PATH_OBJECT_TYPE, String);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_FAST_PATH_ID_TYPE, String);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_FAST_PATH_OBJECT_IDS, ObjectBase);
 
 //----------------------------------------------------------------------------
 class vtkStreamingDemandDrivenPipelineToDataObjectFriendship
@@ -461,6 +466,11 @@ vtkStreamingDemandDrivenPipeline
             inInfo->CopyEntry(outInfo, FAST_PATH_OBJECT_ID());
             }
 
+          if ( outInfo->Has(FAST_PATH_OBJECT_IDS()) )
+            {
+            inInfo->CopyEntry(outInfo, FAST_PATH_OBJECT_IDS());
+            }
+
           if ( outInfo->Has(FAST_PATH_OBJECT_TYPE()) )
             {
             inInfo->CopyEntry(outInfo, FAST_PATH_OBJECT_TYPE());
@@ -473,8 +483,10 @@ vtkStreamingDemandDrivenPipeline
 
           // If an algorithm wants an exact extent it must explicitly
           // add it to the request.  We do not want to get the setting
-          // from another consumer of the same input.
+          // from another consumer of the same input.  The same holds
+          // for the region of interest.
           inInfo->Remove(EXACT_EXTENT());
+          inInfo->Remove(UPDATE_REGION_OF_INTEREST());
 
           // Get the input data object for this connection.  It should
           // have already been created by the UpdateDataObject pass.
@@ -712,9 +724,11 @@ vtkStreamingDemandDrivenPipeline
   info->Remove(UPDATE_TIME_STEPS());
   info->Remove(PREVIOUS_UPDATE_TIME_STEPS());
   info->Remove(FAST_PATH_OBJECT_ID());
+  info->Remove(FAST_PATH_OBJECT_IDS());
   info->Remove(FAST_PATH_OBJECT_TYPE());
   info->Remove(FAST_PATH_ID_TYPE());
   info->Remove(PREVIOUS_FAST_PATH_OBJECT_ID());
+  info->Remove(PREVIOUS_FAST_PATH_OBJECT_IDS());
   info->Remove(PREVIOUS_FAST_PATH_OBJECT_TYPE());
   info->Remove(PREVIOUS_FAST_PATH_ID_TYPE());
 }
@@ -1099,6 +1113,15 @@ vtkStreamingDemandDrivenPipeline
         {
         outInfo->Remove(PREVIOUS_FAST_PATH_OBJECT_ID());
         }
+      if (outInfo->Has(FAST_PATH_OBJECT_IDS()))
+        {
+        outInfo->Set(PREVIOUS_FAST_PATH_OBJECT_IDS(),
+                     outInfo->Get(FAST_PATH_OBJECT_IDS()));
+        }
+      else
+        {
+        outInfo->Remove(PREVIOUS_FAST_PATH_OBJECT_IDS());
+        }
       if (outInfo->Has(FAST_PATH_OBJECT_TYPE()))
         {
         outInfo->Set(PREVIOUS_FAST_PATH_OBJECT_TYPE(),
@@ -1212,6 +1235,11 @@ int vtkStreamingDemandDrivenPipeline
       }
     }
 
+  if (this->NeedToExecuteBasedOnRegionOfInterest(outInfo, dataObject))
+    {
+    return 1;
+    }
+
   if (this->NeedToExecuteBasedOnTime(outInfo, dataObject))
     {
     return 1;
@@ -1298,6 +1326,94 @@ int vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnTime(
 }
 
 
+//----------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnRegionOfInterest(
+  vtkInformation* outInfo, vtkDataObject* dataObject)
+{
+  // Data generated for the whole domain satisfies any region.
+  vtkInformation* dataInfo = dataObject->GetInformation();
+  if (!dataInfo->Has(vtkDataObject::DATA_REGION_OF_INTEREST()))
+    {
+    return 0;
+    }
+  if (!outInfo->Has(UPDATE_REGION_OF_INTEREST()))
+    {
+    return 1;
+    }
+
+  // Otherwise the data can be reused if its slab contains the requested
+  // one, which requires parallel normals.
+  if (outInfo->Length(UPDATE_REGION_OF_INTEREST()) != 8 ||
+      dataInfo->Length(vtkDataObject::DATA_REGION_OF_INTEREST()) != 8)
+    {
+    return 1;
+    }
+  double* updateRegion = outInfo->Get(UPDATE_REGION_OF_INTEREST());
+  double* dataRegion = dataInfo->Get(vtkDataObject::DATA_REGION_OF_INTEREST());
+  if (memcmp(updateRegion, dataRegion, 8 * sizeof(double)) == 0)
+    {
+    return 0;
+    }
+  const double* n = dataRegion;
+  const double* un = updateRegion;
+  double cross[3] =
+    {
+    n[1] * un[2] - n[2] * un[1],
+    n[2] * un[0] - n[0] * un[2],
+    n[0] * un[1] - n[1] * un[0]
+    };
+  double nn = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+  double dot = n[0] * un[0] + n[1] * un[1] + n[2] * un[2];
+  double crossSquared =
+    cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+  if (nn == 0.0 || dot == 0.0 || crossSquared > 1e-20 * dot * dot)
+    {
+    return 1;
+    }
+
+  // With un = k * n, un.(x - uo) = k * n.(x - o) - un.(uo - o), so the
+  // requested range maps to (range + un.(uo - o)) / k along n.
+  double k = dot / nn;
+  double shift = un[0] * (updateRegion[3] - dataRegion[3]) +
+                 un[1] * (updateRegion[4] - dataRegion[4]) +
+                 un[2] * (updateRegion[5] - dataRegion[5]);
+  double low = (updateRegion[6] + shift) / k;
+  double high = (updateRegion[7] + shift) / k;
+  if (k < 0.0)
+    {
+    double tmp = low;
+    low = high;
+    high = tmp;
+    }
+  return (low < dataRegion[6] || high > dataRegion[7]) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+// Returns true when both FAST_PATH_OBJECT_IDS() values hold the same ids.
+static bool vtkStreamingDemandDrivenPipelineSameIds(vtkObjectBase* first,
+                                                    vtkObjectBase* second)
+{
+  if (first == second)
+    {
+    return true;
+    }
+  vtkIdTypeArray* firstIds = vtkIdTypeArray::SafeDownCast(first);
+  vtkIdTypeArray* secondIds = vtkIdTypeArray::SafeDownCast(second);
+  if (!firstIds || !secondIds ||
+      firstIds->GetNumberOfTuples() != secondIds->GetNumberOfTuples())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < firstIds->GetNumberOfTuples(); ++i)
+    {
+    if (firstIds->GetValue(i) != secondIds->GetValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnFastPathData(
   vtkInformation* outInfo)
@@ -1323,6 +1439,9 @@ int vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnFastPathData(
     {
     if( (outInfo->Get(FAST_PATH_OBJECT_ID()) == 
             outInfo->Get(PREVIOUS_FAST_PATH_OBJECT_ID())) &&
+        vtkStreamingDemandDrivenPipelineSameIds(
+          outInfo->Get(FAST_PATH_OBJECT_IDS()),
+          outInfo->Get(PREVIOUS_FAST_PATH_OBJECT_IDS())) &&
         (strcmp(outInfo->Get(FAST_PATH_OBJECT_TYPE()),
                 outInfo->Get(PREVIOUS_FAST_PATH_OBJECT_TYPE())) == 0) &&
         (strcmp(outInfo->Get(FAST_PATH_ID_TYPE()),
@@ -2081,6 +2200,7 @@ void vtkStreamingDemandDrivenPipeline::ResetUpdateInformation(
       if (inInfo)
         {
         inInfo->Remove(FAST_PATH_OBJECT_ID());
+        inInfo->Remove(FAST_PATH_OBJECT_IDS());
         inInfo->Remove(FAST_PATH_OBJECT_TYPE());
         inInfo->Remove(FAST_PATH_ID_TYPE());
         inInfo->Remove(UPDATE_RESOLUTION());
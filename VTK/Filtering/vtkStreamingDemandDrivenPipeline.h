@@ -225,6 +225,19 @@ public:
   // Key to specify the request for exact extent in pipeline information.
   static vtkInformationIntegerKey* EXACT_EXTENT();
 
+  // Description:
+  // Key to tell a source that its consumer only needs the part of the
+  // data inside a slab. The 8 values are a normal (3), an origin (3) and
+  // a range (2); the slab holds the points x for which
+  // range[0] <= normal.(x-origin) <= range[1]. Sources are free to ignore
+  // it. Like EXACT_EXTENT, an algorithm must set it explicitly on its input
+  // information in RequestUpdateExtent; it is not propagated further
+  // upstream because most filters move or resample data. A source that
+  // honors it must record the slab it produced in
+  // vtkDataObject::DATA_REGION_OF_INTEREST. Data produced for the whole
+  // domain, or for a slab that contains the requested one, is reused.
+  static vtkInformationDoubleVectorKey* UPDATE_REGION_OF_INTEREST();
+
   // Description:
   // Key to store available time steps.
   static vtkInformationDoubleVectorKey* TIME_STEPS();
@@ -270,6 +283,20 @@ public:
   static vtkInformationStringKey* FAST_PATH_ID_TYPE();
   // The id (either index or global id) being requested
   static vtkInformationIdTypeKey* FAST_PATH_OBJECT_ID();
+  // The ids (a vtkIdTypeArray) being requested at once. Readers that
+  // handle this key produce the "XXXOverTime" field arrays for all the ids
+  // they find, one block of time steps per id, along with a vtkIdTypeArray
+  // named "vtkFastPathObjectIds" listing these ids in order. Readers that
+  // do not only answer FAST_PATH_OBJECT_ID(), which is set to the first id.
+  // The array must not be modified once it has been set.
+  static vtkInformationObjectBaseKey* FAST_PATH_OBJECT_IDS();
+
+  // Description:
+  // Key that a source sets on its output information when it produces
+  // any piece of any time step without communicating with other processes.
+  // Processes may then update such a source for different time steps at
+  // the same time (see vtkPExtractArraysOverTime).
+  static vtkInformationIntegerKey* INDEPENDENT_PIECES();
 
   // Description:
   // Issues pipeline request to determine and return the priority of the 
@@ -309,6 +336,7 @@ protected:
   static vtkInformationIdTypeKey* PREVIOUS_FAST_PATH_OBJECT_ID();
   static vtkInformationStringKey* PREVIOUS_FAST_PATH_OBJECT_TYPE();
   static vtkInformationStringKey* PREVIOUS_FAST_PATH_ID_TYPE();
+  static vtkInformationObjectBaseKey* PREVIOUS_FAST_PATH_OBJECT_IDS();
 
   // Does the time request correspond to what is in the data?
   // Returns 0 if yes, 1 otherwise.
@@ -318,6 +346,11 @@ protected:
   // If the request contains a fast path key for temporal data, always execute
   virtual int NeedToExecuteBasedOnFastPathData(vtkInformation* outInfo);
 
+  // Was the data generated for a region of interest that does not contain
+  // the one requested? Returns 0 if the data can be reused, 1 otherwise.
+  virtual int NeedToExecuteBasedOnRegionOfInterest(vtkInformation* outInfo,
+                                                   vtkDataObject* dataObject);
+
   // Setup default information on the output after the algorithm
   // executes information.
   virtual int ExecuteInformation(vtkInformation* request,
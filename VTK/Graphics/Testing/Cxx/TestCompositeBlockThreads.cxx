@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test executes vtkThreshold on the blocks of multiblock datasets with
+// vtkCompositeDataPipeline, one block at a time and on several threads. It
+// checks that both produce the same blocks in the same order and prints the
+// time taken for each number of blocks and threads. It also checks that the
+// errors raised by the blocks are reported on the calling thread.
+// Usage: TestCompositeBlockThreads [block dimension] [max number of threads]
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <stdlib.h>
+
+// Builds numBlocks image blocks of dim^3 points with a scalar field varying
+// among the blocks, so that the blocks produce different outputs.
+static vtkMultiBlockDataSet* NewBlocks(int numBlocks, int dim)
+{
+  vtkMultiBlockDataSet* blocks = vtkMultiBlockDataSet::New();
+  blocks->SetNumberOfBlocks(numBlocks);
+  for (int b = 0; b < numBlocks; b++)
+    {
+    vtkImageData* image = vtkImageData::New();
+    image->SetDimensions(dim, dim, dim);
+    image->SetOrigin(b * (dim - 1), 0, 0);
+    vtkFloatArray* scalars = vtkFloatArray::New();
+    scalars->SetName("Scalars");
+    scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+    double pt[3];
+    for (vtkIdType i = 0; i < image->GetNumberOfPoints(); i++)
+      {
+      image->GetPoint(i, pt);
+      scalars->SetValue(i, static_cast<float>(
+          (pt[0] * pt[0] + pt[1] * pt[2]) / (dim * dim * (b + 1))));
+      }
+    image->GetPointData()->SetScalars(scalars);
+    scalars->Delete();
+    blocks->SetBlock(b, image);
+    image->Delete();
+    }
+  return blocks;
+}
+
+// Executes the threshold and returns its output.
+static vtkMultiBlockDataSet* Execute(vtkThreshold* threshold, int numThreads,
+                                     double& time)
+{
+  vtkCompositeDataPipeline::SetNumberOfBlockThreads(numThreads);
+  vtkTimerLog* timer = vtkTimerLog::New();
+  threshold->Modified();
+  timer->StartTimer();
+  threshold->Update();
+  timer->StopTimer();
+  time = timer->GetElapsedTime();
+  timer->Delete();
+
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::New();
+  output->ShallowCopy(threshold->GetOutputDataObject(0));
+  return output;
+}
+
+// Returns 1 when both outputs have the same blocks in the same order.
+static int CompareOutputs(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  vtkCompositeDataIterator* ia = a->NewIterator();
+  vtkCompositeDataIterator* ib = b->NewIterator();
+  int same = 1;
+  for (ia->InitTraversal(), ib->InitTraversal();
+       same && !ia->IsDoneWithTraversal() && !ib->IsDoneWithTraversal();
+       ia->GoToNextItem(), ib->GoToNextItem())
+    {
+    vtkUnstructuredGrid* ga =
+      vtkUnstructuredGrid::SafeDownCast(ia->GetCurrentDataObject());
+    vtkUnstructuredGrid* gb =
+      vtkUnstructuredGrid::SafeDownCast(ib->GetCurrentDataObject());
+    if (!ga || !gb ||
+        ia->GetCurrentFlatIndex() != ib->GetCurrentFlatIndex() ||
+        ga->GetNumberOfCells() != gb->GetNumberOfCells() ||
+        ga->GetNumberOfPoints() != gb->GetNumberOfPoints())
+      {
+      same = 0;
+      break;
+      }
+    for (vtkIdType i = 0; i < ga->GetNumberOfPoints(); i++)
+      {
+      double pa[3], pb[3];
+      ga->GetPoint(i, pa);
+      gb->GetPoint(i, pb);
+      if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+        {
+        same = 0;
+        break;
+        }
+      }
+    }
+  if (!ia->IsDoneWithTraversal() || !ib->IsDoneWithTraversal())
+    {
+    same = 0;
+    }
+  ia->Delete();
+  ib->Delete();
+  return same;
+}
+
+// Counts the errors and those reported on another thread than the caller.
+struct ErrorCounts
+{
+  vtkMultiThreaderIDType Caller;
+  int Errors;
+  int OtherThreadErrors;
+};
+
+static void CountError(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ErrorCounts* counts = static_cast<ErrorCounts*>(clientData);
+  counts->Errors++;
+  if (!vtkMultiThreader::ThreadsEqual(counts->Caller,
+                                      vtkMultiThreader::GetCurrentThreadID()))
+    {
+    counts->OtherThreadErrors++;
+    }
+}
+
+// Returns 1 when the error raised by each block reaches the observers of
+// the threshold on the calling thread.
+static int CheckErrors(int numThreads)
+{
+  const int numBlocks = 16;
+  vtkSmartPointer<vtkMultiBlockDataSet> input;
+  input.TakeReference(NewBlocks(numBlocks, 4));
+  vtkSmartPointer<vtkCompositeDataPipeline> executive =
+    vtkSmartPointer<vtkCompositeDataPipeline>::New();
+  vtkSmartPointer<vtkThreshold> threshold =
+    vtkSmartPointer<vtkThreshold>::New();
+  threshold->SetExecutive(executive);
+  threshold->SetInput(input);
+  // The deprecated attribute mode makes each block raise an error.
+  threshold->SetAttributeModeToUsePointData();
+
+  ErrorCounts counts;
+  counts.Caller = vtkMultiThreader::GetCurrentThreadID();
+  counts.Errors = 0;
+  counts.OtherThreadErrors = 0;
+  vtkSmartPointer<vtkCallbackCommand> observer =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  observer->SetCallback(CountError);
+  observer->SetClientData(&counts);
+  threshold->AddObserver(vtkCommand::ErrorEvent, observer);
+
+  vtkCompositeDataPipeline::SetNumberOfBlockThreads(numThreads);
+  threshold->Update();
+  if (counts.Errors != numBlocks || counts.OtherThreadErrors != 0)
+    {
+    cerr << "With " << numThreads << " threads, " << counts.Errors
+         << " errors were reported instead of " << numBlocks << ", "
+         << counts.OtherThreadErrors << " of them on other threads." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestCompositeBlockThreads(int argc, char* argv[])
+{
+  int dim = 24;
+  int maxThreads = 8;
+  // The test driver passes the test name and its options first.
+  for (int i = 1; i + 1 < argc; i++)
+    {
+    if (atoi(argv[i]) > 0 && atoi(argv[i + 1]) > 0)
+      {
+      dim = atoi(argv[i]);
+      maxThreads = atoi(argv[i + 1]);
+      break;
+      }
+    }
+
+  int blockCounts[] = { 8, 64, 256 };
+  int retVal = EXIT_SUCCESS;
+  for (int c = 0; c < 3; c++)
+    {
+    vtkSmartPointer<vtkMultiBlockDataSet> input;
+    input.TakeReference(NewBlocks(blockCounts[c], dim));
+
+    vtkSmartPointer<vtkCompositeDataPipeline> executive =
+      vtkSmartPointer<vtkCompositeDataPipeline>::New();
+    vtkSmartPointer<vtkThreshold> threshold =
+      vtkSmartPointer<vtkThreshold>::New();
+    threshold->SetExecutive(executive);
+    threshold->SetInput(input);
+    threshold->ThresholdBetween(0.25, 0.75);
+
+    double serialTime;
+    vtkSmartPointer<vtkMultiBlockDataSet> serial;
+    serial.TakeReference(Execute(threshold, 1, serialTime));
+    cout << "Blocks: " << blockCounts[c] << ", threads: 1, time: "
+         << serialTime << " s" << endl;
+
+    for (int numThreads = 2; numThreads <= maxThreads; numThreads *= 2)
+      {
+      double time;
+      vtkSmartPointer<vtkMultiBlockDataSet> threaded;
+      threaded.TakeReference(Execute(threshold, numThreads, time));
+      cout << "Blocks: " << blockCounts[c] << ", threads: " << numThreads
+           << ", time: " << time << " s, speedup: "
+           << (time > 0.0? serialTime / time : 0.0) << endl;
+      if (!CompareOutputs(serial, threaded))
+        {
+        cerr << "The output of " << numThreads << " threads differs from "
+             << "the output of one thread for " << blockCounts[c]
+             << " blocks." << endl;
+        retVal = EXIT_FAILURE;
+        }
+      }
+    }
+  if (!CheckErrors(1) || !CheckErrors(4))
+    {
+    retVal = EXIT_FAILURE;
+    }
+  vtkCompositeDataPipeline::SetNumberOfBlockThreads(1);
+  return retVal;
+}
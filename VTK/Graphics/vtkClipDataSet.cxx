@@ -361,6 +361,14 @@ int vtkClipDataSet::RequestData(
     outCD[1]->CopyAllocate(inCD,estimatedSize,estimatedSize/2);
     }
 
+  // The attributes of the new points and cells are copied a few thousands
+  // at a time.
+  outPD->BeginBatch(inPD);
+  for (i=0; i<numOutputs; i++)
+    {
+    outCD[i]->BeginBatch(inCD);
+    }
+
   //Process all cells and clip each in turn
   //
   int abort=0;
@@ -441,6 +449,12 @@ int vtkClipDataSet::RequestData(
       } //for both outputs
     } //for each cell
 
+  outPD->EndBatch();
+  for (i=0; i<numOutputs; i++)
+    {
+    outCD[i]->EndBatch();
+    }
+
   cell->Delete();
   cellScalars->Delete();
 
@@ -487,6 +487,11 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
     cutScalars->SetComponent(i,0,s);
     }
 
+  // The attributes of the new points and cells are interpolated and copied
+  // a few thousands at a time.
+  outPD->BeginBatch(inPD);
+  outCD->BeginBatch(inCD);
+
   // Compute some information for progress methods
   //
   cell = vtkGenericCell::New();
@@ -606,6 +611,9 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
       } // for all dimensions.
     } // sort by value
 
+  outPD->EndBatch();
+  outCD->EndBatch();
+
   // Update ourselves.  Because we don't know upfront how many verts, lines,
   // polys we've created, take care to reclaim memory. 
   //
@@ -716,6 +724,11 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
     cutScalars->SetComponent(i,0,s);
     }
 
+  // The attributes of the new points and cells are interpolated and copied
+  // a few thousands at a time.
+  outPD->BeginBatch(inPD);
+  outCD->BeginBatch(inCD);
+
   // Compute some information for progress methods
   //
   vtkIdType numCuts = numContours*numCells;
@@ -904,6 +917,9 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
       } // for all dimensions (1,2,3).
     } // sort by value
 
+  outPD->EndBatch();
+  outCD->EndBatch();
+
   // Update ourselves.  Because we don't know upfront how many verts, lines,
   // polys we've created, take care to reclaim memory.
   //
@@ -961,6 +977,26 @@ int vtkCutter::RequestUpdateExtent(
 {
   vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
   inInfo->Set(vtkStreamingDemandDrivenPipeline::EXACT_EXTENT(), 1);
+
+  // A planar cut only touches the slab between the extreme contour
+  // values. Let the source know so that it can skip the rest.
+  vtkPlane *plane = vtkPlane::SafeDownCast(this->CutFunction);
+  int numContours = this->ContourValues->GetNumberOfContours();
+  if (plane && !plane->GetTransform() && numContours > 0)
+    {
+    double roi[8];
+    plane->GetNormal(roi);
+    plane->GetOrigin(roi+3);
+    roi[6] = roi[7] = this->ContourValues->GetValue(0);
+    for (int i = 1; i < numContours; i++)
+      {
+      double value = this->ContourValues->GetValue(i);
+      roi[6] = (value < roi[6]) ? value : roi[6];
+      roi[7] = (value > roi[7]) ? value : roi[7];
+      }
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_REGION_OF_INTEREST(),
+                roi, 8);
+    }
   return 1;
 }
 
@@ -154,8 +154,9 @@ public:
     }
 
   // Description:
-  // Add the output of the extract selection filter. 
-  void AddTimeStep(double time, vtkDataObject* data);
+  // Add the output of the extract selection filter for the time step at
+  // index timeIndex.
+  void AddTimeStep(int timeIndex, double time, vtkDataObject* data);
 
   // Description:
   // Add fast path timeline.
@@ -172,6 +173,11 @@ public:
 
   void AddFastPathTimeline(vtkDataObject* data);
 
+  // Description:
+  // Add the timelines of all the remaining fast-path ids, read at once by a
+  // reader that handles FAST_PATH_OBJECT_IDS().
+  void AddFastPathTimelines(vtkDataObject* data, vtkIdTypeArray* foundIds);
+
   // Description:
   // Collect the gathered timesteps into the output.
   void CollectTimesteps(vtkMultiBlockDataSet* output)
@@ -272,10 +278,79 @@ void vtkExtractArraysOverTime::vtkInternal::AddFastPathTimeline(
   value->PointCoordinatesArray = 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkExtractArraysOverTime::vtkInternal::AddFastPathTimelines(
+  vtkDataObject* input, vtkIdTypeArray* foundIds)
+{
+  vtkFieldData* ifd = input->GetFieldData();
+  int numFieldArrays = ifd->GetNumberOfArrays();
+  vtkIdType numFound = foundIds->GetNumberOfTuples();
+
+  // Index of each id in the blocks of time steps of the over-time arrays.
+  vtkstd::map<vtkIdType, vtkIdType> foundIndex;
+  for (vtkIdType cc=0; cc < numFound; cc++)
+    {
+    foundIndex[foundIds->GetValue(cc)] = cc;
+    }
+
+  for (; this->FastPathIDIndex < this->FastPathIDs.size();
+    this->FastPathIDIndex++)
+    {
+    vtkIdType gid = this->FastPathIDs[this->FastPathIDIndex];
+    vtkValue* value = this->GetOutput(vtkKey(0, gid), NULL);
+
+    vtksys_ios::ostringstream stream;
+    stream << "GlobalID: " << gid;
+    value->Label = stream.str();
+    value->PointCoordinatesArray = 0;
+
+    vtkstd::map<vtkIdType, vtkIdType>::iterator iter = foundIndex.find(gid);
+    if (iter == foundIndex.end())
+      {
+      // Not found by the reader; all samples stay invalid.
+      continue;
+      }
+
+    vtkDataSetAttributes* outputAttributes = value->Output->GetRowData();
+    for (int j=0; j<numFieldArrays; j++)
+      {
+      vtkAbstractArray* inFieldArray = ifd->GetAbstractArray(j);
+      if (!inFieldArray || !inFieldArray->GetName())
+        {
+        continue;
+        }
+      vtkStdString fieldName = inFieldArray->GetName();
+      vtkStdString::size_type idx = fieldName.find("OverTime",0);
+      if (idx == vtkStdString::npos)
+        {
+        continue;
+        }
+      vtkIdType numTimes = inFieldArray->GetNumberOfTuples() / numFound;
+      vtkAbstractArray *outArray = inFieldArray->NewInstance();
+      outArray->SetName(fieldName.substr(0, idx).c_str());
+      outArray->SetNumberOfComponents(inFieldArray->GetNumberOfComponents());
+      outArray->SetNumberOfTuples(numTimes);
+      for (vtkIdType t=0; t < numTimes; t++)
+        {
+        outArray->SetTuple(t, iter->second * numTimes + t, inFieldArray);
+        }
+      outputAttributes->AddArray(outArray);
+      outArray->Delete();
+      }
+
+    if (outputAttributes->GetNumberOfArrays() > 0)
+      {
+      // Mark all pts as valid.
+      value->ValidMaskArray->FillComponent(0, 1);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkExtractArraysOverTime::vtkInternal::AddTimeStep(
-  double time, vtkDataObject* data)
+  int timeIndex, double time, vtkDataObject* data)
 {
+  this->CurrentTimeIndex = timeIndex;
   this->TimeArray->SetTuple1(this->CurrentTimeIndex, time);
 
   if (data && data->IsA("vtkDataSet"))
@@ -296,8 +371,6 @@ void vtkExtractArraysOverTime::vtkInternal::AddTimeStep(
       }
     iter->Delete();
     }
-
-  this->CurrentTimeIndex++;
 }
 
 //----------------------------------------------------------------------------
@@ -535,6 +608,8 @@ vtkExtractArraysOverTime::vtkExtractArraysOverTime()
 {
   this->NumberOfTimeSteps = 0;
   this->CurrentTimeIndex = 0;
+  this->TimeStepBegin = 0;
+  this->TimeStepEnd = 0;
 
   this->SetNumberOfInputPorts(2);
 
@@ -639,9 +714,15 @@ int vtkExtractArraysOverTime::RequestUpdateExtent(
   // vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkInformation* inInfo1 = inputVector[0]->GetInformationObject(0);
 
+  if (!this->IsExecuting)
+    {
+    this->DetermineTimeStepRange();
+    this->CurrentTimeIndex = this->TimeStepBegin;
+    }
+
   // get the requested update extent
   double *inTimes = inInfo1->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
-  if (inTimes)
+  if (inTimes && this->CurrentTimeIndex < this->NumberOfTimeSteps)
     {
     double timeReq[1];
     timeReq[0] = inTimes[this->CurrentTimeIndex];
@@ -657,6 +738,17 @@ int vtkExtractArraysOverTime::RequestUpdateExtent(
     inInfo1->Set(vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_ID(),
                   this->Internal->FastPathIDs[this->Internal->FastPathIDIndex]);
 
+    // Readers that can read several ids at once get all the remaining ones.
+    vtkIdTypeArray* ids = vtkIdTypeArray::New();
+    for (size_t cc = this->Internal->FastPathIDIndex;
+      cc < this->Internal->FastPathIDs.size(); cc++)
+      {
+      ids->InsertNextValue(this->Internal->FastPathIDs[cc]);
+      }
+    inInfo1->Set(vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_IDS(),
+                 ids);
+    ids->Delete();
+
     // Create a key for the data type
     if (this->FieldType == vtkSelectionNode::CELL)
       {
@@ -725,6 +817,16 @@ int vtkExtractArraysOverTime::RequestData(
 
     this->Internal->Initialize(this->NumberOfTimeSteps, this->ContentType, this->FieldType);
 
+    // Start with the requested time values. The time of the data replaces
+    // them as the time steps are extracted; the others are kept for the
+    // fast path and for time steps extracted by other processes.
+    double *inTimes = inputVector[0]->GetInformationObject(0)->Get(
+      vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    if (inTimes)
+      {
+      this->Internal->AddFastPathTimevalues(inTimes, this->NumberOfTimeSteps);
+      }
+
     this->Error = vtkExtractArraysOverTime::NoError;
 
     this->IsExecuting = true;
@@ -737,8 +839,18 @@ int vtkExtractArraysOverTime::RequestData(
     // for the actual data?
     if (this->WaitingForFastPathData)
       {
-      this->Internal->AddFastPathTimeline(vtkDataObject::GetData(inputVector[0], 0));
-      this->Internal->FastPathIDIndex++;
+      vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+      vtkIdTypeArray* foundIds = vtkIdTypeArray::SafeDownCast(
+        input->GetFieldData()->GetAbstractArray("vtkFastPathObjectIds"));
+      if (foundIds)
+        {
+        this->Internal->AddFastPathTimelines(input, foundIds);
+        }
+      else
+        {
+        this->Internal->AddFastPathTimeline(input);
+        this->Internal->FastPathIDIndex++;
+        }
       if (this->Internal->FastPathIDIndex >= this->Internal->FastPathIDs.size())
         {
         // Done with fast path.
@@ -749,18 +861,6 @@ int vtkExtractArraysOverTime::RequestData(
       }
     else
       {
-      // For fast path, we need to explicitly tell initialize the timestep
-      // values. In the regular case, the time value for each step is gotten
-      // from the data.
-      double *inTimes = inputVector[0]->GetInformationObject(0)->Get(
-        vtkStreamingDemandDrivenPipeline::TIME_STEPS());
-      int size = inputVector[0]->GetInformationObject(0)->Length(
-        vtkStreamingDemandDrivenPipeline::TIME_STEPS());
-      if (inTimes)
-        {
-        this->Internal->AddFastPathTimevalues(inTimes, size);
-        }
-
       // Grab the selected id (either an index, or global id)
       // from the input selection. 
       if (!this->UpdateFastPathIDs(inputVector, outInfo))
@@ -778,11 +878,14 @@ int vtkExtractArraysOverTime::RequestData(
     } 
 
   // If we get here, there is no fast-path option available.
-  this->ExecuteAtTimeStep(inputVector, outInfo);
+  if (this->CurrentTimeIndex < this->TimeStepEnd)
+    {
+    this->ExecuteAtTimeStep(inputVector, outInfo);
+    }
 
   // increment the time index
   this->CurrentTimeIndex++;
-  if (this->CurrentTimeIndex == this->NumberOfTimeSteps)
+  if (this->CurrentTimeIndex >= this->TimeStepEnd)
     {
     this->PostExecute(request, inputVector, outputVector);
     }
@@ -847,15 +950,23 @@ void vtkExtractArraysOverTime::ExecuteAtTimeStep(
 
   vtkDebugMacro(<< "Preparing subfilter to extract from dataset");
   //pass all required information to the helper filter
+  // Extract from the piece that was requested from the input, which a
+  // subclass may have changed from the one requested downstream.
+  vtkInformation* pieceInfo = outInfo;
+  if (inInfo->Has(
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
+    {
+    pieceInfo = inInfo;
+    }
   int piece = -1;
   int npieces = -1;
   int *uExtent;
-  if (outInfo->Has(
+  if (pieceInfo->Has(
         vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
     {
-    piece = outInfo->Get(
+    piece = pieceInfo->Get(
       vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
-    npieces = outInfo->Get(
+    npieces = pieceInfo->Get(
       vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
     if (sddp)
       {
@@ -881,7 +992,7 @@ void vtkExtractArraysOverTime::ExecuteAtTimeStep(
 
   double time_step = input->GetInformation()->Get(
     vtkDataObject::DATA_TIME_STEPS())[0];
-  this->Internal->AddTimeStep(time_step, output);
+  this->Internal->AddTimeStep(this->CurrentTimeIndex, time_step, output);
 
   output->Delete();
   filter->Delete();
@@ -889,7 +1000,15 @@ void vtkExtractArraysOverTime::ExecuteAtTimeStep(
   selInputClone->Delete();
 
   this->UpdateProgress(
-    static_cast<double>(this->CurrentTimeIndex)/this->NumberOfTimeSteps);
+    static_cast<double>(this->CurrentTimeIndex - this->TimeStepBegin)/
+    (this->TimeStepEnd - this->TimeStepBegin));
+}
+
+//----------------------------------------------------------------------------
+void vtkExtractArraysOverTime::DetermineTimeStepRange()
+{
+  this->TimeStepBegin = 0;
+  this->TimeStepEnd = this->NumberOfTimeSteps;
 }
 
 /*
@@ -103,8 +103,17 @@ protected:
   void ExecuteAtTimeStep(vtkInformationVector** inputV, 
     vtkInformation* outInfo);
 
+  // Description:
+  // Called before the first time step is requested to choose the range
+  // [TimeStepBegin, TimeStepEnd) of time step indices extracted by this
+  // filter. The default extracts all of them; subclasses may narrow it to
+  // share the time steps among processes.
+  virtual void DetermineTimeStepRange();
+
   int CurrentTimeIndex;
   int NumberOfTimeSteps;
+  int TimeStepBegin;
+  int TimeStepEnd;
 
   int FieldType;
   int ContentType;
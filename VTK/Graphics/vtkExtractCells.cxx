@@ -200,15 +200,21 @@ int vtkExtractCells::RequestData(
   vtkPoints *pts = vtkPoints::New();
   pts->SetNumberOfPoints(numPoints);
 
+  vtkIdList *newPtIds = vtkIdList::New();
+  newPtIds->SetNumberOfIds(numPoints);
+
   for (vtkIdType newId =0; newId<numPoints; newId++)  
     {
     vtkIdType oldId = ptIdMap->GetId(newId);
 
     pts->SetPoint(newId, input->GetPoint(oldId));
 
-    newPD->CopyData(PD, oldId, newId);
+    newPtIds->SetId(newId, newId);
     }
 
+  newPD->CopyData(PD, ptIdMap, newPtIds);
+  newPtIds->Delete();
+
   output->SetPoints(pts);
   pts->Delete();
 
@@ -515,6 +521,10 @@ void vtkExtractCells::CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
   origMap->SetName("vtkOriginalCellIds");
   newCD->AddArray(origMap);
 
+  // The cell attributes are copied once all cells are known.
+  vtkIdList *cellIds = vtkIdList::New();
+  vtkIdList *newCellIds = vtkIdList::New();
+
   vtkIdList *cellPoints = vtkIdList::New();
 
   vtkstd::set<vtkIdType>::iterator cellPtr;
@@ -537,11 +547,16 @@ void vtkExtractCells::CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
       }
     int newId = output->InsertNextCell(input->GetCellType(cellId), cellPoints);
 
-    newCD->CopyData(oldCD, cellId, newId);
+    cellIds->InsertNextId(cellId);
+    newCellIds->InsertNextId(newId);
     origMap->InsertNextValue(cellId);
 
     }
 
+  newCD->CopyData(oldCD, cellIds, newCellIds);
+  cellIds->Delete();
+  newCellIds->Delete();
+
   cellPoints->Delete();
   origMap->Delete();
 
@@ -568,6 +583,10 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
   origMap->SetName("vtkOriginalCellIds");
   newCD->AddArray(origMap);
 
+  // The cell attributes are copied once all cells are known.
+  vtkIdList *cellIds = vtkIdList::New();
+  vtkIdList *newCellIds = vtkIdList::New();
+
   int numCells = static_cast<int>(this->CellList->IdTypeSet.size());
 
   vtkCellArray *cellArray = vtkCellArray::New();                 // output
@@ -616,12 +635,17 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
       newcells->SetValue(cellArrayIdx++, newId);
       }
 
-    newCD->CopyData(oldCD, oldCellId, nextCellId);
+    cellIds->InsertNextId(oldCellId);
+    newCellIds->InsertNextId(nextCellId);
     origMap->InsertNextValue(oldCellId);
 
     nextCellId++;
     }
 
+  newCD->CopyData(oldCD, cellIds, newCellIds);
+  cellIds->Delete();
+  newCellIds->Delete();
+
   output->SetCells(typeArray, locationArray, cellArray);
 
   typeArray->Delete();
@@ -20,6 +20,7 @@
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -30,6 +31,47 @@
 vtkCxxRevisionMacro(vtkPolyDataNormals, "$Revision$");
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+//----------------------------------------------------------------------------
+// Computes the polygon normals of a range of polygons on each thread, using
+// the random access layout of the cell array.
+class vtkPolyDataNormalsPolygons
+{
+public:
+  vtkPoints *Points;
+  vtkCellArray *Polys;
+  float *Normals;
+
+  void Compute(vtkIdType beginCell, vtkIdType endCell)
+    {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId=beginCell; cellId < endCell; cellId++)
+      {
+      this->Polys->GetCellAtId(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float *normal = this->Normals + 3*cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+      }
+    }
+
+  static VTK_THREAD_RETURN_TYPE Execute(void *arg)
+    {
+    vtkMultiThreader::ThreadInfo *info =
+      static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+    vtkPolyDataNormalsPolygons *self =
+      static_cast<vtkPolyDataNormalsPolygons *>(info->UserData);
+    vtkIdType numCells = self->Polys->GetNumberOfCells();
+    self->Compute(
+      static_cast<vtkIdType>(static_cast<double>(numCells) *
+                             info->ThreadID / info->NumberOfThreads),
+      static_cast<vtkIdType>(static_cast<double>(numCells) *
+                             (info->ThreadID + 1) / info->NumberOfThreads));
+    return VTK_THREAD_RETURN_VALUE;
+    }
+};
+
 // Construct with feature angle=30, splitting and consistency turned on, 
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -317,19 +359,40 @@ int vtkPolyDataNormals::RequestData(
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
 
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); 
-       cellId++ )
+  // Large meshes are split among threads, each computing the normals of a
+  // range of polygons.
+  int numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  if ( numThreads > 1 && numPolys >= 10000 )
+    {
+    newPolys->BuildRandomAccess();
+    vtkPolyDataNormalsPolygons polygons;
+    polygons.Points = inPts;
+    polygons.Polys = newPolys;
+    polygons.Normals = this->PolyNormals->GetPointer(0);
+    vtkMultiThreader *threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetSingleMethod(vtkPolyDataNormalsPolygons::Execute, &polygons);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    // Splitting modifies the polygons, so the layout is not kept.
+    newPolys->ReleaseRandomAccess();
+    }
+  else
     {
-    if ((cellId % 1000) == 0)
+    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); 
+         cellId++ )
       {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
+      if ((cellId % 1000) == 0)
         {
-        break; 
+        this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
+        if (this->GetAbortExecute())
+          {
+          break; 
+          }
         }
+      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+      this->PolyNormals->SetTuple(cellId,n);
       }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
     }
 
   // Split mesh if sharp features
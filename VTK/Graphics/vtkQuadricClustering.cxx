@@ -21,12 +21,14 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 #include <vtksys/hash_set.hxx> // keep track of inserted triangles
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkQuadricClustering, "$Revision$");
 vtkStandardNewMacro(vtkQuadricClustering);
@@ -39,6 +41,71 @@ struct vtkQuadricClusteringIdTypeHash {
 class vtkQuadricClusteringCellSet : public vtksys::hash_set<vtkIdType, vtkQuadricClusteringIdTypeHash> {};
 typedef vtkQuadricClusteringCellSet::iterator vtkQuadricClusteringCellSetIterator;
 
+//----------------------------------------------------------------------------
+// Inputs with fewer polygons (or bins used) than this are processed on one
+// thread: starting the threads would cost more than it saves.
+#define VTK_QUADRIC_CLUSTERING_MIN_THREADED_CELLS 20000
+#define VTK_QUADRIC_CLUSTERING_MIN_THREADED_BINS 1000
+
+// State shared by the threads of one threaded pass.
+class vtkQuadricClusteringThreadData
+{
+public:
+  enum
+  {
+    HASH_POINTS,
+    ACCUMULATE_QUADRICS,
+    REPRESENTATIVE_POINTS
+  };
+
+  vtkQuadricClustering *Filter;
+  int Phase;
+  int NumberOfThreads;
+  vtkCellArray *Polys;
+  vtkPoints *Points;
+  vtkIdType *PointBins;
+  // Thread t owns the bins [BinRanges[t], BinRanges[t+1]).
+  vtkstd::vector<vtkIdType> BinRanges;
+  float *OutputPoints;
+};
+
+//----------------------------------------------------------------------------
+// Start of piece "piece" when n items are split into numPieces pieces.
+static vtkIdType vtkQuadricClusteringSplit(vtkIdType n, int piece,
+                                           int numPieces)
+{
+  return (n / numPieces) * piece + ((n % numPieces) * piece) / numPieces;
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkQuadricClusteringThreadedExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkQuadricClusteringThreadData *data =
+    static_cast<vtkQuadricClusteringThreadData*>(info->UserData);
+  data->Filter->ThreadedExecute(data, info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Compute the upper half of the quadric of a triangle.
+static void vtkQuadricClusteringComputeQuadric(double *pt0, double *pt1,
+                                               double *pt2, double quadric[9])
+{
+  double quadric4x4[4][4];
+  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
+  quadric[0] = quadric4x4[0][0];
+  quadric[1] = quadric4x4[0][1];
+  quadric[2] = quadric4x4[0][2];
+  quadric[3] = quadric4x4[0][3];
+  quadric[4] = quadric4x4[1][1];
+  quadric[5] = quadric4x4[1][2];
+  quadric[6] = quadric4x4[1][3];
+  quadric[7] = quadric4x4[2][2];
+  quadric[8] = quadric4x4[2][3];
+}
+
 
 //----------------------------------------------------------------------------
 // Construct with default NumberOfDivisions to 50, DivisionSpacing to 1
@@ -90,6 +157,8 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->InCellCount = this->OutCellCount = 0;
   this->CopyCellData = 0;
 
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_RANGES(), 1);
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_BOUNDS(), 1);
 }
@@ -394,6 +463,13 @@ void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
   double pts0[3], pts1[3], pts2[3];
   vtkIdType binIds[3];
 
+  if (this->NumberOfThreads > 1 &&
+      polys->GetNumberOfCells() >= VTK_QUADRIC_CLUSTERING_MIN_THREADED_CELLS)
+    {
+    this->AddPolygonsThreaded(polys, points, geometryFlag, input, output);
+    return;
+    }
+
   double total = polys->GetNumberOfCells();
   double curr = 0;
   double step = total / 10;
@@ -425,6 +501,218 @@ void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
     }//for all polygons
 }
 
+//----------------------------------------------------------------------------
+// The points are binned and the quadrics of the triangles accumulated on
+// several threads.  Each thread owns a contiguous range of bins, chosen so
+// that the threads get about the same number of points, and visits the
+// triangles in input order, so every bin sums the same quadrics in the same
+// order as AddPolygons does.  The output triangles are then added in input
+// order on this thread, which keeps the point and cell ids unchanged.
+void vtkQuadricClustering::AddPolygonsThreaded(vtkCellArray *polys,
+                                               vtkPoints *points,
+                                               int geometryFlag,
+                                               vtkPolyData *input,
+                                               vtkPolyData *output)
+{
+  int j, t;
+  vtkIdType i;
+  vtkIdType binIds[3];
+  vtkIdType numPts = points->GetNumberOfPoints();
+  vtkIdType numBins = this->NumberOfDivisions[0] * this->NumberOfDivisions[1] *
+    this->NumberOfDivisions[2];
+
+  vtkQuadricClusteringThreadData data;
+  data.Filter = this;
+  data.NumberOfThreads = this->NumberOfThreads;
+  data.Polys = polys;
+  data.Points = points;
+  data.PointBins = new vtkIdType[numPts > 0 ? numPts : 1];
+  data.OutputPoints = 0;
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(data.NumberOfThreads);
+  threader->SetSingleMethod(vtkQuadricClusteringThreadedExecute, &data);
+
+  data.Phase = vtkQuadricClusteringThreadData::HASH_POINTS;
+  threader->SingleMethodExecute();
+  this->UpdateProgress(.65);
+
+  // Split the bins so that each thread owns about the same number of points.
+  vtkstd::vector<vtkIdType> binCounts(numBins, 0);
+  for (i = 0; i < numPts; ++i)
+    {
+    ++binCounts[data.PointBins[i]];
+    }
+  data.BinRanges.resize(data.NumberOfThreads + 1);
+  data.BinRanges[0] = 0;
+  vtkIdType count = 0;
+  t = 1;
+  for (i = 0; i < numBins && t < data.NumberOfThreads; ++i)
+    {
+    count += binCounts[i];
+    while (t < data.NumberOfThreads &&
+           count >= vtkQuadricClusteringSplit(numPts, t, data.NumberOfThreads))
+      {
+      data.BinRanges[t++] = i + 1;
+      }
+    }
+  while (t <= data.NumberOfThreads)
+    {
+    data.BinRanges[t++] = numBins;
+    }
+
+  data.Phase = vtkQuadricClusteringThreadData::ACCUMULATE_QUADRICS;
+  threader->SingleMethodExecute();
+  threader->Delete();
+  this->UpdateProgress(.7);
+
+  vtkIdType *ptr = polys->GetPointer();
+  vtkIdType *end = ptr + polys->GetNumberOfConnectivityEntries();
+  vtkIdType numCellPts;
+  vtkIdType *ptIds;
+
+  double total = polys->GetNumberOfCells();
+  double curr = 0;
+  double step = total / 10;
+  if (step < 1000.0)
+    {
+    step = 1000.0;
+    }
+  double cstep = step;
+
+  while (ptr < end)
+    {
+    numCellPts = *ptr;
+    ptIds = ptr + 1;
+    ptr += numCellPts + 1;
+    if (geometryFlag)
+      {
+      binIds[0] = data.PointBins[ptIds[0]];
+      for (j = 0; j < numCellPts-2; j++)
+        {
+        binIds[1] = data.PointBins[ptIds[j+1]];
+        binIds[2] = data.PointBins[ptIds[j+2]];
+        // Same condition as in AddTriangle.
+        if (this->UseInternalTriangles ||
+            (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
+             binIds[1] != binIds[2]))
+          {
+          this->AddTriangleGeometry(binIds, input, output);
+          }
+        }
+      }
+    ++this->InCellCount;
+    if ( curr > cstep )
+      {
+      this->UpdateProgress(.7 + .1 * curr / total);
+      cstep += step;
+      }
+    curr += 1;
+    }
+
+  delete [] data.PointBins;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::ThreadedExecute(
+  vtkQuadricClusteringThreadData *data, int threadId)
+{
+  vtkIdType i, begin, end;
+  double pt[3];
+
+  if (data->Phase == vtkQuadricClusteringThreadData::HASH_POINTS)
+    {
+    vtkIdType numPts = data->Points->GetNumberOfPoints();
+    begin = vtkQuadricClusteringSplit(numPts, threadId, data->NumberOfThreads);
+    end = vtkQuadricClusteringSplit(numPts, threadId+1, data->NumberOfThreads);
+    for (i = begin; i < end; ++i)
+      {
+      data->Points->GetPoint(i, pt);
+      data->PointBins[i] = this->HashPoint(pt);
+      }
+    }
+  else if (data->Phase == vtkQuadricClusteringThreadData::ACCUMULATE_QUADRICS)
+    {
+    int j, k;
+    double pts0[3], pts1[3], pts2[3];
+    double quadric[9];
+    vtkIdType binIds[3];
+    vtkIdType numCellPts;
+    vtkIdType *ptIds;
+    vtkIdType *ptr = data->Polys->GetPointer();
+    vtkIdType *last = ptr + data->Polys->GetNumberOfConnectivityEntries();
+    begin = data->BinRanges[threadId];
+    end = data->BinRanges[threadId+1];
+    if (begin == end)
+      {
+      return;
+      }
+
+    while (ptr < last)
+      {
+      numCellPts = *ptr;
+      ptIds = ptr + 1;
+      ptr += numCellPts + 1;
+      binIds[0] = data->PointBins[ptIds[0]];
+      for (j = 0; j < numCellPts-2; j++)
+        {
+        binIds[1] = data->PointBins[ptIds[j+1]];
+        binIds[2] = data->PointBins[ptIds[j+2]];
+        if ((binIds[0] < begin || binIds[0] >= end) &&
+            (binIds[1] < begin || binIds[1] >= end) &&
+            (binIds[2] < begin || binIds[2] >= end))
+          {
+          continue;
+          }
+        if (this->UseInternalTriangles == 0 &&
+            (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+             binIds[1] == binIds[2]))
+          {
+          continue;
+          }
+        data->Points->GetPoint(ptIds[0], pts0);
+        data->Points->GetPoint(ptIds[j+1], pts1);
+        data->Points->GetPoint(ptIds[j+2], pts2);
+        vtkQuadricClusteringComputeQuadric(pts0, pts1, pts2, quadric);
+        for (k = 0; k < 3; ++k)
+          {
+          if (binIds[k] < begin || binIds[k] >= end)
+            {
+            continue;
+            }
+          PointQuadric &bin = this->QuadricArray[binIds[k]];
+          if (bin.Dimension > 2)
+            {
+            bin.Dimension = 2;
+            this->InitializeQuadric(bin.Quadric);
+            }
+          if (bin.Dimension == 2)
+            {
+            this->AddQuadric(binIds[k], quadric);
+            }
+          }
+        }
+      }
+    }
+  else if (data->Phase == vtkQuadricClusteringThreadData::REPRESENTATIVE_POINTS)
+    {
+    begin = data->BinRanges[threadId];
+    end = data->BinRanges[threadId+1];
+    for (i = begin; i < end; ++i)
+      {
+      vtkIdType vertexId = this->QuadricArray[i].VertexId;
+      if (vertexId != -1)
+        {
+        this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, pt);
+        float *outPt = data->OutputPoints + 3*vertexId;
+        outPt[0] = static_cast<float>(pt[0]);
+        outPt[1] = static_cast<float>(pt[1]);
+        outPt[2] = static_cast<float>(pt[2]);
+        }
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::AddStrips(vtkCellArray *strips, vtkPoints *points,
                                      int geometryFlag,
@@ -487,9 +775,7 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
                                        vtkPolyData *input, vtkPolyData *output)
 {
   int i;
-  vtkIdType triPtIds[3];
-  double quadric[9], quadric4x4[4][4];
-  vtkIdType minIdx, midIdx, maxIdx, idx;
+  double quadric[9];
 
   // Special condition for fast execution.
   // Only add triangles that traverse three bins to quadrics.
@@ -503,16 +789,7 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
     }
  
   // Compute the quadric.
-  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
-  quadric[0] = quadric4x4[0][0];
-  quadric[1] = quadric4x4[0][1];
-  quadric[2] = quadric4x4[0][2];
-  quadric[3] = quadric4x4[0][3];
-  quadric[4] = quadric4x4[1][1];
-  quadric[5] = quadric4x4[1][2];
-  quadric[6] = quadric4x4[1][3];
-  quadric[7] = quadric4x4[2][2];
-  quadric[8] = quadric4x4[2][3];
+  vtkQuadricClusteringComputeQuadric(pt0, pt1, pt2, quadric);
 
   // Add the quadric to each of the three corner bins.
   for (i = 0; i < 3; ++i)
@@ -532,90 +809,102 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
 
   if (geometryFlag)
     {
-    // Now add the triangle to the geometry.
-    for (i = 0; i < 3; i++)
+    this->AddTriangleGeometry(binIds, input, output);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::AddTriangleGeometry(vtkIdType *binIds,
+                                               vtkPolyData *input,
+                                               vtkPolyData *output)
+{
+  int i;
+  vtkIdType triPtIds[3];
+  vtkIdType minIdx, midIdx, maxIdx, idx;
+
+  // Now add the triangle to the geometry.
+  for (i = 0; i < 3; i++)
+    {
+    // Get the vertex from each bin.
+    if (this->QuadricArray[binIds[i]].VertexId == -1)
       {
-      // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
-        {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
-        this->NumberOfBinsUsed++;
-        }
-      triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+      this->NumberOfBinsUsed++;
       }
-    // This comparison could just as well be on triPtIds.
-    if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
-        binIds[1] != binIds[2])
+    triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+    }
+  // This comparison could just as well be on triPtIds.
+  if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
+      binIds[1] != binIds[2])
+    {
+    if ( this->PreventDuplicateCells )
       {
-      if ( this->PreventDuplicateCells )
+      minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
+                 (binIds[1]<binIds[2] ? 1 : 2) );
+      midIdx = 0;
+      maxIdx = 0;
+      switch ( minIdx )
         {
-        minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
-                   (binIds[1]<binIds[2] ? 1 : 2) );
-        midIdx = 0;
-        maxIdx = 0;
-        switch ( minIdx )
-          {
-          case 0:
-            if ( binIds[1] > binIds[2] )
-              {
-              maxIdx = 1;
-              midIdx = 2;
-              }
-            else
-              {
-              maxIdx = 2;
-              midIdx = 1;
-              }
-            break;
-          case 1:
-            if ( binIds[0] > binIds[2] )
-              {
-              maxIdx = 0;
-              midIdx = 2;
-              }
-            else
-              {
-              maxIdx = 2;
-              midIdx = 0;
-              }
-            break;
-          case 2:
-            if ( binIds[0] > binIds[1] )
-              {
-              maxIdx = 0;
-              midIdx = 1;
-              }
-            else
-              {
-              maxIdx = 1;
-              midIdx = 0;
-              }
-            break;
-          }
-        idx = binIds[minIdx] + this->NumberOfBins*binIds[midIdx] + 
-              this->NumberOfBins*this->NumberOfBins*binIds[maxIdx];
-        if ( this->CellSet->find(idx) == this->CellSet->end() )
-          {
-          this->CellSet->insert(idx);
-          this->OutputTriangleArray->InsertNextCell(3, triPtIds);
-          if (this->CopyCellData && input)
+        case 0:
+          if ( binIds[1] > binIds[2] )
+            {
+            maxIdx = 1;
+            midIdx = 2;
+            }
+          else
+            {
+            maxIdx = 2;
+            midIdx = 1;
+            }
+          break;
+        case 1:
+          if ( binIds[0] > binIds[2] )
+            {
+            maxIdx = 0;
+            midIdx = 2;
+            }
+          else
+            {
+            maxIdx = 2;
+            midIdx = 0;
+            }
+          break;
+        case 2:
+          if ( binIds[0] > binIds[1] )
             {
-            output->GetCellData()->
-              CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
-            }//if cell data
-          }//if not a duplicate
+            maxIdx = 0;
+            midIdx = 1;
+            }
+          else
+            {
+            maxIdx = 1;
+            midIdx = 0;
+            }
+          break;
         }
-      else //don't check for duplicates
+      idx = binIds[minIdx] + this->NumberOfBins*binIds[midIdx] + 
+            this->NumberOfBins*this->NumberOfBins*binIds[maxIdx];
+      if ( this->CellSet->find(idx) == this->CellSet->end() )
         {
+        this->CellSet->insert(idx);
         this->OutputTriangleArray->InsertNextCell(3, triPtIds);
         if (this->CopyCellData && input)
           {
           output->GetCellData()->
             CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
           }//if cell data
-        }//don't check for duplicates
-      }//if not duplicate vertices
-    }//if this should be inserted
+        }//if not a duplicate
+      }
+    else //don't check for duplicates
+      {
+      this->OutputTriangleArray->InsertNextCell(3, triPtIds);
+      if (this->CopyCellData && input)
+        {
+        output->GetCellData()->
+          CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
+        }//if cell data
+      }//don't check for duplicates
+    }//if not duplicate vertices
 }
 
 //----------------------------------------------------------------------------
@@ -969,21 +1258,52 @@ void vtkQuadricClustering::EndAppend()
 
   // Compute the representative points for each bin
   outputPoints = vtkPoints::New();
-  for (i = 0; !abortExecute && i < numBuckets; i++ )
-    {
-    if (cstep > step)
+  if (this->NumberOfThreads > 1 &&
+      this->NumberOfBinsUsed >= VTK_QUADRIC_CLUSTERING_MIN_THREADED_BINS)
+    {
+    // Each thread computes the points of an equal range of bins.
+    outputPoints->SetDataTypeToFloat();
+    outputPoints->SetNumberOfPoints(this->NumberOfBinsUsed);
+    vtkQuadricClusteringThreadData data;
+    data.Filter = this;
+    data.Phase = vtkQuadricClusteringThreadData::REPRESENTATIVE_POINTS;
+    data.NumberOfThreads = this->NumberOfThreads;
+    data.Polys = 0;
+    data.Points = 0;
+    data.PointBins = 0;
+    data.BinRanges.resize(data.NumberOfThreads + 1);
+    for (int t = 0; t <= data.NumberOfThreads; ++t)
       {
-      cstep = 0;
-      vtkDebugMacro(<<"Finding point in bin #" << i);
-      this->UpdateProgress (0.8+0.2*i/numBuckets);
-      abortExecute = this->GetAbortExecute();
+      data.BinRanges[t] =
+        vtkQuadricClusteringSplit(numBuckets, t, data.NumberOfThreads);
       }
-    ++cstep;
+    data.OutputPoints =
+      static_cast<float*>(outputPoints->GetData()->GetVoidPointer(0));
 
-    if (this->QuadricArray[i].VertexId != -1)
+    vtkMultiThreader *threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(data.NumberOfThreads);
+    threader->SetSingleMethod(vtkQuadricClusteringThreadedExecute, &data);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    }
+  else
+    {
+    for (i = 0; !abortExecute && i < numBuckets; i++ )
       {
-      this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
-      outputPoints->InsertPoint(this->QuadricArray[i].VertexId, newPt);
+      if (cstep > step)
+        {
+        cstep = 0;
+        vtkDebugMacro(<<"Finding point in bin #" << i);
+        this->UpdateProgress (0.8+0.2*i/numBuckets);
+        abortExecute = this->GetAbortExecute();
+        }
+      ++cstep;
+
+      if (this->QuadricArray[i].VertexId != -1)
+        {
+        this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
+        outputPoints->InsertPoint(this->QuadricArray[i].VertexId, newPt);
+        }
       }
     }
 
@@ -1619,5 +1939,6 @@ void vtkQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Prevent Duplicate Cells : " 
      << (this->PreventDuplicateCells ? "On\n" : "Off\n");
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << endl;
 }
 
@@ -86,6 +86,7 @@ class vtkCellArray;
 class vtkFeatureEdges;
 class vtkPoints;
 class vtkQuadricClusteringCellSet;
+class vtkQuadricClusteringThreadData;
 
 
 class VTK_GRAPHICS_EXPORT vtkQuadricClustering : public vtkPolyDataAlgorithm
@@ -212,6 +213,22 @@ public:
   vtkGetMacro(PreventDuplicateCells,int);
   vtkBooleanMacro(PreventDuplicateCells,int);
 
+  // Description:
+  // Set/Get the number of threads used to bin the points and accumulate the
+  // quadrics of polygons, and to compute the representative points.  Each
+  // thread owns a contiguous range of bins, so the output does not depend
+  // on the number of threads.  Small inputs are processed on one thread.
+  // The default is the vtkMultiThreader global default.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  //BTX
+  // Description:
+  // For the thread function only.  Runs the current phase of the threaded
+  // execution over the points or bins owned by one thread.
+  void ThreadedExecute(vtkQuadricClusteringThreadData *data, int threadId);
+  //ETX
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering();
@@ -238,6 +255,20 @@ protected:
   void AddTriangle(vtkIdType *binIds, double *pt0, double *pt1, double *pt2,
                    int geometeryFlag, vtkPolyData *input, vtkPolyData *output);
 
+  // Description:
+  // Threaded version of AddPolygons.  The points are binned and the
+  // quadrics accumulated on NumberOfThreads threads, then the triangles are
+  // added to the output in input order by AddTriangleGeometry.
+  void AddPolygonsThreaded(vtkCellArray *polys, vtkPoints *points,
+                           int geometryFlag,
+                           vtkPolyData *input, vtkPolyData *output);
+
+  // Description:
+  // Add the triangle spanning these bins to the output.  This is the
+  // geometry part of AddTriangle.
+  void AddTriangleGeometry(vtkIdType *binIds,
+                           vtkPolyData *input, vtkPolyData *output);
+
   // Description:
   // Add edges to the quadric array.  If geometry flag is on then
   // edges are added to the output.
@@ -348,6 +379,8 @@ protected:
   int InCellCount;
   int OutCellCount;
 
+  int NumberOfThreads;
+
 private:
   vtkQuadricClustering(const vtkQuadricClustering&);  // Not implemented.
   void operator=(const vtkQuadricClustering&);  // Not implemented.
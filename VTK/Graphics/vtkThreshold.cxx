@@ -46,6 +46,7 @@ vtkThreshold::vtkThreshold()
 
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_RANGES(), 1);
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_BOUNDS(), 1);
+  this->GetInformation()->Set(vtkAlgorithm::REENTRANT_REQUEST_DATA(), 1);
 }
 
 vtkThreshold::~vtkThreshold()
@@ -153,6 +154,13 @@ int vtkThreshold::RequestData(
 
   newCellPts = vtkIdList::New();     
 
+  // The attributes of the kept points and cells are copied at the end, one
+  // array at a time.
+  vtkIdList* ptIds = vtkIdList::New();
+  vtkIdList* newPtIds = vtkIdList::New();
+  vtkIdList* cellIds = vtkIdList::New();
+  vtkIdList* newCellIds = vtkIdList::New();
+
   // are we using pointScalars?
   usePointScalars = (inScalars->GetNumberOfTuples() == numPts);
   
@@ -200,16 +208,25 @@ int vtkThreshold::RequestData(
           input->GetPoint(ptId, x);
           newId = newPoints->InsertNextPoint(x);
           pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
+          ptIds->InsertNextId(ptId);
+          newPtIds->InsertNextId(newId);
           }
         newCellPts->InsertId(i,newId);
         }
       newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
+      cellIds->InsertNextId(cellId);
+      newCellIds->InsertNextId(newCellId);
       newCellPts->Reset();
       } // satisfied thresholding
     } // for all cells
 
+  outPD->CopyData(pd,ptIds,newPtIds);
+  outCD->CopyData(cd,cellIds,newCellIds);
+  ptIds->Delete();
+  newPtIds->Delete();
+  cellIds->Delete();
+  newCellIds->Delete();
+
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() 
                 << " number of cells.");
 
@@ -138,57 +138,76 @@ int vtkTriangleFilter::RequestData(
     }
 
   vtkCellArray *newPolys=NULL;
+  vtkCellArray *passPolys=NULL;
   if ( !abort && input->GetPolys()->GetNumberOfCells() > 0 )
     {
     cells = input->GetPolys();
     newId = output->GetNumberOfCells();
-    newPolys = vtkCellArray::New();
-    newPolys->EstimateSize(cells->GetNumberOfCells(),3);
-    output->SetPolys(newPolys);
-    vtkIdList *ptIds = vtkIdList::New();
-    ptIds->Allocate(VTK_CELL_SIZE);
-    int numSimplices;
-    vtkPolygon *poly=vtkPolygon::New();
-    vtkIdType triPts[3];
-    
-    for (cells->InitTraversal(); cells->GetNextCell(npts,pts) && !abort; cellNum++)
+    // Polygons that are all triangles are passed through, unless the
+    // triangles of the strips have to be appended to them. The output gets
+    // its own cell array sharing the connectivity of the input, set once
+    // the output is squeezed so that the input is left untouched.
+    if ( cells->IsHomogeneous() == 3 &&
+         input->GetStrips()->GetNumberOfCells() == 0 )
       {
-      if ( ! (cellNum % updateInterval) ) //manage progress reports / early abort
-        {
-        this->UpdateProgress ((float)cellNum / numCells);
-        abort = this->GetAbortExecute();
-        }
-      if ( npts == 3 )
+      passPolys = vtkCellArray::New();
+      passPolys->SetCells(cells->GetNumberOfCells(), cells->GetData());
+      vtkIdType numPolys = cells->GetNumberOfCells();
+      for (vtkIdType cc=0; cc < numPolys; cc++)
         {
-        newPolys->InsertNextCell(3,pts);
-        outCD->CopyData(inCD, cellNum, newId++);
+        outCD->CopyData(inCD, cellNum++, newId++);
         }
-      else //triangulate polygon
+      }
+    else
+      {
+      newPolys = vtkCellArray::New();
+      newPolys->EstimateSize(cells->GetNumberOfCells(),3);
+      output->SetPolys(newPolys);
+      vtkIdList *ptIds = vtkIdList::New();
+      ptIds->Allocate(VTK_CELL_SIZE);
+      int numSimplices;
+      vtkPolygon *poly=vtkPolygon::New();
+      vtkIdType triPts[3];
+    
+      for (cells->InitTraversal(); cells->GetNextCell(npts,pts) && !abort; cellNum++)
         {
-        //initialize polygon
-        poly->PointIds->SetNumberOfIds(npts);
-        poly->Points->SetNumberOfPoints(npts);
-        for (i=0; i<npts; i++)
+        if ( ! (cellNum % updateInterval) ) //manage progress reports / early abort
           {
-          poly->PointIds->SetId(i,pts[i]);
-          poly->Points->SetPoint(i,inPts->GetPoint(pts[i]));
+          this->UpdateProgress ((float)cellNum / numCells);
+          abort = this->GetAbortExecute();
+          }
+        if ( npts == 3 )
+          {
+          newPolys->InsertNextCell(3,pts);
+          outCD->CopyData(inCD, cellNum, newId++);
           }
-        poly->Triangulate(ptIds);
-        numPts = ptIds->GetNumberOfIds();
-        numSimplices = numPts / 3;
-        for ( i=0; i < numSimplices; i++ )
+        else //triangulate polygon
           {
-          for (j=0; j<3; j++)
+          //initialize polygon
+          poly->PointIds->SetNumberOfIds(npts);
+          poly->Points->SetNumberOfPoints(npts);
+          for (i=0; i<npts; i++)
             {
-            triPts[j] = poly->PointIds->GetId(ptIds->GetId(3*i+j));
+            poly->PointIds->SetId(i,pts[i]);
+            poly->Points->SetPoint(i,inPts->GetPoint(pts[i]));
             }
-          newPolys->InsertNextCell(3, triPts);
-          outCD->CopyData(inCD, cellNum, newId++);
-          }//for each simplex
-        }//triangulate polygon
+          poly->Triangulate(ptIds);
+          numPts = ptIds->GetNumberOfIds();
+          numSimplices = numPts / 3;
+          for ( i=0; i < numSimplices; i++ )
+            {
+            for (j=0; j<3; j++)
+              {
+              triPts[j] = poly->PointIds->GetId(ptIds->GetId(3*i+j));
+              }
+            newPolys->InsertNextCell(3, triPts);
+            outCD->CopyData(inCD, cellNum, newId++);
+            }//for each simplex
+          }//triangulate polygon
+        }
+      ptIds->Delete();
+      poly->Delete();
       }
-    ptIds->Delete();
-    poly->Delete();
     }
   
   //strips
@@ -226,6 +245,11 @@ int vtkTriangleFilter::RequestData(
   output->SetPoints(input->GetPoints());
   output->GetPointData()->PassData(input->GetPointData());
   output->Squeeze();
+  if ( passPolys != NULL )
+    {
+    output->SetPolys(passPolys);
+    passPolys->Delete();
+    }
 
   vtkDebugMacro(<<"Converted " << input->GetNumberOfCells()
                 << "input cells to "
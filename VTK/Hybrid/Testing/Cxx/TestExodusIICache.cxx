@@ -0,0 +1,82 @@
+#include "vtkExodusIICache.h"
+#include "vtkDoubleArray.h"
+#include "vtkSmartPointer.h"
+
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New ();
+
+// Create an array of roughly one MiB.
+static vtkDoubleArray* NewMiBArray()
+{
+  vtkDoubleArray* arr = vtkDoubleArray::New();
+  arr->SetNumberOfTuples( 131072 );
+  return arr;
+}
+
+static int Fail( const char* msg )
+{
+  cerr << "ERROR: " << msg << "\n";
+  return 1;
+}
+
+int TestExodusIICache(int, char *[])
+{
+  VTK_CREATE (vtkExodusIICache, cache);
+  cache->SetCacheCapacity( 2.5 );
+  cache->SetTimeInvariantCacheCapacity( 1.5 );
+
+  // One time-invariant array (e.g. connectivity).
+  vtkExodusIICacheKey conn( -1, 0, 0, 0 );
+  vtkDoubleArray* arr = NewMiBArray();
+  cache->Insert( conn, arr );
+  arr->Delete();
+
+  // Animate through many time steps; the connectivity must survive.
+  for ( int t = 0; t < 10; ++t )
+    {
+    vtkExodusIICacheKey key( t, 1, 0, 0 );
+    arr = NewMiBArray();
+    cache->Insert( key, arr );
+    arr->Delete();
+    if ( ! cache->Find( conn ) )
+      {
+      return Fail( "Time-invariant entry was evicted by per-timestep entries." );
+      }
+    }
+
+  if ( cache->GetNumberOfHits() != 10 || cache->GetNumberOfMisses() != 0 )
+    {
+    return Fail( "Unexpected hit/miss counts." );
+    }
+
+  // Per-timestep entries may borrow the unused half MiB of the
+  // time-invariant budget, but no more.
+  if ( cache->GetTimeVaryingSize() > 3.01 )
+    {
+    return Fail( "Per-timestep entries exceeded their budget." );
+    }
+  if ( ! cache->Find( vtkExodusIICacheKey( 9, 1, 0, 0 ) ) ||
+       cache->Find( vtkExodusIICacheKey( 0, 1, 0, 0 ) ) )
+    {
+    return Fail( "LRU order was not respected." );
+    }
+  if ( cache->GetNumberOfMisses() != 1 || cache->GetBytesEvicted() <= 0. )
+    {
+    return Fail( "Misses or evictions were not counted." );
+    }
+
+  // Invalidating by pattern must keep both partitions consistent.
+  cache->Invalidate( vtkExodusIICacheKey( 0, 1, 0, 0 ), vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+  if ( cache->GetTimeVaryingSize() != 0. || cache->GetTimeInvariantSize() <= 0. )
+    {
+    return Fail( "Invalidate did not update the partition sizes." );
+    }
+
+  cache->Clear();
+  if ( cache->GetSize() != 0. )
+    {
+    return Fail( "Clear did not empty the cache." );
+    }
+
+  return 0;
+}
@@ -9,7 +9,7 @@
 #define VTK_EXO_PRT_KEY( ckey ) \
   "(" << ckey.Time << ", " << ckey.ObjectType << ", " << ckey.ObjectId << ", " << ckey.ArrayId << ")"
 #define VTK_EXO_PRT_ARR( cval ) \
-  " [" << cval << "," <<  (cval ? cval->GetActualMemorySize() / 1024. : 0.) << "/" << this->Size << "/" << this->Capacity << "]"
+  " [" << cval << "," <<  (cval ? cval->GetActualMemorySize() / 1024. : 0.) << "/" << this->GetSize() << "/" << (this->Capacity + this->TimeInvariantCapacity) << "]"
 #define VTK_EXO_PRT_ARR2( cval ) \
   " [" << cval << ", " <<  (cval ? cval->GetActualMemorySize() / 1024. : 0.) << "]"
 
@@ -56,6 +56,11 @@ vtkExodusIICacheEntry::vtkExodusIICacheEntry( const vtkExodusIICacheEntry& other
     this->Value->Register( 0 );
 }
 
+double vtkExodusIICacheEntry::GetSizeInMiB() const
+{
+  return this->Value ? (double) this->Value->GetActualMemorySize() / 1024. : 0.;
+}
+
 #if 0
 void printLRUBack( vtkExodusIICacheRef& cit )
 {
@@ -71,7 +76,13 @@ vtkStandardNewMacro(vtkExodusIICache);
 vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
-  this->Capacity = 2.;
+  this->Capacity = 1.;
+  this->TimeInvariantSize = 0.;
+  this->TimeInvariantCapacity = 1.;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->BytesInserted = 0.;
+  this->BytesEvicted = 0.;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -84,8 +95,15 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   this->Superclass::PrintSelf( os, indent );
   os << indent << "Capacity: " << this->Capacity << " MiB\n";
   os << indent << "Size: " << this->Size << " MiB\n";
+  os << indent << "TimeInvariantCapacity: " << this->TimeInvariantCapacity << " MiB\n";
+  os << indent << "TimeInvariantSize: " << this->TimeInvariantSize << " MiB\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "BytesInserted: " << this->BytesInserted << "\n";
+  os << indent << "BytesEvicted: " << this->BytesEvicted << "\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
-  os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "LRU: " << &this->LRU << " (" << this->LRU.size() << ")\n";
+  os << indent << "TimeInvariantLRU: " << &this->TimeInvariantLRU << " (" << this->TimeInvariantLRU.size() << ")\n";
 }
 
 void vtkExodusIICache::Clear()
@@ -94,65 +112,127 @@ void vtkExodusIICache::Clear()
   this->ReduceToSize( 0. );
 }
 
+void vtkExodusIICache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->BytesInserted = 0.;
+  this->BytesEvicted = 0.;
+}
+
 void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
 {
   if ( sizeInMiB == this->Capacity )
     return;
 
-  if ( this->Size > sizeInMiB )
+  this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
+
+  // Per-timestep entries may still use whatever time-invariant space is free.
+  double borrowable = this->TimeInvariantCapacity - this->TimeInvariantSize;
+  this->ReduceLRUToSize( this->LRU, this->Size, this->Capacity + ( borrowable > 0. ? borrowable : 0. ) );
+}
+
+void vtkExodusIICache::SetTimeInvariantCacheCapacity( double sizeInMiB )
+{
+  if ( sizeInMiB == this->TimeInvariantCapacity )
+    return;
+
+  this->TimeInvariantCapacity = sizeInMiB < 0 ? 0 : sizeInMiB;
+  this->ReduceLRUToSize( this->TimeInvariantLRU, this->TimeInvariantSize, this->TimeInvariantCapacity );
+
+  // Return any space that per-timestep entries borrowed but that no longer exists.
+  double borrowable = this->TimeInvariantCapacity - this->TimeInvariantSize;
+  this->ReduceLRUToSize( this->LRU, this->Size, this->Capacity + ( borrowable > 0. ? borrowable : 0. ) );
+}
+
+int vtkExodusIICache::ReduceToSize( double newSize )
+{
+  int deletedSomething = 0;
+
+  // Drop per-timestep entries first; they are cheap to reload compared to
+  // entries that every timestep needs.
+  double varyingSize = newSize - this->TimeInvariantSize;
+  if ( this->ReduceLRUToSize( this->LRU, this->Size, varyingSize > 0. ? varyingSize : 0. ) )
+    {
+    deletedSomething = 1;
+    }
+  if ( this->ReduceLRUToSize( this->TimeInvariantLRU, this->TimeInvariantSize, newSize - this->Size ) )
     {
-    this->ReduceToSize( sizeInMiB );
+    deletedSomething = 1;
     }
 
-  this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
+  if ( this->Cache.size() == 0 )
+    {
+    this->Size = 0;
+    this->TimeInvariantSize = 0;
+    }
+
+  return deletedSomething;
 }
 
-int vtkExodusIICache::ReduceToSize( double newSize )
+int vtkExodusIICache::ReduceLRUToSize( vtkExodusIICacheLRU& lru, double& size, double newSize )
 {
   int deletedSomething = 0;
-  while ( this->Size > newSize && ! this->LRU.empty() )
+  while ( size > newSize && ! lru.empty() )
     {
-    vtkExodusIICacheRef cit( this->LRU.back() );
+    vtkExodusIICacheRef cit( lru.back() );
     vtkDataArray* arr = cit->second->Value;
     if ( arr )
       {
       deletedSomething = 1;
-      double arrSz = (double) arr->GetActualMemorySize() / 1024.;
-      this->Size -= arrSz;
-#ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
-#endif // VTK_EXO_DBG_CACHE
-      if ( this->Size <= 0 )
-        {
-        if ( this->Cache.size() == 0 )
-          this->Size = 0.;
-        else
-          this->RecomputeSize(); // oops, FP roundoff
-        }
+      this->BytesEvicted += (double) arr->GetActualMemorySize() * 1024.;
       }
-    else
-      {
 #ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
+    cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-      }
-
-    delete cit->second;
-    this->Cache.erase( cit );
-    this->LRU.pop_back();
+    this->Erase( cit );
     }
 
-  if ( this->Cache.size() == 0 )
+  return deletedSomething;
+}
+
+void vtkExodusIICache::Erase( vtkExodusIICacheRef it )
+{
+  bool invariant = vtkExodusIICache::IsTimeInvariant( it->first );
+  double& size = invariant ? this->TimeInvariantSize : this->Size;
+  vtkExodusIICacheLRU& lru = invariant ? this->TimeInvariantLRU : this->LRU;
+
+  size -= it->second->GetSizeInMiB();
+  lru.erase( it->second->LRUEntry );
+  delete it->second;
+  this->Cache.erase( it );
+
+  if ( size <= 0 )
     {
-    this->Size = 0;
+    if ( lru.empty() )
+      size = 0.;
+    else
+      this->RecomputeSize(); // oops, FP roundoff
     }
+}
 
-  return deletedSomething;
+void vtkExodusIICache::MakeRoom( const vtkExodusIICacheKey& key, double vsize )
+{
+  if ( vtkExodusIICache::IsTimeInvariant( key ) )
+    {
+    this->ReduceLRUToSize( this->TimeInvariantLRU, this->TimeInvariantSize, this->TimeInvariantCapacity - vsize );
+    // Reclaim any space per-timestep entries have borrowed from us.
+    double available = this->TimeInvariantCapacity - this->TimeInvariantSize - vsize;
+    this->ReduceLRUToSize( this->LRU, this->Size, this->Capacity + ( available > 0. ? available : 0. ) );
+    }
+  else
+    {
+    double borrowable = this->TimeInvariantCapacity - this->TimeInvariantSize;
+    this->ReduceLRUToSize( this->LRU, this->Size, this->Capacity + ( borrowable > 0. ? borrowable : 0. ) - vsize );
+    }
 }
 
 void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 {
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
+  bool invariant = vtkExodusIICache::IsTimeInvariant( key );
+  double& size = invariant ? this->TimeInvariantSize : this->Size;
+  vtkExodusIICacheLRU& lru = invariant ? this->TimeInvariantLRU : this->LRU;
 
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
@@ -161,33 +241,41 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
       return;
 
     // Remove existing array and put in our new one.
-    this->Size -= vsize;
-    if ( this->Size <= 0 )
+    // Take the entry out of the LRU list while making room so it cannot evict itself.
+    size -= it->second->GetSizeInMiB();
+    lru.erase( it->second->LRUEntry );
+    if ( size < 0 )
       {
-      this->RecomputeSize();
+      size = 0.; // FP roundoff
+      }
+    this->MakeRoom( key, vsize );
+    if ( it->second->Value )
+      {
+      it->second->Value->Delete();
       }
-    this->ReduceToSize( this->Capacity - vsize );
-    it->second->Value->Delete();
     it->second->Value = value;
-    it->second->Value->Register( 0 ); // Since we re-use the cache entry, the constructor's Register won't get called.
-    this->Size += vsize;
+    if ( value )
+      {
+      value->Register( 0 ); // Since we re-use the cache entry, the constructor's Register won't get called.
+      }
+    size += vsize;
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Replacing " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    it->second->LRUEntry = lru.insert( lru.begin(), it );
     }
   else
     {
-    this->ReduceToSize( this->Capacity - vsize );
+    this->MakeRoom( key, vsize );
     vtkstd::pair<const vtkExodusIICacheKey,vtkExodusIICacheEntry*> entry( key, new vtkExodusIICacheEntry(value) );
     vtkstd::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert( entry );
-    this->Size += vsize;
+    size += vsize;
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Adding " << VTK_EXO_PRT_KEY( key ) << VTK_EXO_PRT_ARR( value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    iret.first->second->LRUEntry = this->LRU.insert( this->LRU.begin(), iret.first );
+    iret.first->second->LRUEntry = lru.insert( lru.begin(), iret.first );
     }
+  this->BytesInserted += vsize * 1048576.;
   //printCache( this->Cache, this->LRU );
 }
 
@@ -198,11 +286,15 @@ vtkDataArray*& vtkExodusIICache::Find( vtkExodusIICacheKey key )
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
     {
-    this->LRU.erase( it->second->LRUEntry );
-    it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    vtkExodusIICacheLRU& lru =
+      vtkExodusIICache::IsTimeInvariant( key ) ? this->TimeInvariantLRU : this->LRU;
+    lru.erase( it->second->LRUEntry );
+    it->second->LRUEntry = lru.insert( lru.begin(), it );
+    ++this->NumberOfHits;
     return it->second->Value;
     }
 
+  ++this->NumberOfMisses;
   dummy = 0;
   return dummy;
 }
@@ -215,22 +307,7 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key )
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-      {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-      }
-    delete it->second;
-    this->Cache.erase( it );
-
-    if ( this->Size <= 0 )
-      {
-      if ( this->Cache.size() == 0 )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-      }
-
+    this->Erase( it );
     return 1;
     }
   return 0;
@@ -252,22 +329,8 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key, vtkExodusIICacheKey p
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-      {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-      }
     vtkExodusIICacheRef tmpIt = it++;
-    delete tmpIt->second;
-    this->Cache.erase( tmpIt );
-
-    if ( this->Size <= 0 )
-      {
-      if ( this->Cache.size() == 0 )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-      }
+    this->Erase( tmpIt );
 
     ++nDropped;
     }
@@ -277,12 +340,17 @@ int vtkExodusIICache::Invalidate( vtkExodusIICacheKey key, vtkExodusIICacheKey p
 void vtkExodusIICache::RecomputeSize()
 {
   this->Size = 0.;
+  this->TimeInvariantSize = 0.;
   vtkExodusIICacheRef it;
   for ( it = this->Cache.begin(); it != this->Cache.end(); ++it )
     {
-    if ( it->second->Value )
+    if ( vtkExodusIICache::IsTimeInvariant( it->first ) )
+      {
+      this->TimeInvariantSize += it->second->GetSizeInMiB();
+      }
+    else
       {
-      this->Size += (double)it->second->Value->GetActualMemorySize() / 1024.;
+      this->Size += it->second->GetSizeInMiB();
       }
     }
 }
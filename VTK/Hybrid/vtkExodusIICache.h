@@ -22,6 +22,15 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// Entries whose key has a negative Time (connectivity, id maps,
+// undeflected coordinates, ...) never change from one timestep to
+// the next. They are kept in a separate LRU list with their own
+// budget (the TimeInvariantCapacity) so that animating through a
+// time series cannot push them out of the cache. Any part of the
+// time-invariant budget that is not in use may be borrowed by
+// per-timestep entries; it is reclaimed as soon as a time-invariant
+// array needs the space.
 
 #include "vtkObject.h"
 
@@ -109,6 +118,9 @@ public:
 
   vtkDataArray* GetValue() { return this->Value; }
 
+  /// Return the size of the cached array in MiB (0 if there is no array).
+  double GetSizeInMiB() const;
+
 protected:
   vtkDataArray* Value;
   vtkExodusIICacheLRURef LRUEntry;
@@ -127,21 +139,55 @@ public:
   /// Empty the cache
   void Clear();
 
-  /// Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
+  /** Set the maximum allowable size of the per-timestep entries (in MiB).
+    * This will remove cache entries if the capacity is reduced below the current size.
+    */
   void SetCacheCapacity( double sizeInMiB );
+  double GetCacheCapacity()
+    { return this->Capacity; }
+
+  /** Set the maximum allowable size of the time-invariant entries (in MiB).
+    * Time-invariant entries are those whose key has a negative Time.
+    * This will remove time-invariant entries if the capacity is reduced below their current size.
+    */
+  void SetTimeInvariantCacheCapacity( double sizeInMiB );
+  double GetTimeInvariantCacheCapacity()
+    { return this->TimeInvariantCapacity; }
 
   /** See how much cache space is left.
-    * This is the difference between the capacity and the size of the cache.
+    * This is the difference between the total capacity and the size of the cache.
     * The result is in MiB.
     */
   double GetSpaceLeft()
-    { return this->Capacity - this->Size; }
+    { return this->Capacity + this->TimeInvariantCapacity - this->Size - this->TimeInvariantSize; }
+
+  /// Return the size of all cached arrays (both partitions) in MiB.
+  double GetSize()
+    { return this->Size + this->TimeInvariantSize; }
+
+  /// Return the size of the per-timestep and time-invariant partitions in MiB.
+  double GetTimeVaryingSize()
+    { return this->Size; }
+  double GetTimeInvariantSize()
+    { return this->TimeInvariantSize; }
 
   /** Remove cache entries until the size of the cache is at or below the given size.
+    * Per-timestep entries are dropped before time-invariant ones.
     * Returns a nonzero value if deletions were required.
     */
   int ReduceToSize( double newSize );
 
+  /** Statistics on cache usage since construction or the last call to ResetStatistics().
+    * Hits and misses count calls to Find(); BytesInserted counts the bytes of
+    * every array handed to Insert() (which is what the reader had to load from disk);
+    * BytesEvicted counts the bytes of arrays dropped to make room for others.
+    */
+  vtkGetMacro(NumberOfHits,vtkIdType);
+  vtkGetMacro(NumberOfMisses,vtkIdType);
+  vtkGetMacro(BytesInserted,double);
+  vtkGetMacro(BytesEvicted,double);
+  void ResetStatistics();
+
   //BTX
   /// Insert an entry into the cache (this can remove other cache entries to make space).
   void Insert( vtkExodusIICacheKey& key, vtkDataArray* value );
@@ -180,12 +226,40 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
-  /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
+  //BTX
+  /// Return true when entries with the given key belong to the time-invariant partition.
+  static bool IsTimeInvariant( const vtkExodusIICacheKey& key )
+    { return key.Time < 0; }
+
+  /** Drop least-recently-used entries from \a lru until \a size is at or below \a newSize.
+    * Returns a nonzero value if deletions were required.
+    */
+  int ReduceLRUToSize( vtkExodusIICacheLRU& lru, double& size, double newSize );
+
+  /// Drop the entry referenced by \a it, keeping the partition sizes up to date.
+  void Erase( vtkExodusIICacheRef it );
+
+  /// Make room for an array of \a vsize MiB that will be stored under \a key.
+  void MakeRoom( const vtkExodusIICacheKey& key, double vsize );
+  //ETX
+
+  /// The capacity for per-timestep arrays in MiB.
   double Capacity;
 
-  /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
+  /// The current size of the per-timestep arrays in MiB.
   double Size;
 
+  /// The capacity reserved for time-invariant arrays in MiB.
+  double TimeInvariantCapacity;
+
+  /// The current size of the time-invariant arrays in MiB.
+  double TimeInvariantSize;
+
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  double BytesInserted;
+  double BytesEvicted;
+
   //BTX
   /** A least-recently-used (LRU) cache to hold arrays.
     * During RequestData the cache may contain more than its maximum size since
@@ -195,8 +269,11 @@ protected:
     */
   vtkExodusIICacheSet Cache;
 
-  /// The actual LRU list (indices into the cache ordered least to most recently used).
+  /// The LRU list of per-timestep entries (indices into the cache ordered most to least recently used).
   vtkExodusIICacheLRU LRU;
+
+  /// The LRU list of time-invariant entries.
+  vtkExodusIICacheLRU TimeInvariantLRU;
   //ETX
 
 private:
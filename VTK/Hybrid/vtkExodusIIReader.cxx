@@ -388,6 +388,8 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->DiskWordSize = 8;
 
   this->Cache = vtkExodusIICache::New();
+  this->Cache->SetCacheCapacity( 64. );
+  this->Cache->SetTimeInvariantCacheCapacity( 64. );
 
   this->TimeStep = 0;
   this->HasModeShapes = 0;
@@ -1304,6 +1306,144 @@ int vtkExodusIIReaderPrivate::AssembleOutputCellMaps(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::SetFastPathObjectIds( vtkIdTypeArray* ids )
+{
+  this->FastPathObjectIds.clear();
+  vtkIdType numIds = ids ? ids->GetNumberOfTuples() : 0;
+  for ( vtkIdType i = 0; i < numIds; ++i )
+    {
+    this->FastPathObjectIds.push_back( ids->GetValue( i ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdTypeArray* vtkExodusIIReaderPrivate::GetFastPathGlobalIdMap()
+{
+  vtkExodusIICacheKey globalIdMapKey;
+  switch ( this->FastPathObjectType )
+    {
+    case vtkExodusIIReader::NODAL:
+      globalIdMapKey =
+        vtkExodusIICacheKey( -1, vtkExodusIIReader::NODE_ID, 0, 0 );
+      break;
+    case vtkExodusIIReader::ELEM_BLOCK:
+      globalIdMapKey = 
+        vtkExodusIICacheKey( -1, vtkExodusIIReader::ELEMENT_ID, 0, 0 );
+      break;
+    default:
+      vtkWarningMacro( "Unsupported object type for fast path." );
+      return 0;
+    }
+
+  return vtkIdTypeArray::SafeDownCast( this->GetCacheOrRead( globalIdMapKey ) );
+}
+
+//-----------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::AssembleArraysOverTimeForIds(
+  vtkMultiBlockDataSet* output )
+{
+  vtkIdTypeArray* globalIdMap = this->GetFastPathGlobalIdMap();
+  if ( ! globalIdMap )
+    {
+    return 0;
+    }
+
+  int numArrays = 0;
+  vtkstd::vector<ArrayInfoType>::iterator ai;
+  for ( ai = this->ArrayInfo[this->FastPathObjectType].begin();
+    ai != this->ArrayInfo[this->FastPathObjectType].end(); ++ai )
+    {
+    if ( ai->Status )
+      {
+      ++numArrays;
+      }
+    }
+  if ( numArrays == 0 )
+    {
+    return 0;
+    }
+
+  vtkIdTypeArray* foundIds = vtkIdTypeArray::New();
+  foundIds->SetName( "vtkFastPathObjectIds" );
+  vtkstd::vector<vtkDataArray*> overTime( numArrays, static_cast<vtkDataArray*>( 0 ) );
+  vtkstd::vector<vtkDataArray*> temporalData( numArrays );
+  vtkstd::vector<vtkIdType>::iterator it;
+  for ( it = this->FastPathObjectIds.begin(); it != this->FastPathObjectIds.end(); ++it )
+    {
+    // Ids that do not reside in this file are skipped.
+    vtkIdType index = globalIdMap->LookupValue( *it );
+    if ( index < 0 )
+      {
+      continue;
+      }
+
+    // Only keep ids for which every requested array could be read, so that
+    // all the over-time arrays have the same layout.
+    int aidx = 0;
+    int arr = 0;
+    for ( ai = this->ArrayInfo[this->FastPathObjectType].begin();
+      ai != this->ArrayInfo[this->FastPathObjectType].end() && arr < numArrays; ++ai, ++aidx )
+      {
+      if ( ! ai->Status )
+        {
+        continue;
+        }
+      vtkExodusIICacheKey temporalDataKey(
+        -1, this->GetTemporalTypeFromObjectType( this->FastPathObjectType ),
+        index + 1, aidx );
+      temporalData[arr] = this->GetCacheOrRead( temporalDataKey );
+      if ( ! temporalData[arr] )
+        {
+        vtkWarningMacro( "Unable to read array " << ai->Name.c_str() );
+        break;
+        }
+      ++arr;
+      }
+    if ( arr < numArrays )
+      {
+      continue;
+      }
+
+    for ( arr = 0; arr < numArrays; ++arr )
+      {
+      vtkDataArray* src = temporalData[arr];
+      if ( ! overTime[arr] )
+        {
+        overTime[arr] = src->NewInstance();
+        overTime[arr]->SetName( src->GetName() );
+        overTime[arr]->SetNumberOfComponents( src->GetNumberOfComponents() );
+        overTime[arr]->Allocate(
+          src->GetNumberOfTuples() * src->GetNumberOfComponents() *
+          static_cast<vtkIdType>( this->FastPathObjectIds.size() ) );
+        }
+      vtkIdType numTuples = src->GetNumberOfTuples();
+      for ( vtkIdType t = 0; t < numTuples; ++t )
+        {
+        overTime[arr]->InsertNextTuple( t, src );
+        }
+      }
+    foundIds->InsertNextValue( *it );
+    }
+
+  vtkFieldData* ofd = output->GetFieldData();
+  for ( int arr = 0; arr < numArrays; ++arr )
+    {
+    if ( overTime[arr] )
+      {
+      ofd->AddArray( overTime[arr] );
+      overTime[arr]->Delete();
+      }
+    }
+  int status = foundIds->GetNumberOfTuples() > 0 ? 1 : 0;
+  if ( status )
+    {
+    ofd->AddArray( foundIds );
+    }
+  foundIds->Delete();
+  return status;
+}
+
 //-----------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::AssembleArraysOverTime(vtkMultiBlockDataSet* output )
 {
@@ -1313,6 +1453,12 @@ int vtkExodusIIReaderPrivate::AssembleArraysOverTime(vtkMultiBlockDataSet* outpu
     return 0;
     }
 
+  if ( ! this->FastPathObjectIds.empty() &&
+    strcmp( this->FastPathIdType, "GLOBAL" ) == 0 )
+    {
+    return this->AssembleArraysOverTimeForIds( output );
+    }
+
   vtkstd::vector<ArrayInfoType>::iterator ai;
   vtkFieldData* ofd = output->GetFieldData();
   vtkIdType internalExodusId = -1;
@@ -1324,24 +1470,7 @@ int vtkExodusIIReaderPrivate::AssembleArraysOverTime(vtkMultiBlockDataSet* outpu
   // VTK index, or from the global id
   if (strcmp( this->FastPathIdType, "GLOBAL" )  == 0)
     {
-    vtkExodusIICacheKey globalIdMapKey;
-    switch ( this->FastPathObjectType )
-      {
-      case vtkExodusIIReader::NODAL:
-        globalIdMapKey =
-          vtkExodusIICacheKey( -1, vtkExodusIIReader::NODE_ID, 0, 0 );
-        break;
-      case vtkExodusIIReader::ELEM_BLOCK:
-        globalIdMapKey = 
-          vtkExodusIICacheKey( -1, vtkExodusIIReader::ELEMENT_ID, 0, 0 );
-        break;
-      default:
-        vtkWarningMacro( "Unsupported object type for fast path." );
-        return 0;
-      }
-
-    vtkIdTypeArray* globalIdMap = vtkIdTypeArray::SafeDownCast(
-      this->GetCacheOrRead( globalIdMapKey ) );
+    vtkIdTypeArray* globalIdMap = this->GetFastPathGlobalIdMap();
     if (!globalIdMap)
       {
       return 0;
@@ -4981,6 +5110,7 @@ void vtkExodusIIReaderPrivate::Reset()
   this->TimeStep = 0;
   memset( (void*)&this->ModelParameters, 0, sizeof(this->ModelParameters) );
   this->FastPathObjectId = -1;
+  this->FastPathObjectIds.clear();
 
   // Don't clear file id since it's not part of meta-data that's read from the
   // file, it's set externally (by vtkPExodusIIReader).
@@ -5017,17 +5147,38 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
   this->FastPathObjectType = vtkExodusIIReader::NODAL;
   this->FastPathObjectId = -1;
+  this->FastPathObjectIds.clear();
   this->SetFastPathIdType( 0 );
 }
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  // Keep the capacities: they are user settings, not file state.
   this->Cache->Clear();
-  this->Cache->SetCacheCapacity( 0. ); // FIXME: Perhaps Cache should have a Reset and a Clear method?
-  this->Cache->SetCacheCapacity( 128. ); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  this->Cache->ResetStatistics();
   this->ClearConnectivityCaches();
 }
 
+void vtkExodusIIReaderPrivate::SetCacheSize( double sizeInMiB )
+{
+  this->Cache->SetCacheCapacity( sizeInMiB );
+}
+
+double vtkExodusIIReaderPrivate::GetCacheSize()
+{
+  return this->Cache->GetCacheCapacity();
+}
+
+void vtkExodusIIReaderPrivate::SetTimeInvariantCacheSize( double sizeInMiB )
+{
+  this->Cache->SetTimeInvariantCacheCapacity( sizeInMiB );
+}
+
+double vtkExodusIIReaderPrivate::GetTimeInvariantCacheSize()
+{
+  return this->Cache->GetTimeInvariantCacheCapacity();
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -5729,6 +5880,9 @@ int vtkExodusIIReader::RequestInformation(
   // Advertize the SIL.
   outInfo->Set(vtkDataObject::SIL(), this->Metadata->GetSIL());
 
+  // The file is read without communicating with other processes.
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES(), 1);
+
   if ( newMetadata )
     {
     // update ExodusModelMetadata
@@ -5827,6 +5981,8 @@ int vtkExodusIIReader::RequestData(
     this->SetFastPathObjectType( objectType );
     this->SetFastPathObjectId( objectId );
     this->SetFastPathIdType( idType );
+    this->SetFastPathObjectIds( vtkIdTypeArray::SafeDownCast( outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_IDS() ) ) );
     haveFastPath = true;
     }
 
@@ -5839,6 +5995,7 @@ int vtkExodusIIReader::RequestData(
     {
     this->Metadata->FastPathObjectType = oldFastPathObjType; 
     this->SetFastPathObjectId( oldFastPathObjId );
+    this->SetFastPathObjectIds( 0 );
     this->SetFastPathIdType( oldFastPathIdType );
     delete [] oldFastPathIdType;
     }
@@ -6794,6 +6951,12 @@ void vtkExodusIIReader::SetFastPathObjectId(vtkIdType id)
   this->Modified();
 }
 
+void vtkExodusIIReader::SetFastPathObjectIds(vtkIdTypeArray* ids)
+{
+  this->Metadata->SetFastPathObjectIds(ids);
+  this->Modified();
+}
+
 
 void vtkExodusIIReader::SetFastPathIdType(const char *type)
 {
@@ -6817,6 +6980,54 @@ void vtkExodusIIReader::ResetCache()
   this->Metadata->ResetCache();
 }
 
+void vtkExodusIIReader::SetCacheSize( double CacheSize )
+{
+  if ( this->Metadata->GetCacheSize() != CacheSize )
+    {
+    this->Metadata->SetCacheSize( CacheSize );
+    this->Modified();
+    }
+}
+
+double vtkExodusIIReader::GetCacheSize()
+{
+  return this->Metadata->GetCacheSize();
+}
+
+void vtkExodusIIReader::SetTimeInvariantCacheSize( double CacheSize )
+{
+  if ( this->Metadata->GetTimeInvariantCacheSize() != CacheSize )
+    {
+    this->Metadata->SetTimeInvariantCacheSize( CacheSize );
+    this->Modified();
+    }
+}
+
+double vtkExodusIIReader::GetTimeInvariantCacheSize()
+{
+  return this->Metadata->GetTimeInvariantCacheSize();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheHits()
+{
+  return this->Metadata->GetCache()->GetNumberOfHits();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheMisses()
+{
+  return this->Metadata->GetCache()->GetNumberOfMisses();
+}
+
+double vtkExodusIIReader::GetCacheBytesRead()
+{
+  return this->Metadata->GetCache()->GetBytesInserted();
+}
+
+void vtkExodusIIReader::ResetCacheStatistics()
+{
+  this->Metadata->GetCache()->ResetStatistics();
+}
+
 void vtkExodusIIReader::UpdateTimeInformation()
 {
   if ( this->Metadata->OpenFile( this->FileName ) )
@@ -44,6 +44,7 @@ class vtkExodusIIReaderPrivate;
 class vtkExodusModel;
 class vtkFloatArray;
 class vtkGraph;
+class vtkIdTypeArray;
 class vtkIntArray;
 class vtkPoints;
 class vtkUnstructuredGrid;
@@ -689,6 +690,12 @@ public:
   // "INDEX" means the id refers to an index into the VTK array
   void SetFastPathIdType(const char *type);
   void SetFastPathObjectId(vtkIdType id);
+  // Description:
+  // Request the over-time arrays of several global ids at once. They are
+  // produced one block of time steps per id found in the file, in the order
+  // given by the "vtkFastPathObjectIds" field array. Pass NULL to go back
+  // to the single id given by SetFastPathObjectId().
+  void SetFastPathObjectIds(vtkIdTypeArray* ids);
   //@}
 
   // Description:
@@ -713,6 +720,33 @@ public:
   // Clears out the cache entries.
   void ResetCache();
 
+  // Description:
+  // Set/Get the size of the cache in MiB for arrays that change with
+  // each time step (nodal, element and set variables, displaced
+  // coordinates). The default is 64 MiB.
+  void SetCacheSize( double CacheSize );
+  double GetCacheSize();
+
+  // Description:
+  // Set/Get the size of the cache in MiB for arrays that do not change
+  // with time (connectivity, id maps, undisplaced coordinates). These
+  // are kept apart from the per-timestep arrays so that animating
+  // cannot evict them. Space not used by time-invariant arrays may be
+  // borrowed by per-timestep arrays. The default is 64 MiB, so that
+  // both budgets together match the former single 128 MiB cache.
+  void SetTimeInvariantCacheSize( double CacheSize );
+  double GetTimeInvariantCacheSize();
+
+  // Description:
+  // Cache statistics since the reader was created or the statistics
+  // were last reset: the number of array lookups that were satisfied
+  // by the cache, the number that had to go to disk, and the number of
+  // bytes that were read into the cache.
+  vtkIdType GetNumberOfCacheHits();
+  vtkIdType GetNumberOfCacheMisses();
+  double GetCacheBytesRead();
+  void ResetCacheStatistics();
+
   // Description:
   // Re-reads time information from the exodus file and updates
   // TimeStepRange accordingly.
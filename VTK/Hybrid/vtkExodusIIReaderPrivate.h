@@ -20,6 +20,7 @@ class vtkMultiProcessController;
 #include "vtkExodusII.h"
 
 class vtkExodusIIReaderParser;
+class vtkIdTypeArray;
 class vtkMutableDirectedGraph;
 
 /** This class holds metadata for an Exodus file.
@@ -82,6 +83,17 @@ public:
   /// Clears out any data in the cache and restores it to its initial state.
   void ResetCache();
 
+  /** Set the cache budgets (in MiB) for per-timestep and time-invariant arrays.
+    * Time-invariant arrays are connectivity, id maps, and undeflected coordinates.
+    */
+  void SetCacheSize( double sizeInMiB );
+  double GetCacheSize();
+  void SetTimeInvariantCacheSize( double sizeInMiB );
+  double GetTimeInvariantCacheSize();
+
+  /// Return the array cache (e.g., to query hit/miss statistics).
+  vtkExodusIICache* GetCache() { return this->Cache; }
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before 
     * invoking this member function.
@@ -452,6 +464,7 @@ public:
   void SetFastPathObjectType(vtkExodusIIReader::ObjectType type)
     {this->FastPathObjectType = type;};
   void SetFastPathObjectId(vtkIdType id){this->FastPathObjectId = id;};
+  void SetFastPathObjectIds(vtkIdTypeArray* ids);
   vtkSetStringMacro(FastPathIdType);
 
   bool IsXMLMetadataValid();
@@ -576,6 +589,15 @@ protected:
   /** Add fast-path time-varying data to field data of an output block or set.
     */
   int AssembleArraysOverTime(vtkMultiBlockDataSet* output);
+  /** Add fast-path time-varying data for all of FastPathObjectIds at once.
+    * The over-time arrays hold one block of time steps per id found in
+    * this file, in the order given by the "vtkFastPathObjectIds" array.
+    */
+  int AssembleArraysOverTimeForIds(vtkMultiBlockDataSet* output);
+  /** Return the map from internal exodus ids to global ids for the
+    * fast-path object type, or NULL if that type is not supported.
+    */
+  vtkIdTypeArray* GetFastPathGlobalIdMap();
 
   // Generate the decorations for edge fields.
   void AssembleOutputEdgeDecorations();
@@ -834,6 +856,7 @@ protected:
 
   vtkExodusIIReader::ObjectType FastPathObjectType;
   vtkIdType FastPathObjectId;
+  vtkstd::vector<vtkIdType> FastPathObjectIds;
   char* FastPathIdType;
 
   vtkMutableDirectedGraph* SIL;
@@ -25,7 +25,9 @@
 #include "vtkCommand.h"
 #include "vtkDoubleArray.h"
 #include "vtkExodusIIReaderPrivate.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -43,6 +45,8 @@
 
 #include "vtksys/SystemTools.hxx"
 
+#include <vtkstd/set>
+#include <vtkstd/string>
 #include <vtkstd/vector>
 
 #include <vtksys/RegularExpression.hxx>
@@ -375,10 +379,87 @@ int vtkPExodusIIReader::RequestInformation(
     this->CurrentFileRange[1] = this->FileRange[1];
     }
 
+  // This reader communicates with the other processes, so they must all
+  // update it for the same time step.
+  outInfo->Remove( vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES() );
+
   return 1;
 }
 
 
+//----------------------------------------------------------------------------
+// Append the over-time arrays produced by one file for several fast-path ids
+// to those gathered so far. Ids already gathered from a previous file are
+// skipped: points are duplicated among the files of a set.
+static void vtkPExodusIIReaderAppendArraysOverTime(
+  vtkFieldData* ofd, vtkFieldData* ifd )
+{
+  vtkIdTypeArray* inIds = vtkIdTypeArray::SafeDownCast(
+    ifd->GetAbstractArray( "vtkFastPathObjectIds" ) );
+  vtkIdType numInIds = inIds ? inIds->GetNumberOfTuples() : 0;
+  if ( numInIds == 0 )
+    {
+    return;
+    }
+
+  vtkIdTypeArray* outIds = vtkIdTypeArray::SafeDownCast(
+    ofd->GetAbstractArray( "vtkFastPathObjectIds" ) );
+  if ( ! outIds )
+    {
+    outIds = vtkIdTypeArray::New();
+    outIds->SetName( "vtkFastPathObjectIds" );
+    ofd->AddArray( outIds );
+    outIds->Delete();
+    }
+
+  vtkstd::set<vtkIdType> gathered;
+  vtkIdType i;
+  for ( i = 0; i < outIds->GetNumberOfTuples(); ++i )
+    {
+    gathered.insert( outIds->GetValue( i ) );
+    }
+  vtkstd::vector<vtkIdType> keep;
+  for ( i = 0; i < numInIds; ++i )
+    {
+    if ( gathered.insert( inIds->GetValue( i ) ).second )
+      {
+      keep.push_back( i );
+      }
+    }
+
+  for ( int j = 0; j < ifd->GetNumberOfArrays(); ++j )
+    {
+    vtkAbstractArray* inArray = ifd->GetAbstractArray( j );
+    if ( ! inArray || ! inArray->GetName() ||
+         ! strstr( inArray->GetName(), "OverTime" ) )
+      {
+      continue;
+      }
+    vtkAbstractArray* outArray = ofd->GetAbstractArray( inArray->GetName() );
+    if ( ! outArray )
+      {
+      outArray = inArray->NewInstance();
+      outArray->SetName( inArray->GetName() );
+      outArray->SetNumberOfComponents( inArray->GetNumberOfComponents() );
+      ofd->AddArray( outArray );
+      outArray->Delete();
+      }
+    vtkIdType numTimeSteps = inArray->GetNumberOfTuples() / numInIds;
+    for ( size_t k = 0; k < keep.size(); ++k )
+      {
+      for ( vtkIdType t = 0; t < numTimeSteps; ++t )
+        {
+        outArray->InsertNextTuple( keep[k] * numTimeSteps + t, inArray );
+        }
+      }
+    }
+
+  for ( size_t k = 0; k < keep.size(); ++k )
+    {
+    outIds->InsertNextValue( inIds->GetValue( keep[k] ) );
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkPExodusIIReader::RequestData(
   vtkInformation* vtkNotUsed(request),
@@ -506,6 +587,15 @@ int vtkPExodusIIReader::RequestData(
 #endif // DBG_PEXOIIRDR
   // This constructs the filenames
   int fast_path_reader_index = -1;
+  vtkstd::vector<int> fast_path_readers;
+  vtkIdTypeArray* fastPathObjectIds = 0;
+  if ( outInfo->Has( vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_TYPE() ) &&
+       outInfo->Has( vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_ID() ) &&
+       outInfo->Has( vtkStreamingDemandDrivenPipeline::FAST_PATH_ID_TYPE() ) )
+    {
+    fastPathObjectIds = vtkIdTypeArray::SafeDownCast( outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::FAST_PATH_OBJECT_IDS() ) );
+    }
   for ( fileIndex = min, reader_idx=0; fileIndex <= max; ++fileIndex, ++reader_idx )
     {
     int fileId = -1;
@@ -588,6 +678,8 @@ int vtkPExodusIIReader::RequestData(
     this->ReaderList[reader_idx]->SetAnimateModeShapes( this->GetAnimateModeShapes() );
     this->ReaderList[reader_idx]->SetEdgeFieldDecorations( this->GetEdgeFieldDecorations() );
     this->ReaderList[reader_idx]->SetFaceFieldDecorations( this->GetFaceFieldDecorations() );
+    this->ReaderList[reader_idx]->SetCacheSize( this->GetCacheSize() );
+    this->ReaderList[reader_idx]->SetTimeInvariantCacheSize( this->GetTimeInvariantCacheSize() );
 
     this->ReaderList[reader_idx]->SetExodusModelMetadata( this->ExodusModelMetadata );
     // For now, this *must* come last before the UpdateInformation() call because its MTime is compared to the metadata's MTime,
@@ -650,17 +742,20 @@ int vtkPExodusIIReader::RequestData(
       this->ReaderList[reader_idx]->SetFastPathObjectType( objectType );
       this->ReaderList[reader_idx]->SetFastPathObjectId( objectId );
       this->ReaderList[reader_idx]->SetFastPathIdType( idType );
+      this->ReaderList[reader_idx]->SetFastPathObjectIds( fastPathObjectIds );
       }
     else
       {
       this->ReaderList[reader_idx]->SetFastPathObjectType("CELL");
       this->ReaderList[reader_idx]->SetFastPathObjectId(-1);
       this->ReaderList[reader_idx]->SetFastPathIdType(0);
+      this->ReaderList[reader_idx]->SetFastPathObjectIds(0);
       }
 
     this->ReaderList[reader_idx]->Update();
     if (this->ReaderList[reader_idx]->GetProducedFastPathOutput())
       {
+      fast_path_readers.push_back( reader_idx );
       //if (fast_path_reader_index != -1)
       //  {
       //  Requested fast-path Global ID was provided by two readers. This
@@ -721,7 +816,32 @@ int vtkPExodusIIReader::RequestData(
     output->ShallowCopy( append->GetOutput() );
     }
 
-  if (fast_path_reader_index != -1 && fast_path_reader_index !=0)
+  if ( fastPathObjectIds )
+    {
+    // Each file produced the over-time arrays of the requested ids it
+    // contains; concatenate them all.
+    vtkFieldData* ofd = output->GetFieldData();
+    vtkstd::vector<vtkstd::string> names;
+    for ( int j = 0; j < ofd->GetNumberOfArrays(); ++j )
+      {
+      const char* name = ofd->GetArrayName( j );
+      if ( name && ( strstr( name, "OverTime" ) ||
+          strcmp( name, "vtkFastPathObjectIds" ) == 0 ) )
+        {
+        names.push_back( name );
+        }
+      }
+    for ( size_t j = 0; j < names.size(); ++j )
+      {
+      ofd->RemoveArray( names[j].c_str() );
+      }
+    for ( size_t j = 0; j < fast_path_readers.size(); ++j )
+      {
+      vtkPExodusIIReaderAppendArraysOverTime( ofd,
+        this->ReaderList[fast_path_readers[j]]->GetOutputDataObject(0)->GetFieldData() );
+      }
+    }
+  else if (fast_path_reader_index != -1 && fast_path_reader_index !=0)
     {
     // if fast_path_reader_index==0, then the field data is copied over by
     // vtkAppendCompositeDataLeaves so only copy the "OverTime" arrays if the
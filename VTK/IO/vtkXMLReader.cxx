@@ -389,6 +389,9 @@ int vtkXMLReader
     outputPort = outputPort >= 0 ? outputPort : 0;
     this->SetupOutputInformation
       (outputVector->GetInformationObject(outputPort) );
+    // Each process reads its own pieces from the files.
+    outputVector->GetInformationObject(outputPort)->Set(
+      vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES(), 1);
 
     // this->NumberOfTimeSteps has been set during the
     // this->ReadXMLInformation()
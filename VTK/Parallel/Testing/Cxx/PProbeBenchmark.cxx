@@ -0,0 +1,256 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test compares vtkPProbeFilter, which merges only the valid samples
+// up a binary tree, with the gather of whole probe outputs on process 0 it
+// replaces, and with the distributed (ReduceToRoot off) mode. It checks that
+// both gathers produce the same samples and prints the time taken by each.
+// Usage: PProbeBenchmark [number of samples] [number of iterations]
+
+#include <mpi.h>
+
+#include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkLineSource.h"
+#include "vtkMPIController.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPProbeFilter.h"
+#include "vtkProbeFilter.h"
+#include "vtkTimerLog.h"
+
+#include <stdlib.h>
+
+#define PROBE_BENCHMARK_TAG 4242
+
+// Builds the slab of a 64^3 grid owned by this process. Slabs are split
+// along x and share one layer of points with their neighbors.
+static vtkImageData* NewPiece(int me, int numProcs)
+{
+  const int dim = 64;
+  int x0 = (dim - 1) * me / numProcs;
+  int x1 = (dim - 1) * (me + 1) / numProcs;
+
+  vtkImageData* piece = vtkImageData::New();
+  piece->SetSpacing(1.0 / (dim - 1), 1.0 / (dim - 1), 1.0 / (dim - 1));
+  piece->SetExtent(x0, x1, 0, dim - 1, 0, dim - 1);
+
+  vtkDoubleArray* scalars = vtkDoubleArray::New();
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(piece->GetNumberOfPoints());
+  vtkDoubleArray* vectors = vtkDoubleArray::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(piece->GetNumberOfPoints());
+  double pt[3];
+  for (vtkIdType i = 0; i < piece->GetNumberOfPoints(); i++)
+    {
+    piece->GetPoint(i, pt);
+    scalars->SetValue(i, pt[0] * pt[0] + pt[1] + 0.5 * pt[2]);
+    vectors->SetTuple(i, pt);
+    }
+  piece->GetPointData()->SetScalars(scalars);
+  piece->GetPointData()->AddArray(vectors);
+  scalars->Delete();
+  vectors->Delete();
+  return piece;
+}
+
+// The gather used by vtkPProbeFilter before the valid samples were merged
+// up a tree: every process sends its whole probe output to process 0.
+static void GatherWholeOutputs(vtkMultiProcessController* c,
+                               vtkDataSet* output, vtkIdType numValid,
+                               const char* maskName)
+{
+  int me = c->GetLocalProcessId();
+  int numProcs = c->GetNumberOfProcesses();
+  if (me)
+    {
+    c->Send(&numValid, 1, 0, PROBE_BENCHMARK_TAG);
+    if (numValid > 0)
+      {
+      c->Send(output, 0, PROBE_BENCHMARK_TAG);
+      }
+    return;
+    }
+
+  vtkPointData* pointData = output->GetPointData();
+  for (int i = 1; i < numProcs; i++)
+    {
+    vtkIdType numRemoteValid = 0;
+    c->Receive(&numRemoteValid, 1, i, PROBE_BENCHMARK_TAG);
+    if (numRemoteValid == 0)
+      {
+      continue;
+      }
+    vtkDataSet* remote = output->NewInstance();
+    c->Receive(remote, i, PROBE_BENCHMARK_TAG);
+    vtkPointData* remotePointData = remote->GetPointData();
+    vtkCharArray* maskArray = vtkCharArray::SafeDownCast(
+      remotePointData->GetArray(maskName));
+    for (vtkIdType pointId = 0;
+         maskArray && pointId < remote->GetNumberOfPoints(); pointId++)
+      {
+      if (maskArray->GetValue(pointId) != 1)
+        {
+        continue;
+        }
+      for (int k = 0; k < pointData->GetNumberOfArrays(); k++)
+        {
+        vtkAbstractArray* oaa = pointData->GetArray(k);
+        vtkAbstractArray* raa = remotePointData->GetArray(oaa->GetName());
+        if (raa)
+          {
+          oaa->SetTuple(pointId, pointId, raa);
+          }
+        }
+      }
+    remote->Delete();
+    }
+}
+
+// Returns 1 when both outputs hold the same point data.
+static int CompareOutputs(vtkDataSet* a, vtkDataSet* b)
+{
+  vtkPointData* pa = a->GetPointData();
+  vtkPointData* pb = b->GetPointData();
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      pa->GetNumberOfArrays() != pb->GetNumberOfArrays())
+    {
+    return 0;
+    }
+  for (int k = 0; k < pa->GetNumberOfArrays(); k++)
+    {
+    vtkDataArray* da = pa->GetArray(k);
+    vtkDataArray* db = pb->GetArray(da->GetName());
+    if (!db || db->GetNumberOfComponents() != da->GetNumberOfComponents())
+      {
+      return 0;
+      }
+    for (vtkIdType i = 0; i < da->GetNumberOfTuples(); i++)
+      {
+      for (int j = 0; j < da->GetNumberOfComponents(); j++)
+        {
+        if (da->GetComponent(i, j) != db->GetComponent(i, j))
+          {
+          return 0;
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+
+  vtkMPIController* c = vtkMPIController::New();
+  c->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(c);
+
+  int me = c->GetLocalProcessId();
+  int numProcs = c->GetNumberOfProcesses();
+
+  int numSamples = argc > 1? atoi(argv[1]) : 100000;
+  int numIterations = argc > 2? atoi(argv[2]) : 5;
+
+  vtkImageData* piece = NewPiece(me, numProcs);
+  vtkLineSource* line = vtkLineSource::New();
+  line->SetPoint1(0.0, 0.1, 0.2);
+  line->SetPoint2(1.0, 0.9, 0.7);
+  line->SetResolution(numSamples - 1);
+  line->Update();
+
+  vtkProbeFilter* baseline = vtkProbeFilter::New();
+  baseline->SetInputConnection(line->GetOutputPort());
+  baseline->SetSource(piece);
+
+  vtkPProbeFilter* reduced = vtkPProbeFilter::New();
+  reduced->SetController(c);
+  reduced->SetInputConnection(line->GetOutputPort());
+  reduced->SetSource(piece);
+
+  vtkPProbeFilter* distributed = vtkPProbeFilter::New();
+  distributed->SetController(c);
+  distributed->ReduceToRootOff();
+  distributed->SetInputConnection(line->GetOutputPort());
+  distributed->SetSource(piece);
+
+  vtkTimerLog* timer = vtkTimerLog::New();
+  double baselineTime = 0.0;
+  double reducedTime = 0.0;
+  double distributedTime = 0.0;
+  int retVal = 0;
+  for (int iter = 0; iter < numIterations; iter++)
+    {
+    baseline->Modified();
+    reduced->Modified();
+    distributed->Modified();
+
+    c->Barrier();
+    timer->StartTimer();
+    baseline->Update();
+    GatherWholeOutputs(c, baseline->GetOutput(),
+                       baseline->GetValidPoints()->GetNumberOfTuples(),
+                       baseline->GetValidPointMaskArrayName());
+    c->Barrier();
+    timer->StopTimer();
+    baselineTime += timer->GetElapsedTime();
+
+    timer->StartTimer();
+    reduced->Update();
+    c->Barrier();
+    timer->StopTimer();
+    reducedTime += timer->GetElapsedTime();
+
+    timer->StartTimer();
+    distributed->Update();
+    c->Barrier();
+    timer->StopTimer();
+    distributedTime += timer->GetElapsedTime();
+
+    if (me == 0 && !CompareOutputs(baseline->GetOutput(), reduced->GetOutput()))
+      {
+      cerr << "vtkPProbeFilter output differs from the whole output gather."
+           << endl;
+      retVal = 1;
+      }
+    }
+
+  if (me == 0)
+    {
+    cout << "Processes: " << numProcs << ", samples: " << numSamples
+         << ", iterations: " << numIterations << endl;
+    cout << "Gather whole outputs:    " << baselineTime / numIterations
+         << " s" << endl;
+    cout << "Tree merge valid points: " << reducedTime / numIterations
+         << " s" << endl;
+    cout << "Distributed output:      " << distributedTime / numIterations
+         << " s" << endl;
+    }
+
+  timer->Delete();
+  distributed->Delete();
+  reduced->Delete();
+  baseline->Delete();
+  line->Delete();
+  piece->Delete();
+
+  c->Finalize();
+  c->Delete();
+  return retVal;
+}
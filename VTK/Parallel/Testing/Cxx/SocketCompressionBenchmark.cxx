@@ -0,0 +1,300 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test sends the arrays of a surface mesh between two socket
+// communicators on the loopback interface, through a relay limiting the
+// bandwidth, with and without compression. It checks that the arrays are
+// received unchanged and prints the time taken by each transfer.
+// Usage: SocketCompressionBenchmark [bandwidth in Mbit/s] [mesh dimension]
+
+#include "vtkCallbackCommand.h"
+#include "vtkClientSocket.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define BENCHMARK_POINTS_TAG 5001
+#define BENCHMARK_CELLS_TAG 5002
+#define BENCHMARK_DONE_TAG 5003
+
+struct BenchmarkInfo
+{
+  vtkServerSocket* RelaySocket;
+  int ReceiverPort;
+  double BytesPerSecond;
+  int Dimension;
+  int Compression;
+  double Time;
+};
+
+// Builds the points and the quads of a wavy surface of dim x dim points.
+static void NewMesh(int dim, vtkFloatArray*& points, vtkIdTypeArray*& cells)
+{
+  points = vtkFloatArray::New();
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(dim * dim);
+  for (int j = 0; j < dim; j++)
+    {
+    for (int i = 0; i < dim; i++)
+      {
+      float x = static_cast<float>(i) / dim;
+      float y = static_cast<float>(j) / dim;
+      points->SetTuple3(j * dim + i, x, y,
+                        0.1 * sin(20.0 * x) * cos(15.0 * y));
+      }
+    }
+
+  cells = vtkIdTypeArray::New();
+  cells->SetNumberOfTuples(5 * (dim - 1) * (dim - 1));
+  vtkIdType* cell = cells->GetPointer(0);
+  for (int j = 0; j < dim - 1; j++)
+    {
+    for (int i = 0; i < dim - 1; i++)
+      {
+      *cell++ = 4;
+      *cell++ = j * dim + i;
+      *cell++ = j * dim + i + 1;
+      *cell++ = (j + 1) * dim + i + 1;
+      *cell++ = (j + 1) * dim + i;
+      }
+    }
+}
+
+// Ignores the error of the relay when a side closes its connection.
+static void IgnoreError(vtkObject*, unsigned long, void*, void*)
+{
+}
+
+// One direction of the relay.
+struct RelayDirection
+{
+  vtkSocket* From;
+  vtkSocket* To;
+  double BytesPerSecond;
+};
+
+// Forwards the bytes of one direction, no faster than the given bandwidth,
+// until the sending side closes its connection.
+static VTK_THREAD_RETURN_TYPE Forward(void* arg)
+{
+  RelayDirection* direction = static_cast<RelayDirection*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+
+  const int bufferSize = 16384;
+  char buffer[bufferSize];
+  double start = vtkTimerLog::GetUniversalTime();
+  double bytes = 0.0;
+  for (;;)
+    {
+    int length = direction->From->Receive(buffer, bufferSize, 0);
+    if (length <= 0 || !direction->To->Send(buffer, length))
+      {
+      break;
+      }
+    bytes += length;
+    double wait = bytes / direction->BytesPerSecond -
+      (vtkTimerLog::GetUniversalTime() - start);
+    if (wait > 0.001)
+      {
+      vtksys::SystemTools::Delay(static_cast<unsigned int>(wait * 1000));
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Connects the sender to the receiver and forwards both directions.
+static VTK_THREAD_RETURN_TYPE Relay(void* arg)
+{
+  BenchmarkInfo* info = static_cast<BenchmarkInfo*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+
+  vtkClientSocket* sender = info->RelaySocket->WaitForConnection();
+  vtkClientSocket* receiver = vtkClientSocket::New();
+  if (!sender || receiver->ConnectToServer("localhost", info->ReceiverPort))
+    {
+    if (sender)
+      {
+      sender->Delete();
+      }
+    receiver->Delete();
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
+  vtkCallbackCommand* ignoreError = vtkCallbackCommand::New();
+  ignoreError->SetCallback(IgnoreError);
+  sender->AddObserver(vtkCommand::ErrorEvent, ignoreError);
+  receiver->AddObserver(vtkCommand::ErrorEvent, ignoreError);
+  ignoreError->Delete();
+
+  RelayDirection forward = { sender, receiver, info->BytesPerSecond };
+  RelayDirection backward = { receiver, sender, info->BytesPerSecond };
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  int backwardThread = threader->SpawnThread(Forward, &backward);
+  vtkMultiThreader::ThreadInfo threadInfo;
+  threadInfo.UserData = &forward;
+  Forward(&threadInfo);
+  threader->TerminateThread(backwardThread);
+  threader->Delete();
+
+  sender->CloseSocket();
+  sender->Delete();
+  receiver->CloseSocket();
+  receiver->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Sends the mesh through the relay and waits for the receiver to get it.
+static VTK_THREAD_RETURN_TYPE Send(void* arg)
+{
+  BenchmarkInfo* info = static_cast<BenchmarkInfo*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+
+  vtkFloatArray* points;
+  vtkIdTypeArray* cells;
+  NewMesh(info->Dimension, points, cells);
+
+  vtkSocketCommunicator* comm = vtkSocketCommunicator::New();
+  comm->SetCompression(info->Compression);
+  char host[] = "localhost";
+  if (comm->ConnectTo(host, info->RelaySocket->GetServerPort()))
+    {
+    vtkTimerLog* timer = vtkTimerLog::New();
+    timer->StartTimer();
+    int done = 0;
+    comm->Send(points, 1, BENCHMARK_POINTS_TAG);
+    comm->Send(cells, 1, BENCHMARK_CELLS_TAG);
+    comm->Receive(&done, 1, 1, BENCHMARK_DONE_TAG);
+    timer->StopTimer();
+    info->Time = timer->GetElapsedTime();
+    timer->Delete();
+    comm->CloseConnection();
+    }
+
+  comm->Delete();
+  points->Delete();
+  cells->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Returns 1 when both arrays hold the same values.
+static int Compare(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return 0;
+    }
+  vtkIdType size = a->GetNumberOfTuples() * a->GetNumberOfComponents() *
+    a->GetDataTypeSize();
+  return memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0), size) == 0;
+}
+
+// Receives the mesh sent through the relay and checks it.
+static int Transfer(BenchmarkInfo* info)
+{
+  vtkSmartPointer<vtkServerSocket> receiverSocket =
+    vtkSmartPointer<vtkServerSocket>::New();
+  vtkSmartPointer<vtkServerSocket> relaySocket =
+    vtkSmartPointer<vtkServerSocket>::New();
+  if (receiverSocket->CreateServer(0) || relaySocket->CreateServer(0))
+    {
+    cerr << "Could not create the server sockets." << endl;
+    return 0;
+    }
+  info->ReceiverPort = receiverSocket->GetServerPort();
+  info->RelaySocket = relaySocket;
+  info->Time = -1.0;
+
+  vtkSmartPointer<vtkMultiThreader> threader =
+    vtkSmartPointer<vtkMultiThreader>::New();
+  int relayThread = threader->SpawnThread(Relay, info);
+  int sendThread = threader->SpawnThread(Send, info);
+
+  vtkSmartPointer<vtkSocketCommunicator> comm =
+    vtkSmartPointer<vtkSocketCommunicator>::New();
+  int success = 0;
+  if (comm->WaitForConnection(receiverSocket))
+    {
+    vtkFloatArray* points;
+    vtkIdTypeArray* cells;
+    NewMesh(info->Dimension, points, cells);
+    vtkSmartPointer<vtkFloatArray> receivedPoints =
+      vtkSmartPointer<vtkFloatArray>::New();
+    vtkSmartPointer<vtkIdTypeArray> receivedCells =
+      vtkSmartPointer<vtkIdTypeArray>::New();
+    int done = 1;
+    success = comm->Receive(receivedPoints, 1, BENCHMARK_POINTS_TAG) &&
+      comm->Receive(receivedCells, 1, BENCHMARK_CELLS_TAG) &&
+      comm->Send(&done, 1, 1, BENCHMARK_DONE_TAG) &&
+      comm->GetCompressionEnabled() == info->Compression &&
+      Compare(points, receivedPoints) && Compare(cells, receivedCells);
+    points->Delete();
+    cells->Delete();
+    }
+
+  threader->TerminateThread(sendThread);
+  comm->CloseConnection();
+  threader->TerminateThread(relayThread);
+  return success && info->Time >= 0.0;
+}
+
+int main(int argc, char* argv[])
+{
+  double bandwidth = 100.0;
+  int dim = 512;
+  if (argc > 2)
+    {
+    bandwidth = atof(argv[1]);
+    dim = atoi(argv[2]);
+    }
+
+  BenchmarkInfo info;
+  info.BytesPerSecond = bandwidth * 1.0e6 / 8.0;
+  info.Dimension = dim;
+
+  double megabytes = (3.0 * sizeof(float) + 5.0 * sizeof(vtkIdType)) *
+    dim * dim / 1.0e6;
+  double times[2];
+  int retVal = EXIT_SUCCESS;
+  for (int compression = 0; compression < 2; compression++)
+    {
+    info.Compression = compression;
+    if (!Transfer(&info))
+      {
+      cerr << "The transfer with compression " << (compression? "on" : "off")
+           << " failed or changed the data." << endl;
+      retVal = EXIT_FAILURE;
+      continue;
+      }
+    times[compression] = info.Time;
+    cout << "Bandwidth: " << bandwidth << " Mbit/s, data: " << megabytes
+         << " MB, compression: " << (compression? "on" : "off")
+         << ", time: " << info.Time << " s, throughput: "
+         << megabytes / info.Time << " MB/s" << endl;
+    }
+  if (retVal == EXIT_SUCCESS)
+    {
+    cout << "Speedup: " << times[0] / times[1] << endl;
+    }
+  return retVal;
+}
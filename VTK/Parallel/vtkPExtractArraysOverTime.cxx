@@ -16,12 +16,16 @@
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkExecutive.h"
 #include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSelection.h"
 #include "vtkSelectionNode.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
 
@@ -36,6 +40,8 @@ vtkPExtractArraysOverTime::vtkPExtractArraysOverTime()
 {
   this->Controller = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->NumberOfTimePartitions = 1;
+  this->SelectionAllowsTimePartitions = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -49,6 +55,142 @@ void vtkPExtractArraysOverTime::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "NumberOfTimePartitions: "
+     << this->NumberOfTimePartitions << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkPExtractArraysOverTime::GetNumberOfTimeGroups(
+  int& piece, int& numPieces, int procid)
+{
+  int numProcs = this->Controller?
+    this->Controller->GetNumberOfProcesses() : 1;
+  int numGroups = 1;
+  if (this->SelectionAllowsTimePartitions && numProcs > 1 &&
+      this->NumberOfTimePartitions > 1 && this->InputAllowsTimePartitions())
+    {
+    numGroups = this->NumberOfTimePartitions;
+    if (numGroups > this->NumberOfTimeSteps)
+      {
+      numGroups = this->NumberOfTimeSteps;
+      }
+    if (numGroups > numProcs)
+      {
+      numGroups = numProcs;
+      }
+    if (numGroups < 1)
+      {
+      numGroups = 1;
+      }
+    while (numProcs % numGroups != 0)
+      {
+      numGroups--;
+      }
+    }
+  numPieces = numProcs / numGroups;
+  piece = procid % numPieces;
+  return numGroups;
+}
+
+//----------------------------------------------------------------------------
+int vtkPExtractArraysOverTime::InputAllowsTimePartitions()
+{
+  if (this->GetNumberOfInputConnections(0) < 1)
+    {
+    return 0;
+    }
+  // Only sources that do not communicate while executing set the key, and
+  // filters do not pass it downstream.
+  vtkInformation* inInfo = this->GetExecutive()->GetInputInformation(0, 0);
+  if (!inInfo ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES()))
+    {
+    return 0;
+    }
+  return inInfo->Get(vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES());
+}
+
+//----------------------------------------------------------------------------
+void vtkPExtractArraysOverTime::DetermineTimeStepRange()
+{
+  this->Superclass::DetermineTimeStepRange();
+
+  int procid = this->Controller? this->Controller->GetLocalProcessId() : 0;
+  int piece, numPieces;
+  int numGroups = this->GetNumberOfTimeGroups(piece, numPieces, procid);
+  if (numGroups > 1)
+    {
+    int group = procid / numPieces;
+    this->TimeStepBegin = this->NumberOfTimeSteps * group / numGroups;
+    this->TimeStepEnd = this->NumberOfTimeSteps * (group + 1) / numGroups;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPExtractArraysOverTime::RequestUpdateExtent(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector,
+      outputVector))
+    {
+    return 0;
+    }
+
+  // When the time steps are shared among groups, each group processes the
+  // whole data, split among the processes of the group.
+  int procid = this->Controller? this->Controller->GetLocalProcessId() : 0;
+  int piece, numPieces;
+  if (this->GetNumberOfTimeGroups(piece, numPieces, procid) > 1)
+    {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      piece);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      numPieces);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPExtractArraysOverTime::RequestData(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  // The time steps and piece requested for the first iteration depend on
+  // whether the selection can be extracted with the time steps shared among
+  // groups, which is only known now. When that changed since the last
+  // execution, the input is requested again.
+  if (!this->IsExecuting && this->NumberOfTimeSteps > 0 &&
+    inputVector[1]->GetInformationObject(0))
+    {
+    vtkSelection* selection = vtkSelection::GetData(inputVector[1], 0);
+    if (!this->DetermineSelectionType(selection))
+      {
+      return 0;
+      }
+    int allows = (this->ContentType != vtkSelectionNode::INDICES &&
+      !(this->UseFastPath &&
+        this->ContentType == vtkSelectionNode::GLOBALIDS))? 1 : 0;
+    if (allows != this->SelectionAllowsTimePartitions)
+      {
+      int procid = this->Controller?
+        this->Controller->GetLocalProcessId() : 0;
+      int piece, numPieces;
+      int numGroups = this->GetNumberOfTimeGroups(piece, numPieces, procid);
+      this->SelectionAllowsTimePartitions = allows;
+      if (this->GetNumberOfTimeGroups(piece, numPieces, procid) != numGroups)
+        {
+        request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(),
+          1);
+        return 1;
+        }
+      }
+    }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
 //----------------------------------------------------------------------------
@@ -76,6 +218,8 @@ void vtkPExtractArraysOverTime::PostExecute(
   vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector, 0);
   if (procid == 0)
     {
+    // The piece each block of the output comes from.
+    vtkstd::vector<int> blockPieces(output->GetNumberOfBlocks(), 0);
     for (int cc=1; cc < numProcs; cc++)
       {
       vtkMultiBlockDataSet* remoteOutput = vtkMultiBlockDataSet::New();
@@ -96,7 +240,9 @@ void vtkPExtractArraysOverTime::PostExecute(
           name.c_str());
         }
       iter->Delete();
-      this->AddRemoteData(remoteOutput, output);
+      int remotePiece, numPieces;
+      this->GetNumberOfTimeGroups(remotePiece, numPieces, cc);
+      this->AddRemoteData(remoteOutput, output, remotePiece, blockPieces);
       remoteOutput->Delete();
       }
     int num_blocks = static_cast<int>(output->GetNumberOfBlocks());
@@ -127,25 +273,20 @@ void vtkPExtractArraysOverTime::PostExecute(
 
 //----------------------------------------------------------------------------
 void vtkPExtractArraysOverTime::AddRemoteData(
-  vtkMultiBlockDataSet* remoteOutput, vtkMultiBlockDataSet* output)
+  vtkMultiBlockDataSet* remoteOutput, vtkMultiBlockDataSet* output,
+  int remotePiece, vtkstd::vector<int>& blockPieces)
 {
+  // Global id and location based selections name the blocks the same way on
+  // every process. Other selections name them after ids local to a piece;
+  // those blocks only match blocks extracted from the same piece, by
+  // another group of time steps.
+  bool globalNames = (this->ContentType == vtkSelectionNode::LOCATIONS ||
+    this->ContentType == vtkSelectionNode::GLOBALIDS);
   vtkCompositeDataIterator* remoteIter = remoteOutput->NewIterator();
   vtkCompositeDataIterator* localIter = output->NewIterator();
   for (remoteIter->InitTraversal();
     !remoteIter->IsDoneWithTraversal(); remoteIter->GoToNextItem())
     {
-    // We really need to think of merging blocks only in 2 cases: for global id
-    // based selections or for location based selections
-    if (this->ContentType != vtkSelectionNode::LOCATIONS &&
-      this->ContentType != vtkSelectionNode::GLOBALIDS)
-      {
-      unsigned int index = output->GetNumberOfBlocks();
-      output->SetBlock(index, remoteIter->GetCurrentDataObject());
-      output->GetMetaData(index)->Copy(remoteIter->GetCurrentMetaData(),
-        /*deep=*/0);
-      continue;
-      }
-
     if (!remoteIter->GetCurrentMetaData()->Has(vtkCompositeDataSet::NAME()))
       {
       vtkWarningMacro("Internal filter error: Missing NAME()");
@@ -156,10 +297,12 @@ void vtkPExtractArraysOverTime::AddRemoteData(
 
     // We need to merge "coincident" tables.
     bool merged = false;
+    unsigned int localIndex = 0;
     for (localIter->InitTraversal(); !localIter->IsDoneWithTraversal();
-      localIter->GoToNextItem())
+      localIter->GoToNextItem(), localIndex++)
       {
-      if (name ==
+      if ((globalNames || blockPieces[localIndex] == remotePiece) &&
+        name ==
         localIter->GetCurrentMetaData()->Get(vtkCompositeDataSet::NAME()))
         {
         this->MergeTables(vtkTable::SafeDownCast(remoteIter->GetCurrentDataObject()),
@@ -174,6 +317,7 @@ void vtkPExtractArraysOverTime::AddRemoteData(
       output->SetBlock(index, remoteIter->GetCurrentDataObject());
       output->GetMetaData(index)->Copy(remoteIter->GetCurrentMetaData(),
         /*deep=*/0);
+      blockPieces.push_back(remotePiece);
       }
     }
   localIter->Delete();
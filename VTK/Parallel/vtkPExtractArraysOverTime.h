@@ -26,6 +26,9 @@
 // This filter produces a valid output on the root node alone, all other nodes,
 // simply have empty multi-block dataset with number of blocks matching the root
 // (to ensure that all processes have the same structure).
+// The time steps may also be shared among groups of processes (see
+// NumberOfTimePartitions), which lets the groups run the upstream pipeline
+// for disjoint ranges of time steps concurrently.
 // .SECTION See Also
 // vtkExtractArraysOverTime
 
@@ -34,6 +37,10 @@
 
 #include "vtkExtractArraysOverTime.h"
 
+//BTX
+#include <vtkstd/vector> // STL Header; Required for vector
+//ETX
+
 class vtkMultiProcessController;
 class vtkTable;
 
@@ -49,6 +56,24 @@ public:
   virtual void SetController(vtkMultiProcessController*);
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
+  // Description:
+  // Number of groups of processes among which the time steps are shared.
+  // The default, 1, has every process extract all the time steps from its
+  // own piece of the data. With N groups, each group extracts a contiguous
+  // range of about 1/N of the time steps, from the whole data split into as
+  // many pieces as there are processes in the group. N is reduced to the
+  // largest divisor of the number of processes that does not exceed the
+  // number of time steps. Index based selections, which refer to the pieces
+  // of a single group, and reads through the temporal fast-path always use
+  // one group. Since the groups update the input for different time steps
+  // at the same time, the time steps are only shared when the input is
+  // produced directly by a source that sets
+  // vtkStreamingDemandDrivenPipeline::INDEPENDENT_PIECES(), i.e. one that
+  // does not communicate among processes while executing (e.g. the XML
+  // readers or vtkExodusIIReader, but not vtkPExodusIIReader).
+  vtkSetClampMacro(NumberOfTimePartitions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTimePartitions, int);
+
 //BTX
   enum Tags
   {
@@ -60,14 +85,49 @@ protected:
   vtkPExtractArraysOverTime();
   ~vtkPExtractArraysOverTime();
 
+  virtual int RequestUpdateExtent(vtkInformation* request,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector* outputVector);
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
   virtual void PostExecute(vtkInformation* request,
                            vtkInformationVector** inputVector,
                            vtkInformationVector* outputVector);
+  virtual void DetermineTimeStepRange();
+
+  // Description:
+  // Returns the number of groups of processes the time steps are actually
+  // shared among, and the piece of the data processed by process procid.
+  int GetNumberOfTimeGroups(int& piece, int& numPieces, int procid);
+
+  // Description:
+  // Returns 1 when the input is produced directly by a source that sets
+  // INDEPENDENT_PIECES(), which lets the time steps be shared among groups.
+  // Other sources and filters may communicate among processes while
+  // executing, which would deadlock when the groups update different time
+  // steps.
+  int InputAllowsTimePartitions();
+
+//BTX
+  // Description:
+  // Adds the blocks extracted by a remote process from piece remotePiece to
+  // output. blockPieces holds the piece each block of output comes from;
+  // blocks are merged only when they come from the same piece or when the
+  // selection identifies them globally.
   void AddRemoteData(vtkMultiBlockDataSet* routput,
-                     vtkMultiBlockDataSet* output);
+                     vtkMultiBlockDataSet* output,
+                     int remotePiece,
+                     vtkstd::vector<int>& blockPieces);
+//ETX
   void MergeTables(vtkTable* routput, vtkTable* output);
 
   vtkMultiProcessController* Controller;
+  int NumberOfTimePartitions;
+
+  // Set when the last selection could be extracted with the time steps
+  // shared among groups.
+  int SelectionAllowsTimePartitions;
 
 private:
   vtkPExtractArraysOverTime(const vtkPExtractArraysOverTime&);  // Not implemented.
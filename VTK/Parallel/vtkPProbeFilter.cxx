@@ -16,6 +16,7 @@
 
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCharArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
@@ -25,6 +26,9 @@
 #include "vtkOnePieceExtentTranslator.h"
 #include "vtkPolyData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+
+#define VTK_PPROBE_POINT_IDS "vtkPProbeFilterPointIds"
 
 vtkCxxRevisionMacro(vtkPProbeFilter, "$Revision$");
 vtkStandardNewMacro(vtkPProbeFilter);
@@ -36,6 +40,7 @@ vtkPProbeFilter::vtkPProbeFilter()
 {
   this->Controller = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->ReduceToRoot = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -84,71 +89,166 @@ int vtkPProbeFilter::RequestData(vtkInformation *request,
   vtkDataSet *output = vtkDataSet::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  int procid = 0;
-  int numProcs = 1;
-  if ( this->Controller )
+  if ( this->ReduceToRoot && this->Controller &&
+       this->Controller->GetNumberOfProcesses() > 1 )
     {
-    procid = this->Controller->GetLocalProcessId();
-    numProcs = this->Controller->GetNumberOfProcesses();
+    this->ReduceValidPoints(output);
     }
 
-  vtkIdType numPoints = this->NumberOfValidPoints;
-  if ( procid )
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Returns a table with the valid samples of pd (as flagged by the mask array)
+// and their point ids.
+static vtkTable* vtkPProbeFilterExtractValidPoints(vtkPointData* pd,
+                                                   vtkCharArray* maskArray)
+{
+  vtkIdTypeArray* ids = vtkIdTypeArray::New();
+  ids->SetName(VTK_PPROBE_POINT_IDS);
+  vtkIdType numPoints = maskArray? maskArray->GetNumberOfTuples() : 0;
+  for (vtkIdType pointId = 0; pointId < numPoints; pointId++)
     {
-    // Satellite node
-    this->Controller->Send(&numPoints, 1, 0, PROBE_COMMUNICATION_TAG);
-    if ( numPoints > 0 )
+    if (maskArray->GetValue(pointId) == 1)
       {
-      this->Controller->Send(output, 0, PROBE_COMMUNICATION_TAG);
+      ids->InsertNextValue(pointId);
       }
-    output->ReleaseData();
     }
-  else if ( numProcs > 1 )
+
+  vtkTable* table = vtkTable::New();
+  vtkIdType numValid = ids->GetNumberOfTuples();
+  vtkDataSetAttributes* rowData = table->GetRowData();
+  rowData->CopyAllOn();
+  rowData->CopyAllocate(pd, numValid);
+  rowData->SetNumberOfTuples(numValid);
+  for (vtkIdType i = 0; i < numValid; i++)
+    {
+    rowData->CopyData(pd, ids->GetValue(i), i);
+    }
+  rowData->AddArray(ids);
+  ids->Delete();
+  return table;
+}
+
+//----------------------------------------------------------------------------
+// Returns a table with the rows of first followed by the rows of second,
+// keeping the columns common to both.
+static vtkTable* vtkPProbeFilterAppendValidPoints(vtkTable* first,
+                                                  vtkTable* second)
+{
+  vtkIdType numFirst = first->GetNumberOfRows();
+  vtkIdType numSecond = second->GetNumberOfRows();
+  if (numFirst == 0 || numSecond == 0)
+    {
+    vtkTable* result = numFirst? first : second;
+    result->Register(0);
+    return result;
+    }
+
+  vtkDataSetAttributes::FieldList fieldList(2);
+  fieldList.InitializeFieldList(first->GetRowData());
+  fieldList.IntersectFieldList(second->GetRowData());
+
+  vtkTable* result = vtkTable::New();
+  vtkDataSetAttributes* rowData = result->GetRowData();
+  rowData->CopyAllOn();
+  rowData->CopyAllocate(fieldList, numFirst + numSecond);
+  rowData->SetNumberOfTuples(numFirst + numSecond);
+  for (vtkIdType i = 0; i < numFirst; i++)
+    {
+    rowData->CopyData(fieldList, first->GetRowData(), 0, i, i);
+    }
+  for (vtkIdType i = 0; i < numSecond; i++)
+    {
+    rowData->CopyData(fieldList, second->GetRowData(), 1, i, numFirst + i);
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPProbeFilter::ReduceValidPoints(vtkDataSet* output)
+{
+  int procid = this->Controller->GetLocalProcessId();
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  vtkPointData *pointData = output->GetPointData();
+
+  // Process 0 already has its own samples in the output, so it starts empty.
+  vtkTable* validPoints = 0;
+  if ( procid )
+    {
+    validPoints = vtkPProbeFilterExtractValidPoints(pointData,
+      vtkCharArray::SafeDownCast(
+        pointData->GetArray(this->ValidPointMaskArrayName)));
+    }
+  else
     {
-    vtkIdType numRemoteValidPoints = 0;
-    vtkDataSet *remoteProbeOutput = output->NewInstance();
-    vtkPointData *remotePointData;
-    vtkPointData *pointData = output->GetPointData();
-    vtkIdType i;
-    vtkIdType k;
-    vtkIdType pointId;
-    for (i = 1; i < numProcs; i++)
+    validPoints = vtkTable::New();
+    }
+
+  // Binary tree reduction: at each level, the higher process of a pair sends
+  // its samples (including what it received at lower levels) to the lower
+  // one, which appends them after its own. Rows therefore end up ordered by
+  // process id and, as samples of higher processes are applied last, a
+  // sample found by several processes takes the value of the highest one.
+  for (int step = 1; step < numProcs; step *= 2)
+    {
+    if ( procid % (2*step) == step )
+      {
+      vtkIdType numValid = validPoints->GetNumberOfRows();
+      this->Controller->Send(&numValid, 1, procid - step,
+                             PROBE_COMMUNICATION_TAG);
+      if ( numValid > 0 )
+        {
+        this->Controller->Send(validPoints, procid - step,
+                               PROBE_COMMUNICATION_TAG);
+        }
+      break;
+      }
+    if ( procid % (2*step) == 0 && procid + step < numProcs )
       {
-      this->Controller->Receive(&numRemoteValidPoints, 1, i, PROBE_COMMUNICATION_TAG);
-      if (numRemoteValidPoints > 0)
+      vtkIdType numRemoteValid = 0;
+      this->Controller->Receive(&numRemoteValid, 1, procid + step,
+                                PROBE_COMMUNICATION_TAG);
+      if ( numRemoteValid > 0 )
         {
-        this->Controller->Receive(remoteProbeOutput, i, PROBE_COMMUNICATION_TAG);
-      
-        remotePointData = remoteProbeOutput->GetPointData();
-
-        vtkCharArray* maskArray = vtkCharArray::SafeDownCast(
-          remotePointData->GetArray(this->ValidPointMaskArrayName));
-
-        // Iterate over all point data in the output gathered from the remove
-        // and copy array values from all the pointIds which have the mask array
-        // bit set to 1.
-        vtkIdType numRemotePoints = remoteProbeOutput->GetNumberOfPoints();
-        for (pointId=0; (pointId < numRemotePoints) && maskArray; pointId++)
-          {
-          if (maskArray->GetValue(pointId) == 1)
-            {
-            for (k = 0; k < pointData->GetNumberOfArrays(); k++)
-              {
-              vtkAbstractArray *oaa = pointData->GetArray(k);
-              vtkAbstractArray *raa = remotePointData->GetArray(oaa->GetName());
-              if (raa != NULL)
-                {
-                oaa->SetTuple(pointId, pointId, raa);
-                }            
-              }
-            }
-          }
+        vtkTable* remoteValidPoints = vtkTable::New();
+        this->Controller->Receive(remoteValidPoints, procid + step,
+                                  PROBE_COMMUNICATION_TAG);
+        vtkTable* merged = vtkPProbeFilterAppendValidPoints(
+          validPoints, remoteValidPoints);
+        remoteValidPoints->Delete();
+        validPoints->Delete();
+        validPoints = merged;
         }
       }
-    remoteProbeOutput->Delete();
     }
 
-  return 1;
+  if ( procid )
+    {
+    validPoints->Delete();
+    output->ReleaseData();
+    return;
+    }
+
+  // Copy the samples found on the other processes into the output.
+  vtkDataSetAttributes* rowData = validPoints->GetRowData();
+  vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(
+    rowData->GetAbstractArray(VTK_PPROBE_POINT_IDS));
+  vtkIdType numRows = ids? ids->GetNumberOfTuples() : 0;
+  for (int k = 0; k < pointData->GetNumberOfArrays(); k++)
+    {
+    vtkAbstractArray *oaa = pointData->GetAbstractArray(k);
+    vtkAbstractArray *raa = rowData->GetAbstractArray(oaa->GetName());
+    if (raa == NULL)
+      {
+      continue;
+      }
+    for (vtkIdType row = 0; row < numRows; row++)
+      {
+      oaa->SetTuple(ids->GetValue(row), row, raa);
+      }
+    }
+  validPoints->Delete();
 }
 
 #include "vtkInformationIntegerVectorKey.h"
@@ -205,4 +305,5 @@ void vtkPProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
   os << indent << "Controller " << this->Controller << endl;
+  os << indent << "ReduceToRoot " << this->ReduceToRoot << endl;
 }
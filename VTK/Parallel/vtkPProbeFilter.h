@@ -14,6 +14,15 @@
 =========================================================================*/
 // .NAME vtkPProbeFilter - probe dataset in parallel
 // .SECTION Description
+// vtkPProbeFilter probes the local piece of the source on every process.
+// By default the samples found on the other processes are then merged into
+// the output of process 0. Only the valid samples (those flagged in the
+// valid point mask) are sent, along with their point ids, and they are
+// combined pairwise up a binary tree so that process 0 receives log(P)
+// messages instead of one full probe output per process. The output on the
+// other processes is empty. When ReduceToRoot is off, no communication takes
+// place and every process keeps the samples it found, which is what a
+// parallel consumer of the output wants.
 
 #ifndef __vtkPProbeFilter_h
 #define __vtkPProbeFilter_h
@@ -35,6 +44,14 @@ public:
   virtual void SetController(vtkMultiProcessController*);
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
+  // Description:
+  // When on (default), the valid samples of all processes are merged into
+  // the output of process 0. When off, each process keeps its own probe
+  // output and the valid point mask tells which samples it found.
+  vtkSetMacro(ReduceToRoot, int);
+  vtkGetMacro(ReduceToRoot, int);
+  vtkBooleanMacro(ReduceToRoot, int);
+
 //BTX
 protected:
   vtkPProbeFilter();
@@ -51,7 +68,13 @@ protected:
   virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Merges the valid samples of all processes into the output of process 0
+  // using a binary tree reduction.
+  void ReduceValidPoints(vtkDataSet* output);
+
   vtkMultiProcessController* Controller;
+  int ReduceToRoot;
 
 private:
   vtkPProbeFilter(const vtkPProbeFilter&);  // Not implemented.
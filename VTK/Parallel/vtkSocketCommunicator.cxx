@@ -21,6 +21,7 @@
 #include "vtkSocketController.h"
 #include "vtkStdString.h"
 #include "vtkTypeTraits.h"
+#include "vtkZLibDataCompressor.h"
 
 #include <vtkstd/algorithm>
 #include <vtkstd/vector>
@@ -34,6 +35,11 @@
 #define vtkSocketCommunicatorHashId 100 /* MD5 */
 #include "Parallel/vtkSocketCommunicatorHash.h"
 
+// Messages of at least this many bytes are compressed, in chunks of
+// this many bytes, when compression is enabled.
+#define VTK_SOCKET_COMMUNICATOR_COMPRESSION_THRESHOLD 4096
+#define VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK 65536
+
 vtkStandardNewMacro(vtkSocketCommunicator);
 vtkCxxRevisionMacro(vtkSocketCommunicator, "$Revision$");
 vtkCxxSetObjectMacro(vtkSocketCommunicator, Socket, vtkClientSocket);
@@ -49,6 +55,10 @@ vtkSocketCommunicator::vtkSocketCommunicator()
   this->LogStream = 0;
   this->LogFile = 0;
   this->TagMessageLength = 0;
+  this->Compression = 0;
+  this->CompressionEnabled = 0;
+  this->Compressor = vtkZLibDataCompressor::New();
+  this->Compressor->SetCompressionLevel(1);
 
   this->ReportErrors = 1;
 }
@@ -58,6 +68,7 @@ vtkSocketCommunicator::~vtkSocketCommunicator()
 {
   this->SetSocket(0);
   this->SetLogStream(0);
+  this->Compressor->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -97,6 +108,8 @@ void vtkSocketCommunicator::PrintSelf(ostream& os, vtkIndent indent)
     
   os << indent << "Perform a handshake: " 
      << ( this->PerformHandshake ? "Yes" : "No" ) << endl;
+  os << indent << "Compression: " << this->Compression << endl;
+  os << indent << "CompressionEnabled: " << this->CompressionEnabled << endl;
 
   os << indent << "ReportErrors: " << this->ReportErrors << endl;
 }
@@ -468,6 +481,8 @@ int vtkSocketCommunicator::ServerSideHandshake()
         }
       return 0;
       }
+
+    return this->CompressionHandshake();
     }
   return 1;
 }
@@ -605,6 +620,41 @@ int vtkSocketCommunicator::ClientSideHandshake()
     }
   vtkDebugMacro(<< "Remote has 64 bit ids: " << this->RemoteHas64BitIds);
 
+  return this->CompressionHandshake();
+}
+
+//----------------------------------------------------------------------------
+int vtkSocketCommunicator::CompressionHandshake()
+{
+  // Compression is enabled if either side asks for it.  The server receives
+  // first, the client sends first.
+  this->CompressionEnabled = 0;
+  int remoteCompression = 0;
+  int ok;
+  if (this->IsServer)
+    {
+    ok = this->ReceiveTagged(&remoteCompression, static_cast<int>(sizeof(int)),
+                             1, vtkSocketController::COMPRESSION_TAG, 0) &&
+      this->SendTagged(&this->Compression, static_cast<int>(sizeof(int)), 1,
+                       vtkSocketController::COMPRESSION_TAG, 0);
+    }
+  else
+    {
+    ok = this->SendTagged(&this->Compression, static_cast<int>(sizeof(int)), 1,
+                          vtkSocketController::COMPRESSION_TAG, 0) &&
+      this->ReceiveTagged(&remoteCompression, static_cast<int>(sizeof(int)),
+                          1, vtkSocketController::COMPRESSION_TAG, 0);
+    }
+  if (!ok)
+    {
+    if (this->ReportErrors)
+      {
+      vtkErrorMacro("Compression handshake failed.");
+      }
+    return 0;
+    }
+  this->CompressionEnabled = (this->Compression || remoteCompression)? 1 : 0;
+  vtkDebugMacro(<< "Compression: " << this->CompressionEnabled);
   return 1;
 }
 
@@ -666,6 +716,7 @@ int vtkSocketCommunicator::WaitForConnection(vtkServerSocket* socket,
 //----------------------------------------------------------------------------
 void vtkSocketCommunicator::CloseConnection()
 {
+  this->CompressionEnabled = 0;
   if (this->Socket)
     {
     this->Socket->CloseSocket();
@@ -731,7 +782,7 @@ int vtkSocketCommunicator::SendTagged(const void* data, int wordSize,
   // Only do the actual send if there is some data in the message.
   if (length > 0)
     {
-    if(!this->Socket->Send(data, length))
+    if(!this->SendMessage(data, length))
       {
       if (this->ReportErrors)
         {
@@ -854,7 +905,7 @@ int vtkSocketCommunicator::ReceivePartialTagged(void* data, int wordSize,
   // Only do the actual receive if there is some data to receive
   if (wordSize*numWords > 0)
     {
-    if(!this->Socket->Receive(data, wordSize*numWords))
+    if(!this->ReceiveMessage(data, wordSize*numWords))
       {
       if (this->ReportErrors)
         {
@@ -887,6 +938,106 @@ int vtkSocketCommunicator::ReceivePartialTagged(void* data, int wordSize,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkSocketCommunicator::SendMessage(const void* data, int length)
+{
+  if (!this->CompressionEnabled ||
+      length < VTK_SOCKET_COMMUNICATOR_COMPRESSION_THRESHOLD)
+    {
+    return this->Socket->Send(data, length);
+    }
+
+  // Each chunk is preceded by its compressed length, or by its length if it
+  // is sent uncompressed.  The socket buffers the chunk being transmitted
+  // while the next one is compressed.
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  vtkstd::vector<unsigned char> buffer(
+    this->Compressor->GetMaximumCompressionSpace(
+      VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK));
+  for (int offset = 0; offset < length;
+       offset += VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK)
+    {
+    int size = length - offset;
+    if (size > VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK)
+      {
+      size = VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK;
+      }
+    int compressedSize = static_cast<int>(this->Compressor->Compress(
+        bytes + offset, size, &buffer[0], buffer.size()));
+    if (compressedSize > 0 && compressedSize < size)
+      {
+      if (!this->Socket->Send(&compressedSize, 
+                              static_cast<int>(sizeof(int))) ||
+          !this->Socket->Send(&buffer[0], compressedSize))
+        {
+        return 0;
+        }
+      }
+    else
+      {
+      if (!this->Socket->Send(&size, static_cast<int>(sizeof(int))) ||
+          !this->Socket->Send(bytes + offset, size))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSocketCommunicator::ReceiveMessage(void* data, int length)
+{
+  if (!this->CompressionEnabled ||
+      length < VTK_SOCKET_COMMUNICATOR_COMPRESSION_THRESHOLD)
+    {
+    return this->Socket->Receive(data, length);
+    }
+
+  unsigned char* bytes = reinterpret_cast<unsigned char*>(data);
+  vtkstd::vector<unsigned char> buffer(
+    this->Compressor->GetMaximumCompressionSpace(
+      VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK));
+  for (int offset = 0; offset < length;
+       offset += VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK)
+    {
+    int size = length - offset;
+    if (size > VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK)
+      {
+      size = VTK_SOCKET_COMMUNICATOR_COMPRESSION_CHUNK;
+      }
+    int compressedSize;
+    if (!this->Socket->Receive(&compressedSize, static_cast<int>(sizeof(int))))
+      {
+      return 0;
+      }
+    if(this->SwapBytesInReceivedData == vtkSocketCommunicator::SwapOn)
+      {
+      vtkSwap4(reinterpret_cast<char*>(&compressedSize));
+      }
+    if (compressedSize == size)
+      {
+      if (!this->Socket->Receive(bytes + offset, size))
+        {
+        return 0;
+        }
+      }
+    else if (compressedSize <= 0 || 
+             compressedSize > static_cast<int>(buffer.size()) ||
+             !this->Socket->Receive(&buffer[0], compressedSize) ||
+             static_cast<int>(this->Compressor->Uncompress(
+                 &buffer[0], compressedSize, bytes + offset, size)) != size)
+      {
+      if (this->ReportErrors)
+        {
+        vtkErrorMacro("Could not receive compressed message.");
+        }
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 template <class T, class OutType>
 void vtkSocketCommunicatorLogArray(ostream& os, T* array, int length, int max,
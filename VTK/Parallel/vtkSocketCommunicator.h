@@ -49,6 +49,7 @@
 
 class vtkClientSocket;
 class vtkServerSocket;
+class vtkZLibDataCompressor;
 
 class VTK_PARALLEL_EXPORT vtkSocketCommunicator : public vtkCommunicator
 {
@@ -142,6 +143,22 @@ public:
   vtkBooleanMacro(PerformHandshake, int);
   vtkGetMacro(PerformHandshake, int);
 
+  // Description:
+  // Set or get whether this side asks for compressed messages. The
+  // handshake enables compression when either side asks for it. Messages
+  // of 4 kB or more are then sent as chunks of 64 kB compressed with zlib
+  // at its fastest level. A chunk is compressed while the previous one is
+  // in transit. Chunks that do not compress are sent as they are.
+  // It is off by default, and must be set before the handshake.
+  vtkSetClampMacro(Compression, int, 0, 1);
+  vtkBooleanMacro(Compression, int);
+  vtkGetMacro(Compression, int);
+
+  // Description:
+  // Returns 1 if the messages are compressed, as negotiated by the
+  // handshake.
+  vtkGetMacro(CompressionEnabled, int);
+
   //BTX
   // Description:
   // Get/Set the output stream to which communications should be
@@ -198,6 +215,9 @@ protected:
   int RemoteHas64BitIds;
   int PerformHandshake;
   int IsServer;
+  int Compression;
+  int CompressionEnabled;
+  vtkZLibDataCompressor* Compressor;
   
   int ReportErrors;
 
@@ -215,6 +235,15 @@ protected:
                     const char* logName);
   int ReceivePartialTagged(void* data, int wordSize, int numWords, int tag,
                     const char* logName);
+
+  // Send or receive the bytes of a message, compressed if it is large
+  // enough and compression is enabled.  Return 1 for success, and 0 for
+  // failure.
+  int SendMessage(const void* data, int length);
+  int ReceiveMessage(void* data, int length);
+
+  // Negotiate the compression at the end of the handshake.
+  int CompressionHandshake();
   
   // Internal utility methods.
   void LogTagged(const char* name, const void* data, int wordSize, int numWords,
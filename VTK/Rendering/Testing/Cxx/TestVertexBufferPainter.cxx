@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test renders the same polydata with UseVertexBuffers off and on and
+// compares the images. The scene has triangles with point colors, quads and
+// a wireframe of quads, which the buffer painter must leave to its delegate. The scalars are then modified so that only the
+// colors have to be uploaded again, and the images are compared once more.
+//
+// The command line arguments are:
+// -I        => run in interactive mode; unless this is used, the program will
+//              not allow interaction and exit
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkElevationFilter.h"
+#include "vtkImageData.h"
+#include "vtkImageDifference.h"
+#include "vtkPainterPolyDataMapper.h"
+#include "vtkPlaneSource.h"
+#include "vtkProperty.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderWindowInteractor.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTesting.h"
+#include "vtkWindowToImageFilter.h"
+
+#define NUMBER_OF_MAPPERS 3
+
+// Renders the scene with the given UseVertexBuffers and returns a copy of the
+// image.
+static vtkImageData* Capture(vtkRenderWindow* renWin,
+                             vtkPainterPolyDataMapper** mappers, int useVBO)
+{
+  for (int i = 0; i < NUMBER_OF_MAPPERS; i++)
+    {
+    mappers[i]->SetUseVertexBuffers(useVBO);
+    }
+  renWin->Render();
+
+  vtkSmartPointer<vtkWindowToImageFilter> grabber =
+    vtkSmartPointer<vtkWindowToImageFilter>::New();
+  grabber->SetInput(renWin);
+  grabber->Update();
+  vtkImageData* image = vtkImageData::New();
+  image->DeepCopy(grabber->GetOutput());
+  return image;
+}
+
+// Returns 1 when the images with and without vertex buffers are the same.
+static int Compare(vtkRenderWindow* renWin, vtkPainterPolyDataMapper** mappers,
+                   const char* step)
+{
+  vtkImageData* reference = Capture(renWin, mappers, 0);
+  vtkImageData* image = Capture(renWin, mappers, 1);
+
+  vtkSmartPointer<vtkImageDifference> diff =
+    vtkSmartPointer<vtkImageDifference>::New();
+  diff->SetInput(image);
+  diff->SetImage(reference);
+  diff->Update();
+  double error = diff->GetThresholdedError();
+  reference->Delete();
+  image->Delete();
+
+  if (error > 10.0)
+    {
+    cerr << "ERROR: " << step << ": the image with vertex buffers differs by "
+         << error << " from the image without." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestVertexBufferPainter(int argc, char* argv[])
+{
+  vtkSmartPointer<vtkRenderer> renderer = vtkSmartPointer<vtkRenderer>::New();
+  vtkSmartPointer<vtkRenderWindow> renWin =
+    vtkSmartPointer<vtkRenderWindow>::New();
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  vtkSmartPointer<vtkRenderWindowInteractor> iren =
+    vtkSmartPointer<vtkRenderWindowInteractor>::New();
+  iren->SetRenderWindow(renWin);
+
+  // Triangles with point normals and colors.
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkSmartPointer<vtkElevationFilter> elevation =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, -0.5, 0.0);
+  elevation->SetHighPoint(0.0, 0.5, 0.0);
+
+  // Quads, which are drawn as triangle fans from the buffers.
+  vtkSmartPointer<vtkPlaneSource> plane =
+    vtkSmartPointer<vtkPlaneSource>::New();
+  plane->SetResolution(8, 8);
+
+  vtkPainterPolyDataMapper* mappers[NUMBER_OF_MAPPERS];
+  vtkSmartPointer<vtkActor> actors[NUMBER_OF_MAPPERS];
+  for (int i = 0; i < NUMBER_OF_MAPPERS; i++)
+    {
+    mappers[i] = vtkPainterPolyDataMapper::New();
+    actors[i] = vtkSmartPointer<vtkActor>::New();
+    actors[i]->SetMapper(mappers[i]);
+    renderer->AddActor(actors[i]);
+    }
+  mappers[0]->SetInputConnection(elevation->GetOutputPort());
+  mappers[1]->SetInputConnection(plane->GetOutputPort());
+  mappers[1]->ScalarVisibilityOff();
+  actors[1]->SetPosition(1.2, 0.0, 0.0);
+  actors[1]->GetProperty()->SetColor(0.2, 0.6, 1.0);
+  mappers[2]->SetInputConnection(plane->GetOutputPort());
+  mappers[2]->ScalarVisibilityOff();
+  actors[2]->SetPosition(-1.2, 0.0, 0.0);
+  actors[2]->GetProperty()->SetRepresentationToWireframe();
+
+  renderer->ResetCamera();
+  renderer->GetActiveCamera()->Elevation(30.0);
+
+  int retVal = Compare(renWin, mappers, "first render");
+
+  // Only the colors of the sphere change.
+  elevation->SetLowPoint(0.0, 0.5, 0.0);
+  elevation->SetHighPoint(0.0, -0.5, 0.0);
+  retVal = Compare(renWin, mappers, "modified scalars") && retVal;
+
+  vtkSmartPointer<vtkTesting> testing = vtkSmartPointer<vtkTesting>::New();
+  for (int i = 0; i < argc; i++)
+    {
+    testing->AddArgument(argv[i]);
+    }
+  if (testing->IsInteractiveModeSpecified())
+    {
+    iren->Start();
+    }
+
+  for (int i = 0; i < NUMBER_OF_MAPPERS; i++)
+    {
+    mappers[i]->Delete();
+    }
+  return !retVal;
+}
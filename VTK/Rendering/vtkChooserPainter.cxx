@@ -27,6 +27,7 @@
 #include "vtkRenderer.h"
 #include "vtkStandardPolyDataPainter.h"
 #include "vtkTStripsPainter.h"
+#include "vtkVertexBufferPainter.h"
 
 vtkCxxRevisionMacro(vtkChooserPainter, "$Revision$");
 vtkStandardNewMacro(vtkChooserPainter);
@@ -205,7 +206,19 @@ void vtkChooserPainter::ChoosePainters(vtkRenderer *renderer, vtkActor* actor)
         this->SetPolyPainter(painter);
         painter->Delete();
         vtkStandardPolyDataPainter* sp = vtkStandardPolyDataPainter::New();
-        painter->SetDelegatePainter(sp);
+        if (painter->IsA("vtkVertexBufferPainter"))
+          {
+          // The polygons painter renders the polys the buffers can not.
+          vtkPolyDataPainter* fallback =
+            this->CreatePainter("vtkPolygonsPainter");
+          painter->SetDelegatePainter(fallback);
+          fallback->SetDelegatePainter(sp);
+          fallback->Delete();
+          }
+        else
+          {
+          painter->SetDelegatePainter(sp);
+          }
         sp->Delete();
         }
       }
@@ -250,7 +263,13 @@ void vtkChooserPainter::SelectPainters(vtkRenderer *vtkNotUsed(renderer),
   polyptype = "vtkPolygonsPainter";
   stripptype = "vtkTStripsPainter";
   // No elaborate selection as yet. 
-  // Merely create the pipeline as the vtkOpenGLPolyDataMapper.
+  // Merely create the pipeline as the vtkOpenGLPolyDataMapper, rendering the
+  // polys from buffer objects when requested.
+  if (this->Information->Has(vtkVertexBufferPainter::USE_VERTEX_BUFFERS()) &&
+    this->Information->Get(vtkVertexBufferPainter::USE_VERTEX_BUFFERS()))
+    {
+    polyptype = "vtkVertexBufferPainter";
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -273,6 +292,10 @@ vtkPolyDataPainter* vtkChooserPainter::CreatePainter(const char *paintertype)
     {
     p = vtkTStripsPainter::New();
     }
+  else if (strcmp(paintertype, "vtkVertexBufferPainter") == 0)
+    {
+    p = vtkVertexBufferPainter::New();
+    }
   else
     {
     vtkErrorMacro("Cannot create painter " << paintertype);
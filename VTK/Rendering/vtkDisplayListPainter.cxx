@@ -19,6 +19,7 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkGraphicsFactory.h"
 #include "vtkObjectFactory.h"
+#include "vtkVertexBufferPainter.h"
 
 // Needed when we don't use the vtkStandardNewMacro.
 vtkInstantiatorNewMacro(vtkDisplayListPainter);
@@ -29,6 +30,7 @@ vtkInformationKeyMacro(vtkDisplayListPainter, IMMEDIATE_MODE_RENDERING, Integer)
 vtkDisplayListPainter::vtkDisplayListPainter()
 {
   this->ImmediateModeRendering = 0;
+  this->UseVertexBuffers = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -50,6 +52,11 @@ void vtkDisplayListPainter::ProcessInformation(vtkInformation* info)
     {
     this->SetImmediateModeRendering(info->Get(IMMEDIATE_MODE_RENDERING()));
     }
+  if (info->Has(vtkVertexBufferPainter::USE_VERTEX_BUFFERS()))
+    {
+    this->SetUseVertexBuffers(
+      info->Get(vtkVertexBufferPainter::USE_VERTEX_BUFFERS()));
+    }
 
   this->Superclass::ProcessInformation(info);
 }
@@ -71,4 +78,5 @@ void vtkDisplayListPainter::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "ImmediateModeRendering: " << this->ImmediateModeRendering
     << endl;
+  os << indent << "UseVertexBuffers: " << this->UseVertexBuffers << endl;
 }
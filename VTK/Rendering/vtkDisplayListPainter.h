@@ -57,9 +57,15 @@ protected:
   // These methods set the ivars. These are purposefully protected.
   // The only means to affect them should be using information object.
   vtkSetMacro(ImmediateModeRendering,int);
+  vtkSetMacro(UseVertexBuffers,int);
 
   int ImmediateModeRendering;
 
+  // Set from vtkVertexBufferPainter::USE_VERTEX_BUFFERS(). The polys are
+  // then rendered in immediate mode since draws from buffer objects must
+  // not be compiled in display lists.
+  int UseVertexBuffers;
+
 private:
   vtkDisplayListPainter(const vtkDisplayListPainter&); // Not implemented.
   void operator=(const vtkDisplayListPainter&); // Not implemented.
@@ -36,6 +36,7 @@
 #include "vtkOpenGLRepresentationPainter.h"
 #include "vtkOpenGLScalarsToColorsPainter.h"
 #include "vtkOpenGLTexture.h"
+#include "vtkOpenGLVertexBufferPainter.h"
 #endif
 
 // Win32 specific stuff
@@ -90,6 +91,7 @@
 #include "vtkMesaRepresentationPainter.h"
 #include "vtkMesaScalarsToColorsPainter.h"
 #include "vtkMesaTexture.h"
+#include "vtkMesaVertexBufferPainter.h"
 #include "vtkXMesaRenderWindow.h"
 #endif
 
@@ -377,6 +379,16 @@ vtkObject* vtkGraphicsFactory::CreateInstance(const char* vtkclassname )
 #endif
       return vtkOpenGLRepresentationPainter::New();
       }
+    if (strcmp(vtkclassname, "vtkVertexBufferPainter") == 0)
+      {
+#if defined(VTK_USE_MANGLED_MESA)
+      if ( vtkGraphicsFactory::UseMesaClasses )
+        {
+        return vtkMesaVertexBufferPainter::New();
+        }
+#endif
+      return vtkOpenGLVertexBufferPainter::New();
+      }
     if(strcmp(vtkclassname, "vtkRenderer") == 0)
       {
 #if defined(VTK_USE_MANGLED_MESA)
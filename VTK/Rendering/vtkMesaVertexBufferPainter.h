@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMesaVertexBufferPainter - vertex buffer painter using Mesa.
+// .SECTION Description
+// vtkMesaVertexBufferPainter is the mangled Mesa version of
+// vtkOpenGLVertexBufferPainter. It never uses buffer objects: the polys are
+// always rendered by the delegate painter. The vtkgl buffer functions are
+// loaded by vtkOpenGLExtensionManager with glXGetProcAddress(), which
+// returns the entry points of the system OpenGL library, not the mangled
+// Mesa ones, so calling them would not draw in the Mesa context.
+// Offscreen rendering with an unmangled OSMesa (VTK_OPENGL_HAS_OSMESA) uses
+// vtkOpenGLVertexBufferPainter and does use the buffers.
+
+#ifndef __vtkMesaVertexBufferPainter_h
+#define __vtkMesaVertexBufferPainter_h
+
+#include "vtkVertexBufferPainter.h"
+
+class VTK_RENDERING_EXPORT vtkMesaVertexBufferPainter :
+  public vtkVertexBufferPainter
+{
+public:
+  static vtkMesaVertexBufferPainter* New();
+  vtkTypeRevisionMacro(vtkMesaVertexBufferPainter, vtkVertexBufferPainter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Release any graphics resources that are being consumed by this painter.
+  // The parameter window could be used to determine which graphic
+  // resources to release. In this case, releases the buffer objects.
+  virtual void ReleaseGraphicsResources(vtkWindow *);
+//BTX
+protected:
+  vtkMesaVertexBufferPainter();
+  ~vtkMesaVertexBufferPainter();
+
+  // Description:
+  // Uploads the modified arrays and renders the polys. Returns 0 when the
+  // buffers can not be used.
+  virtual int RenderPrimitive(unsigned long flags, vtkDataArray* n,
+    vtkUnsignedCharArray* c, vtkDataArray* t, vtkRenderer* ren);
+
+private:
+  vtkMesaVertexBufferPainter(const vtkMesaVertexBufferPainter&); // Not implemented.
+  void operator=(const vtkMesaVertexBufferPainter&); // Not implemented.
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
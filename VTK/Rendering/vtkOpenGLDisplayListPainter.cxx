@@ -136,6 +136,23 @@ void vtkOpenGLDisplayListPainter::RenderInternal(vtkRenderer *renderer,
 
   this->TimeToDraw = 0.0;
 
+  if (this->UseVertexBuffers && (typeflags & vtkPainter::POLYS))
+    {
+    // The polys drawn from buffer objects can not be compiled in a display
+    // list. The other primitives still are.
+    if (!forceCompileOnly)
+      {
+      this->Superclass::RenderInternal(renderer, actor, vtkPainter::POLYS,
+        forceCompileOnly);
+      this->TimeToDraw += this->DelegatePainter->GetTimeToDraw();
+      }
+    typeflags &= ~vtkPainter::POLYS;
+    if (!typeflags)
+      {
+      return;
+      }
+    }
+
   vtkDataObject* input = this->GetInput();
   // if something has changed regenrate display lists.
 
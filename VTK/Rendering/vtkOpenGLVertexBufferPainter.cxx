@@ -0,0 +1,374 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkOpenGLVertexBufferPainter.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkOpenGLExtensionManager.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRenderer.h"
+#include "vtkUnsignedCharArray.h"
+
+#ifndef VTK_IMPLEMENT_MESA_CXX
+#  include "vtkOpenGL.h"
+#endif
+#include "vtkgl.h" // vtkgl namespace
+
+#include <vtkstd/vector>
+
+#ifndef VTK_IMPLEMENT_MESA_CXX
+vtkStandardNewMacro(vtkOpenGLVertexBufferPainter);
+vtkCxxRevisionMacro(vtkOpenGLVertexBufferPainter, "$Revision$");
+#endif
+
+class vtkOpenGLVertexBufferPainter::vtkInternals
+{
+public:
+  // A buffer object and the data it was last filled with. The data pointer is
+  // only compared, never dereferenced: a new array allocated at the same
+  // address has a different MTime.
+  struct Buffer
+    {
+    GLuint Handle;
+    vtkObject* Data;
+    unsigned long DataMTime;
+    Buffer() : Handle(0), Data(0), DataMTime(0) {}
+    };
+
+  Buffer Points;
+  Buffer Normals;
+  Buffer Colors;
+  Buffer TCoords;
+  Buffer Indices;
+  GLsizei NumberOfIndices;
+  bool AllTriangles;
+
+  // Whether LastWindow supports buffer objects: -1 when not checked yet.
+  int Supported;
+
+  vtkInternals()
+    {
+    this->NumberOfIndices = 0;
+    this->AllTriangles = true;
+    this->Supported = -1;
+    }
+
+  // Must be called with the context of the window the buffers were created
+  // in current.
+  void ReleaseAllBuffers()
+    {
+    this->Release(this->Points);
+    this->Release(this->Normals);
+    this->Release(this->Colors);
+    this->Release(this->TCoords);
+    this->Release(this->Indices);
+    this->NumberOfIndices = 0;
+    }
+
+  void Release(Buffer& buffer)
+    {
+    if (buffer.Handle)
+      {
+      vtkgl::DeleteBuffers(1, &buffer.Handle);
+      }
+    buffer = Buffer();
+    }
+
+  // Uploads the array to the buffer if it changed since the last upload.
+  void Upload(Buffer& buffer, vtkDataArray* array)
+    {
+    if (buffer.Handle && buffer.Data == array &&
+      buffer.DataMTime == array->GetMTime())
+      {
+      return;
+      }
+    if (!buffer.Handle)
+      {
+      vtkgl::GenBuffers(1, &buffer.Handle);
+      }
+    vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, buffer.Handle);
+    vtkgl::BufferData(vtkgl::ARRAY_BUFFER,
+      static_cast<vtkgl::GLsizeiptr>(array->GetNumberOfTuples() *
+        array->GetNumberOfComponents() * array->GetDataTypeSize()),
+      array->GetVoidPointer(0), vtkgl::STATIC_DRAW);
+    vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, 0);
+    buffer.Data = array;
+    buffer.DataMTime = array->GetMTime();
+    }
+
+  // Splits the polygons in triangle fans and uploads the point ids, if the
+  // polys changed since the last upload.
+  void UploadIndices(vtkCellArray* polys)
+    {
+    if (this->Indices.Handle && this->Indices.Data == polys &&
+      this->Indices.DataMTime == polys->GetMTime())
+      {
+      return;
+      }
+
+    // The connectivity of the random access layout of triangles, when it
+    // is stored with 32-bit integers, is uploaded as it is. The layout is
+    // released after the upload, unless it was already there.
+    vtkDataArray* connectivity = 0;
+    int hadRandomAccess = polys->HasRandomAccess();
+    int hadConnectivity = hadRandomAccess && polys->GetConnectivityArray();
+    int cellSize = polys->IsHomogeneous();
+    this->AllTriangles = (cellSize == 3 || cellSize == 0);
+    if (cellSize == 3)
+      {
+      polys->BuildConnectivityArray();
+      connectivity = polys->GetConnectivityArray();
+      if (connectivity->GetDataTypeSize() != sizeof(GLuint))
+        {
+        connectivity = 0;
+        }
+      }
+
+    vtkstd::vector<GLuint> indices;
+    const void* data = 0;
+    vtkIdType numIndices;
+    if (connectivity)
+      {
+      numIndices = connectivity->GetNumberOfTuples();
+      data = connectivity->GetVoidPointer(0);
+      }
+    else
+      {
+      indices.reserve(3 * polys->GetNumberOfCells());
+      vtkIdType npts;
+      vtkIdType* pts;
+      for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+        {
+        for (vtkIdType cc = 2; cc < npts; cc++)
+          {
+          indices.push_back(static_cast<GLuint>(pts[0]));
+          indices.push_back(static_cast<GLuint>(pts[cc - 1]));
+          indices.push_back(static_cast<GLuint>(pts[cc]));
+          }
+        }
+      numIndices = static_cast<vtkIdType>(indices.size());
+      data = indices.empty()? NULL : &indices[0];
+      }
+
+    if (!this->Indices.Handle)
+      {
+      vtkgl::GenBuffers(1, &this->Indices.Handle);
+      }
+    vtkgl::BindBuffer(vtkgl::ELEMENT_ARRAY_BUFFER, this->Indices.Handle);
+    vtkgl::BufferData(vtkgl::ELEMENT_ARRAY_BUFFER,
+      static_cast<vtkgl::GLsizeiptr>(numIndices * sizeof(GLuint)),
+      numIndices > 0? data : NULL, vtkgl::STATIC_DRAW);
+    vtkgl::BindBuffer(vtkgl::ELEMENT_ARRAY_BUFFER, 0);
+    if (!hadRandomAccess)
+      {
+      polys->ReleaseRandomAccess();
+      }
+    else if (!hadConnectivity)
+      {
+      polys->ReleaseConnectivityArray();
+      }
+    this->NumberOfIndices = static_cast<GLsizei>(numIndices);
+    this->Indices.Data = polys;
+    this->Indices.DataMTime = polys->GetMTime();
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Returns the OpenGL type of the float or double arrays that can be put in
+// buffers, 0 otherwise.
+static GLenum vtkOpenGLVertexBufferPainterGetType(vtkDataArray* array)
+{
+  switch (array->GetDataType())
+    {
+  case VTK_FLOAT:
+    return GL_FLOAT;
+  case VTK_DOUBLE:
+    return GL_DOUBLE;
+    }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkOpenGLVertexBufferPainter::vtkOpenGLVertexBufferPainter()
+{
+  this->Internals = new vtkInternals();
+}
+
+//-----------------------------------------------------------------------------
+vtkOpenGLVertexBufferPainter::~vtkOpenGLVertexBufferPainter()
+{
+  if (this->LastWindow)
+    {
+    this->ReleaseGraphicsResources(this->LastWindow);
+    }
+  delete this->Internals;
+  this->Internals = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOpenGLVertexBufferPainter::ReleaseGraphicsResources(vtkWindow* win)
+{
+  if (win && win->GetMapped() && this->Internals->Supported == 1)
+    {
+    win->MakeCurrent();
+    this->Internals->ReleaseAllBuffers();
+    }
+  // The buffers are gone with the context otherwise.
+  this->Internals->Points = vtkInternals::Buffer();
+  this->Internals->Normals = vtkInternals::Buffer();
+  this->Internals->Colors = vtkInternals::Buffer();
+  this->Internals->TCoords = vtkInternals::Buffer();
+  this->Internals->Indices = vtkInternals::Buffer();
+  this->Internals->NumberOfIndices = 0;
+  this->Internals->Supported = -1;
+  this->Superclass::ReleaseGraphicsResources(win);
+  this->LastWindow = NULL;
+}
+
+//-----------------------------------------------------------------------------
+int vtkOpenGLVertexBufferPainter::RenderPrimitive(unsigned long idx,
+  vtkDataArray* n, vtkUnsignedCharArray* c, vtkDataArray* t, vtkRenderer* ren)
+{
+  if (!this->UseVertexBuffers ||
+    (idx & (VTK_PDM_CELL_COLORS | VTK_PDM_CELL_NORMALS | VTK_PDM_FIELD_COLORS |
+            VTK_PDM_GENERIC_VERTEX_ATTRIBUTES)) ||
+    // Without point normals the delegate computes the normal of every
+    // polygon.
+    !(idx & VTK_PDM_NORMALS))
+    {
+    return 0;
+    }
+
+  vtkPolyData* pd = this->GetInputAsPolyData();
+  vtkCellArray* polys = pd->GetPolys();
+  if (polys->GetNumberOfCells() == 0)
+    {
+    return 1;
+    }
+
+  vtkDataArray* points = pd->GetPoints()->GetData();
+  GLenum pointsType = vtkOpenGLVertexBufferPainterGetType(points);
+  GLenum normalsType = vtkOpenGLVertexBufferPainterGetType(n);
+  GLenum tcoordsType = t? vtkOpenGLVertexBufferPainterGetType(t) : GL_FLOAT;
+  if (!pointsType || !normalsType || !tcoordsType ||
+    (c && c->GetNumberOfComponents() < 3) ||
+    pd->GetNumberOfPoints() > static_cast<vtkIdType>(VTK_UNSIGNED_INT_MAX))
+    {
+    return 0;
+    }
+
+  vtkRenderWindow* renWin = ren->GetRenderWindow();
+  if (this->LastWindow && this->LastWindow.GetPointer() != renWin)
+    {
+    this->ReleaseGraphicsResources(this->LastWindow);
+    }
+  this->LastWindow = renWin;
+#ifdef VTK_IMPLEMENT_MESA_CXX
+  // The extension manager would load the system OpenGL functions, which do
+  // not draw in the mangled Mesa context.
+  this->Internals->Supported = 0;
+#endif
+  if (this->Internals->Supported == -1)
+    {
+    vtkOpenGLRenderWindow* glRenWin = vtkOpenGLRenderWindow::SafeDownCast(renWin);
+    vtkOpenGLExtensionManager* mgr =
+      glRenWin? glRenWin->GetExtensionManager() : 0;
+    this->Internals->Supported = 0;
+    if (mgr && mgr->ExtensionSupported("GL_VERSION_1_5"))
+      {
+      mgr->LoadExtension("GL_VERSION_1_5");
+      this->Internals->Supported = 1;
+      }
+    else if (mgr && mgr->ExtensionSupported("GL_ARB_vertex_buffer_object"))
+      {
+      mgr->LoadCorePromotedExtension("GL_ARB_vertex_buffer_object");
+      this->Internals->Supported = 1;
+      }
+    }
+  if (!this->Internals->Supported)
+    {
+    return 0;
+    }
+
+  this->Internals->UploadIndices(polys);
+  if (!this->Internals->AllTriangles)
+    {
+    // The diagonals of the fans must not show when the representation
+    // painter draws the polygons (or their edges) as lines or points.
+    GLint polygonMode[2];
+    glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+    if (polygonMode[0] != GL_FILL || polygonMode[1] != GL_FILL)
+      {
+      return 0;
+      }
+    }
+
+  this->Internals->Upload(this->Internals->Points, points);
+  this->Internals->Upload(this->Internals->Normals, n);
+  if (c)
+    {
+    this->Internals->Upload(this->Internals->Colors, c);
+    }
+  if (t)
+    {
+    this->Internals->Upload(this->Internals->TCoords, t);
+    }
+
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+  vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, this->Internals->Points.Handle);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, pointsType, 0, 0);
+
+  vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, this->Internals->Normals.Handle);
+  glEnableClientState(GL_NORMAL_ARRAY);
+  glNormalPointer(normalsType, 0, 0);
+
+  if (c)
+    {
+    // Opaque colors ignore the alpha of RGBA colors, as the delegate does.
+    int numComps = c->GetNumberOfComponents();
+    vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, this->Internals->Colors.Handle);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer((idx & VTK_PDM_OPAQUE_COLORS)? 3 : numComps,
+      GL_UNSIGNED_BYTE, numComps, 0);
+    }
+
+  if (t)
+    {
+    vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, this->Internals->TCoords.Handle);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(t->GetNumberOfComponents(), tcoordsType, 0, 0);
+    }
+
+  vtkgl::BindBuffer(vtkgl::ELEMENT_ARRAY_BUFFER,
+    this->Internals->Indices.Handle);
+  glDrawElements(GL_TRIANGLES, this->Internals->NumberOfIndices,
+    GL_UNSIGNED_INT, 0);
+
+  vtkgl::BindBuffer(vtkgl::ELEMENT_ARRAY_BUFFER, 0);
+  vtkgl::BindBuffer(vtkgl::ARRAY_BUFFER, 0);
+  glPopClientAttrib();
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOpenGLVertexBufferPainter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkOpenGLVertexBufferPainter - vertex buffer painter using OpenGL.
+// .SECTION Description
+// vtkOpenGLVertexBufferPainter renders the polys with glDrawElements() from
+// OpenGL buffer objects (OpenGL 1.5 or GL_ARB_vertex_buffer_object). The
+// polygons are split into triangles once, when the polys change. Each array
+// is uploaded again only when it is modified. The delegate renders the polys
+// when the render window does not support buffer objects (as with the
+// mangled Mesa classes), when the buffers can not represent the attributes
+// (cell normals or colors, polygons without normals, generic vertex
+// attributes) or when polygons that are not triangles are drawn as
+// wireframe or with their edges.
+
+#ifndef __vtkOpenGLVertexBufferPainter_h
+#define __vtkOpenGLVertexBufferPainter_h
+
+#include "vtkVertexBufferPainter.h"
+
+class VTK_RENDERING_EXPORT vtkOpenGLVertexBufferPainter :
+  public vtkVertexBufferPainter
+{
+public:
+  static vtkOpenGLVertexBufferPainter* New();
+  vtkTypeRevisionMacro(vtkOpenGLVertexBufferPainter, vtkVertexBufferPainter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Release any graphics resources that are being consumed by this painter.
+  // The parameter window could be used to determine which graphic
+  // resources to release. In this case, releases the buffer objects.
+  virtual void ReleaseGraphicsResources(vtkWindow *);
+//BTX
+protected:
+  vtkOpenGLVertexBufferPainter();
+  ~vtkOpenGLVertexBufferPainter();
+
+  // Description:
+  // Uploads the modified arrays and renders the polys. Returns 0 when the
+  // buffers can not be used.
+  virtual int RenderPrimitive(unsigned long flags, vtkDataArray* n,
+    vtkUnsignedCharArray* c, vtkDataArray* t, vtkRenderer* ren);
+
+private:
+  vtkOpenGLVertexBufferPainter(const vtkOpenGLVertexBufferPainter&); // Not implemented.
+  void operator=(const vtkOpenGLVertexBufferPainter&); // Not implemented.
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
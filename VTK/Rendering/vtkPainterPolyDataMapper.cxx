@@ -36,6 +36,7 @@
 #include "vtkRenderWindow.h"
 #include "vtkScalarsToColorsPainter.h"
 #include "vtkStandardPolyDataPainter.h"
+#include "vtkVertexBufferPainter.h"
 #include "vtkgl.h"
 
 vtkStandardNewMacro(vtkPainterPolyDataMapper);
@@ -81,6 +82,8 @@ vtkPainterPolyDataMapper::vtkPainterPolyDataMapper()
   this->Painter->SetDelegatePainter(cp);
   cp->Delete();
 
+  this->UseVertexBuffers = 0;
+
   this->SelectionPainter = 0;
   vtkPainter* selPainter = vtkHardwareSelectionPolyDataPainter::New();
   this->SetSelectionPainter(selPainter);
@@ -275,6 +278,8 @@ void vtkPainterPolyDataMapper::UpdatePainterInformation()
   int immr = (this->ImmediateModeRendering || 
               vtkMapper::GetGlobalImmediateModeRendering());
   info->Set(vtkDisplayListPainter::IMMEDIATE_MODE_RENDERING(), immr);
+  info->Set(vtkVertexBufferPainter::USE_VERTEX_BUFFERS(),
+    this->UseVertexBuffers);
 }
 
 //-----------------------------------------------------------------------------
@@ -438,4 +443,5 @@ void vtkPainterPolyDataMapper::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "(none)" << endl;
     }
   os << indent << "SelectionPainter: " << this->SelectionPainter << endl;
+  os << indent << "UseVertexBuffers: " << this->UseVertexBuffers << endl;
 }
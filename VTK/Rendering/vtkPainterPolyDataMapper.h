@@ -84,6 +84,17 @@ public:
   // Remove all vertex attributes.
   virtual void RemoveAllVertexAttributeMappings();
   
+  // Description:
+  // When on, the polygons are rendered from vertex buffer objects kept on
+  // the graphics card, which are updated only when the data is modified.
+  // Display lists are not used for the polygons in that case, but still
+  // are for the other primitives. Rendering falls back to
+  // immediate mode when buffer objects are not supported or can not
+  // represent the data. Off by default.
+  vtkSetMacro(UseVertexBuffers, int);
+  vtkGetMacro(UseVertexBuffers, int);
+  vtkBooleanMacro(UseVertexBuffers, int);
+
   // Description:
   // Get/Set the painter used when rendering the selection pass.
   vtkGetObjectMacro(SelectionPainter, vtkPainter);
@@ -117,6 +128,7 @@ protected:
   // (look at vtkHardwareSelector).
   vtkPainter* SelectionPainter;
   vtkPainterPolyDataMapperObserver* Observer;
+  int UseVertexBuffers;
 private:
   vtkPainterPolyDataMapper(const vtkPainterPolyDataMapper&); // Not implemented.
   void operator=(const vtkPainterPolyDataMapper&); // Not implemented.
@@ -0,0 +1,70 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkVertexBufferPainter.h"
+
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkGraphicsFactory.h"
+#include "vtkObjectFactory.h"
+
+// Needed when we don't use the vtkStandardNewMacro.
+vtkInstantiatorNewMacro(vtkVertexBufferPainter);
+vtkCxxRevisionMacro(vtkVertexBufferPainter, "$Revision$");
+vtkInformationKeyMacro(vtkVertexBufferPainter, USE_VERTEX_BUFFERS, Integer);
+
+//----------------------------------------------------------------------------
+vtkVertexBufferPainter::vtkVertexBufferPainter()
+{
+  this->SetSupportedPrimitive(vtkPainter::POLYS);
+  this->UseVertexBuffers = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkVertexBufferPainter::~vtkVertexBufferPainter()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkVertexBufferPainter* vtkVertexBufferPainter::New()
+{
+  vtkObject* o = vtkGraphicsFactory::CreateInstance("vtkVertexBufferPainter");
+  return static_cast<vtkVertexBufferPainter *>(o);
+}
+
+//----------------------------------------------------------------------------
+void vtkVertexBufferPainter::ProcessInformation(vtkInformation* info)
+{
+  if (info->Has(USE_VERTEX_BUFFERS()))
+    {
+    this->SetUseVertexBuffers(info->Get(USE_VERTEX_BUFFERS()));
+    }
+
+  this->Superclass::ProcessInformation(info);
+}
+
+//----------------------------------------------------------------------------
+int vtkVertexBufferPainter::RenderPrimitive(unsigned long,
+  vtkDataArray*, vtkUnsignedCharArray*, vtkDataArray*, vtkRenderer*)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkVertexBufferPainter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseVertexBuffers: " << this->UseVertexBuffers << endl;
+}
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkVertexBufferPainter - abstract superclass for painters that
+// render polygons from buffer objects.
+// .SECTION Description
+// vtkVertexBufferPainter renders the polys of its input from buffers kept on
+// the graphics card. The points, normals, colors and texture coordinates are
+// uploaded once and only the arrays modified since the last render are
+// uploaded again. The polygons are rendered by the delegate painter when the
+// buffers can not be used (missing extensions, cell normals or colors etc.).
+// vtkChooserPainter uses this painter for the polys when
+// USE_VERTEX_BUFFERS() is set in the information.
+
+#ifndef __vtkVertexBufferPainter_h
+#define __vtkVertexBufferPainter_h
+
+#include "vtkPrimitivePainter.h"
+
+class vtkInformationIntegerKey;
+
+class VTK_RENDERING_EXPORT vtkVertexBufferPainter : public vtkPrimitivePainter
+{
+public:
+  static vtkVertexBufferPainter* New();
+  vtkTypeRevisionMacro(vtkVertexBufferPainter, vtkPrimitivePainter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // When set to 1, the polys are rendered from buffer objects when
+  // possible. vtkDisplayListPainter then renders the polys in immediate
+  // mode and keeps display lists for the other primitives.
+  static vtkInformationIntegerKey* USE_VERTEX_BUFFERS();
+
+protected:
+  vtkVertexBufferPainter();
+  ~vtkVertexBufferPainter();
+
+  // Description:
+  // Called before RenderInternal() if the Information has been changed
+  // since the last time this method was called.
+  virtual void ProcessInformation(vtkInformation*);
+
+  // Description:
+  // Renders nothing: the delegate renders the polys.
+  virtual int RenderPrimitive(unsigned long flags, vtkDataArray* n,
+    vtkUnsignedCharArray* c, vtkDataArray* t, vtkRenderer* ren);
+
+  // These methods set the ivars. These are purposefully protected.
+  // The only means to affect them should be using information object.
+  vtkSetMacro(UseVertexBuffers, int);
+
+  int UseVertexBuffers;
+
+private:
+  vtkVertexBufferPainter(const vtkVertexBufferPainter&); // Not implemented.
+  void operator=(const vtkVertexBufferPainter&); // Not implemented.
+};
+
+#endif
@@ -17,10 +17,11 @@ Caveats:
    supported.  Char arrays are also not easy to handle and might not
    work as you expect.  Patches welcome.
 
- - You need to make sure you hold a reference to a Numpy array you want
-   to import into VTK.  If not you'll get a segfault (in the best case).
-   The same holds in reverse when you convert a VTK array to a numpy
-   array -- don't delete the VTK array.
+ - A VTK array created from a Numpy array by numpy_to_vtk holds a
+   reference to the Numpy data it points to until it is deleted.  A Numpy
+   array created from a VTK array by vtk_to_numpy holds a reference to
+   the VTK array.  Neither conversion copies the data unless the types
+   differ or a deep copy is requested.
 
 
 Created by Prabhu Ramachandran in Feb. 2008.
@@ -102,6 +103,15 @@ def create_vtk_array(vtk_arr_type):
     return tmp
 
 
+def _make_reference_holder(num_array):
+    """Internal function that returns an observer holding a reference to
+    num_array. It is attached to the DeleteEvent of a VTK array pointing
+    to the numpy data so that the data lives as long as the VTK array."""
+    def holder(caller, event):
+        ref = num_array
+    return holder
+
+
 def numpy_to_vtk(num_array, deep=0):
     """Converts a contiguous real numpy Array to a VTK array object.
 
@@ -116,9 +126,9 @@ def numpy_to_vtk(num_array, deep=0):
     (shallow copy) and uses more memory but detaches the two arrays
     such that the numpy array can be released.
 
-    WARNING: You must maintain a reference to the passed numpy array, if
-    the numpy data is gc'd and VTK will point to garbage which will in
-    the best case give you a segfault.
+    Unless deep is set, the VTK array points to the numpy data and holds
+    a reference to it (or to the converted copy when the numpy type has
+    no VTK equivalent) until the VTK array is deleted.
 
     Parameters
     ----------
@@ -148,7 +158,8 @@ def numpy_to_vtk(num_array, deep=0):
     else:
         result_array.SetNumberOfComponents(shape[1])
 
-    result_array.SetNumberOfTuples(shape[0])
+    # The number of tuples is set by SetVoidArray below. Setting it here
+    # would allocate memory that is released right away.
 
     # Ravel the array appropriately.
     arr_dtype = get_numpy_array_type(vtk_typecode)
@@ -167,6 +178,9 @@ def numpy_to_vtk(num_array, deep=0):
         copy.UnRegister(None)
         copy.DeepCopy(result_array)
         result_array = copy
+    else:
+        result_array.AddObserver('DeleteEvent',
+                                 _make_reference_holder(z_flat))
     return result_array
 
 